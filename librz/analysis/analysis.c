@@ -8,6 +8,7 @@
 #include <rz_util/rz_path.h>
 #include <rz_lib.h>
 #include <config.h>
+#include "analysis_private.h"
 
 RZ_LIB_VERSION(rz_analysis);
 
@@ -145,6 +146,7 @@ RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *a) {
 	ht_pp_free(a->ht_name_fun);
 	set_u_free(a->visited);
 	rz_analysis_hint_storage_fini(a);
+	rz_analysis_op_cache_fini(a);
 	rz_interval_tree_fini(&a->meta);
 	free(a->cpu);
 	free(a->os);
@@ -154,8 +156,7 @@ RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *a) {
 	rz_platform_target_free(a->arch_target);
 	rz_platform_target_index_free(a->platform_target);
 	rz_reg_free(a->reg);
-	ht_up_free(a->ht_xrefs_from);
-	ht_up_free(a->ht_xrefs_to);
+	rz_analysis_xrefs_fini(a);
 	rz_list_free(a->leaddrs);
 	rz_type_db_free(a->typedb);
 	sdb_free(a->sdb);
@@ -315,6 +316,10 @@ RZ_API int rz_analysis_get_address_bits(RzAnalysis *analysis) {
 }
 
 RZ_API void rz_analysis_set_cpu(RzAnalysis *analysis, const char *cpu) {
+	if (rz_str_cmp(analysis->cpu, cpu, -1)) {
+		// the cpu is not part of the op cache keys
+		rz_analysis_op_cache_invalidate_all(analysis);
+	}
 	free(analysis->cpu);
 	analysis->cpu = cpu ? strdup(cpu) : NULL;
 	int v = rz_analysis_archinfo(analysis, RZ_ANALYSIS_ARCHINFO_TEXT_ALIGN);
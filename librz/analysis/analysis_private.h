@@ -7,5 +7,10 @@
 #include <rz_analysis.h>
 
 RZ_IPI RZ_BORROW RzAnalysisVar *rz_analysis_function_add_var_dwarf(RzAnalysisFunction *fcn, RZ_OWN RzAnalysisVar *var, int size);
+RZ_IPI void rz_analysis_xrefs_fini(RzAnalysis *analysis);
+
+RZ_IPI void rz_analysis_op_cache_fini(RzAnalysis *analysis);
+RZ_IPI bool rz_analysis_op_cache_get(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, const ut8 *data, int len, RzAnalysisOpMask mask, int *ret);
+RZ_IPI void rz_analysis_op_cache_put(RzAnalysis *analysis, const RzAnalysisOp *op, ut64 addr, const ut8 *data, int size, RzAnalysisOpMask mask, int ret);
 
 #endif // RZ_ANALYSIS_PRIVATE_H
@@ -121,6 +121,9 @@ RZ_API bool rz_analysis_esil_set_op(RzAnalysisEsil *esil, const char *op, RzAnal
 			free(eop);
 			return false;
 		}
+		// the word may have been compiled as a value
+		ht_pp_free(esil->programs);
+		esil->programs = NULL;
 	}
 	eop->push = push;
 	eop->pop = pop;
@@ -169,6 +172,8 @@ RZ_API void rz_analysis_esil_free(RzAnalysisEsil *esil) {
 	}
 	ht_pp_free(esil->ops);
 	esil->ops = NULL;
+	ht_pp_free(esil->programs);
+	esil->programs = NULL;
 	rz_analysis_esil_interrupts_fini(esil);
 	rz_analysis_esil_sources_fini(esil);
 	sdb_free(esil->stats);
@@ -2835,11 +2840,32 @@ static bool iscommand(RzAnalysisEsil *esil, const char *word, RzAnalysisEsilOp *
 	return false;
 }
 
-static bool runword(RzAnalysisEsil *esil, const char *word) {
-	RzAnalysisEsilOp *op = NULL;
-	if (!word) {
-		return false;
+typedef enum {
+	ESIL_WORD_PLAIN, ///< operation or value
+	ESIL_WORD_IF, ///< "?{"
+	ESIL_WORD_ELSE, ///< "}{"
+	ESIL_WORD_ENDIF, ///< "}"
+	ESIL_WORD_EMPTY, ///< nothing to run, only kept as a goto target
+} EsilWordKind;
+
+static EsilWordKind word_kind(const char *word) {
+	if (!strcmp(word, "?{")) {
+		return ESIL_WORD_IF;
+	}
+	if (!strcmp(word, "}{")) {
+		return ESIL_WORD_ELSE;
+	}
+	if (!strcmp(word, "}")) {
+		return ESIL_WORD_ENDIF;
 	}
+	return ESIL_WORD_PLAIN;
+}
+
+/**
+ * Runs a word whose kind and operation (NULL if the word is a value) are
+ * already known.
+ */
+static bool runword_resolved(RzAnalysisEsil *esil, const char *word, EsilWordKind kind, RzAnalysisEsilOp *op) {
 	esil->parse_goto_count--;
 	if (esil->parse_goto_count < 1) {
 		ESIL_LOG("ESIL infinite loop detected\n");
@@ -2848,7 +2874,7 @@ static bool runword(RzAnalysisEsil *esil, const char *word) {
 		return false;
 	}
 
-	if (!strcmp(word, "}{")) {
+	if (kind == ESIL_WORD_ELSE) {
 		if (esil->skip == 1) {
 			esil->skip = 0;
 		} else if (esil->skip == 0) { // this isn't perfect, but should work for valid esil
@@ -2856,34 +2882,32 @@ static bool runword(RzAnalysisEsil *esil, const char *word) {
 		}
 		return true;
 	}
-	if (!strcmp(word, "}")) {
+	if (kind == ESIL_WORD_ENDIF) {
 		if (esil->skip) {
 			esil->skip--;
 		}
 		return true;
 	}
-	if (esil->skip && strcmp(word, "?{")) {
+	if (esil->skip && kind != ESIL_WORD_IF) {
 		return true;
 	}
 
-	if (iscommand(esil, word, &op)) {
+	if (op) {
 		// run action
-		if (op) {
-			if (esil->cb.hook_command) {
-				if (esil->cb.hook_command(esil, word)) {
-					return 1; // XXX cannot return != 1
-				}
-			}
-			rz_strbuf_set(&esil->current_opstr, word);
-			// so this is basically just sharing what's the operation with the operation
-			// useful for wrappers
-			const bool ret = op->code(esil);
-			rz_strbuf_fini(&esil->current_opstr);
-			if (!ret) {
-				ESIL_LOG("%s returned 0\n", word);
+		if (esil->cb.hook_command) {
+			if (esil->cb.hook_command(esil, word)) {
+				return 1; // XXX cannot return != 1
 			}
-			return ret;
 		}
+		rz_strbuf_set(&esil->current_opstr, word);
+		// so this is basically just sharing what's the operation with the operation
+		// useful for wrappers
+		const bool ret = op->code(esil);
+		rz_strbuf_fini(&esil->current_opstr);
+		if (!ret) {
+			ESIL_LOG("%s returned 0\n", word);
+		}
+		return ret;
 	}
 	if (!*word || *word == ',') {
 		// skip empty words
@@ -2899,6 +2923,15 @@ static bool runword(RzAnalysisEsil *esil, const char *word) {
 	return true;
 }
 
+static bool runword(RzAnalysisEsil *esil, const char *word) {
+	RzAnalysisEsilOp *op = NULL;
+	if (!word) {
+		return false;
+	}
+	iscommand(esil, word, &op);
+	return runword_resolved(esil, word, word_kind(word), op);
+}
+
 static const char *gotoWord(const char *str, int n) {
 	const char *ostr = str;
 	int count = 0;
@@ -2966,25 +2999,7 @@ static bool __stepOut(RzAnalysisEsil *esil, const char *cmd) {
 	return false;
 }
 
-RZ_API bool rz_analysis_esil_parse(RzAnalysisEsil *esil, const char *str) {
-	int wordi = 0;
-	int dorunword;
-	char word[64];
-	const char *ostr = str;
-	rz_return_val_if_fail(esil && RZ_STR_ISNOTEMPTY(str), 0);
-
-	if (__stepOut(esil, esil->cmd_step)) {
-		(void)__stepOut(esil, esil->cmd_step_out);
-		return true;
-	}
-	const char *hashbang = strstr(str, "#!");
-	esil->trap = 0;
-	if (esil->cmd && esil->cmd_todo) {
-		if (!strncmp(str, "TODO", 4)) {
-			esil->cmd(esil, esil->cmd_todo, esil->address, 0);
-		}
-	}
-loop:
+static void parse_reset(RzAnalysisEsil *esil) {
 	esil->repeat = 0;
 	esil->skip = 0;
 	esil->parse_goto = -1;
@@ -2992,6 +3007,20 @@ loop:
 	// memleak or failing aetr test. wat du
 	//	rz_analysis_esil_stack_free (esil);
 	esil->parse_goto_count = esil->analysis ? esil->analysis->esil_goto_limit : RZ_ANALYSIS_ESIL_GOTO_LIMIT;
+}
+
+/**
+ * Tokenizes and runs \p ostr word by word, this handles all the corner cases
+ * of the syntax (';', hashbangs, empty words) the compiled programs do not.
+ */
+static int parse_words(RzAnalysisEsil *esil, const char *ostr) {
+	int wordi = 0;
+	int dorunword;
+	char word[64];
+	const char *str;
+	const char *hashbang = strstr(ostr, "#!");
+loop:
+	parse_reset(esil);
 	str = ostr;
 repeat:
 	wordi = 0;
@@ -3004,7 +3033,6 @@ repeat:
 		}
 		if (wordi > 62) {
 			ESIL_LOG("Invalid esil string\n");
-			__stepOut(esil, esil->cmd_step_out);
 			return -1;
 		}
 		dorunword = 0;
@@ -3019,20 +3047,16 @@ repeat:
 		if (dorunword) {
 			if (*word) {
 				if (!runword(esil, word)) {
-					__stepOut(esil, esil->cmd_step_out);
 					return 0;
 				}
 				word[wordi] = ',';
 				wordi = 0;
 				switch (evalWord(esil, ostr, &str)) {
 				case 0: goto loop;
-				case 1:
-					__stepOut(esil, esil->cmd_step_out);
-					return 0;
+				case 1: return 0;
 				case 2: continue;
 				}
 				if (dorunword == 1) {
-					__stepOut(esil, esil->cmd_step_out);
 					return 0;
 				}
 			}
@@ -3048,21 +3072,195 @@ repeat:
 	word[wordi] = 0;
 	if (*word) {
 		if (!runword(esil, word)) {
-			__stepOut(esil, esil->cmd_step_out);
 			return 0;
 		}
 		switch (evalWord(esil, ostr, &str)) {
 		case 0: goto loop;
-		case 1:
-			__stepOut(esil, esil->cmd_step_out);
-			return 0;
+		case 1: return 0;
 		case 2: goto repeat;
 		}
 	}
-	__stepOut(esil, esil->cmd_step_out);
 	return 1;
 }
 
+/*
+ * Compiled expressions
+ *
+ * Emulation runs the same few expressions over and over (every loop
+ * iteration, every call to a hot function, the same instruction found at
+ * many addresses), so instead of splitting the string and looking up every
+ * word in the operations table each time, an expression is split once into
+ * a program of words with their operations resolved. Programs are cached by
+ * expression string, which already identifies the decoded instruction bytes
+ * and the architecture they were lifted for.
+ *
+ * Only the words are resolved: the register and number operands are pushed as
+ * strings and parsed by the operations popping them, exactly as with
+ * parse_words(), because that is what the operations, including the custom
+ * ones set by the plugins, consume.
+ */
+
+#define ESIL_PROGRAM_CACHE_MAX 4096
+
+typedef struct {
+	const char *word; ///< points into EsilProgram.words
+	RzAnalysisEsilOp *op; ///< NULL if the word is a value to push
+	EsilWordKind kind;
+} EsilWord;
+
+typedef struct {
+	char *words; ///< copy of the expression with the ',' replaced by '\0'
+	EsilWord *code; ///< NULL if the expression can only be run by parse_words()
+	ut32 len;
+	ut32 refs; ///< the cache and every running parse own a reference
+} EsilProgram;
+
+static void program_unref(EsilProgram *prog) {
+	if (!prog || --prog->refs) {
+		return;
+	}
+	free(prog->words);
+	free(prog->code);
+	free(prog);
+}
+
+static void programs_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	program_unref(kv->value);
+}
+
+/**
+ * Only the expressions made of ',' separated non empty words (a trailing
+ * ',' is tolerated) are compiled, the others are left to parse_words().
+ */
+static bool program_compile(RzAnalysisEsil *esil, EsilProgram *prog) {
+	const char *str = prog->words;
+	if (*str == ',' || strchr(str, ';') || strstr(str, ",,") || strstr(str, "#!")) {
+		return true;
+	}
+	ut32 len = 1;
+	for (const char *c = str; *c; c++) {
+		len += *c == ',';
+	}
+	EsilWord *code = RZ_NEWS0(EsilWord, len);
+	if (!code) {
+		return false;
+	}
+	char *word = prog->words;
+	for (ut32 i = 0; i < len; i++) {
+		char *end = strchr(word, ',');
+		if (end) {
+			*end = '\0';
+		}
+		if (strlen(word) > 62) {
+			free(code);
+			return true;
+		}
+		EsilWord *w = &code[i];
+		w->word = word;
+		w->kind = *word ? word_kind(word) : ESIL_WORD_EMPTY;
+		if (w->kind != ESIL_WORD_ELSE && w->kind != ESIL_WORD_ENDIF) {
+			iscommand(esil, word, &w->op);
+		}
+		word = end ? end + 1 : NULL;
+	}
+	prog->code = code;
+	prog->len = len;
+	return true;
+}
+
+/**
+ * \return the program of \p str with a reference for the caller, NULL on allocation failure
+ */
+static EsilProgram *program_get(RzAnalysisEsil *esil, const char *str) {
+	EsilProgram *prog = esil->programs ? ht_pp_find(esil->programs, str, NULL) : NULL;
+	if (prog) {
+		prog->refs++;
+		return prog;
+	}
+	prog = RZ_NEW0(EsilProgram);
+	if (!prog) {
+		return NULL;
+	}
+	prog->refs = 1;
+	prog->words = strdup(str);
+	if (!prog->words || !program_compile(esil, prog)) {
+		program_unref(prog);
+		return NULL;
+	}
+	if (esil->programs && esil->programs->count >= ESIL_PROGRAM_CACHE_MAX) {
+		// running programs keep their own reference
+		ht_pp_free(esil->programs);
+		esil->programs = NULL;
+	}
+	if (!esil->programs) {
+		esil->programs = ht_pp_new(NULL, programs_kv_free, NULL);
+	}
+	if (esil->programs && ht_pp_insert(esil->programs, str, prog)) {
+		prog->refs++;
+	}
+	return prog;
+}
+
+/**
+ * Same as parse_words() but for a compiled program, see evalWord() for the
+ * meaning of the state checked after every word.
+ */
+static int program_run(RzAnalysisEsil *esil, const EsilProgram *prog) {
+	ut32 i;
+loop:
+	parse_reset(esil);
+	i = 0;
+	while (i < prog->len) {
+		const EsilWord *w = &prog->code[i++];
+		if (w->kind == ESIL_WORD_EMPTY) {
+			continue;
+		}
+		if (!runword_resolved(esil, w->word, w->kind, w->op)) {
+			return 0;
+		}
+		if (esil->repeat) {
+			goto loop;
+		}
+		if (esil->parse_goto != -1) {
+			if (esil->parse_goto < 0 || (ut32)esil->parse_goto >= prog->len) {
+				ESIL_LOG("Cannot find word %d\n", esil->parse_goto);
+				return 0;
+			}
+			i = esil->parse_goto;
+			esil->parse_goto = -1;
+			continue;
+		}
+		if (esil->parse_stop) {
+			if (esil->parse_stop == 2) {
+				RZ_LOG_DEBUG("[esil at 0x%08" PFMT64x "] TODO: %s\n", esil->address, w->word);
+			}
+			return 0;
+		}
+	}
+	return 1;
+}
+
+RZ_API bool rz_analysis_esil_parse(RzAnalysisEsil *esil, const char *str) {
+	rz_return_val_if_fail(esil && RZ_STR_ISNOTEMPTY(str), 0);
+
+	if (__stepOut(esil, esil->cmd_step)) {
+		(void)__stepOut(esil, esil->cmd_step_out);
+		return true;
+	}
+	esil->trap = 0;
+	if (esil->cmd && esil->cmd_todo) {
+		if (!strncmp(str, "TODO", 4)) {
+			esil->cmd(esil, esil->cmd_todo, esil->address, 0);
+		}
+	}
+	EsilProgram *prog = program_get(esil, str);
+	int ret = prog && prog->code ? program_run(esil, prog) : parse_words(esil, str);
+	program_unref(prog);
+	__stepOut(esil, esil->cmd_step_out);
+	return ret;
+}
+
 RZ_API bool rz_analysis_esil_runword(RzAnalysisEsil *esil, const char *word) {
 	(void)runword(esil, word);
 	// for some reasons this is called twice in the original code from condret.
@@ -279,8 +279,10 @@ RZ_API void rz_analysis_function_remove_block(RzAnalysisFunction *fcn, RzAnalysi
 	rz_analysis_block_unref(bb);
 }
 
-static void ensure_fcn_range(RzAnalysisFunction *fcn) {
-	if (fcn->meta._min != UT64_MAX) { // recalculate only if invalid
+static void get_fcn_range(const RzAnalysisFunction *fcn, ut64 *min, ut64 *max) {
+	if (fcn->meta._min != UT64_MAX) {
+		*min = fcn->meta._min;
+		*max = fcn->meta._max;
 		return;
 	}
 	ut64 minval = UT64_MAX;
@@ -295,8 +297,15 @@ static void ensure_fcn_range(RzAnalysisFunction *fcn) {
 			maxval = block->addr + block->size;
 		}
 	}
-	fcn->meta._min = minval;
-	fcn->meta._max = minval == UT64_MAX ? UT64_MAX : maxval;
+	*min = minval;
+	*max = minval == UT64_MAX ? UT64_MAX : maxval;
+}
+
+static void ensure_fcn_range(RzAnalysisFunction *fcn) {
+	if (fcn->meta._min != UT64_MAX) { // recalculate only if invalid
+		return;
+	}
+	get_fcn_range(fcn, &fcn->meta._min, &fcn->meta._max);
 }
 
 RZ_API ut64 rz_analysis_function_linear_size(RzAnalysisFunction *fcn) {
@@ -304,6 +313,19 @@ RZ_API ut64 rz_analysis_function_linear_size(RzAnalysisFunction *fcn) {
 	return fcn->meta._max - fcn->meta._min;
 }
 
+/**
+ * \brief Same as rz_analysis_function_linear_size(), without caching the range of \p fcn
+ *
+ * Unlike rz_analysis_function_linear_size(), it does not write \p fcn,
+ * so it can be used by tasks that run concurrently with others.
+ */
+RZ_API ut64 rz_analysis_function_linear_size_nocache(RZ_NONNULL const RzAnalysisFunction *fcn) {
+	rz_return_val_if_fail(fcn, 0);
+	ut64 min, max;
+	get_fcn_range(fcn, &min, &max);
+	return max - min;
+}
+
 RZ_API ut64 rz_analysis_function_min_addr(RzAnalysisFunction *fcn) {
 	ensure_fcn_range(fcn);
 	return fcn->meta._min;
@@ -85,10 +85,11 @@ void rz_analysis_hint_storage_fini(RzAnalysis *a) {
 RZ_API void rz_analysis_hint_clear(RzAnalysis *a) {
 	rz_analysis_hint_storage_fini(a);
 	rz_analysis_hint_storage_init(a);
+	rz_analysis_op_cache_invalidate_all(a);
 }
 
 typedef struct {
-	HtUP *ht;
+	RzAnalysis *analysis;
 	ut64 addr;
 	ut64 size;
 } DeleteRangeCtx;
@@ -98,7 +99,8 @@ static bool addr_hint_range_delete_cb(void *user, const ut64 key, const void *va
 	if (key < ctx->addr || key >= ctx->addr + ctx->size) {
 		return true;
 	}
-	ht_up_delete(ctx->ht, key);
+	ht_up_delete(ctx->analysis->addr_hints, key);
+	rz_analysis_op_cache_invalidate(ctx->analysis, key);
 	return true;
 }
 
@@ -106,12 +108,13 @@ RZ_API void rz_analysis_hint_del(RzAnalysis *a, ut64 addr, ut64 size) {
 	if (size <= 1) {
 		// only single address
 		ht_up_delete(a->addr_hints, addr);
+		rz_analysis_op_cache_invalidate(a, addr);
 		rz_analysis_hint_unset_arch(a, addr);
 		rz_analysis_hint_unset_bits(a, addr);
 		return;
 	}
 	// ranged delete
-	DeleteRangeCtx ctx = { a->addr_hints, addr, size };
+	DeleteRangeCtx ctx = { a, addr, size };
 	ht_up_foreach(a->addr_hints, addr_hint_range_delete_cb, &ctx);
 	while (true) { // arch
 		RBNode *node = rz_rbtree_lower_bound(a->arch_hints, &addr, ranged_hint_record_cmp, NULL);
@@ -148,6 +151,7 @@ static void unset_addr_hint_record(RzAnalysis *analysis, RzAnalysisAddrHintType
 		if (record->type == type) {
 			addr_hint_record_fini(record, NULL);
 			rz_vector_remove_at(records, i, NULL);
+			rz_analysis_op_cache_invalidate(analysis, addr);
 			return;
 		}
 	}
@@ -183,6 +187,7 @@ static RzAnalysisAddrHintRecord *ensure_addr_hint_record(RzAnalysis *analysis, R
 			break; \
 		} \
 		setcode \
+		rz_analysis_op_cache_invalidate(a, addr); \
 	} while (0)
 
 static RzAnalysisRangedHintRecordBase *ensure_ranged_hint_record(RBTree *tree, ut64 addr, size_t sz) {
@@ -283,6 +288,7 @@ RZ_API void rz_analysis_hint_set_arch(RzAnalysis *a, ut64 addr, RZ_NULLABLE cons
 	}
 	free(record->arch);
 	record->arch = arch ? strdup(arch) : NULL;
+	rz_analysis_op_cache_invalidate_all(a);
 }
 
 RZ_API void rz_analysis_hint_set_bits(RzAnalysis *a, ut64 addr, int bits) {
@@ -291,6 +297,7 @@ RZ_API void rz_analysis_hint_set_bits(RzAnalysis *a, ut64 addr, int bits) {
 		return;
 	}
 	record->bits = bits;
+	rz_analysis_op_cache_invalidate_all(a);
 	if (a->hint_cbs.on_bits) {
 		a->hint_cbs.on_bits(a, addr, bits, true);
 	}
@@ -361,11 +368,15 @@ RZ_API void rz_analysis_hint_unset_stackframe(RzAnalysis *a, ut64 addr) {
 }
 
 RZ_API void rz_analysis_hint_unset_arch(RzAnalysis *a, ut64 addr) {
-	rz_rbtree_delete(&a->arch_hints, &addr, ranged_hint_record_cmp, NULL, arch_hint_record_free_rb, NULL);
+	if (rz_rbtree_delete(&a->arch_hints, &addr, ranged_hint_record_cmp, NULL, arch_hint_record_free_rb, NULL)) {
+		rz_analysis_op_cache_invalidate_all(a);
+	}
 }
 
 RZ_API void rz_analysis_hint_unset_bits(RzAnalysis *a, ut64 addr) {
-	rz_rbtree_delete(&a->bits_hints, &addr, ranged_hint_record_cmp, NULL, bits_hint_record_free_rb, NULL);
+	if (rz_rbtree_delete(&a->bits_hints, &addr, ranged_hint_record_cmp, NULL, bits_hint_record_free_rb, NULL)) {
+		rz_analysis_op_cache_invalidate_all(a);
+	}
 }
 
 RZ_API void rz_analysis_hint_free(RzAnalysisHint *h) {
@@ -114,6 +114,7 @@ RZ_API RZ_OWN RzAnalysisILVM *rz_analysis_il_vm_new(RzAnalysis *a, RZ_NULLABLE R
 		goto ruby_pool;
 	}
 	setup_vm_init_state(r, config->init_state, init_state_reg);
+	r->lifted_max = RZ_ANALYSIS_IL_VM_LIFTED_MAX;
 ruby_pool:
 	rz_analysis_il_config_free(config);
 	return r;
@@ -129,6 +130,7 @@ RZ_API void rz_analysis_il_vm_free(RZ_NULLABLE RzAnalysisILVM *vm) {
 	rz_il_vm_free(vm->vm);
 	rz_il_reg_binding_free(vm->reg_binding);
 	rz_buf_free(vm->io_buf);
+	ht_up_free(vm->lifted);
 	free(vm);
 }
 
@@ -228,6 +230,108 @@ RZ_API bool rz_analysis_il_vm_sync_to_reg(RzAnalysisILVM *vm, RZ_NONNULL RzReg *
 	return rz_il_vm_sync_to_reg(vm->vm, vm->reg_binding, reg);
 }
 
+/**
+ * An instruction lifted by a step, kept so that the next steps at the same
+ * address (e.g. in loops) do not have to lift it again. It is only reused if
+ * the bytes at the address and the plugin state it was lifted with are the
+ * same, which also catches code written by the emulated program itself.
+ */
+typedef struct {
+	RzAnalysisPlugin *plugin;
+	int bits;
+	int big_endian;
+	int size;
+	ut8 bytes[RZ_ANALYSIS_IL_VM_CODE_MAX];
+	RzILOpEffect *effect;
+} ILLifted;
+
+static void lifted_free(HtUPKv *kv) {
+	ILLifted *l = kv->value;
+	rz_il_op_effect_free(l->effect);
+	free(l);
+}
+
+/**
+ * \brief Set the maximum number of lifted instructions kept by \p vm
+ *
+ * 0 disables the cache, so every step lifts its instruction again.
+ */
+RZ_API void rz_analysis_il_vm_cache_set_max(RZ_NONNULL RzAnalysisILVM *vm, size_t max) {
+	rz_return_if_fail(vm);
+	vm->lifted_max = max;
+	rz_analysis_il_vm_cache_clear(vm);
+}
+
+/**
+ * \brief Drop all the lifted instructions kept by \p vm
+ */
+RZ_API void rz_analysis_il_vm_cache_clear(RZ_NONNULL RzAnalysisILVM *vm) {
+	rz_return_if_fail(vm);
+	ht_up_free(vm->lifted);
+	vm->lifted = NULL;
+}
+
+/**
+ * Find a lifted instruction for \p addr that is still valid. Instructions
+ * with address hints are never cached, as hints may change their size.
+ */
+static ILLifted *lifted_get(RzAnalysis *analysis, RzAnalysisILVM *vm, ut64 addr) {
+	ILLifted *l = vm->lifted ? ht_up_find(vm->lifted, addr, NULL) : NULL;
+	if (!l) {
+		return NULL;
+	}
+	if (analysis->coreb.archbits) {
+		// done by rz_analysis_op() otherwise
+		analysis->coreb.archbits(analysis->coreb.core, addr);
+	}
+	ut8 code[RZ_ANALYSIS_IL_VM_CODE_MAX];
+	if (l->plugin != analysis->cur || l->bits != analysis->bits || l->big_endian != analysis->big_endian ||
+		!analysis->read_at(analysis, addr, code, l->size) || memcmp(code, l->bytes, l->size)) {
+		ht_up_delete(vm->lifted, addr);
+		return NULL;
+	}
+	const RzVector *hints = rz_analysis_addr_hints_at(analysis, addr);
+	if (hints && !rz_vector_empty(hints)) {
+		ht_up_delete(vm->lifted, addr);
+		return NULL;
+	}
+	return l;
+}
+
+/**
+ * Keep the lifted \p op, taking its IL effect.
+ */
+static void lifted_put(RzAnalysis *analysis, RzAnalysisILVM *vm, RzAnalysisOp *op, const ut8 *code) {
+	if (op->size < 1 || op->size > RZ_ANALYSIS_IL_VM_CODE_MAX) {
+		return;
+	}
+	const RzVector *hints = rz_analysis_addr_hints_at(analysis, op->addr);
+	if (hints && !rz_vector_empty(hints)) {
+		return;
+	}
+	if (vm->lifted && vm->lifted->count >= vm->lifted_max) {
+		rz_analysis_il_vm_cache_clear(vm);
+	}
+	if (!vm->lifted && !(vm->lifted = ht_up_new(NULL, lifted_free, NULL))) {
+		return;
+	}
+	ILLifted *l = RZ_NEW(ILLifted);
+	if (!l) {
+		return;
+	}
+	l->plugin = analysis->cur;
+	l->bits = analysis->bits;
+	l->big_endian = analysis->big_endian;
+	l->size = op->size;
+	memcpy(l->bytes, code, op->size);
+	l->effect = op->il_op;
+	if (!ht_up_insert(vm->lifted, op->addr, l)) {
+		free(l);
+		return;
+	}
+	op->il_op = NULL;
+}
+
 /**
  * Repeatedly perform steps in the VM until the condition callback returns false
  *
@@ -253,16 +357,28 @@ RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis
 	RzAnalysisILStepResult res = RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS;
 	while (cond(vm, user)) {
 		ut64 addr = rz_bv_to_ut64(vm->vm->pc);
-		ut8 code[32] = { 0 };
+		ILLifted *lifted = vm->lifted_max ? lifted_get(analysis, vm, addr) : NULL;
+		if (lifted) {
+			vm->ops_reused++;
+			if (!rz_il_vm_step(vm->vm, lifted->effect, addr + lifted->size)) {
+				res = RZ_ANALYSIS_IL_STEP_IL_RUNTIME_ERROR;
+				break;
+			}
+			continue;
+		}
+		ut8 code[RZ_ANALYSIS_IL_VM_CODE_MAX] = { 0 };
 		analysis->read_at(analysis, addr, code, sizeof(code));
 		RzAnalysisOp op = { 0 };
 		int r = rz_analysis_op(analysis, &op, addr, code, sizeof(code), RZ_ANALYSIS_OP_MASK_IL | RZ_ANALYSIS_OP_MASK_HINT);
 		RzILOpEffect *ilop = r < 0 ? NULL : op.il_op;
 
 		if (ilop) {
+			vm->ops_lifted++;
 			bool succ = rz_il_vm_step(vm->vm, ilop, addr + (op.size > 0 ? op.size : 1));
 			if (!succ) {
 				res = RZ_ANALYSIS_IL_STEP_IL_RUNTIME_ERROR;
+			} else if (vm->lifted_max) {
+				lifted_put(analysis, vm, &op, code);
 			}
 		} else {
 			res = RZ_ANALYSIS_IL_STEP_INVALID_OP;
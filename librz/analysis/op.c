@@ -5,6 +5,7 @@
 #include <rz_analysis.h>
 #include <rz_util.h>
 #include <rz_list.h>
+#include "analysis_private.h"
 
 RZ_API RzAnalysisOp *rz_analysis_op_new(void) {
 	RzAnalysisOp *op = RZ_NEW(RzAnalysisOp);
@@ -98,6 +99,7 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 
 	rz_analysis_op_init(op);
 	int ret = RZ_MIN(2, len);
+	int decoded = 0;
 	if (len > 0 && analysis->cur && analysis->cur->op) {
 		// use core binding to set asm.bits correctly based on the addr
 		// this is because of the hassle of arm/thumb
@@ -111,6 +113,9 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 			op->size = 1;
 			return -1;
 		}
+		if (analysis->op_cache && rz_analysis_op_cache_get(analysis, op, addr, data, len, mask, &ret)) {
+			return ret;
+		}
 		ret = analysis->cur->op(analysis, op, addr, data, len, mask);
 		if (ret < 1) {
 			op->type = RZ_ANALYSIS_OP_TYPE_ILL;
@@ -120,6 +125,8 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 		if (op->nopcode < 1) {
 			op->nopcode = 1;
 		}
+		// ops cut short by the end of the buffer would not match the same bytes in a longer one
+		decoded = op->size <= len ? op->size : 0;
 	} else if (!memcmp(data, "\xff\xff\xff\xff", RZ_MIN(4, len))) {
 		op->type = RZ_ANALYSIS_OP_TYPE_ILL;
 	} else {
@@ -138,6 +145,9 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 			rz_analysis_hint_free(hint);
 		}
 	}
+	if (analysis->op_cache && decoded) {
+		rz_analysis_op_cache_put(analysis, op, addr, data, decoded, mask, ret);
+	}
 	return ret;
 }
 
@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "analysis_private.h"
+
+/*
+ * Cache of the ops returned by rz_analysis_op(), so that the instructions
+ * decoded again and again by function analysis, disassembly, emulation and
+ * type matching only go through the plugin once.
+ *
+ * The cache is direct mapped: every address maps to a single slot, which
+ * keeps the last op decoded there. A slot is only reused if everything the
+ * decoding depended on is the same: the mask, the plugin, the bits, the
+ * endianness, the register profile (values point to its register items) and
+ * the bytes of the instruction. Comparing the bytes means that writes to
+ * the analyzed memory need no invalidation. Hints are applied to the cached
+ * ops, so hint changes drop the ops of their address, or all of them for
+ * the ranged arch and bits hints.
+ *
+ * Plugins whose decoding depends on state kept between instructions (e.g.
+ * the hexagon packets) may return different ops for the same bytes, which
+ * is why the cache is opt-in.
+ */
+
+#define OP_CACHE_BYTES_MAX 32
+
+typedef struct {
+	ut64 addr; ///< UT64_MAX for unused slots
+	RzAnalysisOpMask mask;
+	RzAnalysisPlugin *plugin;
+	int bits;
+	int big_endian;
+	ut32 reg_generation;
+	int ret; ///< return value of rz_analysis_op()
+	int size; ///< number of bytes decoded by the plugin, before applying the hints
+	ut8 bytes[OP_CACHE_BYTES_MAX];
+	RzAnalysisOp op;
+} OpCacheSlot;
+
+struct rz_analysis_op_cache_t {
+	OpCacheSlot *slots;
+	size_t count; ///< power of 2
+	ut64 hits;
+	ut64 misses;
+};
+
+static inline OpCacheSlot *slot_at(RzAnalysisOpCache *oc, ut64 addr) {
+	// instructions are often aligned, mix the high bits in
+	ut64 h = addr ^ (addr >> 17) ^ (addr >> 31);
+	return &oc->slots[h & (oc->count - 1)];
+}
+
+static void slot_drop(OpCacheSlot *slot) {
+	if (slot->addr == UT64_MAX) {
+		return;
+	}
+	rz_analysis_op_fini(&slot->op);
+	slot->addr = UT64_MAX;
+}
+
+/**
+ * Deep copy of the parts of \p src an op can own, except the IL op and the
+ * switch op, which are never cached.
+ */
+static bool op_copy(RzAnalysisOp *dst, const RzAnalysisOp *src) {
+	*dst = *src;
+	dst->mnemonic = NULL;
+	memset(dst->src, 0, sizeof(dst->src));
+	dst->dst = NULL;
+	dst->access = NULL;
+	dst->il_op = NULL;
+	dst->switch_op = NULL;
+	rz_strbuf_init(&dst->esil);
+	rz_strbuf_init(&dst->opex);
+	if (src->mnemonic && !(dst->mnemonic = strdup(src->mnemonic))) {
+		goto fail;
+	}
+	for (size_t i = 0; i < 3; i++) {
+		if (src->src[i] && !(dst->src[i] = rz_analysis_value_copy(src->src[i]))) {
+			goto fail;
+		}
+	}
+	if (src->dst && !(dst->dst = rz_analysis_value_copy(src->dst))) {
+		goto fail;
+	}
+	if (src->access) {
+		dst->access = rz_list_newf((RzListFree)rz_analysis_value_free);
+		if (!dst->access) {
+			goto fail;
+		}
+		RzListIter *it;
+		RzAnalysisValue *val;
+		rz_list_foreach (src->access, it, val) {
+			RzAnalysisValue *copy = rz_analysis_value_copy(val);
+			if (!copy || !rz_list_append(dst->access, copy)) {
+				rz_analysis_value_free(copy);
+				goto fail;
+			}
+		}
+	}
+	if (!rz_strbuf_copy(&dst->esil, (RzStrBuf *)&src->esil) || !rz_strbuf_copy(&dst->opex, (RzStrBuf *)&src->opex)) {
+		goto fail;
+	}
+	return true;
+fail:
+	rz_analysis_op_fini(dst);
+	return false;
+}
+
+static void op_cache_free(RzAnalysisOpCache *oc) {
+	if (!oc) {
+		return;
+	}
+	if (oc->slots) {
+		for (size_t i = 0; i < oc->count; i++) {
+			slot_drop(&oc->slots[i]);
+		}
+	}
+	free(oc->slots);
+	free(oc);
+}
+
+/**
+ * \brief Enable, resize or disable the op cache
+ *
+ * \param analysis The RzAnalysis instance
+ * \param slots Number of ops to keep, rounded up to a power of 2, 0 disables the cache
+ * \return false if the cache could not be allocated, in which case it stays disabled
+ */
+RZ_API bool rz_analysis_op_cache_resize(RZ_NONNULL RzAnalysis *analysis, size_t slots) {
+	rz_return_val_if_fail(analysis, false);
+	size_t count = 1;
+	while (count < slots) {
+		count <<= 1;
+	}
+	if (analysis->op_cache && analysis->op_cache->count == count) {
+		return true;
+	}
+	op_cache_free(analysis->op_cache);
+	analysis->op_cache = NULL;
+	if (!slots) {
+		return true;
+	}
+	RzAnalysisOpCache *oc = RZ_NEW0(RzAnalysisOpCache);
+	if (!oc) {
+		return false;
+	}
+	oc->count = count;
+	oc->slots = RZ_NEWS(OpCacheSlot, count);
+	if (!oc->slots) {
+		free(oc);
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		oc->slots[i].addr = UT64_MAX;
+	}
+	analysis->op_cache = oc;
+	return true;
+}
+
+RZ_IPI void rz_analysis_op_cache_fini(RzAnalysis *analysis) {
+	op_cache_free(analysis->op_cache);
+	analysis->op_cache = NULL;
+}
+
+/**
+ * \brief Drop the cached op decoded at \p addr
+ */
+RZ_API void rz_analysis_op_cache_invalidate(RZ_NONNULL RzAnalysis *analysis, ut64 addr) {
+	rz_return_if_fail(analysis);
+	RzAnalysisOpCache *oc = analysis->op_cache;
+	if (!oc) {
+		return;
+	}
+	OpCacheSlot *slot = slot_at(oc, addr);
+	if (slot->addr == addr) {
+		slot_drop(slot);
+	}
+}
+
+/**
+ * \brief Drop all the cached ops
+ */
+RZ_API void rz_analysis_op_cache_invalidate_all(RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_if_fail(analysis);
+	RzAnalysisOpCache *oc = analysis->op_cache;
+	if (!oc) {
+		return;
+	}
+	for (size_t i = 0; i < oc->count; i++) {
+		slot_drop(&oc->slots[i]);
+	}
+}
+
+/**
+ * \brief Get the number of ops served from the cache and of ops decoded by the plugin
+ */
+RZ_API void rz_analysis_op_cache_stats(RZ_NONNULL RzAnalysis *analysis, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses) {
+	rz_return_if_fail(analysis);
+	RzAnalysisOpCache *oc = analysis->op_cache;
+	if (hits) {
+		*hits = oc ? oc->hits : 0;
+	}
+	if (misses) {
+		*misses = oc ? oc->misses : 0;
+	}
+}
+
+/**
+ * Fills \p op with the cached op decoded at \p addr from \p data, if any.
+ * \return true on hit, with the return value of rz_analysis_op() in \p ret
+ */
+RZ_IPI bool rz_analysis_op_cache_get(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, const ut8 *data, int len, RzAnalysisOpMask mask, int *ret) {
+	RzAnalysisOpCache *oc = analysis->op_cache;
+	OpCacheSlot *slot = slot_at(oc, addr);
+	if (slot->addr != addr || slot->mask != mask || slot->plugin != analysis->cur ||
+		slot->bits != analysis->bits || slot->big_endian != analysis->big_endian ||
+		slot->reg_generation != analysis->reg->generation ||
+		slot->size > len || memcmp(slot->bytes, data, slot->size)) {
+		oc->misses++;
+		return false;
+	}
+	if (!op_copy(op, &slot->op)) {
+		rz_analysis_op_init(op);
+		oc->misses++;
+		return false;
+	}
+	oc->hits++;
+	*ret = slot->ret;
+	return true;
+}
+
+/**
+ * Keeps a copy of \p op, the result of decoding \p size bytes of \p data
+ * at \p addr, with its hints applied.
+ */
+RZ_IPI void rz_analysis_op_cache_put(RzAnalysis *analysis, const RzAnalysisOp *op, ut64 addr, const ut8 *data, int size, RzAnalysisOpMask mask, int ret) {
+	if (ret < 1 || size < 1 || size > OP_CACHE_BYTES_MAX || op->il_op || op->switch_op) {
+		return;
+	}
+	for (size_t i = 3; i < RZ_ARRAY_SIZE(op->src); i++) {
+		if (op->src[i]) {
+			return;
+		}
+	}
+	OpCacheSlot *slot = slot_at(analysis->op_cache, addr);
+	slot_drop(slot);
+	if (!op_copy(&slot->op, op)) {
+		return;
+	}
+	slot->addr = addr;
+	slot->mask = mask;
+	slot->plugin = analysis->cur;
+	slot->bits = analysis->bits;
+	slot->big_endian = analysis->big_endian;
+	slot->reg_generation = analysis->reg->generation;
+	slot->ret = ret;
+	slot->size = size;
+	memcpy(slot->bytes, data, size);
+}
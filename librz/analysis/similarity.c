@@ -17,6 +17,9 @@
  * If two signatures are of the same size, memcmp is used to perform
  * a fast compare which speeds up the computation and skips the levenshtein
  * distance calculation which is more expensive to perform.
+ *
+ * Large lists of functions are first indexed by locality-sensitive
+ * hashing, so that only the likely matches are compared.
  */
 
 #define iob_read_at(addr, buf, size) (analysis->iob.read_at(analysis->iob.io, addr, buf, size))
@@ -267,6 +270,9 @@ static RZ_OWN RzAnalysisMatchResult *analysis_match_result_new(RZ_NONNULL RzAnal
 	}
 
 	result->matches = rz_th_queue_pop_all(shared.matches);
+	if (result->matches) {
+		result->matches->free = (RzListFree)free;
+	}
 	result->unmatch_a = rz_th_queue_pop_all(shared.unmatch);
 	result->unmatch_b = unmatch_b;
 
@@ -277,6 +283,7 @@ static RZ_OWN RzAnalysisMatchResult *analysis_match_result_new(RZ_NONNULL RzAnal
 
 	rz_th_pool_free(pool);
 	shared_context_fini(&shared);
+	rz_list_free(unmatch_a);
 	return result;
 
 fail:
@@ -425,6 +432,314 @@ static void *analysis_match_functions(SharedContext *shared) {
 	return NULL;
 }
 
+/*
+ * Matching every function of A against every function of B costs one
+ * levenshtein distance per pair, which does not scale to large binaries.
+ * Above SIMILARITY_INDEX_MIN_PAIRS pairs, the functions of B are indexed by
+ * their MinHash sketch over the n-grams of their bytes, and each function of
+ * A is only compared against the functions sharing at least one band of its
+ * sketch (locality-sensitive hashing), plus the function with the same name.
+ *
+ * With SIMILARITY_MINHASH_BANDS bands of SIMILARITY_MINHASH_ROWS rows, two
+ * functions whose n-grams have a jaccard similarity of 0.5 share a bucket
+ * with a probability above 0.9999, which drops to about 0.27 for 0.1.
+ */
+
+#define SIMILARITY_INDEX_MIN_PAIRS (1ull << 20)
+#define SIMILARITY_NGRAM           4
+#define SIMILARITY_MINHASH_ROWS    2
+#define SIMILARITY_MINHASH_BANDS   32
+#define SIMILARITY_MINHASH_SIZE    (SIMILARITY_MINHASH_ROWS * SIMILARITY_MINHASH_BANDS)
+#define SIMILARITY_BUCKET_MAX      256
+
+typedef struct function_sketch_t {
+	RzAnalysisFunction *fcn;
+	ut8 *buf; ///< NULL if the bytes could not be read
+	ut32 size;
+	ut64 bands[SIMILARITY_MINHASH_BANDS];
+	struct function_sketch_t *match; ///< only used for the functions of A
+	double similarity;
+	bool matched; ///< only used for the functions of B
+} FunctionSketch;
+
+typedef struct {
+	ut64 key;
+	ut32 idx;
+} SketchBucket;
+
+typedef struct {
+	FunctionSketch *b;
+	size_t n_b;
+	SketchBucket *bands[SIMILARITY_MINHASH_BANDS]; ///< n_b buckets per band, sorted by key
+	HtPP /*<char *, FunctionSketch *>*/ *names;
+} SketchIndex;
+
+static inline ut64 sketch_mix(ut64 x) {
+	// splitmix64 finalizer
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ull;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebull;
+	x ^= x >> 31;
+	return x;
+}
+
+static void function_sketch_compute(FunctionSketch *sketch, void *user) {
+	if (!sketch->buf) {
+		return;
+	}
+	ut64 minhash[SIMILARITY_MINHASH_SIZE];
+	memset(minhash, 0xff, sizeof(minhash));
+	ut32 n = sketch->size < SIMILARITY_NGRAM ? 1 : sketch->size - SIMILARITY_NGRAM + 1;
+	for (ut32 i = 0; i < n; i++) {
+		ut64 gram = 0;
+		for (ut32 j = 0; j < SIMILARITY_NGRAM && i + j < sketch->size; j++) {
+			gram |= (ut64)sketch->buf[i + j] << (j * 8);
+		}
+		// the permutations are derived from two hashes of the n-gram
+		ut64 h1 = sketch_mix(gram);
+		ut64 h2 = sketch_mix(gram ^ 0x9e3779b97f4a7c15ull) | 1;
+		for (ut32 k = 0; k < SIMILARITY_MINHASH_SIZE; k++) {
+			ut64 h = h1 + k * h2;
+			if (h < minhash[k]) {
+				minhash[k] = h;
+			}
+		}
+	}
+	for (ut32 b = 0; b < SIMILARITY_MINHASH_BANDS; b++) {
+		ut64 key = b;
+		for (ut32 r = 0; r < SIMILARITY_MINHASH_ROWS; r++) {
+			key = sketch_mix(key ^ minhash[b * SIMILARITY_MINHASH_ROWS + r]);
+		}
+		sketch->bands[b] = key;
+	}
+}
+
+static int sketch_bucket_cmp(const void *a, const void *b) {
+	const SketchBucket *ba = a, *bb = b;
+	if (ba->key != bb->key) {
+		return ba->key < bb->key ? -1 : 1;
+	}
+	return ba->idx < bb->idx ? -1 : (ba->idx > bb->idx);
+}
+
+static int candidate_cmp(const void *a, const void *b) {
+	ut32 ia = *(const ut32 *)a, ib = *(const ut32 *)b;
+	return ia < ib ? -1 : (ia > ib);
+}
+
+static bool function_name_is_unique(const char *name) {
+	return RZ_STR_ISNOTEMPTY(name) && strncmp(name, "fcn.", strlen("fcn."));
+}
+
+static void sketch_index_fini(SketchIndex *index) {
+	for (size_t i = 0; i < SIMILARITY_MINHASH_BANDS; i++) {
+		free(index->bands[i]);
+	}
+	ht_pp_free(index->names);
+}
+
+static bool sketch_index_init(SketchIndex *index, FunctionSketch *b, size_t n_b) {
+	memset(index, 0, sizeof(*index));
+	index->b = b;
+	index->n_b = n_b;
+	index->names = ht_pp_new0();
+	if (!index->names) {
+		return false;
+	}
+	for (size_t i = 0; i < SIMILARITY_MINHASH_BANDS; i++) {
+		SketchBucket *buckets = RZ_NEWS(SketchBucket, n_b);
+		if (!buckets && n_b) {
+			sketch_index_fini(index);
+			return false;
+		}
+		size_t n = 0;
+		for (size_t j = 0; j < n_b; j++) {
+			if (b[j].buf) {
+				buckets[n].key = b[j].bands[i];
+				buckets[n].idx = j;
+				n++;
+			}
+		}
+		for (; n < n_b; n++) {
+			// functions without bytes are never candidates
+			buckets[n].key = UT64_MAX;
+			buckets[n].idx = UT32_MAX;
+		}
+		qsort(buckets, n_b, sizeof(SketchBucket), sketch_bucket_cmp);
+		index->bands[i] = buckets;
+	}
+	for (size_t j = 0; j < n_b; j++) {
+		if (b[j].buf && function_name_is_unique(b[j].fcn->name)) {
+			// keeps the first function with the name, like the exhaustive search
+			ht_pp_insert(index->names, b[j].fcn->name, &b[j]);
+		}
+	}
+	return true;
+}
+
+static void sketch_index_candidates(const SketchIndex *index, const FunctionSketch *a, RzVector /*<ut32>*/ *out) {
+	for (size_t i = 0; i < SIMILARITY_MINHASH_BANDS; i++) {
+		const SketchBucket *buckets = index->bands[i];
+		size_t lo = 0, hi = index->n_b;
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (buckets[mid].key < a->bands[i]) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		for (size_t j = lo; j < index->n_b && j - lo < SIMILARITY_BUCKET_MAX && buckets[j].key == a->bands[i] && buckets[j].idx != UT32_MAX; j++) {
+			rz_vector_push(out, (void *)&buckets[j].idx);
+		}
+	}
+	// compare the candidates in the order of B, as the exhaustive search does
+	if (!rz_vector_empty(out)) {
+		rz_vector_sort(out, candidate_cmp, false);
+	}
+}
+
+static void function_sketch_match(FunctionSketch *a, SketchIndex *index) {
+	if (!a->buf) {
+		return;
+	}
+	if (function_name_is_unique(a->fcn->name)) {
+		FunctionSketch *b = ht_pp_find(index->names, a->fcn->name, NULL);
+		if (b) {
+			a->match = b;
+			a->similarity = calculate_similarity(a->buf, a->size, b->buf, b->size);
+			return;
+		}
+	}
+
+	RzVector candidates;
+	rz_vector_init(&candidates, sizeof(ut32), NULL, NULL);
+	sketch_index_candidates(index, a, &candidates);
+	ut32 *idx, prev = UT32_MAX;
+	double max_similarity = 0.0;
+	rz_vector_foreach(&candidates, idx) {
+		if (*idx == prev) {
+			continue;
+		}
+		prev = *idx;
+		FunctionSketch *b = &index->b[*idx];
+		// the levenshtein similarity is bounded by the ratio of the sizes
+		double bound = (double)RZ_MIN(a->size, b->size) / RZ_MAX(a->size, b->size);
+		if (bound < RZ_ANALYSIS_SIMILARITY_THRESHOLD && bound <= max_similarity) {
+			continue;
+		}
+		double calc_similarity = calculate_similarity(a->buf, a->size, b->buf, b->size);
+		if (calc_similarity < RZ_ANALYSIS_SIMILARITY_THRESHOLD && calc_similarity <= max_similarity) {
+			continue;
+		}
+		max_similarity = calc_similarity;
+		a->match = b;
+		if (max_similarity >= 1.0) {
+			break;
+		}
+	}
+	a->similarity = max_similarity;
+	rz_vector_fini(&candidates);
+}
+
+static bool function_sketches_read(RzAnalysis *analysis, RzList /*<RzAnalysisFunction *>*/ *list, FunctionSketch *sketches, RzPVector /*<FunctionSketch *>*/ *all) {
+	RzListIter *iter;
+	RzAnalysisFunction *fcn;
+	size_t i = 0;
+	rz_list_foreach (list, iter, fcn) {
+		FunctionSketch *sketch = &sketches[i++];
+		sketch->fcn = fcn;
+		if (!function_data_new(analysis, fcn, &sketch->buf, &sketch->size)) {
+			RZ_LOG_ERROR("analysis_match: cannot allocate buffer for function %s\n", fcn->name);
+			sketch->buf = NULL;
+			continue;
+		}
+		if (!rz_pvector_push(all, sketch)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool analysis_match_use_index(RzList /*<RzAnalysisFunction *>*/ *list_a, RzList /*<RzAnalysisFunction *>*/ *list_b) {
+	return (ut64)rz_list_length(list_a) * rz_list_length(list_b) >= SIMILARITY_INDEX_MIN_PAIRS;
+}
+
+static RZ_OWN RzAnalysisMatchResult *analysis_match_functions_indexed(RZ_NONNULL RzAnalysis *analysis_a, RZ_NONNULL RzAnalysis *analysis_b, RZ_NONNULL RzList /*<RzAnalysisFunction *>*/ *list_a, RZ_NONNULL RzList /*<RzAnalysisFunction *>*/ *list_b) {
+	size_t n_a = rz_list_length(list_a);
+	size_t n_b = rz_list_length(list_b);
+	RzAnalysisMatchResult *result = NULL;
+	SketchIndex index = { 0 };
+	RzPVector sketched, targets;
+	rz_pvector_init(&sketched, NULL);
+	rz_pvector_init(&targets, NULL);
+	FunctionSketch *a = RZ_NEWS0(FunctionSketch, n_a + 1);
+	FunctionSketch *b = RZ_NEWS0(FunctionSketch, n_b + 1);
+	if (!a || !b) {
+		goto fail;
+	}
+
+	// reading is not thread safe, hashing and matching are
+	if (!function_sketches_read(analysis_a, list_a, a, &targets) ||
+		!function_sketches_read(analysis_b, list_b, b, &sketched) ||
+		!rz_pvector_reserve(&sketched, rz_pvector_len(&sketched) + rz_pvector_len(&targets))) {
+		goto fail;
+	}
+	void **it;
+	rz_pvector_foreach (&targets, it) {
+		rz_pvector_push(&sketched, *it);
+	}
+	if (!rz_th_iterate_pvector(&sketched, (RzThreadIterator)function_sketch_compute, RZ_THREAD_POOL_ALL_CORES, NULL) ||
+		!sketch_index_init(&index, b, n_b)) {
+		RZ_LOG_ERROR("analysis_match: cannot initialize search context\n");
+		goto fail;
+	}
+	if (!rz_th_iterate_pvector(&targets, (RzThreadIterator)function_sketch_match, RZ_THREAD_POOL_ALL_CORES, &index)) {
+		goto fail;
+	}
+
+	result = RZ_NEW0(RzAnalysisMatchResult);
+	if (!result ||
+		!(result->matches = rz_list_newf((RzListFree)free)) ||
+		!(result->unmatch_a = rz_list_new()) ||
+		!(result->unmatch_b = rz_list_new())) {
+		goto fail;
+	}
+	for (size_t i = 0; i < n_a; i++) {
+		RzAnalysisMatchPair *pair = NULL;
+		if (a[i].match && (pair = match_pair_new(a[i].fcn, a[i].match->fcn, a[i].similarity))) {
+			a[i].match->matched = true;
+			rz_list_append(result->matches, pair);
+			continue;
+		}
+		rz_list_append(result->unmatch_a, a[i].fcn);
+	}
+	for (size_t i = 0; i < n_b; i++) {
+		if (!b[i].matched) {
+			rz_list_append(result->unmatch_b, b[i].fcn);
+		}
+	}
+	goto end;
+
+fail:
+	rz_analysis_match_result_free(result);
+	result = NULL;
+end:
+	sketch_index_fini(&index);
+	for (size_t i = 0; a && i < n_a; i++) {
+		free(a[i].buf);
+	}
+	for (size_t i = 0; b && i < n_b; i++) {
+		free(b[i].buf);
+	}
+	free(a);
+	free(b);
+	rz_pvector_fini(&sketched);
+	rz_pvector_fini(&targets);
+	return result;
+}
+
 /**
  * \brief      Finds matching functions of 2 given lists of functions using the same RzAnalysis core
  *
@@ -436,6 +751,9 @@ static void *analysis_match_functions(SharedContext *shared) {
  */
 RZ_API RZ_OWN RzAnalysisMatchResult *rz_analysis_match_functions(RZ_NONNULL RzAnalysis *analysis, RzList /*<RzAnalysisFunction *>*/ *list_a, RzList /*<RzAnalysisFunction *>*/ *list_b) {
 	rz_return_val_if_fail(analysis && list_a && list_b, NULL);
+	if (analysis_match_use_index(list_a, list_b)) {
+		return analysis_match_functions_indexed(analysis, analysis, list_a, list_b);
+	}
 	return analysis_match_result_new(analysis, analysis, list_a, list_b, (RzThreadFunction)analysis_match_functions, (AllocateBuffer)function_data_new);
 }
 
@@ -466,5 +784,8 @@ RZ_API RZ_OWN RzAnalysisMatchResult *rz_analysis_match_basic_blocks_2(RZ_NONNULL
  */
 RZ_API RZ_OWN RzAnalysisMatchResult *rz_analysis_match_functions_2(RZ_NONNULL RzAnalysis *analysis_a, RzList /*<RzAnalysisFunction *>*/ *list_a, RZ_NONNULL RzAnalysis *analysis_b, RzList /*<RzAnalysisFunction *>*/ *list_b) {
 	rz_return_val_if_fail(analysis_a && analysis_b && list_a && list_b, NULL);
+	if (analysis_match_use_index(list_a, list_b)) {
+		return analysis_match_functions_indexed(analysis_a, analysis_b, list_a, list_b);
+	}
 	return analysis_match_result_new(analysis_a, analysis_b, list_a, list_b, (RzThreadFunction)analysis_match_functions, (AllocateBuffer)function_data_new);
 }
@@ -6,64 +6,55 @@
 
 #include <rz_analysis.h>
 #include <rz_cons.h>
+#include "analysis_private.h"
+
+/*
+ * Xrefs are kept in a compact columnar store instead of one heap allocated
+ * RzAnalysisXRef per edge. Every (from, to) pair lives exactly once in the
+ * store, either in the small unsorted write buffer or in one of the runs.
+ * A run holds the same entries twice, once sorted by (from, to) and once by
+ * (to, from), so both directions and address ranges are binary searches.
+ *
+ * When the buffer fills up it becomes a new run and runs of similar size are
+ * merged (logarithmic method), keeping insertion amortized O(log n).
+ * Deleted entries inside runs are marked with XREF_TYPE_DELETED and dropped
+ * on the next merge.
+ */
 
-#if 0
-DICT
-====
-
-refs 10->20 C 16->10 J 20->10 C
+#define XREF_TYPE_DELETED ((RzAnalysisXRefType)0xff)
+#define XREF_BUFFER_SIZE 128
 
-	xrefs 20->[10 C] 10 -> [16 J, 20 C]
+typedef struct {
+	RzAnalysisXRef *by_from; ///< entries sorted by (from, to)
+	RzAnalysisXRef *by_to; ///< same entries sorted by (to, from)
+	size_t len;
+} XRefRun;
 
-	10 : call 20 16 : jmp 10 20 : call 10
-#endif
+struct rz_analysis_xref_store_t {
+	RzPVector /*<XRefRun *>*/ runs; ///< sorted runs, keys are unique across all runs and the buffer
+	RzVector /*<RzAnalysisXRef>*/ buffer; ///< unsorted recent insertions
+	ut64 count; ///< number of live xrefs
+};
 
-// XXX: is it possible to have multiple type for the same (from, to) pair?
-//      if it is, things need to be adjusted
+typedef struct {
+	RzAnalysisXRef xref;
+	size_t seq;
+} XRefBulkItem;
 
-static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, ut64 type) {
+static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, RzAnalysisXRefType type) {
 	RzAnalysisXRef *xref = RZ_NEW(RzAnalysisXRef);
 	if (xref) {
 		xref->from = from;
 		xref->to = to;
-		xref->type = (type == -1) ? RZ_ANALYSIS_XREF_TYPE_CODE : type;
+		xref->type = type;
 	}
 	return xref;
 }
 
-static void rz_analysis_xref_free(RzAnalysisXRef *xref) {
-	free(xref);
-}
-
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xref_list_new() {
 	return rz_list_newf((RzListFree)free);
 }
 
-static void xrefs_ht_free(HtUPKv *kv) {
-	ht_up_free(kv->value);
-}
-
-static void xrefs_ref_free(HtUPKv *kv) {
-	rz_analysis_xref_free(kv->value);
-}
-
-static bool appendRef(void *u, const ut64 k, const void *v) {
-	RzList *list = (RzList *)u;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
-	RzAnalysisXRef *cloned = rz_analysis_xref_new(xref->from, xref->to, xref->type);
-	if (cloned) {
-		rz_list_append(list, cloned);
-		return true;
-	}
-	return false;
-}
-
-static bool mylistrefs_cb(void *list, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, appendRef, list);
-	return true;
-}
-
 static int ref_cmp(const RzAnalysisXRef *a, const RzAnalysisXRef *b) {
 	if (a->from < b->from) {
 		return -1;
@@ -80,102 +71,372 @@ static int ref_cmp(const RzAnalysisXRef *a, const RzAnalysisXRef *b) {
 	return 0;
 }
 
+static int ref_cmp_to(const RzAnalysisXRef *a, const RzAnalysisXRef *b) {
+	if (a->to < b->to) {
+		return -1;
+	}
+	if (a->to > b->to) {
+		return 1;
+	}
+	if (a->from < b->from) {
+		return -1;
+	}
+	if (a->from > b->from) {
+		return 1;
+	}
+	return 0;
+}
+
+static int ref_qsort_cmp(const void *a, const void *b) {
+	return ref_cmp(a, b);
+}
+
+static int ref_qsort_cmp_to(const void *a, const void *b) {
+	return ref_cmp_to(a, b);
+}
+
+static int bulk_item_cmp(const void *a, const void *b) {
+	const XRefBulkItem *ia = a;
+	const XRefBulkItem *ib = b;
+	int r = ref_cmp(&ia->xref, &ib->xref);
+	if (r) {
+		return r;
+	}
+	return ia->seq < ib->seq ? -1 : (ia->seq > ib->seq ? 1 : 0);
+}
+
 static void sortxrefs(RzList /*<RzAnalysisXRef *>*/ *list) {
 	rz_list_sort(list, (RzListComparator)ref_cmp);
 }
 
-static void listxrefs(HtUP *m, ut64 addr, RzList /*<RzAnalysisXRef *>*/ *list) {
-	if (addr == UT64_MAX) {
-		ht_up_foreach(m, mylistrefs_cb, list);
-	} else {
-		HtUP *d = ht_up_find(m, addr, NULL);
-		if (d) {
-			ht_up_foreach(d, appendRef, list);
+/**
+ * Index of the first entry of \p arr not lower than (\p k1, \p k2), where
+ * the keys are (from, to) or (to, from) depending on \p by_to.
+ */
+static size_t run_lower_bound(const RzAnalysisXRef *arr, size_t len, bool by_to, ut64 k1, ut64 k2) {
+	size_t lo = 0, hi = len;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		ut64 a1 = by_to ? arr[mid].to : arr[mid].from;
+		ut64 a2 = by_to ? arr[mid].from : arr[mid].to;
+		if (a1 < k1 || (a1 == k1 && a2 < k2)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
 	}
+	return lo;
 }
 
-static bool set_xref(HtUP *m, RzAnalysisXRef *xref, bool from2to) {
-	ut64 key1 = from2to ? xref->from : xref->to;
-	HtUP *ht = ht_up_find(m, key1, NULL);
-	if (!ht) {
-		// RzAnalysis::ht_xrefs_to is responsible for releasing of pointers.
-		HtUPKvFreeFunc cb = from2to ? NULL : xrefs_ref_free;
-		ht = ht_up_new(NULL, cb, NULL);
-		if (!ht) {
-			return false;
+static RzAnalysisXRef *run_find(const XRefRun *run, bool by_to, ut64 from, ut64 to) {
+	const RzAnalysisXRef *arr = by_to ? run->by_to : run->by_from;
+	size_t i = by_to ? run_lower_bound(arr, run->len, true, to, from) : run_lower_bound(arr, run->len, false, from, to);
+	if (i < run->len && arr[i].from == from && arr[i].to == to) {
+		return (RzAnalysisXRef *)&arr[i];
+	}
+	return NULL;
+}
+
+static void run_free(XRefRun *run) {
+	if (!run) {
+		return;
+	}
+	free(run->by_from);
+	free(run->by_to);
+	free(run);
+}
+
+/**
+ * Builds a run that takes ownership of \p by_from, which must already be
+ * sorted by (from, to) and hold \p len unique entries.
+ */
+static XRefRun *run_new(RZ_OWN RzAnalysisXRef *by_from, size_t len) {
+	XRefRun *run = RZ_NEW0(XRefRun);
+	RzAnalysisXRef *by_to = RZ_NEWS(RzAnalysisXRef, len);
+	if (!run || !by_to) {
+		free(run);
+		free(by_to);
+		free(by_from);
+		return NULL;
+	}
+	memcpy(by_to, by_from, len * sizeof(RzAnalysisXRef));
+	qsort(by_to, len, sizeof(RzAnalysisXRef), ref_qsort_cmp_to);
+	run->by_from = by_from;
+	run->by_to = by_to;
+	run->len = len;
+	return run;
+}
+
+static size_t merge_sorted(RzAnalysisXRef *dst, const RzAnalysisXRef *a, size_t alen, const RzAnalysisXRef *b, size_t blen, bool by_to) {
+	size_t i = 0, j = 0, n = 0;
+	while (i < alen || j < blen) {
+		const RzAnalysisXRef *x;
+		if (j >= blen) {
+			x = &a[i++];
+		} else if (i >= alen) {
+			x = &b[j++];
+		} else if ((by_to ? ref_cmp_to(&a[i], &b[j]) : ref_cmp(&a[i], &b[j])) < 0) {
+			x = &a[i++];
+		} else {
+			x = &b[j++];
 		}
-		if (!ht_up_insert(m, key1, ht)) {
-			return false;
+		if (x->type != XREF_TYPE_DELETED) {
+			dst[n++] = *x;
 		}
 	}
-	ut64 key2 = from2to ? xref->to : xref->from;
-	return ht_up_update(ht, key2, xref);
+	return n;
 }
 
-// Set a cross reference from FROM to TO.
-RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
-	if (!analysis || from == to) {
-		return false;
+/**
+ * Merges two runs into a new one, dropping deleted entries.
+ * Keys are unique across runs, so no deduplication is needed.
+ */
+static XRefRun *run_merge(const XRefRun *a, const XRefRun *b) {
+	size_t cap = a->len + b->len;
+	XRefRun *run = RZ_NEW0(XRefRun);
+	if (!run) {
+		return NULL;
 	}
-	if (analysis->iob.is_valid_offset) {
-		if (!analysis->iob.is_valid_offset(analysis->iob.io, from, 0)) {
-			return false;
+	run->by_from = RZ_NEWS(RzAnalysisXRef, RZ_MAX(cap, 1));
+	run->by_to = RZ_NEWS(RzAnalysisXRef, RZ_MAX(cap, 1));
+	if (!run->by_from || !run->by_to) {
+		run_free(run);
+		return NULL;
+	}
+	run->len = merge_sorted(run->by_from, a->by_from, a->len, b->by_from, b->len, false);
+	merge_sorted(run->by_to, a->by_to, a->len, b->by_to, b->len, true);
+	if (run->len && run->len < cap) {
+		RzAnalysisXRef *tmp = realloc(run->by_from, run->len * sizeof(RzAnalysisXRef));
+		run->by_from = tmp ? tmp : run->by_from;
+		tmp = realloc(run->by_to, run->len * sizeof(RzAnalysisXRef));
+		run->by_to = tmp ? tmp : run->by_to;
+	}
+	return run;
+}
+
+static RzAnalysisXRefStore *xref_store_new(void) {
+	RzAnalysisXRefStore *st = RZ_NEW0(RzAnalysisXRefStore);
+	if (!st) {
+		return NULL;
+	}
+	rz_pvector_init(&st->runs, (RzPVectorFree)run_free);
+	rz_vector_init(&st->buffer, sizeof(RzAnalysisXRef), NULL, NULL);
+	return st;
+}
+
+static void xref_store_free(RzAnalysisXRefStore *st) {
+	if (!st) {
+		return;
+	}
+	rz_pvector_fini(&st->runs);
+	rz_vector_fini(&st->buffer);
+	free(st);
+}
+
+/**
+ * Pushes \p run on top of the run stack and merges the top runs for as long
+ * as the lower one is not much bigger than the upper one.
+ * On allocation failure the runs are left unmerged, which is still consistent.
+ */
+static void xref_store_push_run(RzAnalysisXRefStore *st, RZ_OWN XRefRun *run) {
+	if (!run->len) {
+		run_free(run);
+		return;
+	}
+	if (!rz_pvector_push(&st->runs, run)) {
+		run_free(run);
+		return;
+	}
+	while (rz_pvector_len(&st->runs) > 1) {
+		size_t n = rz_pvector_len(&st->runs);
+		XRefRun *top = rz_pvector_at(&st->runs, n - 1);
+		XRefRun *prev = rz_pvector_at(&st->runs, n - 2);
+		if (prev->len > 2 * top->len) {
+			break;
 		}
-		if (!analysis->iob.is_valid_offset(analysis->iob.io, to, 0)) {
-			return false;
+		XRefRun *merged = run_merge(prev, top);
+		if (!merged) {
+			break;
 		}
+		rz_pvector_pop(&st->runs);
+		rz_pvector_pop(&st->runs);
+		run_free(top);
+		run_free(prev);
+		if (!merged->len) {
+			run_free(merged);
+			continue;
+		}
+		rz_pvector_push(&st->runs, merged);
 	}
-	RzAnalysisXRef *xref = rz_analysis_xref_new(from, to, type);
-	if (!xref) {
-		return false;
+}
+
+/**
+ * Turns the write buffer into a sorted run.
+ */
+static bool xref_store_flush(RzAnalysisXRefStore *st) {
+	size_t len = rz_vector_len(&st->buffer);
+	if (!len) {
+		return true;
 	}
-	if (!set_xref(analysis->ht_xrefs_from, xref, true)) {
-		// Pointer isn't added to <ht_xrefs_from> so we have to release it
-		rz_analysis_xref_free(xref);
+	RzAnalysisXRef *by_from = RZ_NEWS(RzAnalysisXRef, len);
+	if (!by_from) {
 		return false;
 	}
-	if (!set_xref(analysis->ht_xrefs_to, xref, false)) {
-		// Delete the entry in <ht_xrefs_from>
-		rz_analysis_xrefs_deln(analysis, from, to, type);
-		// Pointer isn't added to <ht_xrefs_to> so we have to release it
-		rz_analysis_xref_free(xref);
+	memcpy(by_from, rz_vector_index_ptr(&st->buffer, 0), len * sizeof(RzAnalysisXRef));
+	qsort(by_from, len, sizeof(RzAnalysisXRef), ref_qsort_cmp);
+	XRefRun *run = run_new(by_from, len);
+	if (!run) {
 		return false;
 	}
+	rz_vector_clear(&st->buffer);
+	xref_store_push_run(st, run);
 	return true;
 }
 
-RZ_API bool rz_analysis_xrefs_deln(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
-	if (!analysis) {
-		return false;
+/**
+ * Merges everything into a single run, so that iterating its by_from array
+ * visits all xrefs in (from, to) order.
+ */
+static void xref_store_compact(RzAnalysisXRefStore *st) {
+	xref_store_flush(st);
+	while (rz_pvector_len(&st->runs) > 1) {
+		size_t n = rz_pvector_len(&st->runs);
+		XRefRun *top = rz_pvector_at(&st->runs, n - 1);
+		XRefRun *prev = rz_pvector_at(&st->runs, n - 2);
+		XRefRun *merged = run_merge(prev, top);
+		if (!merged) {
+			return;
+		}
+		rz_pvector_pop(&st->runs);
+		rz_pvector_pop(&st->runs);
+		run_free(top);
+		run_free(prev);
+		if (merged->len) {
+			rz_pvector_push(&st->runs, merged);
+		} else {
+			run_free(merged);
+		}
+	}
+}
+
+static RzAnalysisXRef *buffer_find(RzAnalysisXRefStore *st, ut64 from, ut64 to, size_t *idx) {
+	RzAnalysisXRef *xref;
+	size_t i = 0;
+	rz_vector_foreach(&st->buffer, xref) {
+		if (xref->from == from && xref->to == to) {
+			if (idx) {
+				*idx = i;
+			}
+			return xref;
+		}
+		i++;
+	}
+	return NULL;
+}
+
+/**
+ * Changes the type of an existing (from, to) entry in place.
+ * \return false if the pair is not in the store at all
+ */
+static bool xref_store_update(RzAnalysisXRefStore *st, ut64 from, ut64 to, RzAnalysisXRefType type, RzAnalysisXRefType *old) {
+	RzAnalysisXRef *xref = buffer_find(st, from, to, NULL);
+	if (xref) {
+		*old = xref->type;
+		xref->type = type;
+		return true;
 	}
-	HtUP *ht1 = ht_up_find(analysis->ht_xrefs_from, from, NULL);
-	if (ht1) {
-		ht_up_delete(ht1, to);
+	void **it;
+	rz_pvector_foreach (&st->runs, it) {
+		XRefRun *run = *it;
+		xref = run_find(run, false, from, to);
+		if (!xref) {
+			continue;
+		}
+		*old = xref->type;
+		xref->type = type;
+		xref = run_find(run, true, from, to);
+		rz_warn_if_fail(xref);
+		if (xref) {
+			xref->type = type;
+		}
+		return true;
 	}
-	HtUP *ht2 = ht_up_find(analysis->ht_xrefs_to, to, NULL);
-	if (ht2) {
-		ht_up_delete(ht2, from);
+	return false;
+}
+
+static bool xref_store_set(RzAnalysisXRefStore *st, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	RzAnalysisXRefType old;
+	if (xref_store_update(st, from, to, type, &old)) {
+		if (old == XREF_TYPE_DELETED) {
+			st->count++;
+		}
+		return true;
+	}
+	RzAnalysisXRef xref = { from, to, type };
+	if (!rz_vector_push(&st->buffer, &xref)) {
+		return false;
+	}
+	st->count++;
+	if (rz_vector_len(&st->buffer) >= XREF_BUFFER_SIZE) {
+		xref_store_flush(st);
 	}
 	return true;
 }
 
-RZ_API bool rz_analysis_xref_del(RzAnalysis *analysis, ut64 from, ut64 to) {
-	bool res = false;
-	res |= rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_NULL);
-	res |= rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_CODE);
-	res |= rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_CALL);
-	res |= rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_DATA);
-	res |= rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_STRING);
-	return res;
+static void xref_store_del(RzAnalysisXRefStore *st, ut64 from, ut64 to) {
+	size_t idx;
+	if (buffer_find(st, from, to, &idx)) {
+		rz_vector_remove_at(&st->buffer, idx, NULL);
+		st->count--;
+		return;
+	}
+	RzAnalysisXRefType old;
+	if (xref_store_update(st, from, to, XREF_TYPE_DELETED, &old) && old != XREF_TYPE_DELETED) {
+		st->count--;
+	}
 }
 
-RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis *analysis, ut64 addr) {
+static void append_xref(RzList /*<RzAnalysisXRef *>*/ *list, const RzAnalysisXRef *xref) {
+	RzAnalysisXRef *cloned = rz_analysis_xref_new(xref->from, xref->to, xref->type);
+	if (cloned) {
+		rz_list_append(list, cloned);
+	}
+}
+
+/**
+ * Appends to \p list every xref whose source (or target if \p by_to) is in [\p lo, \p hi].
+ */
+static void listxrefs(RzAnalysisXRefStore *st, bool by_to, ut64 lo, ut64 hi, RzList /*<RzAnalysisXRef *>*/ *list) {
+	void **it;
+	rz_pvector_foreach (&st->runs, it) {
+		const XRefRun *run = *it;
+		const RzAnalysisXRef *arr = by_to ? run->by_to : run->by_from;
+		size_t i = run_lower_bound(arr, run->len, by_to, lo, 0);
+		for (; i < run->len; i++) {
+			ut64 key = by_to ? arr[i].to : arr[i].from;
+			if (key > hi) {
+				break;
+			}
+			if (arr[i].type != XREF_TYPE_DELETED) {
+				append_xref(list, &arr[i]);
+			}
+		}
+	}
+	RzAnalysisXRef *xref;
+	rz_vector_foreach(&st->buffer, xref) {
+		ut64 key = by_to ? xref->to : xref->from;
+		if (key >= lo && key <= hi) {
+			append_xref(list, xref);
+		}
+	}
+}
+
+static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *xrefs_get_range(RzAnalysis *analysis, bool by_to, ut64 lo, ut64 hi) {
 	RzList *list = rz_analysis_xref_list_new();
 	if (!list) {
 		return NULL;
 	}
-	listxrefs(analysis->ht_xrefs_to, addr, list);
+	listxrefs(analysis->xrefs, by_to, lo, hi, list);
 	sortxrefs(list);
 	if (rz_list_empty(list)) {
 		rz_list_free(list);
@@ -184,18 +445,162 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis
 	return list;
 }
 
+static bool xref_is_valid(RzAnalysis *analysis, ut64 from, ut64 to) {
+	if (from == to) {
+		return false;
+	}
+	if (analysis->iob.is_valid_offset) {
+		if (!analysis->iob.is_valid_offset(analysis->iob.io, from, 0)) {
+			return false;
+		}
+		if (!analysis->iob.is_valid_offset(analysis->iob.io, to, 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool xref_type_is_valid(RzAnalysisXRefType type) {
+	switch (type) {
+	case RZ_ANALYSIS_XREF_TYPE_NULL:
+	case RZ_ANALYSIS_XREF_TYPE_CODE:
+	case RZ_ANALYSIS_XREF_TYPE_CALL:
+	case RZ_ANALYSIS_XREF_TYPE_DATA:
+	case RZ_ANALYSIS_XREF_TYPE_STRING:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Set a cross reference from FROM to TO.
+RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	if (!analysis || !xref_is_valid(analysis, from, to)) {
+		return false;
+	}
+	if (!xref_type_is_valid(type)) {
+		RZ_LOG_ERROR("analysis: invalid xref type 0x%x from 0x%" PFMT64x " to 0x%" PFMT64x "\n", (ut32)type, from, to);
+		return false;
+	}
+	return xref_store_set(analysis->xrefs, from, to, type);
+}
+
+/**
+ * \brief Set many cross references at once.
+ *
+ * Equivalent to calling rz_analysis_xrefs_set() on every element of \p xrefs
+ * in order, but new pairs are sorted once and added to the store as a whole
+ * run instead of going through the write buffer one by one. Like there,
+ * xrefs with an invalid type are rejected.
+ *
+ * \param analysis RzAnalysis instance
+ * \param xrefs RzVector <RzAnalysisXRef>
+ * \return number of accepted xrefs
+ */
+RZ_API size_t rz_analysis_xrefs_set_bulk(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const RzVector /*<RzAnalysisXRef>*/ *xrefs) {
+	rz_return_val_if_fail(analysis && xrefs, 0);
+	RzAnalysisXRefStore *st = analysis->xrefs;
+	size_t accepted = 0;
+	RzVector fresh;
+	rz_vector_init(&fresh, sizeof(XRefBulkItem), NULL, NULL);
+	RzAnalysisXRef *xref;
+	rz_vector_foreach(xrefs, xref) {
+		if (!xref_is_valid(analysis, xref->from, xref->to) || !xref_type_is_valid(xref->type)) {
+			continue;
+		}
+		RzAnalysisXRefType type = xref->type;
+		RzAnalysisXRefType old;
+		if (xref_store_update(st, xref->from, xref->to, type, &old)) {
+			if (old == XREF_TYPE_DELETED) {
+				st->count++;
+			}
+			accepted++;
+			continue;
+		}
+		XRefBulkItem item = { { xref->from, xref->to, type }, rz_vector_len(&fresh) };
+		if (!rz_vector_push(&fresh, &item)) {
+			continue;
+		}
+		accepted++;
+	}
+	size_t len = rz_vector_len(&fresh);
+	if (!len) {
+		rz_vector_fini(&fresh);
+		return accepted;
+	}
+	// The same pair may appear several times, the last one wins
+	XRefBulkItem *items = rz_vector_index_ptr(&fresh, 0);
+	qsort(items, len, sizeof(XRefBulkItem), bulk_item_cmp);
+	RzAnalysisXRef *by_from = RZ_NEWS(RzAnalysisXRef, len);
+	if (!by_from) {
+		rz_vector_fini(&fresh);
+		return accepted - len;
+	}
+	size_t n = 0;
+	for (size_t i = 0; i < len; i++) {
+		if (i + 1 < len && !ref_cmp(&items[i].xref, &items[i + 1].xref)) {
+			continue;
+		}
+		by_from[n++] = items[i].xref;
+	}
+	rz_vector_fini(&fresh);
+	XRefRun *run = run_new(by_from, n);
+	if (!run) {
+		return accepted - len;
+	}
+	st->count += n;
+	xref_store_push_run(st, run);
+	return accepted;
+}
+
+RZ_API bool rz_analysis_xrefs_deln(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	if (!analysis) {
+		return false;
+	}
+	xref_store_del(analysis->xrefs, from, to);
+	return true;
+}
+
+RZ_API bool rz_analysis_xref_del(RzAnalysis *analysis, ut64 from, ut64 to) {
+	return rz_analysis_xrefs_deln(analysis, from, to, RZ_ANALYSIS_XREF_TYPE_NULL);
+}
+
+RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis *analysis, ut64 addr) {
+	if (addr == UT64_MAX) {
+		return xrefs_get_range(analysis, true, 0, UT64_MAX);
+	}
+	return xrefs_get_range(analysis, true, addr, addr);
+}
+
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalysis *analysis, ut64 addr) {
-	RzList *list = rz_analysis_xref_list_new();
-	if (!list) {
+	if (addr == UT64_MAX) {
+		return xrefs_get_range(analysis, false, 0, UT64_MAX);
+	}
+	return xrefs_get_range(analysis, false, addr, addr);
+}
+
+/**
+ * \brief Get all xrefs whose target is in [\p from, \p to).
+ * \return RzList <RzAnalysisXRef *> sorted by source address, NULL if there are none
+ */
+RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to_range(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to) {
+	rz_return_val_if_fail(analysis, NULL);
+	if (from >= to) {
 		return NULL;
 	}
-	listxrefs(analysis->ht_xrefs_from, addr, list);
-	sortxrefs(list);
-	if (rz_list_empty(list)) {
-		rz_list_free(list);
-		list = NULL;
+	return xrefs_get_range(analysis, true, from, to - 1);
+}
+
+/**
+ * \brief Get all xrefs whose source is in [\p from, \p to).
+ * \return RzList <RzAnalysisXRef *> sorted by source address, NULL if there are none
+ */
+RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from_range(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to) {
+	rz_return_val_if_fail(analysis, NULL);
+	if (from >= to) {
+		return NULL;
 	}
-	return list;
+	return xrefs_get_range(analysis, false, from, to - 1);
 }
 
 /**
@@ -207,12 +612,44 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_list(RzAnalysis *
 	rz_return_val_if_fail(analysis, NULL);
 	RzList *list = rz_analysis_xref_list_new();
 	if (list) {
-		listxrefs(analysis->ht_xrefs_from, UT64_MAX, list);
+		listxrefs(analysis->xrefs, false, 0, UT64_MAX, list);
 		sortxrefs(list);
 	}
 	return list;
 }
 
+/**
+ * \brief Call \p cb on every xref, in (from, to) order.
+ *
+ * The store must not be modified from within \p cb.
+ * Iteration stops as soon as \p cb returns false.
+ */
+RZ_API bool rz_analysis_xrefs_foreach(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	RzAnalysisXRefStore *st = analysis->xrefs;
+	xref_store_compact(st);
+	void **it;
+	rz_pvector_foreach (&st->runs, it) {
+		const XRefRun *run = *it;
+		for (size_t i = 0; i < run->len; i++) {
+			if (run->by_from[i].type == XREF_TYPE_DELETED) {
+				continue;
+			}
+			if (!cb(&run->by_from[i], user)) {
+				return false;
+			}
+		}
+	}
+	// only reached if compaction failed to allocate
+	RzAnalysisXRef *xref;
+	rz_vector_foreach(&st->buffer, xref) {
+		if (!cb(xref, user)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 RZ_API const char *rz_analysis_xrefs_type_tostring(RzAnalysisXRefType type) {
 	switch (type) {
 	case RZ_ANALYSIS_XREF_TYPE_CODE:
@@ -243,39 +680,21 @@ RZ_API RzAnalysisXRefType rz_analysis_xrefs_type(char ch) {
 }
 
 RZ_API bool rz_analysis_xrefs_init(RzAnalysis *analysis) {
-	ht_up_free(analysis->ht_xrefs_from);
-	analysis->ht_xrefs_from = NULL;
-	ht_up_free(analysis->ht_xrefs_to);
-	analysis->ht_xrefs_to = NULL;
-
-	HtUP *tmp = ht_up_new(NULL, xrefs_ht_free, NULL);
-	if (!tmp) {
-		return false;
-	}
-	analysis->ht_xrefs_from = tmp;
-
-	tmp = ht_up_new(NULL, xrefs_ht_free, NULL);
-	if (!tmp) {
-		ht_up_free(analysis->ht_xrefs_from);
-		analysis->ht_xrefs_from = NULL;
-		return false;
-	}
-	analysis->ht_xrefs_to = tmp;
-	return true;
+	xref_store_free(analysis->xrefs);
+	analysis->xrefs = xref_store_new();
+	return analysis->xrefs != NULL;
 }
 
-static bool count_cb(void *user, const ut64 k, const void *v) {
-	(*(ut64 *)user) += ((HtUP *)v)->count;
-	return true;
+RZ_IPI void rz_analysis_xrefs_fini(RzAnalysis *analysis) {
+	xref_store_free(analysis->xrefs);
+	analysis->xrefs = NULL;
 }
 
 RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis) {
-	ut64 ret = 0;
-	ht_up_foreach(analysis->ht_xrefs_to, count_cb, &ret);
-	return ret;
+	return analysis->xrefs->count;
 }
 
-static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, HtUP *ht) {
+static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, bool by_to) {
 	RzListIter *iter;
 	RzAnalysisBlock *bb;
 	RzList *list = rz_analysis_xref_list_new();
@@ -287,7 +706,7 @@ static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fc
 
 		for (i = 0; i < bb->ninstr; i++) {
 			ut64 at = bb->addr + rz_analysis_block_get_op_offset(bb, i);
-			listxrefs(ht, at, list);
+			listxrefs(fcn->analysis->xrefs, by_to, at, at, list);
 		}
 	}
 	sortxrefs(list);
@@ -296,12 +715,12 @@ static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fc
 
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_from(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_from);
+	return fcn_get_refs(fcn, false);
 }
 
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_to(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_to);
+	return fcn_get_refs(fcn, true);
 }
 
 RZ_API const char *rz_analysis_ref_type_tostring(RzAnalysisXRefType t) {
@@ -449,15 +449,10 @@ RZ_API bool rz_asm_use(RzAsm *a, const char *name) {
 		if (h->arch && h->name && !strcmp(h->name, name)) {
 			if (!a->cur || (a->cur && strcmp(a->cur->arch, h->arch))) {
 				plugin_fini(a);
-				char *opcodes_dir = rz_path_system(RZ_SDB_OPCODES);
-				char *file = rz_str_newf("%s/%s.sdb", opcodes_dir, h->arch);
-				if (file) {
-					rz_asm_set_cpu(a, NULL);
-					sdb_free(a->pair);
-					a->pair = sdb_new(NULL, file, 0);
-					free(file);
-				}
-				free(opcodes_dir);
+				rz_asm_set_cpu(a, NULL);
+				// the opcode descriptions are opened by rz_asm_describe() when needed
+				sdb_free(a->pair);
+				a->pair = NULL;
 			}
 			if (h->init && !h->init(&a->plugin_data)) {
 				RZ_LOG_ERROR("asm plugin '%s' failed to initialize.\n", h->name);
@@ -1198,8 +1193,30 @@ RZ_API int rz_asm_get_offset(RzAsm *a, int type, int idx) { // link to rbin
 	return -1;
 }
 
+/**
+ * \brief Get the opcode descriptions of the current arch, opening them on first use
+ *
+ * \return Sdb mapping the mnemonics to their description, NULL if there is none
+ */
+RZ_API RZ_BORROW Sdb *rz_asm_get_descriptions(RzAsm *a) {
+	if (!a || !a->cur || !a->cur->arch) {
+		return NULL;
+	}
+	if (!a->pair) {
+		char *opcodes_dir = rz_path_system(RZ_SDB_OPCODES);
+		char *file = rz_str_newf("%s/%s.sdb", opcodes_dir, a->cur->arch);
+		if (file) {
+			a->pair = sdb_new(NULL, file, 0);
+			free(file);
+		}
+		free(opcodes_dir);
+	}
+	return a->pair;
+}
+
 RZ_API char *rz_asm_describe(RzAsm *a, const char *str) {
-	return (a && a->pair) ? sdb_get(a->pair, str, 0) : NULL;
+	Sdb *pair = rz_asm_get_descriptions(a);
+	return pair ? sdb_get(pair, str, 0) : NULL;
 }
 
 RZ_API RzList /*<RzAsmPlugin *>*/ *rz_asm_get_plugins(RzAsm *a) {
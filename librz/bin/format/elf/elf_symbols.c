@@ -5,10 +5,25 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include "elf.h"
-#include <ht_uu.h>
 
 #define HASH_NCHAIN_OFFSET(x) ((x) + 4)
 
+#if RZ_BIN_ELF64
+#define SYMBOL_ENTRY_SIZE 24
+#else
+#define SYMBOL_ENTRY_SIZE 16
+#endif
+
+// number of entries read from the buffer at once
+#define SYMBOLS_CHUNK 1024
+
+/* the entries of a symbols segment, from start to end (excluded) every entry_size bytes */
+struct processed_range {
+	ut64 start;
+	ut64 end;
+	ut64 entry_size;
+};
+
 struct symbols_segment {
 	ut64 offset;
 	ut64 number;
@@ -150,31 +165,58 @@ static const char *symbol_bind_to_str(Elf_(Sym) * sym) {
 	return RZ_BIN_BIND_UNKNOWN_STR;
 }
 
-static bool get_symbol_entry_aux(ELFOBJ *bin, ut64 offset, Elf_(Sym) * result) {
+static inline void decode_symbol_entry(const ut8 *buf, bool big_endian, Elf_(Sym) * result) {
 #if RZ_BIN_ELF64
-	return Elf_(rz_bin_elf_read_word)(bin, &offset, &result->st_name) &&
-		Elf_(rz_bin_elf_read_char)(bin, &offset, &result->st_info) &&
-		Elf_(rz_bin_elf_read_char)(bin, &offset, &result->st_other) &&
-		Elf_(rz_bin_elf_read_section)(bin, &offset, &result->st_shndx) &&
-		Elf_(rz_bin_elf_read_addr)(bin, &offset, &result->st_value) &&
-		Elf_(rz_bin_elf_read_xword)(bin, &offset, &result->st_size);
+	result->st_name = rz_read_ble32(buf, big_endian);
+	result->st_info = buf[4];
+	result->st_other = buf[5];
+	result->st_shndx = rz_read_ble16(buf + 6, big_endian);
+	result->st_value = rz_read_ble64(buf + 8, big_endian);
+	result->st_size = rz_read_ble64(buf + 16, big_endian);
 #else
-	return Elf_(rz_bin_elf_read_word)(bin, &offset, &result->st_name) &&
-		Elf_(rz_bin_elf_read_addr)(bin, &offset, &result->st_value) &&
-		Elf_(rz_bin_elf_read_word)(bin, &offset, &result->st_size) &&
-		Elf_(rz_bin_elf_read_char)(bin, &offset, &result->st_info) &&
-		Elf_(rz_bin_elf_read_char)(bin, &offset, &result->st_other) &&
-		Elf_(rz_bin_elf_read_section)(bin, &offset, &result->st_shndx);
+	result->st_name = rz_read_ble32(buf, big_endian);
+	result->st_value = rz_read_ble32(buf + 4, big_endian);
+	result->st_size = rz_read_ble32(buf + 8, big_endian);
+	result->st_info = buf[12];
+	result->st_other = buf[13];
+	result->st_shndx = rz_read_ble16(buf + 14, big_endian);
 #endif
 }
 
-static bool get_symbol_entry(ELFOBJ *bin, ut64 offset, Elf_(Sym) * result) {
-	if (!get_symbol_entry_aux(bin, offset, result)) {
-		RZ_LOG_WARN("Failed to read symbol entry at 0x%" PFMT64x ".\n", offset);
-		return false;
+/* one loop per byte order, so that the byte order is a constant inside of each */
+static void decode_symbol_entries_le(const ut8 *buf, size_t count, ut64 entry_size, Elf_(Sym) * result) {
+	for (size_t i = 0; i < count; i++) {
+		decode_symbol_entry(buf + i * entry_size, false, &result[i]);
 	}
+}
 
-	return true;
+static void decode_symbol_entries_be(const ut8 *buf, size_t count, ut64 entry_size, Elf_(Sym) * result) {
+	for (size_t i = 0; i < count; i++) {
+		decode_symbol_entry(buf + i * entry_size, true, &result[i]);
+	}
+}
+
+/**
+ * Reads and decodes up to \p count entries of \p entry_size bytes from \p offset.
+ * Returns the number of entries decoded, less than \p count if the buffer ends before.
+ */
+static size_t get_symbol_entries(ELFOBJ *bin, ut64 offset, size_t count, ut64 entry_size, ut8 *buf, Elf_(Sym) * result) {
+	ut64 size = (count - 1) * entry_size + SYMBOL_ENTRY_SIZE;
+	st64 read = rz_buf_read_at(bin->b, offset, buf, size);
+	if (read < SYMBOL_ENTRY_SIZE) {
+		return 0;
+	}
+	if ((ut64)read < size) {
+		count = (read - SYMBOL_ENTRY_SIZE) / entry_size + 1;
+	}
+
+	if (bin->big_endian) {
+		decode_symbol_entries_be(buf, count, entry_size, result);
+	} else {
+		decode_symbol_entries_le(buf, count, entry_size, result);
+	}
+
+	return count;
 }
 
 static bool is_section_local_symbol(ELFOBJ *bin, Elf_(Sym) * symbol) {
@@ -240,11 +282,18 @@ static bool convert_elf_symbol_entry(ELFOBJ *bin, struct symbols_segment *segmen
 	return true;
 }
 
-static bool has_already_been_processed(ELFOBJ *bin, ut64 offset, HtUU *set) {
-	bool found;
-	ht_uu_find(set, offset, &found);
+static bool has_already_been_processed(ELFOBJ *bin, ut64 offset, RzVector /*<struct processed_range>*/ *processed, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		const struct processed_range *range = rz_vector_index_ptr(processed, i);
+		if (offset < range->start || offset >= range->end) {
+			continue;
+		}
+		if (!range->entry_size || !((offset - range->start) % range->entry_size)) {
+			return true;
+		}
+	}
 
-	return found;
+	return false;
 }
 
 static void elf_symbol_fini(void *e, RZ_UNUSED void *user) {
@@ -252,47 +301,80 @@ static void elf_symbol_fini(void *e, RZ_UNUSED void *user) {
 	free(ptr->name);
 }
 
-static bool compute_symbols_from_segment(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, struct symbols_segment *segment, RzBinElfSymbolFilter filter, HtUU *set) {
-	ut64 offset = segment->offset + segment->entry_size;
+static bool compute_symbols_from_segment(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, struct symbols_segment *segment, RzBinElfSymbolFilter filter, RzVector /*<struct processed_range>*/ *processed) {
+	// with a null entry size, all the entries are the same one
+	ut64 number = segment->entry_size ? segment->number : RZ_MIN(segment->number, 2);
+	if (number < 2) {
+		return true;
+	}
 
-	for (size_t i = 1; i < segment->number; i++) {
-		if (has_already_been_processed(bin, offset, set)) {
-			offset += segment->entry_size;
-			continue;
-		}
+	ut64 start = segment->offset + segment->entry_size;
+	if (segment->entry_size && number - 1 > (UT64_MAX - start) / segment->entry_size) {
+		RZ_LOG_WARN("Invalid number of symbols 0x%" PFMT64x ".\n", number);
+		return false;
+	}
 
-		if (!ht_uu_insert(set, offset, offset)) {
-			return false;
-		}
+	// unusually big entries are read one at a time
+	size_t chunk = segment->entry_size > SYMBOL_ENTRY_SIZE * 4 ? 1 : RZ_MIN(number - 1, SYMBOLS_CHUNK);
+	ut8 *buf = malloc((chunk - 1) * segment->entry_size + SYMBOL_ENTRY_SIZE);
+	Elf_(Sym) *entries = RZ_NEWS(Elf_(Sym), chunk);
+	if (!buf || !entries) {
+		goto error;
+	}
 
-		Elf_(Sym) entry;
-		if (!get_symbol_entry(bin, offset, &entry)) {
-			return false;
-		}
+	// the entries of a segment are only checked against the ones of the previous segments
+	size_t n_processed = rz_vector_len(processed);
+	struct processed_range range = {
+		.start = start,
+		.end = segment->entry_size ? start + (number - 1) * segment->entry_size : start + 1,
+		.entry_size = segment->entry_size
+	};
+	if (!rz_vector_push(processed, &range)) {
+		goto error;
+	}
 
-		if (!filter(bin, &entry, segment->dynamic)) {
-			offset += segment->entry_size;
-			continue;
+	size_t i = 1;
+	while (i < number) {
+		ut64 offset = segment->offset + i * segment->entry_size;
+		size_t count = get_symbol_entries(bin, offset, RZ_MIN(number - i, chunk), segment->entry_size, buf, entries);
+		if (!count) {
+			RZ_LOG_WARN("Failed to read symbol entry at 0x%" PFMT64x ".\n", offset);
+			goto error;
 		}
 
-		RzBinElfSymbol symbol = { 0 };
+		for (size_t j = 0; j < count; j++, i++, offset += segment->entry_size) {
+			if (has_already_been_processed(bin, offset, processed, n_processed)) {
+				continue;
+			}
 
-		if (!convert_elf_symbol_entry(bin, segment, &symbol, &entry, i)) {
-			return false;
-		}
+			if (!filter(bin, &entries[j], segment->dynamic)) {
+				continue;
+			}
 
-		if (!rz_vector_push(result, &symbol)) {
-			elf_symbol_fini(&symbol, NULL);
-			return false;
-		}
+			RzBinElfSymbol symbol = { 0 };
+
+			if (!convert_elf_symbol_entry(bin, segment, &symbol, &entries[j], i)) {
+				goto error;
+			}
 
-		offset += segment->entry_size;
+			if (!rz_vector_push(result, &symbol)) {
+				elf_symbol_fini(&symbol, NULL);
+				goto error;
+			}
+		}
 	}
 
+	free(entries);
+	free(buf);
 	return true;
+
+error:
+	free(entries);
+	free(buf);
+	return false;
 }
 
-static bool get_dynamic_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, HtUU *set) {
+static bool get_dynamic_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, RzVector /*<struct processed_range>*/ *processed) {
 	if (!Elf_(rz_bin_elf_is_executable)(bin)) {
 		return true;
 	}
@@ -315,14 +397,14 @@ static bool get_dynamic_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *
 
 	struct symbols_segment segment = symbols_segment_init(offset, number, entry_size, true, bin->dynstr);
 
-	if (!compute_symbols_from_segment(bin, result, &segment, filter, set)) {
+	if (!compute_symbols_from_segment(bin, result, &segment, filter, processed)) {
 		return false;
 	}
 
 	return true;
 }
 
-static bool get_section_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, HtUU *set) {
+static bool get_section_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, RzVector /*<struct processed_range>*/ *processed) {
 	size_t i;
 	RzBinElfSection *section;
 	rz_bin_elf_enumerate_sections(bin, section, i) {
@@ -353,7 +435,7 @@ static bool get_section_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *
 
 		struct symbols_segment segment = symbols_segment_init(section->offset, number, sizeof(Elf_(Sym)), false, strtab);
 
-		if (!compute_symbols_from_segment(bin, result, &segment, filter, set)) {
+		if (!compute_symbols_from_segment(bin, result, &segment, filter, processed)) {
 			Elf_(rz_bin_elf_strtab_free)(strtab);
 			return false;
 		}
@@ -364,7 +446,7 @@ static bool get_section_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *
 	return true;
 }
 
-static bool get_gnu_debugdata_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, HtUU *set) {
+static bool get_gnu_debugdata_elf_symbols(ELFOBJ *bin, RzVector /*<RzBinElfSymbol>*/ *result, RzBinElfSymbolFilter filter, RzVector /*<struct processed_range>*/ *processed) {
 	// Get symbols from .gnu_debugdata according to https://sourceware.org/gdb/onlinedocs/gdb/MiniDebugInfo.html
 	bool res = false;
 	const RzBinElfSection *gnu_debugdata = Elf_(rz_bin_elf_get_section_with_name)(bin, ".gnu_debugdata");
@@ -489,28 +571,25 @@ RZ_OWN RzVector /*<RzBinElfSymbol>*/ *Elf_(rz_bin_elf_compute_symbols)(ELFOBJ *b
 		return NULL;
 	}
 
-	HtUU *set = ht_uu_new0();
-	if (!set) {
-		rz_vector_free(result);
-		return NULL;
-	}
+	RzVector processed;
+	rz_vector_init(&processed, sizeof(struct processed_range), NULL, NULL);
 
-	if (!get_dynamic_elf_symbols(bin, result, filter, set)) {
+	if (!get_dynamic_elf_symbols(bin, result, filter, &processed)) {
 		rz_vector_free(result);
-		ht_uu_free(set);
+		rz_vector_fini(&processed);
 		return NULL;
 	}
 
-	if (!get_section_elf_symbols(bin, result, filter, set)) {
+	if (!get_section_elf_symbols(bin, result, filter, &processed)) {
 		rz_vector_free(result);
-		ht_uu_free(set);
+		rz_vector_fini(&processed);
 		return NULL;
 	}
 
 	// Parsing .gnu_debugdata is completely optional, ignore errors if any and just continue
-	(void)get_gnu_debugdata_elf_symbols(bin, result, filter, set);
+	(void)get_gnu_debugdata_elf_symbols(bin, result, filter, &processed);
 
-	ht_uu_free(set);
+	rz_vector_fini(&processed);
 
 	if (!rz_vector_len(result)) {
 		rz_vector_free(result);
@@ -922,7 +922,6 @@ beach:
 static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffset, ut64 slideInfoSize, ut64 start_of_data, ut64 slide) {
 	ut8 *tmp_buf_1 = NULL;
 	ut8 *tmp_buf_2 = NULL;
-	ut8 *one_page_buf = NULL;
 	RzBuffer *cache_buf = cache->buf;
 
 	ut64 offset = slideInfoOffset;
@@ -959,13 +958,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc(slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RzDyldRebaseInfo3 *rebase_info = RZ_NEW0(RzDyldRebaseInfo3);
 		if (!rebase_info) {
 			goto beach;
@@ -979,7 +971,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 		rebase_info->page_starts_count = slide_info.page_starts_count;
 		rebase_info->auth_value_add = slide_info.auth_value_add;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide(cache, 0x7ffffffffffffULL, 0);
 			if (rebase_info->slide) {
@@ -1033,13 +1024,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc(slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RzDyldRebaseInfo2 *rebase_info = RZ_NEW0(RzDyldRebaseInfo2);
 		if (!rebase_info) {
 			goto beach;
@@ -1056,7 +1040,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 		rebase_info->value_mask = ~rebase_info->delta_mask;
 		rebase_info->delta_shift = dumb_ctzll(rebase_info->delta_mask) - 2;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide(cache, rebase_info->value_mask, rebase_info->value_add);
 			if (rebase_info->slide) {
@@ -1110,11 +1093,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		one_page_buf = malloc(4096);
-		if (!one_page_buf) {
-			goto beach;
-		}
-
 		RzDyldRebaseInfo1 *rebase_info = RZ_NEW0(RzDyldRebaseInfo1);
 		if (!rebase_info) {
 			goto beach;
@@ -1122,7 +1100,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 
 		rebase_info->version = 1;
 		rebase_info->start_of_data = start_of_data;
-		rebase_info->one_page_buf = one_page_buf;
 		rebase_info->page_size = 4096;
 		rebase_info->toc = (ut16 *)tmp_buf_1;
 		rebase_info->toc_count = slide_info.toc_count;
@@ -1146,7 +1123,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 beach:
 	free(tmp_buf_1);
 	free(tmp_buf_2);
-	free(one_page_buf);
 	return NULL;
 }
 
@@ -1393,8 +1369,6 @@ static void rebase_info_free(RzDyldRebaseInfo *rebase_info) {
 		return;
 	}
 
-	RZ_FREE(rebase_info->one_page_buf);
-
 	ut8 version = rebase_info->version;
 
 	if (version == 1) {
@@ -1498,6 +1472,7 @@ RZ_API void rz_dyldcache_free(RzDyldCache *cache) {
 	cache->bins = NULL;
 	rz_buf_free(cache->buf);
 	cache->buf = NULL;
+	rz_dyldcache_rebase_cache_free(cache->rebase_cache);
 	if (cache->rebase_infos) {
 		int i;
 		for (i = 0; i < cache->rebase_infos->length; i++) {
@@ -140,11 +140,26 @@ static inline bool rz_dyldcache_header_may_have_accel(RzDyldCacheHeader *hdr) {
 typedef struct rz_dyld_rebase_info_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 } RzDyldRebaseInfo;
 
+/**
+ * \brief Bounded LRU cache of the rebased pages read through the rebasing buffer
+ */
+typedef struct rz_dyld_rebase_cache_t {
+	HtUP /*<ut64, RzDyldRebasePage *>*/ *pages; ///< by file offset of the page
+	struct rz_dyld_rebase_page_t *head; ///< most recently used
+	struct rz_dyld_rebase_page_t *tail; ///< least recently used, evicted first
+	size_t count;
+	size_t max_pages;
+	ut64 hits;
+	ut64 misses;
+	ut64 evictions;
+} RzDyldRebaseCache;
+
+#define RZ_DYLDCACHE_REBASE_CACHE_PAGES 2048
+
 typedef struct rz_dyld_rebase_infos_entry_t {
 	ut64 start;
 	ut64 end;
@@ -159,7 +174,6 @@ typedef struct rz_dyld_rebase_infos_t {
 typedef struct rz_dyld_rebase_info_3_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -172,7 +186,6 @@ typedef struct rz_dyld_rebase_info_3_t {
 typedef struct rz_dyld_rebase_info_2_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -188,7 +201,6 @@ typedef struct rz_dyld_rebase_info_2_t {
 typedef struct rz_dyld_rebase_info_1_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *toc;
@@ -229,6 +241,7 @@ typedef struct rz_dyldcache_t {
 	RzList /*<RzDyldBinImage *>*/ *bins;
 	RzBuffer *buf;
 	RzDyldRebaseInfos *rebase_infos;
+	RzDyldRebaseCache *rebase_cache;
 	cache_accel_t *accel;
 	RzDyldLocSym *locsym;
 	objc_cache_opt_info *oi;
@@ -247,6 +260,7 @@ RZ_API void rz_dyldcache_symbols_from_locsym(RzDyldCache *cache, RzDyldBinImage
 
 RZ_API RzBuffer *rz_dyldcache_new_rebasing_buf(RzDyldCache *cache);
 RZ_API bool rz_dyldcache_needs_rebasing(RzDyldCache *cache);
+RZ_API void rz_dyldcache_rebase_cache_free(RZ_NULLABLE RzDyldRebaseCache *rc);
 RZ_API bool rz_dyldcache_range_needs_rebasing(RzDyldCache *cache, ut64 paddr, ut64 size);
 
 #endif
@@ -159,6 +159,21 @@ static RzDyldRebaseInfo *rebase_info_by_range(RzDyldRebaseInfos *infos, ut64 off
 	return NULL;
 }
 
+/* Returns the first entry ending after \p offset, NULL if there is none */
+static RzDyldRebaseInfosEntry *rebase_infos_entry_after(RzDyldRebaseInfos *infos, ut64 offset) {
+	size_t imin = 0;
+	size_t imax = infos->length;
+	while (imin < imax) {
+		size_t imid = imin + (imax - imin) / 2;
+		if (infos->entries[imid].end <= offset) {
+			imin = imid + 1;
+		} else {
+			imax = imid;
+		}
+	}
+	return imin < infos->length ? &infos->entries[imin] : NULL;
+}
+
 static void rebase_bytes(RzDyldRebaseInfo *rebase_info, ut8 *buf, ut64 offset, int count, ut64 start_of_write) {
 	if (!rebase_info || !buf) {
 		return;
@@ -173,6 +188,161 @@ static void rebase_bytes(RzDyldRebaseInfo *rebase_info, ut8 *buf, ut64 offset, i
 	}
 }
 
+/* rebase_bytes() may access one pointer past the end of the bytes it is given */
+#define REBASE_PAGE_SLACK 8
+
+typedef struct rz_dyld_rebase_page_t {
+	ut64 addr;
+	ut64 size;
+	ut8 *data;
+	struct rz_dyld_rebase_page_t *prev;
+	struct rz_dyld_rebase_page_t *next;
+} RzDyldRebasePage;
+
+static void rebase_page_free(RzDyldRebasePage *page) {
+	if (page) {
+		free(page->data);
+		free(page);
+	}
+}
+
+static void rebase_cache_unlink(RzDyldRebaseCache *rc, RzDyldRebasePage *page) {
+	if (page->prev) {
+		page->prev->next = page->next;
+	} else {
+		rc->head = page->next;
+	}
+	if (page->next) {
+		page->next->prev = page->prev;
+	} else {
+		rc->tail = page->prev;
+	}
+	page->prev = page->next = NULL;
+}
+
+static void rebase_cache_push_front(RzDyldRebaseCache *rc, RzDyldRebasePage *page) {
+	page->next = rc->head;
+	if (rc->head) {
+		rc->head->prev = page;
+	} else {
+		rc->tail = page;
+	}
+	rc->head = page;
+}
+
+static RzDyldRebaseCache *rebase_cache_new(size_t max_pages) {
+	RzDyldRebaseCache *rc = RZ_NEW0(RzDyldRebaseCache);
+	if (!rc) {
+		return NULL;
+	}
+	rc->pages = ht_up_new0();
+	if (!rc->pages) {
+		free(rc);
+		return NULL;
+	}
+	rc->max_pages = max_pages;
+	return rc;
+}
+
+static void rebase_cache_purge(RzDyldRebaseCache *rc) {
+	if (!rc) {
+		return;
+	}
+	RzDyldRebasePage *page = rc->head;
+	while (page) {
+		RzDyldRebasePage *next = page->next;
+		rebase_page_free(page);
+		page = next;
+	}
+	rc->head = rc->tail = NULL;
+	rc->count = 0;
+	ht_up_free(rc->pages);
+	rc->pages = ht_up_new0();
+}
+
+RZ_API void rz_dyldcache_rebase_cache_free(RZ_NULLABLE RzDyldRebaseCache *rc) {
+	if (!rc) {
+		return;
+	}
+	RZ_LOG_DEBUG("dyldcache: rebased pages cache: %" PFMT64u " hits, %" PFMT64u " misses, %" PFMT64u " evictions\n",
+		rc->hits, rc->misses, rc->evictions);
+	rebase_cache_purge(rc);
+	ht_up_free(rc->pages);
+	free(rc);
+}
+
+/**
+ * Returns the page at \p page_addr rebased with \p rebase_info,
+ * from the cache or rebased and cached now.
+ */
+static RzDyldRebasePage *rebase_cache_get(RzDyldCache *cache, RzDyldRebaseInfo *rebase_info, ut64 page_addr) {
+	RzDyldRebaseCache *rc = cache->rebase_cache;
+	if (!rc) {
+		rc = cache->rebase_cache = rebase_cache_new(RZ_DYLDCACHE_REBASE_CACHE_PAGES);
+		if (!rc) {
+			return NULL;
+		}
+	}
+	if (!rc->pages) {
+		return NULL;
+	}
+
+	RzDyldRebasePage *page = ht_up_find(rc->pages, page_addr, NULL);
+	if (page) {
+		rc->hits++;
+		if (page != rc->head) {
+			rebase_cache_unlink(rc, page);
+			rebase_cache_push_front(rc, page);
+		}
+		return page;
+	}
+	rc->misses++;
+
+	ut8 *data = NULL;
+	if (rc->count >= rc->max_pages && rc->tail) {
+		// recycle the least recently used page
+		page = rc->tail;
+		rebase_cache_unlink(rc, page);
+		ht_up_delete(rc->pages, page->addr);
+		rc->count--;
+		rc->evictions++;
+		data = page->size == rebase_info->page_size ? page->data : NULL;
+		if (!data) {
+			free(page->data);
+		}
+	} else {
+		page = RZ_NEW0(RzDyldRebasePage);
+		if (!page) {
+			return NULL;
+		}
+	}
+	if (!data) {
+		data = malloc(rebase_info->page_size + REBASE_PAGE_SLACK);
+		if (!data) {
+			free(page);
+			return NULL;
+		}
+	}
+	memset(data + rebase_info->page_size, 0, REBASE_PAGE_SLACK);
+	page->data = data;
+	page->addr = page_addr;
+
+	st64 size = rz_buf_read_at(cache->buf, page_addr, page->data, rebase_info->page_size);
+	if (size <= 0) {
+		rebase_page_free(page);
+		return NULL;
+	}
+	page->size = size;
+	rebase_bytes(rebase_info, page->data, page_addr, size, 0);
+	if (!ht_up_insert(rc->pages, page_addr, page)) {
+		rebase_page_free(page);
+		return NULL;
+	}
+	rebase_cache_push_front(rc, page);
+	rc->count++;
+	return page;
+}
+
 typedef struct {
 	RzDyldCache *cache;
 	ut64 off;
@@ -196,6 +366,7 @@ static bool buf_fini(RzBuffer *b) {
 
 static bool buf_resize(RzBuffer *b, ut64 newsize) {
 	BufCtx *ctx = b->priv;
+	rebase_cache_purge(ctx->cache->rebase_cache);
 	return rz_buf_resize(ctx->cache->buf, newsize);
 }
 
@@ -207,49 +378,43 @@ static st64 buf_read(RzBuffer *b, ut8 *buf, ut64 len) {
 	}
 
 	RzDyldCache *cache = ctx->cache;
-	RzDyldRebaseInfo *rebase_info = rebase_info_by_range(cache->rebase_infos, ctx->off, len);
-
-	if (!rebase_info) {
-		return rz_buf_read_at(cache->buf, ctx->off, buf, len);
-	} else if (rebase_info->page_size < 1) {
-		return -1;
+	if (!rebase_info_by_range(cache->rebase_infos, ctx->off, r)) {
+		return r;
 	}
 
-	st64 result = 0;
-	ut64 offset_in_data = ctx->off - rebase_info->start_of_data;
-	ut64 page_offset = offset_in_data % rebase_info->page_size;
-
-	ut64 internal_offset = ctx->off & ~(rebase_info->page_size - 1);
-	ut64 internal_end = ctx->off + len;
-	int rounded_count = internal_end - internal_offset;
-
-	ut8 *internal_buf = rebase_info->one_page_buf;
-	if (rounded_count > rebase_info->page_size) {
-		internal_buf = malloc(rounded_count);
-		if (!internal_buf) {
-			RZ_LOG_ERROR("dyldcache: Cannot allocate memory for 'internal_buf'\n");
+	// Replace the bytes of each page in a rebased range with the rebased page
+	ut64 end = ctx->off + r;
+	for (ut64 off = ctx->off; off < end;) {
+		RzDyldRebaseInfosEntry *entry = rebase_infos_entry_after(cache->rebase_infos, off);
+		if (!entry || entry->start >= end) {
+			break;
+		}
+		// the bytes before the next rebased range are already read
+		off = RZ_MAX(off, entry->start);
+		RzDyldRebaseInfo *rebase_info = entry->info;
+		if (!rebase_info) {
+			off = entry->end;
+			continue;
+		}
+		if (rebase_info->page_size < 1) {
 			return -1;
 		}
+		ut64 page_addr = off & ~((ut64)rebase_info->page_size - 1);
+		RzDyldRebasePage *page = rebase_cache_get(cache, rebase_info, page_addr);
+		if (!page || off - page_addr >= page->size) {
+			RZ_LOG_ERROR("dyldcache: Cannot rebase address\n");
+			break;
+		}
+		ut64 size = RZ_MIN(RZ_MIN(end, entry->end) - off, page->size - (off - page_addr));
+		memcpy(buf + (off - ctx->off), page->data + (off - page_addr), size);
+		off += size;
 	}
-
-	st64 internal_result = rz_buf_read_at(cache->buf, internal_offset, internal_buf, rounded_count);
-	if (internal_result >= page_offset + len) {
-		rebase_bytes(rebase_info, internal_buf, internal_offset, internal_result, page_offset);
-		result = RZ_MIN(len, internal_result);
-		memcpy(buf, internal_buf + page_offset, result);
-	} else {
-		RZ_LOG_ERROR("dyldcache: Cannot rebase address\n");
-		result = rz_buf_read_at(cache->buf, ctx->off, buf, len);
-	}
-
-	if (internal_buf != rebase_info->one_page_buf) {
-		RZ_FREE(internal_buf);
-	}
-	return result;
+	return r;
 }
 
 static st64 buf_write(RzBuffer *b, const ut8 *buf, ut64 len) {
 	BufCtx *ctx = b->priv;
+	rebase_cache_purge(ctx->cache->rebase_cache);
 	return rz_buf_write_at(ctx->cache->buf, ctx->off, buf, len);
 }
 
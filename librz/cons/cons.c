@@ -11,9 +11,10 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include "grep_private.h"
 
 #define COUNT_LINES 1
-#define CTX(x)      I.context->x
+#define CTX(x)      cons_context()->x
 
 RZ_LIB_VERSION(rz_cons);
 
@@ -21,6 +22,16 @@ static RzConsContext rz_cons_context_default = { { { { 0 } } } };
 static RzCons rz_cons_instance = { 0 };
 #define I rz_cons_instance
 
+/**
+ * Context used by the calling thread instead of I.context, so that
+ * concurrent tasks do not share their output buffers.
+ */
+static RZ_THREAD_LOCAL RzConsContext *thread_context = NULL;
+
+static inline RzConsContext *cons_context(void) {
+	return thread_context ? thread_context : I.context;
+}
+
 // this structure goes into cons_stack when rz_cons_push/pop
 typedef struct {
 	char *buf;
@@ -28,6 +39,8 @@ typedef struct {
 	int buf_size;
 	RzConsGrep *grep;
 	bool noflush;
+	bool streamed;
+	bool stream_show;
 } RzConsStack;
 
 typedef struct {
@@ -69,6 +82,9 @@ static RzConsStack *cons_stack_dump(bool recreate) {
 			data->buf_size = CTX(buffer_sz);
 		}
 		data->noflush = CTX(noflush);
+		data->streamed = CTX(streamed);
+		data->stream_show = CTX(stream_show);
+		CTX(streamed) = false;
 		data->grep = RZ_NEW0(RzConsGrep);
 		if (data->grep) {
 			memcpy(data->grep, &CTX(grep), sizeof(RzConsGrep));
@@ -105,6 +121,8 @@ static void cons_stack_load(RzConsStack *data, bool free_current) {
 		memcpy(&CTX(grep), data->grep, sizeof(RzConsGrep));
 	}
 	CTX(noflush) = data->noflush;
+	CTX(streamed) = data->streamed;
+	CTX(stream_show) = data->stream_show;
 	ctx_rowcol_calc_reset();
 }
 
@@ -355,11 +373,11 @@ RZ_API void rz_cons_context_break_pop(RzConsContext *context, bool sig) {
 }
 
 RZ_API void rz_cons_break_push(RzConsBreak cb, void *user) {
-	rz_cons_context_break_push(I.context, cb, user, true);
+	rz_cons_context_break_push(cons_context(), cb, user, true);
 }
 
 RZ_API void rz_cons_break_pop(void) {
-	rz_cons_context_break_pop(I.context, true);
+	rz_cons_context_break_pop(cons_context(), true);
 }
 
 RZ_API bool rz_cons_is_interactive(void) {
@@ -723,6 +741,105 @@ static bool palloc(int moar) {
 	return true;
 }
 
+static bool cons_grep_enabled(void) {
+	return I.filter || CTX(grep).nstrings > 0 || CTX(grep).tokens_used || CTX(grep).less || CTX(grep).json;
+}
+
+static void cons_tee(const char *buf, size_t len) {
+	const char *tee = I.teefile;
+	if (RZ_STR_ISEMPTY(tee)) {
+		return;
+	}
+	FILE *d = rz_sys_fopen(tee, "a+");
+	if (d) {
+		if (len != fwrite(buf, 1, len, d)) {
+			eprintf("rz_cons_flush: fwrite: error (%s)\n", tee);
+		}
+		fclose(d);
+	} else {
+		eprintf("Cannot write on '%s'\n", tee);
+	}
+}
+
+/*
+ * With scr.stream, the complete lines of the buffer are grepped and written
+ * out as soon as it grows beyond I.stream_size bytes, so that the memory
+ * used by a command does not depend on the size of its output. Outputs that
+ * are captured with rz_cons_push(), paged, or filtered as a whole (sorted,
+ * counted, indented, ...) are still buffered until rz_cons_flush().
+ */
+static bool cons_can_stream(void) {
+	if (CTX(noflush) || I.null || I.is_html || I.filter || I.flush || RZ_STR_ISNOTEMPTY(I.highlight) ||
+		!rz_cons_context_is_main() || (CTX(cons_stack) && !rz_stack_is_empty(CTX(cons_stack)))) {
+		return false;
+	}
+	if (rz_cons_is_interactive() && I.fdout == 1 && (I.linesleep > 0 || (CTX(pageable) && RZ_STR_ISNOTEMPTY(I.pager)))) {
+		return false;
+	}
+	return !cons_grep_enabled() || rz_cons_grep_is_streamable(&CTX(grep));
+}
+
+static void cons_stream_write(size_t len) {
+	char *buf = CTX(buffer);
+	if (!CTX(streamed)) {
+		CTX(streamed) = true;
+		CTX(stream_show) = false;
+		I.lines = 0;
+	}
+	if (cons_grep_enabled()) {
+		RzStrBuf ob;
+		rz_strbuf_init(&ob);
+		if (rz_cons_grep_chunk(buf, len, &ob, &CTX(stream_show))) {
+			cons_tee(rz_strbuf_get(&ob), rz_strbuf_length(&ob));
+			__cons_write(rz_strbuf_get(&ob), rz_strbuf_length(&ob));
+		}
+		rz_strbuf_fini(&ob);
+	} else {
+		cons_tee(buf, len);
+		__cons_write(buf, len);
+	}
+	memmove(buf, buf + len, CTX(buffer_len) - len);
+	CTX(buffer_len) -= len;
+	buf[CTX(buffer_len)] = 0;
+	I.lastline = buf;
+	ctx_rowcol_calc_reset();
+}
+
+/**
+ * Writes out the complete lines of the buffer if it is too big,
+ * \p appended being the offset of the bytes just added to it.
+ */
+static void cons_stream(size_t appended) {
+	if (I.stream_size <= 0 || CTX(buffer_len) < (size_t)I.stream_size || !cons_can_stream()) {
+		return;
+	}
+	// only the new bytes are searched, to keep long lines linear
+	size_t len = CTX(buffer_len);
+	while (len > appended && CTX(buffer)[len - 1] != '\n') {
+		len--;
+	}
+	if (len > appended) {
+		cons_stream_write(len);
+	}
+}
+
+/* greps the rest of a streamed output, continuing its line count */
+static void cons_stream_grep_rest(void) {
+	RzStrBuf *ob = rz_strbuf_new("");
+	if (!ob) {
+		return;
+	}
+	if (!CTX(buffer) || !rz_cons_grep_chunk(CTX(buffer), CTX(buffer_len), ob, &CTX(stream_show))) {
+		rz_strbuf_free(ob);
+		return;
+	}
+	free(CTX(buffer));
+	CTX(buffer_len) = rz_strbuf_length(ob);
+	CTX(buffer_sz) = CTX(buffer_len) + 1;
+	CTX(buffer) = rz_strbuf_drain(ob);
+	ctx_rowcol_calc_reset();
+}
+
 RZ_API int rz_cons_eof(void) {
 	return feof(I.fdin);
 }
@@ -812,6 +929,7 @@ RZ_API void rz_cons_reset(void) {
 		(CTX(buffer))[0] = '\0';
 	}
 	CTX(buffer_len) = 0;
+	CTX(streamed) = false;
 	I.lines = 0;
 	I.lastline = CTX(buffer);
 	cons_grep_reset(&CTX(grep));
@@ -841,8 +959,12 @@ RZ_API int rz_cons_get_buffer_len(void) {
 
 RZ_API void rz_cons_filter(void) {
 	/* grep */
-	if (I.filter || CTX(grep).nstrings > 0 || CTX(grep).tokens_used || CTX(grep).less || CTX(grep).json) {
-		(void)rz_cons_grepbuf();
+	if (cons_grep_enabled()) {
+		if (CTX(streamed)) {
+			cons_stream_grep_rest();
+		} else {
+			(void)rz_cons_grepbuf();
+		}
 		I.filter = false;
 	}
 	/* html */
@@ -912,12 +1034,27 @@ RZ_API void rz_cons_context_load(RzConsContext *context) {
 	I.context = context;
 }
 
+/**
+ * \brief Loads \p context only for the calling thread, which then ignores
+ * rz_cons_context_load until it is called again with NULL.
+ */
+RZ_API void rz_cons_context_load_thread(RZ_NULLABLE RzConsContext *context) {
+	thread_context = context;
+}
+
+/**
+ * \brief Returns the context used by the calling thread.
+ */
+RZ_API RZ_BORROW RzConsContext *rz_cons_context(void) {
+	return cons_context();
+}
+
 RZ_API void rz_cons_context_reset(void) {
 	I.context = &rz_cons_context_default;
 }
 
 RZ_API bool rz_cons_context_is_main(void) {
-	return I.context == &rz_cons_context_default;
+	return cons_context() == &rz_cons_context_default;
 }
 
 RZ_API void rz_cons_context_break(RzConsContext *context) {
@@ -939,7 +1076,7 @@ RZ_API void rz_cons_last(void) {
 }
 
 static bool lastMatters(void) {
-	return (CTX(buffer_len) > 0) && (CTX(lastEnabled) && !I.filter && CTX(grep).nstrings < 1 && !CTX(grep).tokens_used && !CTX(grep).less && !CTX(grep).json && !I.is_html);
+	return (CTX(buffer_len) > 0) && (CTX(lastEnabled) && !CTX(streamed) && !cons_grep_enabled() && !I.is_html);
 }
 
 RZ_API void rz_cons_echo(const char *msg) {
@@ -963,7 +1100,6 @@ RZ_API void rz_cons_echo(const char *msg) {
 }
 
 RZ_API void rz_cons_flush(void) {
-	const char *tee = I.teefile;
 	if (CTX(noflush)) {
 		return;
 	}
@@ -980,10 +1116,14 @@ RZ_API void rz_cons_flush(void) {
 		CTX(lastLength) = CTX(buffer_len);
 		memcpy(CTX(lastOutput), CTX(buffer), CTX(buffer_len));
 	} else {
+		if (CTX(streamed)) {
+			// only the tail is left, there is nothing meaningful to show again
+			CTX(lastLength) = 0;
+		}
 		CTX(lastMode) = false;
 	}
 	rz_cons_filter();
-	if (rz_cons_is_interactive() && I.fdout == 1) {
+	if (rz_cons_is_interactive() && I.fdout == 1 && !CTX(streamed)) {
 		/* Use a pager if the output doesn't fit on the terminal window. */
 		if (CTX(pageable) && CTX(buffer) && I.pager && *I.pager && CTX(buffer_len) > 0 && rz_str_char_count(CTX(buffer), '\n') >= I.rows) {
 			(CTX(buffer))[CTX(buffer_len) - 1] = 0;
@@ -1022,17 +1162,7 @@ RZ_API void rz_cons_flush(void) {
 			rz_cons_set_raw(true);
 		}
 	}
-	if (tee && *tee) {
-		FILE *d = rz_sys_fopen(tee, "a+");
-		if (d) {
-			if (CTX(buffer_len) != fwrite(CTX(buffer), 1, CTX(buffer_len), d)) {
-				eprintf("rz_cons_flush: fwrite: error (%s)\n", tee);
-			}
-			fclose(d);
-		} else {
-			eprintf("Cannot write on '%s'\n", tee);
-		}
-	}
+	cons_tee(CTX(buffer), CTX(buffer_len));
 	rz_cons_highlight(I.highlight);
 
 	// is_html must be a filter, not a write endpoint
@@ -1199,6 +1329,7 @@ RZ_API void rz_cons_printf_list(const char *format, va_list ap) {
 				}
 			}
 			CTX(buffer_len) += written;
+			cons_stream(CTX(buffer_len) - written);
 		}
 	} else {
 		rz_cons_strcat(format);
@@ -1245,6 +1376,7 @@ RZ_API int rz_cons_memcat(const char *str, int len) {
 			memcpy(CTX(buffer) + CTX(buffer_len), str, len);
 			CTX(buffer_len) += len;
 			(CTX(buffer))[CTX(buffer_len)] = 0;
+			cons_stream(CTX(buffer_len) - len);
 		}
 	}
 	if (I.flush) {
@@ -1264,6 +1396,7 @@ RZ_API void rz_cons_memset(char ch, int len) {
 			memset(CTX(buffer) + CTX(buffer_len), ch, len);
 			CTX(buffer_len) += len;
 			(CTX(buffer))[CTX(buffer_len)] = 0;
+			cons_stream(CTX(buffer_len) - len);
 		}
 	}
 }
@@ -5,6 +5,7 @@
 #include <rz_cons.h>
 #include <rz_util/rz_print.h>
 #include <sdb.h>
+#include "grep_private.h"
 
 #define I(x) rz_cons_singleton()->x
 
@@ -83,11 +84,11 @@ static void parse_grep_expression(const char *str) {
 		return;
 	}
 	RzCons *cons = rz_cons_singleton();
-	RzConsGrep *grep = &cons->context->grep;
+	RzConsGrep *grep = &rz_cons_context()->grep;
 	sorted_column = 0;
 	bool first = true;
 
-	// setup cons->context->grep.icase according to cons->grep_icase
+	// setup grep->icase according to cons->grep_icase
 	if (cons->grep_icase == RZ_CONS_SEARCH_CASE_SMART) {
 		// smartcase - when the search term is all lowercase, ignore the case,
 		// instead if the search term is uppercase or a mix, do a case-sensitive search.
@@ -101,9 +102,9 @@ static void parse_grep_expression(const char *str) {
 			grep_str++;
 		}
 
-		cons->context->grep.icase = has_upper ? RZ_CONS_SEARCH_CASE_SENSITIVE : RZ_CONS_SEARCH_CASE_INSENSITIVE;
+		grep->icase = has_upper ? RZ_CONS_SEARCH_CASE_SENSITIVE : RZ_CONS_SEARCH_CASE_INSENSITIVE;
 	} else {
-		cons->context->grep.icase = cons->grep_icase;
+		grep->icase = cons->grep_icase;
 	}
 
 	while (*str) {
@@ -480,20 +481,137 @@ static int cmp(const void *a, const void *b) {
 	return strcmp(a, b);
 }
 
+/**
+ * Appends to \p ob the lines of \p buf that pass the grep, continuing the
+ * line count of cons->lines. Only the lines terminated by a newline are used.
+ * \param show State of the line range selection, kept between the calls
+ * \return false if the grep failed, in which case the output must be dropped
+ */
+static bool grep_lines(RzCons *cons, const char *buf, int len, RzStrBuf *ob, bool *show) {
+	RzConsGrep *grep = &rz_cons_context()->grep;
+	const char *in = buf;
+	int ret, l = 0, tl = 0;
+	bool is_range_line_grep_only = grep->range_line != 2 && !*grep->str;
+	while ((int)(size_t)(in - buf) < len) {
+		const char *p = strchr(in, '\n');
+		if (!p) {
+			break;
+		}
+		l = p - in;
+		if ((!l && is_range_line_grep_only) || l > 0) {
+			char *tline = rz_str_ndup(in, l);
+			if (cons->grep_color) {
+				tl = l;
+			} else {
+				tl = rz_str_ansi_filter(tline, NULL, NULL, l);
+			}
+			if (tl < 0) {
+				ret = -1;
+			} else {
+				ret = rz_cons_grep_line(tline, tl);
+				if (!grep->range_line) {
+					if (grep->line == cons->lines) {
+						*show = true;
+					}
+				} else if (grep->range_line == 1) {
+					if (grep->f_line == cons->lines) {
+						*show = true;
+					}
+					if (grep->l_line == cons->lines) {
+						*show = false;
+					}
+				} else {
+					*show = true;
+				}
+			}
+			if ((!ret && is_range_line_grep_only) || ret > 0) {
+				if (*show) {
+					char *str = rz_str_ndup(tline, ret);
+					if (cons->grep_highlight) {
+						int i;
+						for (i = 0; i < grep->nstrings; i++) {
+							char *newstr = rz_str_newf(Color_INVERT "%s" Color_RESET, grep->strings[i]);
+							if (str && newstr) {
+								if (grep->icase) {
+									str = rz_str_replace_icase(str, grep->strings[i], newstr, 1, 1);
+								} else {
+									str = rz_str_replace(str, grep->strings[i], newstr, 1);
+								}
+							}
+							free(newstr);
+						}
+					}
+					if (str) {
+						rz_strbuf_append(ob, str);
+						rz_strbuf_append(ob, "\n");
+					}
+					free(str);
+				}
+				if (!grep->range_line) {
+					*show = false;
+				}
+				cons->lines++;
+			} else if (ret < 0) {
+				free(tline);
+				return false;
+			}
+			free(tline);
+			in += l + 1;
+		} else {
+			in++;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \return true if the grep can be applied to the output as it is produced,
+ * line by line, which is not the case when it sorts, counts or reformats the
+ * whole output or selects lines relative to its end
+ */
+RZ_IPI bool rz_cons_grep_is_streamable(const RzConsGrep *grep) {
+	if (grep->sort != -1 || grep->counter || grep->json || grep->less || grep->hud || grep->zoom) {
+		return false;
+	}
+	switch (grep->range_line) {
+	case 0:
+		return grep->line >= 0;
+	case 1:
+		return grep->f_line >= 0 && grep->l_line >= 0;
+	default:
+		return true;
+	}
+}
+
+/**
+ * Greps the lines of a chunk of the output into \p ob. The line numbers
+ * and the range selection carry over from the previous chunks.
+ */
+RZ_IPI bool rz_cons_grep_chunk(const char *buf, int len, RzStrBuf *ob, bool *show) {
+	RzCons *cons = rz_cons_singleton();
+	RzConsGrep *grep = &rz_cons_context()->grep;
+	if (grep->range_line == 1 && !grep->l_line) {
+		// up to the last line, which is not known yet
+		grep->l_line = INT_MAX;
+	}
+	return grep_lines(cons, buf, len, ob, show);
+}
+
 RZ_API void rz_cons_grepbuf(void) {
 	RzCons *cons = rz_cons_singleton();
-	cons->context->row = 0;
-	cons->context->col = 0;
-	cons->context->rowcol_calc_start = 0;
-	const char *buf = cons->context->buffer;
-	const int len = cons->context->buffer_len;
-	RzConsGrep *grep = &cons->context->grep;
+	rz_cons_context()->row = 0;
+	rz_cons_context()->col = 0;
+	rz_cons_context()->rowcol_calc_start = 0;
+	const char *buf = rz_cons_context()->buffer;
+	const int len = rz_cons_context()->buffer_len;
+	RzConsGrep *grep = &rz_cons_context()->grep;
 	const char *in = buf;
-	int ret, total_lines = 0, l = 0, tl = 0;
+	int total_lines = 0, l = 0;
 	bool show = false;
 	if (cons->filter) {
-		cons->context->buffer_len = 0;
-		RZ_FREE(cons->context->buffer);
+		rz_cons_context()->buffer_len = 0;
+		RZ_FREE(rz_cons_context()->buffer);
 		return;
 	}
 
@@ -505,14 +623,14 @@ RZ_API void rz_cons_grepbuf(void) {
 	}
 
 	if (grep->zoom) {
-		char *in = calloc(cons->context->buffer_len + 2, 4);
-		strcpy(in, cons->context->buffer);
+		char *in = calloc(rz_cons_context()->buffer_len + 2, 4);
+		strcpy(in, rz_cons_context()->buffer);
 		char *out = rz_str_scale(in, grep->zoom * 2, grep->zoomy ? grep->zoomy : grep->zoom);
 		if (out) {
-			free(cons->context->buffer);
-			cons->context->buffer = out;
-			cons->context->buffer_len = strlen(out);
-			cons->context->buffer_sz = cons->context->buffer_len;
+			free(rz_cons_context()->buffer);
+			rz_cons_context()->buffer = out;
+			rz_cons_context()->buffer_len = strlen(out);
+			rz_cons_context()->buffer_sz = rz_cons_context()->buffer_len;
 		}
 		grep->zoom = 0;
 		grep->zoomy = 0;
@@ -521,7 +639,7 @@ RZ_API void rz_cons_grepbuf(void) {
 	}
 	if (grep->json) {
 		if (grep->json_path) {
-			RzJson *json = rz_json_parse(cons->context->buffer);
+			RzJson *json = rz_json_parse(rz_cons_context()->buffer);
 			if (!json) {
 				RZ_FREE(grep->json_path);
 				return;
@@ -544,10 +662,10 @@ RZ_API void rz_cons_grepbuf(void) {
 					rz_json_free(json);
 					return;
 				}
-				free(cons->context->buffer);
-				cons->context->buffer = u;
-				cons->context->buffer_len = strlen(u);
-				cons->context->buffer_sz = cons->context->buffer_len + 1;
+				free(rz_cons_context()->buffer);
+				rz_cons_context()->buffer = u;
+				rz_cons_context()->buffer_len = strlen(u);
+				rz_cons_context()->buffer_sz = rz_cons_context()->buffer_len + 1;
 				grep->json = 0;
 				rz_cons_newline();
 			}
@@ -555,33 +673,33 @@ RZ_API void rz_cons_grepbuf(void) {
 			RZ_FREE(grep->json_path);
 		} else {
 			const char *palette[] = {
-				cons->context->pal.graph_false, // f
-				cons->context->pal.graph_true, // t
-				cons->context->pal.num, // k
-				cons->context->pal.comment, // v
+				rz_cons_context()->pal.graph_false, // f
+				rz_cons_context()->pal.graph_true, // t
+				rz_cons_context()->pal.num, // k
+				rz_cons_context()->pal.comment, // v
 				Color_RESET,
 				NULL
 			};
 			char *bb = strdup(buf);
 			rz_str_ansi_filter(bb, NULL, NULL, -1);
-			char *out = (cons->context->grep.human)
+			char *out = (rz_cons_context()->grep.human)
 				? rz_print_json_human(bb)
 				: rz_print_json_indent(bb, I(context->color_mode), "  ", palette);
 			free(bb);
 			if (!out) {
 				return;
 			}
-			free(cons->context->buffer);
-			cons->context->buffer = out;
-			cons->context->buffer_len = strlen(out);
-			cons->context->buffer_sz = cons->context->buffer_len + 1;
+			free(rz_cons_context()->buffer);
+			rz_cons_context()->buffer = out;
+			rz_cons_context()->buffer_len = strlen(out);
+			rz_cons_context()->buffer_sz = rz_cons_context()->buffer_len + 1;
 			grep->json = 0;
 			if (grep->hud) {
 				grep->hud = false;
-				rz_cons_hud_string(cons->context->buffer);
+				rz_cons_hud_string(rz_cons_context()->buffer);
 			} else if (grep->less) {
 				grep->less = 0;
-				rz_cons_less_str(cons->context->buffer, NULL);
+				rz_cons_less_str(rz_cons_context()->buffer, NULL);
 			}
 		}
 		return;
@@ -598,18 +716,18 @@ RZ_API void rz_cons_grepbuf(void) {
 			}
 		} else {
 			rz_cons_less_str(buf, NULL);
-			cons->context->buffer_len = 0;
-			if (cons->context->buffer) {
-				cons->context->buffer[0] = 0;
+			rz_cons_context()->buffer_len = 0;
+			if (rz_cons_context()->buffer) {
+				rz_cons_context()->buffer[0] = 0;
 			}
-			RZ_FREE(cons->context->buffer);
+			RZ_FREE(rz_cons_context()->buffer);
 		}
 		return;
 	}
-	if (!cons->context->buffer) {
-		cons->context->buffer_len = len + 20;
-		cons->context->buffer = malloc(cons->context->buffer_len);
-		cons->context->buffer[0] = 0;
+	if (!rz_cons_context()->buffer) {
+		rz_cons_context()->buffer_len = len + 20;
+		rz_cons_context()->buffer = malloc(rz_cons_context()->buffer_len);
+		rz_cons_context()->buffer[0] = 0;
 	}
 	RzStrBuf *ob = rz_strbuf_new("");
 	// if we modify cons->lines we should update I.context->buffer too
@@ -639,101 +757,34 @@ RZ_API void rz_cons_grepbuf(void) {
 			grep->l_line = total_lines + grep->l_line;
 		}
 	}
-	bool is_range_line_grep_only = grep->range_line != 2 && !*grep->str;
-	in = buf;
-	while ((int)(size_t)(in - buf) < len) {
-		char *p = strchr(in, '\n');
-		if (!p) {
-			break;
-		}
-		l = p - in;
-		if ((!l && is_range_line_grep_only) || l > 0) {
-			char *tline = rz_str_ndup(in, l);
-			if (cons->grep_color) {
-				tl = l;
-			} else {
-				tl = rz_str_ansi_filter(tline, NULL, NULL, l);
-			}
-			if (tl < 0) {
-				ret = -1;
-			} else {
-				ret = rz_cons_grep_line(tline, tl);
-				if (!grep->range_line) {
-					if (grep->line == cons->lines) {
-						show = true;
-					}
-				} else if (grep->range_line == 1) {
-					if (grep->f_line == cons->lines) {
-						show = true;
-					}
-					if (grep->l_line == cons->lines) {
-						show = false;
-					}
-				} else {
-					show = true;
-				}
-			}
-			if ((!ret && is_range_line_grep_only) || ret > 0) {
-				if (show) {
-					char *str = rz_str_ndup(tline, ret);
-					if (cons->grep_highlight) {
-						int i;
-						for (i = 0; i < grep->nstrings; i++) {
-							char *newstr = rz_str_newf(Color_INVERT "%s" Color_RESET, grep->strings[i]);
-							if (str && newstr) {
-								if (grep->icase) {
-									str = rz_str_replace_icase(str, grep->strings[i], newstr, 1, 1);
-								} else {
-									str = rz_str_replace(str, grep->strings[i], newstr, 1);
-								}
-							}
-							free(newstr);
-						}
-					}
-					if (str) {
-						rz_strbuf_append(ob, str);
-						rz_strbuf_append(ob, "\n");
-					}
-					free(str);
-				}
-				if (!grep->range_line) {
-					show = false;
-				}
-				cons->lines++;
-			} else if (ret < 0) {
-				free(tline);
-				return;
-			}
-			free(tline);
-			in += l + 1;
-		} else {
-			in++;
-		}
+	if (!grep_lines(cons, buf, len, ob, &show)) {
+		rz_strbuf_free(ob);
+		return;
 	}
 
-	cons->context->buffer_len = rz_strbuf_length(ob);
+	rz_cons_context()->buffer_len = rz_strbuf_length(ob);
 	if (grep->counter) {
-		int cnt = grep->charCounter ? strlen(cons->context->buffer) : cons->lines;
-		if (cons->context->buffer_len < 10) {
-			cons->context->buffer_len = 10; // HACK
+		int cnt = grep->charCounter ? strlen(rz_cons_context()->buffer) : cons->lines;
+		if (rz_cons_context()->buffer_len < 10) {
+			rz_cons_context()->buffer_len = 10; // HACK
 		}
-		snprintf(cons->context->buffer, cons->context->buffer_len, "%d\n", cnt);
-		cons->context->buffer_len = strlen(cons->context->buffer);
+		snprintf(rz_cons_context()->buffer, rz_cons_context()->buffer_len, "%d\n", cnt);
+		rz_cons_context()->buffer_len = strlen(rz_cons_context()->buffer);
 		cons->num->value = cons->lines;
 		rz_strbuf_free(ob);
 		return;
 	}
 
 	const int ob_len = rz_strbuf_length(ob);
-	if (ob_len >= cons->context->buffer_sz) {
-		cons->context->buffer_sz = ob_len + 1;
-		cons->context->buffer = rz_strbuf_drain(ob);
+	if (ob_len >= rz_cons_context()->buffer_sz) {
+		rz_cons_context()->buffer_sz = ob_len + 1;
+		rz_cons_context()->buffer = rz_strbuf_drain(ob);
 	} else {
-		memcpy(cons->context->buffer, rz_strbuf_getbin(ob, NULL), ob_len);
-		cons->context->buffer[ob_len] = 0;
+		memcpy(rz_cons_context()->buffer, rz_strbuf_getbin(ob, NULL), ob_len);
+		rz_cons_context()->buffer[ob_len] = 0;
 		rz_strbuf_free(ob);
 	}
-	cons->context->buffer_len = ob_len;
+	rz_cons_context()->buffer_len = ob_len;
 
 	if (grep->sort != -1) {
 #define INSERT_LINES(list) \
@@ -749,7 +800,7 @@ RZ_API void rz_cons_grepbuf(void) {
 
 		RzListIter *iter;
 		int nl = 0;
-		char *ptr = cons->context->buffer;
+		char *ptr = rz_cons_context()->buffer;
 		char *str;
 		sorted_column = grep->sort;
 		rz_list_sort(sorted_lines, cmp);
@@ -768,7 +819,7 @@ RZ_API void rz_cons_grepbuf(void) {
 
 RZ_API int rz_cons_grep_line(char *buf, int len) {
 	RzCons *cons = rz_cons_singleton();
-	RzConsGrep *grep = &cons->context->grep;
+	RzConsGrep *grep = &rz_cons_context()->grep;
 	const char *delims = " |,;=\t";
 	char *tok = NULL;
 	bool hit = grep->neg;
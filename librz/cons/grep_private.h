@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef GREP_PRIVATE_H
+#define GREP_PRIVATE_H
+
+RZ_IPI bool rz_cons_grep_is_streamable(const RzConsGrep *grep);
+RZ_IPI bool rz_cons_grep_chunk(const char *buf, int len, RzStrBuf *ob, bool *show);
+
+#endif
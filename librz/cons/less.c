@@ -169,5 +169,5 @@ RZ_API int rz_cons_less_str(const char *str, const char *exitkeys) {
 }
 
 RZ_API void rz_cons_less(void) {
-	(void)rz_cons_less_str(rz_cons_singleton()->context->buffer, NULL);
+	(void)rz_cons_less_str(rz_cons_context()->buffer, NULL);
 }
@@ -1142,9 +1142,8 @@ static HtPU *compute_pos(const RzAGraph *g, int is_left, HtPP *v_nodes) {
 	}
 
 	HtPUOptions pu_opt = { 0 };
-	HtPPOptions pp_opt = { 0 };
 	HtPU *res = ht_pu_new_opt(&pu_opt);
-	SetP *placed = (SetP *)ht_pp_new_opt(&pp_opt);
+	SetP *placed = set_p_new();
 	if (!res || !placed) {
 		ht_pu_free(res);
 		set_p_free(placed);
@@ -1667,7 +1666,10 @@ static void set_layer_gap(RzAGraph *g) {
 	}
 }
 
-static void fix_back_edge_dummy_nodes(RzAGraph *g, RzANode *from, RzANode *to) {
+/* removes the dummy nodes of the back edge from the layers, the graph nodes
+ * are only collected in dead_list (and dead) to be deleted all at once, or
+ * deleted right away when there is no dead_list */
+static void fix_back_edge_dummy_nodes(RzAGraph *g, RzANode *from, RzANode *to, RzList *dead_list, SetP *dead) {
 	RzANode *v, *tmp = NULL;
 	RzGraphNode *gv = NULL;
 	RzListIter *it;
@@ -1675,6 +1677,9 @@ static void fix_back_edge_dummy_nodes(RzAGraph *g, RzANode *from, RzANode *to) {
 	rz_return_if_fail(g && from && to);
 	const RzList *neighbours = rz_graph_get_neighbours(g->graph, to->gnode);
 	graph_foreach_anode (neighbours, it, gv, v) {
+		if (dead && set_p_contains(dead, gv)) {
+			continue;
+		}
 		tmp = v;
 		while (tmp->is_dummy) {
 			tmp = (RzANode *)(((RzGraphNode *)rz_list_first(tmp->gnode->out_nodes))->data);
@@ -1702,7 +1707,12 @@ static void fix_back_edge_dummy_nodes(RzAGraph *g, RzANode *from, RzANode *to) {
 			g->layers[v->layer].nodes[g->layers[v->layer].n_nodes - 1] = 0;
 			g->layers[v->layer].n_nodes -= 1;
 
-			rz_graph_del_node(g->graph, v->gnode);
+			if (dead_list) {
+				set_p_add(dead, v->gnode);
+				rz_list_append(dead_list, v->gnode);
+			} else {
+				rz_graph_del_node(g->graph, v->gnode);
+			}
 		}
 	}
 }
@@ -1921,6 +1931,600 @@ static void agraph_edge_free(AEdge *e) {
 	free(e);
 }
 
+/* scalable layout
+ *
+ * The crossing matrices and the hashtable based placement used above are
+ * quadratic in the size of the layers, which makes them unusable on functions
+ * with thousands of basic blocks. Bigger graphs are instead ordered with the
+ * barycenter heuristic and placed with the algorithm based on:
+ * Fast and Simple Horizontal Coordinate Assignment
+ * by U. Brandes, B. Köpf
+ * Both work on arrays indexed by the position of the nodes in the layers.
+ * The result is cached by graph signature, so it is computed again only when
+ * the graph changes. */
+
+#define SCALABLE_SWEEPS     4
+#define SCALABLE_BARY_SCALE 1024
+#define LAYOUT_CACHE_MAX    32
+
+struct bary_t {
+	RzGraphNode *gn;
+	st64 bary;
+	int pos;
+};
+
+struct agraph_layout_cache_t {
+	int n_nodes;
+	int *ids; // index of each node, in the order of rz_graph_get_nodes()
+	int *pos; // position in its layer of each node
+	int *x;
+};
+
+/* nodes of the graph indexed by layer and position, with their neighbours in
+ * the adjacent layers sorted by position */
+typedef struct bk_graph_t {
+	const RzAGraph *g;
+	int n;
+	int *layer_start;
+	RzANode **nodes;
+	int *up_start; // up[up_start[v]..up_start[v + 1]] are the neighbours of v in the previous layer
+	int *up;
+	bool *up_marked; // type 1 conflicts, i.e. segments crossing an inner segment
+	int *down_start;
+	int *down;
+	int *root;
+	int *align;
+} BKGraph;
+
+static int bary_cmp(const void *a, const void *b) {
+	const struct bary_t *ba = a, *bb = b;
+	if (ba->bary != bb->bary) {
+		return ba->bary < bb->bary ? -1 : 1;
+	}
+	return ba->pos - bb->pos;
+}
+
+/* sorts layer i by the mean position of the neighbours in the previous layer */
+static void bary_sweep_layer(const RzAGraph *g, int i, bool from_up, struct bary_t *tmp) {
+	const int adj = from_up ? i - 1 : i + 1;
+	const int len = g->layers[i].n_nodes;
+	int j;
+
+	for (j = 0; j < len; j++) {
+		RzGraphNode *gn = g->layers[i].nodes[j];
+		const RzList *neigh = from_up
+			? rz_graph_innodes(g->graph, gn)
+			: rz_graph_get_neighbours(g->graph, gn);
+		const RzGraphNode *gk;
+		const RzListIter *itk;
+		const RzANode *ak;
+		st64 sum = 0;
+		int n = 0;
+
+		graph_foreach_anode (neigh, itk, gk, ak) {
+			if (ak->layer == adj) {
+				sum += ak->pos_in_layer;
+				n++;
+			}
+		}
+		tmp[j].gn = gn;
+		tmp[j].pos = j;
+		// nodes without neighbours keep their position
+		tmp[j].bary = n ? sum * SCALABLE_BARY_SCALE / n : (st64)j * SCALABLE_BARY_SCALE;
+	}
+	qsort(tmp, len, sizeof(struct bary_t), bary_cmp);
+	for (j = 0; j < len; j++) {
+		RzANode *n = get_anode(tmp[j].gn);
+		g->layers[i].nodes[j] = tmp[j].gn;
+		n->pos_in_layer = j;
+	}
+}
+
+/* layer-by-layer sweep, ordering each layer with the barycenter heuristic */
+static void minimize_crossings_bary(const RzAGraph *g) {
+	int i, s, max_len = 0;
+
+	for (i = 0; i < g->n_layers; i++) {
+		max_len = RZ_MAX(max_len, g->layers[i].n_nodes);
+	}
+	struct bary_t *tmp = RZ_NEWS(struct bary_t, max_len + 1);
+	if (!tmp) {
+		return;
+	}
+	for (s = 0; s < SCALABLE_SWEEPS; s++) {
+		if (rz_cons_is_breaked()) {
+			break;
+		}
+		for (i = 1; i < g->n_layers; i++) {
+			bary_sweep_layer(g, i, true, tmp);
+		}
+		for (i = g->n_layers - 2; i >= 0; i--) {
+			bary_sweep_layer(g, i, false, tmp);
+		}
+	}
+	free(tmp);
+}
+
+static int int_cmp(const void *a, const void *b) {
+	return *(const int *)a - *(const int *)b;
+}
+
+static inline int bk_index(const BKGraph *bk, const RzANode *an) {
+	return bk->layer_start[an->layer] + an->pos_in_layer;
+}
+
+static void bk_fini(BKGraph *bk) {
+	free(bk->layer_start);
+	free(bk->nodes);
+	free(bk->up_start);
+	free(bk->up);
+	free(bk->up_marked);
+	free(bk->down_start);
+	free(bk->down);
+	free(bk->root);
+	free(bk->align);
+}
+
+/* fills start/adj with the neighbours of each node in the layer above (up) or below */
+static bool bk_fill_neighbours(BKGraph *bk, bool up, int **start, int **adj) {
+	const RzAGraph *g = bk->g;
+	int v, k, n_adj = 0;
+
+	*start = RZ_NEWS0(int, bk->n + 1);
+	if (!*start) {
+		return false;
+	}
+	for (v = 0; v < bk->n; v++) {
+		const RzANode *an = bk->nodes[v];
+		const RzList *neigh = up
+			? rz_graph_innodes(g->graph, an->gnode)
+			: rz_graph_get_neighbours(g->graph, an->gnode);
+		const RzGraphNode *gk;
+		const RzListIter *itk;
+		const RzANode *ak;
+
+		(*start)[v] = n_adj;
+		graph_foreach_anode (neigh, itk, gk, ak) {
+			if (ak->layer == an->layer + (up ? -1 : 1)) {
+				n_adj++;
+			}
+		}
+	}
+	(*start)[bk->n] = n_adj;
+	*adj = RZ_NEWS(int, n_adj + 1);
+	if (!*adj) {
+		return false;
+	}
+	for (v = 0; v < bk->n; v++) {
+		const RzANode *an = bk->nodes[v];
+		const RzList *neigh = up
+			? rz_graph_innodes(g->graph, an->gnode)
+			: rz_graph_get_neighbours(g->graph, an->gnode);
+		const RzGraphNode *gk;
+		const RzListIter *itk;
+		const RzANode *ak;
+
+		k = (*start)[v];
+		graph_foreach_anode (neigh, itk, gk, ak) {
+			if (ak->layer == an->layer + (up ? -1 : 1)) {
+				(*adj)[k++] = bk_index(bk, ak);
+			}
+		}
+		qsort(*adj + (*start)[v], k - (*start)[v], sizeof(int), int_cmp);
+	}
+	return true;
+}
+
+static bool bk_init(BKGraph *bk, const RzAGraph *g) {
+	int i, j;
+
+	memset(bk, 0, sizeof(*bk));
+	bk->g = g;
+	bk->layer_start = RZ_NEWS0(int, g->n_layers + 1);
+	if (!bk->layer_start) {
+		return false;
+	}
+	for (i = 0; i < g->n_layers; i++) {
+		bk->layer_start[i] = bk->n;
+		bk->n += g->layers[i].n_nodes;
+	}
+	bk->layer_start[g->n_layers] = bk->n;
+	bk->nodes = RZ_NEWS(RzANode *, bk->n + 1);
+	bk->up_marked = NULL;
+	bk->root = RZ_NEWS(int, bk->n + 1);
+	bk->align = RZ_NEWS(int, bk->n + 1);
+	if (!bk->nodes || !bk->root || !bk->align) {
+		return false;
+	}
+	for (i = 0; i < g->n_layers; i++) {
+		for (j = 0; j < g->layers[i].n_nodes; j++) {
+			bk->nodes[bk->layer_start[i] + j] = get_anode(g->layers[i].nodes[j]);
+		}
+	}
+	if (!bk_fill_neighbours(bk, true, &bk->up_start, &bk->up) ||
+		!bk_fill_neighbours(bk, false, &bk->down_start, &bk->down)) {
+		return false;
+	}
+	bk->up_marked = RZ_NEWS0(bool, bk->up_start[bk->n] + 1);
+	return bk->up_marked;
+}
+
+static bool bk_is_inner(const BKGraph *bk, int u, int v) {
+	return bk->nodes[u]->is_dummy && bk->nodes[v]->is_dummy;
+}
+
+/* returns the upper end of the inner segment ending in v, or -1 */
+static int bk_inner_upper(const BKGraph *bk, int v) {
+	int k;
+	if (!bk->nodes[v]->is_dummy) {
+		return -1;
+	}
+	for (k = bk->up_start[v]; k < bk->up_start[v + 1]; k++) {
+		if (bk->nodes[bk->up[k]]->is_dummy) {
+			return bk->up[k];
+		}
+	}
+	return -1;
+}
+
+/* marks the segments crossing an inner segment (made by two dummy nodes), so
+ * that the long edges are kept as straight as possible */
+static void bk_mark_conflicts(BKGraph *bk) {
+	const RzAGraph *g = bk->g;
+	int i, k;
+
+	for (i = 1; i < g->n_layers; i++) {
+		const int upper = bk->layer_start[i - 1];
+		int l1, l = 0, k0 = 0;
+
+		for (l1 = 0; l1 < g->layers[i].n_nodes; l1++) {
+			const int v = bk->layer_start[i] + l1;
+			const int inner = bk_inner_upper(bk, v);
+			if (l1 != g->layers[i].n_nodes - 1 && inner < 0) {
+				continue;
+			}
+			const int k1 = inner >= 0 ? inner - upper : g->layers[i - 1].n_nodes - 1;
+			for (; l <= l1; l++) {
+				const int w = bk->layer_start[i] + l;
+				for (k = bk->up_start[w]; k < bk->up_start[w + 1]; k++) {
+					const int pos = bk->up[k] - upper;
+					if ((pos < k0 || pos > k1) && !bk_is_inner(bk, bk->up[k], w)) {
+						bk->up_marked[k] = true;
+					}
+				}
+			}
+			k0 = k1;
+		}
+	}
+}
+
+/* returns true if the segment between u (upper) and v (lower) is marked */
+static bool bk_is_marked(const BKGraph *bk, int u, int v) {
+	int lo = bk->up_start[v], hi = bk->up_start[v + 1] - 1;
+	while (lo <= hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (bk->up[mid] == u) {
+			return bk->up_marked[mid];
+		}
+		if (bk->up[mid] < u) {
+			lo = mid + 1;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	return false;
+}
+
+/* aligns each node with the median of its neighbours in the previous layer,
+ * forming blocks of vertically aligned nodes */
+static void bk_align(BKGraph *bk, bool down, bool left) {
+	const RzAGraph *g = bk->g;
+	int i, v, m;
+
+	for (v = 0; v < bk->n; v++) {
+		bk->root[v] = v;
+		bk->align[v] = v;
+	}
+	for (i = down ? 1 : g->n_layers - 2; down ? i < g->n_layers : i >= 0; i += down ? 1 : -1) {
+		const int *start = down ? bk->up_start : bk->down_start;
+		const int *adj = down ? bk->up : bk->down;
+		const int len = g->layers[i].n_nodes;
+		int r = left ? -1 : INT_MAX;
+		int k;
+
+		for (k = 0; k < len; k++) {
+			v = bk->layer_start[i] + (left ? k : len - 1 - k);
+			const int d = start[v + 1] - start[v];
+			if (d == 0) {
+				continue;
+			}
+			const int medians[2] = {
+				start[v] + (left ? (d - 1) / 2 : d / 2),
+				start[v] + (left ? d / 2 : (d - 1) / 2)
+			};
+			for (m = 0; m < 2; m++) {
+				if (bk->align[v] != v) {
+					break;
+				}
+				const int u = adj[medians[m]];
+				const bool marked = down ? bk_is_marked(bk, u, v) : bk_is_marked(bk, v, u);
+				if (!marked && (left ? r < u : r > u)) {
+					bk->align[u] = v;
+					bk->root[v] = bk->root[u];
+					bk->align[v] = bk->root[v];
+					r = u;
+				}
+			}
+		}
+	}
+}
+
+static int bk_separation(const RzANode *a, const RzANode *b) {
+	// same distance between adjacent nodes as dist_nodes()
+	if (a->is_reversed && b->is_reversed) {
+		return 1;
+	}
+	return a->w / 2 + b->w / 2 + HORIZONTAL_NODE_SPACING;
+}
+
+/* places the blocks as close as possible to their left (or right) neighbours.
+ * The blocks form a DAG, which is traversed in topological order first to
+ * find the minimal coordinates, then backwards to pull every block towards
+ * its right neighbours, so that the classes of blocks never overlap. */
+static bool bk_compact(BKGraph *bk, bool left, int *x) {
+	const int n = bk->n;
+	bool ret = false;
+	int v, k, head = 0, tail = 0, n_edges = 0;
+
+	int *e_from = RZ_NEWS(int, n + 1);
+	int *e_to = RZ_NEWS(int, n + 1);
+	int *e_sep = RZ_NEWS(int, n + 1);
+	int *out_start = RZ_NEWS0(int, n + 2);
+	int *out = RZ_NEWS(int, n + 1);
+	int *indeg = RZ_NEWS0(int, n + 1);
+	int *order = RZ_NEWS(int, n + 1);
+	int *bx = RZ_NEWS0(int, n + 1);
+	if (!e_from || !e_to || !e_sep || !out_start || !out || !indeg || !order || !bx) {
+		goto beach;
+	}
+
+	// block graph: an edge between the blocks of each pair of adjacent nodes
+	for (v = 0; v < n; v++) {
+		const RzANode *an = bk->nodes[v];
+		const int pos = left ? an->pos_in_layer : bk->g->layers[an->layer].n_nodes - 1 - an->pos_in_layer;
+		if (pos == 0) {
+			continue;
+		}
+		const int p = left ? v - 1 : v + 1;
+		e_from[n_edges] = bk->root[p];
+		e_to[n_edges] = bk->root[v];
+		e_sep[n_edges] = bk_separation(bk->nodes[p], an);
+		out_start[e_from[n_edges] + 1]++;
+		indeg[e_to[n_edges]]++;
+		n_edges++;
+	}
+	for (v = 0; v < n; v++) {
+		out_start[v + 1] += out_start[v];
+	}
+	int *fill = order; // reused as temporary cursor before the sort
+	for (v = 0; v < n; v++) {
+		fill[v] = out_start[v];
+	}
+	for (k = 0; k < n_edges; k++) {
+		out[fill[e_from[k]]++] = k;
+	}
+
+	// topological sort of the blocks
+	for (v = 0; v < n; v++) {
+		if (bk->root[v] == v && !indeg[v]) {
+			order[tail++] = v;
+		}
+	}
+	while (head < tail) {
+		const int b = order[head++];
+		for (k = out_start[b]; k < out_start[b + 1]; k++) {
+			const int e = out[k];
+			bx[e_to[e]] = RZ_MAX(bx[e_to[e]], bx[b] + e_sep[e]);
+			if (!--indeg[e_to[e]]) {
+				order[tail++] = e_to[e];
+			}
+		}
+	}
+	for (k = tail - 1; k >= 0; k--) {
+		const int b = order[k];
+		if (out_start[b] == out_start[b + 1]) {
+			continue;
+		}
+		int min = INT_MAX;
+		for (v = out_start[b]; v < out_start[b + 1]; v++) {
+			const int e = out[v];
+			min = RZ_MIN(min, bx[e_to[e]] - e_sep[e]);
+		}
+		bx[b] = RZ_MAX(bx[b], min);
+	}
+
+	for (v = 0; v < n; v++) {
+		x[v] = left ? bx[bk->root[v]] : -bx[bk->root[v]];
+	}
+	ret = true;
+
+beach:
+	free(e_from);
+	free(e_to);
+	free(e_sep);
+	free(out_start);
+	free(out);
+	free(indeg);
+	free(order);
+	free(bx);
+	return ret;
+}
+
+/* computes the four placements (up/down, left/right) and sets the x of each
+ * node to the average of the median ones */
+static void place_brandes_koepf(const RzAGraph *g) {
+	BKGraph bk;
+	int *xs[4] = { NULL };
+	int min[4], max[4];
+	int a, v, best = 0;
+
+	if (!bk_init(&bk, g)) {
+		goto beach;
+	}
+	bk_mark_conflicts(&bk);
+	for (a = 0; a < 4; a++) {
+		const bool down = a < 2, left = !(a & 1);
+		xs[a] = RZ_NEWS(int, bk.n + 1);
+		if (!xs[a]) {
+			goto beach;
+		}
+		bk_align(&bk, down, left);
+		if (!bk_compact(&bk, left, xs[a])) {
+			goto beach;
+		}
+		min[a] = INT_MAX;
+		max[a] = INT_MIN;
+		for (v = 0; v < bk.n; v++) {
+			min[a] = RZ_MIN(min[a], xs[a][v]);
+			max[a] = RZ_MAX(max[a], xs[a][v]);
+		}
+		if (max[a] - min[a] < max[best] - min[best]) {
+			best = a;
+		}
+	}
+
+	// align the placements to the narrowest one
+	for (a = 0; a < 4; a++) {
+		const int shift = !(a & 1) ? min[best] - min[a] : max[best] - max[a];
+		for (v = 0; v < bk.n; v++) {
+			xs[a][v] += shift;
+		}
+	}
+	for (v = 0; v < bk.n; v++) {
+		int vals[4] = { xs[0][v], xs[1][v], xs[2][v], xs[3][v] };
+		qsort(vals, 4, sizeof(int), int_cmp);
+		bk.nodes[v]->x = (vals[1] + vals[2]) / 2;
+	}
+
+beach:
+	for (a = 0; a < 4; a++) {
+		free(xs[a]);
+	}
+	bk_fini(&bk);
+}
+
+static void layout_cache_free(HtUPKv *kv) {
+	struct agraph_layout_cache_t *c = kv->value;
+	free(c->ids);
+	free(c->pos);
+	free(c->x);
+	free(c);
+}
+
+static inline ut64 layout_signature_mix(ut64 h, ut64 v) {
+	return (h ^ v) * 0x100000001b3ULL;
+}
+
+/* hash of everything the scalable layout depends on */
+static ut64 layout_signature(const RzAGraph *g) {
+	const RzList *nodes = rz_graph_get_nodes(g->graph);
+	const RzGraphNode *gn, *gk;
+	const RzListIter *it, *itk;
+	const RzANode *an, *ak;
+	ut64 h = 0xcbf29ce484222325ULL;
+
+	h = layout_signature_mix(h, g->layout);
+	graph_foreach_anode (nodes, it, gn, an) {
+		h = layout_signature_mix(h, gn->idx);
+		h = layout_signature_mix(h, an->layer);
+		h = layout_signature_mix(h, an->w);
+		h = layout_signature_mix(h, an->is_dummy | an->is_reversed << 1);
+		graph_foreach_anode (rz_graph_get_neighbours(g->graph, gn), itk, gk, ak) {
+			h = layout_signature_mix(h, gk->idx);
+		}
+	}
+	return h;
+}
+
+/* restores the order of the layers from the cache, the coordinates are set by
+ * layout_cache_apply_x once the dimensions of the layers are known */
+static bool layout_cache_apply_order(const RzAGraph *g, const struct agraph_layout_cache_t *c) {
+	const RzList *nodes = rz_graph_get_nodes(g->graph);
+	RzGraphNode *gn;
+	const RzListIter *it;
+	RzANode *an;
+	int i = 0;
+
+	// the signature may collide, so the cached layout must describe the same nodes
+	if (c->n_nodes != rz_list_length(nodes)) {
+		return false;
+	}
+	graph_foreach_anode (nodes, it, gn, an) {
+		if (c->ids[i] != gn->idx || c->pos[i] < 0 || c->pos[i] >= g->layers[an->layer].n_nodes) {
+			return false;
+		}
+		i++;
+	}
+	i = 0;
+	graph_foreach_anode (nodes, it, gn, an) {
+		an->pos_in_layer = c->pos[i++];
+		g->layers[an->layer].nodes[an->pos_in_layer] = gn;
+	}
+	return true;
+}
+
+static void layout_cache_apply_x(const RzAGraph *g, const struct agraph_layout_cache_t *c) {
+	const RzGraphNode *gn;
+	const RzListIter *it;
+	RzANode *an;
+	int i = 0;
+
+	graph_foreach_anode (rz_graph_get_nodes(g->graph), it, gn, an) {
+		an->x = c->x[i++];
+	}
+}
+
+static void layout_cache_add(RzAGraph *g, ut64 sig) {
+	const RzList *nodes = rz_graph_get_nodes(g->graph);
+	const RzGraphNode *gn;
+	const RzListIter *it;
+	const RzANode *an;
+	int i = 0;
+
+	if (g->layout_cache && g->layout_cache->count >= LAYOUT_CACHE_MAX) {
+		ht_up_free(g->layout_cache);
+		g->layout_cache = NULL;
+	}
+	if (!g->layout_cache) {
+		g->layout_cache = ht_up_new(NULL, layout_cache_free, NULL);
+		if (!g->layout_cache) {
+			return;
+		}
+	}
+	struct agraph_layout_cache_t *c = RZ_NEW0(struct agraph_layout_cache_t);
+	if (!c) {
+		return;
+	}
+	c->n_nodes = rz_list_length(nodes);
+	c->ids = RZ_NEWS(int, c->n_nodes + 1);
+	c->pos = RZ_NEWS(int, c->n_nodes + 1);
+	c->x = RZ_NEWS(int, c->n_nodes + 1);
+	if (!c->ids || !c->pos || !c->x) {
+		free(c->ids);
+		free(c->pos);
+		free(c->x);
+		free(c);
+		return;
+	}
+	graph_foreach_anode (nodes, it, gn, an) {
+		c->ids[i] = gn->idx;
+		c->pos[i] = an->pos_in_layer;
+		c->x[i] = an->x;
+		i++;
+	}
+	ht_up_update(g->layout_cache, sig, c);
+}
+
 /* 1) trasform the graph into a DAG
  * 2) partition the nodes in layers
  * 3) split long edges that traverse multiple layers
@@ -1937,7 +2541,20 @@ static void set_layout(RzAGraph *g) {
 	assign_layers(g);
 	create_dummy_nodes(g);
 	create_layers(g);
-	minimize_crossings(g);
+
+	const bool scalable = g->scalable > 0 && g->graph->n_nodes >= g->scalable;
+	const struct agraph_layout_cache_t *cached = NULL;
+	ut64 sig = 0;
+	if (scalable) {
+		sig = layout_signature(g);
+		cached = g->layout_cache ? ht_up_find(g->layout_cache, sig, NULL) : NULL;
+		if (!cached || !layout_cache_apply_order(g, cached)) {
+			cached = NULL;
+			minimize_crossings_bary(g);
+		}
+	} else {
+		minimize_crossings(g);
+	}
 
 	if (rz_cons_is_breaked()) {
 		rz_cons_break_end();
@@ -1978,21 +2595,43 @@ static void set_layout(RzAGraph *g) {
 	/* x-coordinate assignment: algorithm based on:
 	 * A Fast Layout Algorithm for k-Level Graphs
 	 * by C. Buchheim, M. Junger, S. Leipert */
-	place_dummies(g);
-	place_original(g);
+	if (cached) {
+		layout_cache_apply_x(g, cached);
+	} else if (scalable) {
+		/* for big graphs, the linear time algorithm from Brandes and Köpf */
+		place_brandes_koepf(g);
+		layout_cache_add(g, sig);
+	} else {
+		place_dummies(g);
+		place_original(g);
+	}
 
 	/* IDEA: need to put this hack because of the way algorithm is implemented.
 	 * I think backedges should be restored to their original state instead of
 	 * converting them to longedges and adding dummy nodes. */
 	const RzListIter *it;
 	const RzGraphEdge *e;
+	RzList *dead_list = rz_list_new();
+	SetP *dead = set_p_new();
+	if (!dead_list || !dead) {
+		// delete the dummy nodes one by one, slower but the edges are still restored
+		rz_list_free(dead_list);
+		set_p_free(dead);
+		dead_list = NULL;
+		dead = NULL;
+	}
 	rz_list_foreach (g->back_edges, it, e) {
 		RzANode *from = e->from ? get_anode(e->from) : NULL;
 		RzANode *to = e->to ? get_anode(e->to) : NULL;
-		fix_back_edge_dummy_nodes(g, from, to);
+		fix_back_edge_dummy_nodes(g, from, to, dead_list, dead);
 		rz_agraph_del_edge(g, to, from);
 		rz_agraph_add_edge_at(g, from, to, e->nth);
 	}
+	if (dead_list) {
+		rz_graph_del_nodes(g->graph, dead_list);
+	}
+	rz_list_free(dead_list);
+	set_p_free(dead);
 
 	switch (g->layout) {
 	default:
@@ -3846,6 +4485,7 @@ RZ_API void rz_agraph_free(RzAGraph *g) {
 	rz_list_free(g->dummy_nodes);
 	rz_graph_free(g->graph);
 	rz_list_free(g->edges);
+	ht_up_free(g->layout_cache);
 	rz_agraph_set_title(g, NULL);
 	sdb_free(g->db);
 	rz_cons_canvas_free(g->can);
@@ -3859,6 +4499,7 @@ RZ_API RzAGraph *rz_agraph_new(RzConsCanvas *can) {
 	}
 	g->can = can;
 	g->dummy = true;
+	g->scalable = RZ_AGRAPH_SCALABLE_NODES;
 	agraph_init(g);
 	agraph_sdb_init(g);
 	return g;
@@ -4103,6 +4744,7 @@ RZ_IPI int rz_core_visual_graph(RzCore *core, RzAGraph *g, RzAnalysisFunction *_
 		}
 		g->layout = rz_config_get_i(core->config, "graph.layout");
 		g->dummy = rz_config_get_i(core->config, "graph.dummy");
+		g->scalable = rz_config_get_i(core->config, "graph.scalable");
 		g->show_node_titles = rz_config_get_i(core->config, "graph.ntitles");
 	} else {
 		o_can = g->can;
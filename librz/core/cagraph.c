@@ -64,6 +64,7 @@ RZ_IPI void rz_core_agraph_del_edge(RzCore *core, const char *un, const char *vn
 
 RZ_IPI void rz_core_agraph_print_ascii(RzCore *core) {
 	core->graph->can->linemode = rz_config_get_i(core->config, "graph.linemode");
+	core->graph->scalable = rz_config_get_i(core->config, "graph.scalable");
 	core->graph->can->color = rz_config_get_i(core->config, "scr.color");
 	rz_agraph_set_title(core->graph, rz_config_get(core->config, "graph.title"));
 	rz_agraph_print(core->graph);
@@ -89,6 +90,7 @@ RZ_IPI void rz_core_agraph_print_interactive(RzCore *core) {
 	core->graph->force_update_seek = true;
 	core->graph->need_set_layout = true;
 	core->graph->layout = rz_config_get_i(core->config, "graph.layout");
+	core->graph->scalable = rz_config_get_i(core->config, "graph.scalable");
 	bool ov = rz_cons_is_interactive();
 	core->graph->need_update_dim = true;
 	int update_seek = rz_core_visual_graph(core, core->graph, NULL, true);
@@ -2155,12 +2155,13 @@ static bool is_valid_xref(RzCore *core, ut64 xref_to, RzAnalysisXRefType type, i
  * \brief Sets a new xref according to the given to and from addresses.
  *
  * \param core       The rizin core.
+ * \param batch      Vector collecting the xrefs to be added in bulk.
  * \param xref_from  The address where the xref is located.
  * \param xref_to    The target address of the xref.
  * \param type       The xref type.
  * \param can_search When true, search and set the new string.
  */
-static void set_new_xref(RzCore *core, ut64 xref_from, ut64 xref_to, RzAnalysisXRefType type, bool can_search) {
+static void set_new_xref(RzCore *core, RzVector /*<RzAnalysisXRef>*/ *batch, ut64 xref_from, ut64 xref_to, RzAnalysisXRefType type, bool can_search) {
 	size_t length = 0;
 	char *string = NULL;
 	RzStrEnc encoding = 0;
@@ -2174,9 +2175,9 @@ static void set_new_xref(RzCore *core, ut64 xref_from, ut64 xref_to, RzAnalysisX
 		free(flagname);
 		free(string);
 	}
-	// Add to SDB
 	if (xref_to) {
-		rz_analysis_xrefs_set(core->analysis, xref_from, xref_to, type);
+		RzAnalysisXRef xref = { xref_from, xref_to, type };
+		rz_vector_push(batch, &xref);
 	}
 }
 
@@ -2221,6 +2222,8 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 		return -1;
 	}
 
+	RzVector batch;
+	rz_vector_init(&batch, sizeof(RzAnalysisXRef), NULL, NULL);
 	rz_cons_break_push(NULL, NULL);
 
 	at = from;
@@ -2251,7 +2254,7 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 			// find references
 			if ((st64)op.val > asm_sub_varmin && op.val != UT64_MAX && op.val != UT32_MAX) {
 				if (is_valid_xref(core, op.val, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.val, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.val, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
 					count++;
 				}
 			}
@@ -2259,7 +2262,7 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 				st64 aval = op.analysis_vals[i].imm;
 				if (aval > asm_sub_varmin && aval != UT64_MAX && aval != UT32_MAX) {
 					if (is_valid_xref(core, aval, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-						set_new_xref(core, op.addr, aval, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
+						set_new_xref(core, &batch, op.addr, aval, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
 						count++;
 					}
 				}
@@ -2267,35 +2270,35 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 			// find references
 			if (op.ptr && op.ptr != UT64_MAX && op.ptr != UT32_MAX) {
 				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
 					count++;
 				}
 			}
 			// find references
 			if (op.addr > 512 && op.disp > 512 && op.disp && op.disp != UT64_MAX) {
 				if (is_valid_xref(core, op.disp, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.disp, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.disp, RZ_ANALYSIS_XREF_TYPE_DATA, can_search_string);
 					count++;
 				}
 			}
 			switch (op.type) {
 			case RZ_ANALYSIS_OP_TYPE_JMP:
 				if (is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
 					count++;
 				}
 				break;
 			case RZ_ANALYSIS_OP_TYPE_CJMP:
 				if (rz_config_get_b(core->config, "analysis.jmp.cref") &&
 					is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
 					count++;
 				}
 				break;
 			case RZ_ANALYSIS_OP_TYPE_CALL:
 			case RZ_ANALYSIS_OP_TYPE_CCALL:
 				if (is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL, can_search_string);
 					count++;
 				}
 				break;
@@ -2307,7 +2310,7 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 			case RZ_ANALYSIS_OP_TYPE_UCJMP:
 				count++;
 				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CODE, can_search_string);
 					count++;
 				}
 				break;
@@ -2317,7 +2320,7 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 			case RZ_ANALYSIS_OP_TYPE_IRCALL:
 			case RZ_ANALYSIS_OP_TYPE_UCCALL:
 				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_CALL, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CALL, can_search_string);
+					set_new_xref(core, &batch, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CALL, can_search_string);
 					count++;
 				}
 				break;
@@ -2330,6 +2333,8 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 		rz_analysis_op_fini(&op);
 	}
 	rz_cons_break_pop();
+	rz_analysis_xrefs_set_bulk(core->analysis, &batch);
+	rz_vector_fini(&batch);
 	free(buf);
 	free(block);
 	return count;
@@ -4347,15 +4352,14 @@ struct core_noretl {
 	SetU *todo;
 };
 
-static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v) {
+static bool process_reference_noreturn_cb(const RzAnalysisXRef *xref, void *u) {
 	RzCore *core = ((struct core_noretl *)u)->core;
 	RzList *noretl = ((struct core_noretl *)u)->noretl;
 	SetU *todo = ((struct core_noretl *)u)->todo;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
 	if (xref->type == RZ_ANALYSIS_XREF_TYPE_CALL || xref->type == RZ_ANALYSIS_XREF_TYPE_CODE) {
 		// At first we check if there are any relocations that override the call address
 		// Note, that the relocation overrides only the part of the instruction
-		ut64 addr = k;
+		ut64 addr = xref->from;
 		ut8 buf[CALL_BUF_SIZE] = { 0 };
 		RzAnalysisOp op = { 0 };
 		if (core->analysis->iob.read_at(core->analysis->iob.io, addr, buf, CALL_BUF_SIZE)) {
@@ -4379,12 +4383,6 @@ static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v)
 	return true;
 }
 
-static bool process_refs_cb(void *u, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, process_reference_noreturn_cb, u);
-	return true;
-}
-
 static bool reanalyze_fcns_cb(void *u, const ut64 k, const void *v) {
 	RzCore *core = u;
 	RzAnalysisFunction *fcn = (RzAnalysisFunction *)(size_t)k;
@@ -4406,7 +4404,7 @@ RZ_API void rz_core_analysis_propagate_noreturn_relocs(RzCore *core, ut64 addr)
 	// List of the potentially noreturn functions
 	SetU *todo = set_u_new();
 	struct core_noretl u = { core, noretl, todo };
-	ht_up_foreach(core->analysis->ht_xrefs_to, process_refs_cb, &u);
+	rz_analysis_xrefs_foreach(core->analysis, process_reference_noreturn_cb, &u);
 	rz_list_free(noretl);
 	core->analysis->bits = bits1;
 	core->rasm->bits = bits2;
@@ -5046,6 +5044,12 @@ RZ_API bool rz_core_analysis_sigdb_apply(RZ_NONNULL RzCore *core, RZ_NULLABLE in
 		return false;
 	}
 
+	RzPVector *trees = rz_pvector_new((RzPVectorFree)rz_sign_flirt_node_free);
+	if (!trees) {
+		rz_list_free(sigdb);
+		return false;
+	}
+
 	n_flags_old = rz_flag_count(core->flags, "flirt");
 	rz_list_foreach (sigdb, iter, sig) {
 		if (rz_cons_is_breaked()) {
@@ -5071,9 +5075,17 @@ RZ_API bool rz_core_analysis_sigdb_apply(RZ_NONNULL RzCore *core, RZ_NULLABLE in
 			rz_cons_printf("Applying %s/%s/%u/%s signature file\n",
 				sig->bin_name, sig->arch_name, sig->arch_bits, sig->base_name);
 		}
-		rz_sign_flirt_apply(core->analysis, sig->file_path, arch_id);
+		RzFlirtNode *node = rz_sign_flirt_parse_file(sig->file_path, arch_id);
+		if (node && !rz_pvector_push(trees, node)) {
+			rz_sign_flirt_node_free(node);
+		}
 	}
 	rz_list_free(sigdb);
+	// all the files are matched at once, in the order they were listed
+	if (!rz_cons_is_breaked() && !rz_sign_flirt_apply_nodes(core->analysis, trees, rz_config_get_i(core->config, "flirt.threads"))) {
+		RZ_LOG_ERROR("FLIRT: Error while applying the signatures\n");
+	}
+	rz_pvector_free(trees);
 	n_flags_new = rz_flag_count(core->flags, "flirt");
 
 	if (n_applied) {
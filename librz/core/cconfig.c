@@ -225,6 +225,35 @@ static bool cb_analysis_sleep(void *user, void *data) {
 	return true;
 }
 
+static bool cb_analysis_opcache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	ut64 slots = rz_config_get_i(core->config, "analysis.opcache.slots");
+	return rz_analysis_op_cache_resize(core->analysis, node->i_value ? slots : 0);
+}
+
+static bool cb_analysis_opcache_slots(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	if (!node->i_value) {
+		return false;
+	}
+	if (!rz_config_get_b(core->config, "analysis.opcache")) {
+		return true;
+	}
+	return rz_analysis_op_cache_resize(core->analysis, node->i_value);
+}
+
+static bool cb_analysis_types_pin(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	core->analysis->typedb->pin_all = node->i_value;
+	if (node->i_value) {
+		rz_type_db_pin_all(core->analysis->typedb);
+	}
+	return true;
+}
+
 static bool cb_analysis_maxrefs(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -1970,6 +1999,25 @@ static bool cb_io_cache(void *user, void *data) {
 	return true;
 }
 
+static bool cb_io_pagecache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	ut64 pages = rz_config_get_i(core->config, "io.pagecache.pages");
+	return rz_io_page_cache_resize(core->io, node->i_value ? pages : 0);
+}
+
+static bool cb_io_pagecache_pages(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	if (!node->i_value) {
+		return false;
+	}
+	if (!rz_config_get_b(core->config, "io.pagecache")) {
+		return true;
+	}
+	return rz_io_page_cache_resize(core->io, node->i_value);
+}
+
 static bool cb_ioaslr(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -2188,6 +2236,12 @@ static bool cb_scrpagesize(void *user, void *data) {
 	return true;
 }
 
+static bool cb_scrstream(void *user, void *data) {
+	RzConfigNode *node = (RzConfigNode *)data;
+	rz_cons_singleton()->stream_size = node->i_value;
+	return true;
+}
+
 static bool cb_scrflush(void *user, void *data) {
 	RzConfigNode *node = (RzConfigNode *)data;
 	rz_cons_singleton()->flush = node->i_value;
@@ -2935,6 +2989,9 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETICB("analysis.depth", 64, &cb_analysis_depth, "Max depth at code analysis"); // XXX: warn if depth is > 50 .. can be problematic
 	SETICB("analysis.graph_depth", 256, &cb_analysis_graphdepth, "Max depth for path search");
 	SETICB("analysis.sleep", 0, &cb_analysis_sleep, "Sleep N usecs every so often during analysis. Avoid 100% CPU usage");
+	SETICB("analysis.opcache.slots", 0x4000, &cb_analysis_opcache_slots, "Number of decoded instructions kept by analysis.opcache");
+	SETCB("analysis.opcache", "false", &cb_analysis_opcache, "Cache decoded instructions (plugins keeping state between instructions may misbehave)");
+	SETCB("analysis.types.pin", "false", &cb_analysis_types_pin, "Load all the function signatures of the type libraries upfront instead of on first use");
 	SETCB("analysis.ignbithints", "false", &cb_analysis_ignbithints, "Ignore the ahb hints (only obey asm.bits)");
 	SETBPREF("analysis.calls", "false", "Make basic af analysis walk into calls");
 	SETBPREF("analysis.autoname", "false", "Speculatively set a name for the functions, may result in some false positives");
@@ -3230,6 +3287,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	/* prj */
 	SETPREF("prj.file", "", "Path of the currently opened project");
 	SETBPREF("prj.compress", "false", "Compress the project file while saving");
+	SETBPREF("prj.binary", "false", "Save the project in the binary format, rewriting only what changed since the last save");
 
 	/* cfg */
 	SETBPREF("cfg.plugins", "true", "Load plugins at startup");
@@ -3494,6 +3552,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETBPREF("graph.json.usenames", "true", "Use names instead of addresses in Global Call Graph (agCj)");
 	SETI("graph.edges", 2, "0=no edges, 1=simple edges, 2=avoid collisions");
 	SETI("graph.layout", 0, "Graph layout (0=vertical, 1=horizontal)");
+	SETI("graph.scalable", RZ_AGRAPH_SCALABLE_NODES, "Use a faster layout for graphs with at least this many nodes (0=never)");
 	SETI("graph.linemode", 1, "Graph edges (0=diagonal, 1=square)");
 	SETPREF("graph.font", "Courier", "Font for dot graphs");
 	SETBPREF("graph.offset", "false", "Show offsets in graphs");
@@ -3536,6 +3595,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETICB("scr.maxtab", 4096, &cb_completion_maxtab, "Change max number of auto completion suggestions");
 	SETICB("scr.pagesize", 1, &cb_scrpagesize, "Flush in pages when scr.linesleep is != 0");
 	SETCB("scr.flush", "false", &cb_scrflush, "Force flush to console in realtime (breaks scripting)");
+	SETICB("scr.stream", 0, &cb_scrstream, "Write the complete lines of the output once it exceeds this many bytes (0: buffer it until the command ends)");
 	SETBPREF("scr.slow", "true", "Do slow stuff on visual mode like RzFlag.get_at(true)");
 	SETCB("scr.prompt.popup", "false", &cb_scr_prompt_popup, "Show widget dropdown for autocomplete");
 #if __WINDOWS__
@@ -3615,6 +3675,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETBPREF("search.flags", "true", "All search results are flagged, otherwise only printed");
 	SETBPREF("search.overlap", "false", "Look for overlapped search hits");
 	SETI("search.maxhits", 0, "Maximum number of hits (0: no limit)");
+	SETI("search.threads", RZ_THREAD_POOL_ALL_CORES, "Threads used by keyword searches over large ranges and by aap (0: all cores, 1: single thread)");
 	SETI("search.from", -1, "Search start address");
 	n = NODECB("search.in", "io.maps", &cb_searchin);
 	SETDESC(n, "Specify search boundaries");
@@ -3649,6 +3710,8 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("io.pcache", "false", &cb_iopcache, "io.cache for p-level");
 	SETCB("io.pcache.write", "false", &cb_iopcachewrite, "Enable write-cache");
 	SETCB("io.pcache.read", "false", &cb_iopcacheread, "Enable read-cache");
+	SETICB("io.pagecache.pages", 1024, &cb_io_pagecache_pages, "Number of 4K pages kept by io.pagecache");
+	SETCB("io.pagecache", "false", &cb_io_pagecache, "Cache plugin reads in 4K pages (useful for slow backends)");
 	SETCB("io.ff", "true", &cb_ioff, "Fill invalid buffers with 0xff instead of returning error");
 	SETBPREF("io.exec", "true", "See !!rizin -h~-x");
 	SETICB("io.0xff", 0xff, &cb_io_oxff, "Use this value instead of 0xff to fill unallocated areas");
@@ -3734,6 +3797,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETB("flirt.sigdb.load.system", true, "Load signatures from the system path");
 	SETB("flirt.sigdb.load.extra", true, "Load signatures from the extra path");
 	SETB("flirt.sigdb.load.home", true, "Load signatures from the home path");
+	SETI("flirt.threads", RZ_THREAD_POOL_ALL_CORES, "Threads used to match the functions against the signatures (0: all cores, 1: single thread)");
 
 	rz_config_lock(cfg, true);
 	return true;
@@ -85,6 +85,7 @@ struct __rebase_struct {
 	ut64 old_base;
 	ut64 diff;
 	int type;
+	RzVector /*<RzAnalysisXRef>*/ *xrefs;
 };
 
 #define __is_inside_section(item_addr, section) \
@@ -105,19 +106,10 @@ static bool __rebase_flags(RzFlagItem *flag, void *user) {
 	return true;
 }
 
-static bool __rebase_xrefs_i(void *user, const ut64 k, const void *v) {
+static bool __rebase_xrefs(const RzAnalysisXRef *xref, void *user) {
 	struct __rebase_struct *reb = (void *)user;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
-	xref->from += reb->diff;
-	xref->to += reb->diff;
-	rz_analysis_xrefs_set(reb->core->analysis, xref->from, xref->to, xref->type);
-	return true;
-}
-
-static bool __rebase_xrefs(void *user, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, __rebase_xrefs_i, user);
-	return true;
+	RzAnalysisXRef rebased = { xref->from + reb->diff, xref->to + reb->diff, xref->type };
+	return rz_vector_push(reb->xrefs, &rebased);
 }
 
 static void __rebase_everything(RzCore *core, RzList /*<RzBinSection *>*/ *old_sections, ut64 old_base) {
@@ -168,14 +160,13 @@ static void __rebase_everything(RzCore *core, RzList /*<RzBinSection *>*/ *old_s
 	rz_meta_rebase(core->analysis, diff);
 
 	// XREFS
-	HtUP *xrefs_from = core->analysis->ht_xrefs_from;
-	HtUP *xrefs_to = core->analysis->ht_xrefs_to;
-	core->analysis->ht_xrefs_from = NULL;
-	core->analysis->ht_xrefs_to = NULL;
+	RzVector xrefs;
+	rz_vector_init(&xrefs, sizeof(RzAnalysisXRef), NULL, NULL);
+	reb.xrefs = &xrefs;
+	rz_analysis_xrefs_foreach(core->analysis, __rebase_xrefs, &reb);
 	rz_analysis_xrefs_init(core->analysis);
-	ht_up_foreach(xrefs_from, __rebase_xrefs, &reb);
-	ht_up_free(xrefs_from);
-	ht_up_free(xrefs_to);
+	rz_analysis_xrefs_set_bulk(core->analysis, &xrefs);
+	rz_vector_fini(&xrefs);
 
 	// BREAKPOINTS
 	rz_debug_bp_rebase(core->dbg, old_base, new_base);
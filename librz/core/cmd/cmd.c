@@ -215,7 +215,7 @@ static void recursive_help(RzCore *core, int detail, const char *cmd_prefix) {
 RZ_IPI bool rz_core_cmd_lastcmd_repeat(RzCore *core, bool next) {
 	int res = -1;
 	// Fix for backtickbug px`~`
-	if (!core->lastcmd || core->cons->context->cmd_depth < 1) {
+	if (!core->lastcmd || rz_cons_context()->cmd_depth < 1) {
 		return false;
 	}
 	switch (*core->lastcmd) {
@@ -263,8 +263,8 @@ RZ_IPI bool rz_core_cmd_lastcmd_repeat(RzCore *core, bool next) {
 
 static int rz_core_cmd_nullcallback(void *data) {
 	RzCore *core = (RzCore *)data;
-	if (core->cons->context->breaked) {
-		core->cons->context->breaked = false;
+	if (rz_cons_context()->breaked) {
+		rz_cons_context()->breaked = false;
 		return 0;
 	}
 	if (!core->cmdrepeat) {
@@ -1226,7 +1226,7 @@ static int rz_core_cmd_subst(RzCore *core, char *cmd) {
 		goto beach;
 	}
 
-	if (core->max_cmd_depth - core->cons->context->cmd_depth == 1) {
+	if (core->max_cmd_depth - rz_cons_context()->cmd_depth == 1) {
 		core->prompt_offset = core->offset;
 	}
 	cmd = (char *)rz_str_trim_head_ro(icmd);
@@ -2910,7 +2910,7 @@ RZ_API int rz_core_cmd_foreach(RzCore *core, const char *cmd, char *each) {
 			RzAnalysisFunction *fcn;
 			RzListIter *iter;
 			if (core->analysis) {
-				RzConsGrep grep = core->cons->context->grep;
+				RzConsGrep grep = rz_cons_context()->grep;
 				rz_list_foreach (core->analysis->fcns, iter, fcn) {
 					char *buf;
 					rz_core_seek(core, fcn->addr, true);
@@ -2924,7 +2924,7 @@ RZ_API int rz_core_cmd_foreach(RzCore *core, const char *cmd, char *each) {
 						break;
 					}
 				}
-				core->cons->context->grep = grep;
+				rz_cons_context()->grep = grep;
 			}
 			goto out_finish;
 		}
@@ -5171,8 +5171,8 @@ DEFINE_HANDLE_TS_FCN(statements) {
 
 	RZ_LOG_DEBUG("commands with %d childs\n", child_count);
 	if (child_count == 0 && !*state->input) {
-		if (core->cons->context->breaked) {
-			core->cons->context->breaked = false;
+		if (rz_cons_context()->breaked) {
+			rz_cons_context()->breaked = false;
 			return RZ_CMD_STATUS_INVALID;
 		}
 		if (!core->cmdrepeat) {
@@ -5184,12 +5184,12 @@ DEFINE_HANDLE_TS_FCN(statements) {
 		rz_cons_break_push(NULL, NULL);
 	}
 	for (i = 0; i < child_count; i++) {
-		if (core->cons->context->cmd_depth < 1) {
+		if (rz_cons_context()->cmd_depth < 1) {
 			RZ_LOG_ERROR("handle_ts_statements: That was too deep...\n");
 			return RZ_CMD_STATUS_INVALID;
 		}
-		core->cons->context->cmd_depth--;
-		if (core->max_cmd_depth - core->cons->context->cmd_depth == 1) {
+		rz_cons_context()->cmd_depth--;
+		if (core->max_cmd_depth - rz_cons_context()->cmd_depth == 1) {
 			core->prompt_offset = core->offset;
 		}
 
@@ -5203,7 +5203,7 @@ DEFINE_HANDLE_TS_FCN(statements) {
 			rz_cons_flush();
 			rz_core_task_yield(&core->tasks);
 		}
-		core->cons->context->cmd_depth++;
+		rz_cons_context()->cmd_depth++;
 		if (cmd_res == RZ_CMD_STATUS_INVALID) {
 			char *command_str = ts_node_sub_string(command, state->input);
 			RZ_LOG_ERROR("core: Error while executing command: %s\n", command_str);
@@ -5328,11 +5328,11 @@ static int run_cmd_depth(RzCore *core, char *cmd) {
 	char *rcmd;
 	int ret = false;
 
-	if (core->cons->context->cmd_depth < 1) {
+	if (rz_cons_context()->cmd_depth < 1) {
 		RZ_LOG_ERROR("core: rz_core_cmd: That was too deep (%s)...\n", cmd);
 		return false;
 	}
-	core->cons->context->cmd_depth--;
+	rz_cons_context()->cmd_depth--;
 	for (rcmd = cmd;;) {
 		char *ptr = strchr(rcmd, '\n');
 		if (ptr) {
@@ -5348,7 +5348,7 @@ static int run_cmd_depth(RzCore *core, char *cmd) {
 		}
 		rcmd = ptr + 1;
 	}
-	core->cons->context->cmd_depth++;
+	rz_cons_context()->cmd_depth++;
 	return ret;
 }
 
@@ -5554,6 +5554,51 @@ RZ_API ut8 *rz_core_cmd_raw(RzCore *core, const char *cmd, int *length) {
 	return core_cmd_raw(core, cmd, length);
 }
 
+/**
+ * \brief Check whether \p cmd is a single invocation of a read-only command
+ *
+ * Only plain commands are considered: anything using pipes, redirections,
+ * temporary seeks, grep, sub-commands or quoting is never read-only, because
+ * it goes through the shell and touches the shared state of \p core.
+ * Such commands can be run concurrently with rz_core_cmd_read_only().
+ */
+RZ_API bool rz_core_cmd_is_read_only(RZ_NONNULL RzCore *core, RZ_NONNULL const char *cmd) {
+	rz_return_val_if_fail(core && cmd, false);
+	cmd = rz_str_trim_head_ro(cmd);
+	if (!*cmd || cmd[strcspn(cmd, "@;|>~`$()?\"'\\\n")]) {
+		return false;
+	}
+	char *name = rz_str_ndup(cmd, strcspn(cmd, " \t\r"));
+	if (!name) {
+		return false;
+	}
+	RzCmdDesc *cd = rz_cmd_get_desc(core->rcmd, name);
+	bool res = cd && rz_cmd_desc_is_read_only(cd, name);
+	free(name);
+	return res;
+}
+
+/**
+ * Run \p cmd, which must satisfy rz_core_cmd_is_read_only(), without going
+ * through the shell, so that nothing but the output is modified.
+ */
+RZ_IPI RzCmdStatus rz_core_cmd_read_only(RzCore *core, const char *cmd) {
+	int argc = 0;
+	char **argv = rz_str_argv(cmd, &argc);
+	if (!argv || argc < 1) {
+		rz_str_argv_free(argv);
+		return RZ_CMD_STATUS_INVALID;
+	}
+	RzCmdParsedArgs *args = rz_cmd_parsed_args_new(argv[0], argc - 1, argv + 1);
+	rz_str_argv_free(argv);
+	if (!args) {
+		return RZ_CMD_STATUS_INVALID;
+	}
+	RzCmdStatus res = rz_cmd_call_parsed_args(core->rcmd, args);
+	rz_cmd_parsed_args_free(args);
+	return res;
+}
+
 static int compare_cmd_descriptor_name(const void *a, const void *b) {
 	return strcmp(((RzCmdDescriptor *)a)->cmd, ((RzCmdDescriptor *)b)->cmd);
 }
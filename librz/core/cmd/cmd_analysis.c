@@ -3505,7 +3505,8 @@ static void function_list_print(RzCore *core, RzList /*<RzAnalysisFunction *>*/
 	rz_list_foreach (list, it, fcn) {
 		char *msg = NULL;
 		ut64 realsize = rz_analysis_function_realsize(fcn);
-		ut64 size = rz_analysis_function_linear_size(fcn);
+		// afl runs as a read-only task, concurrently with others
+		ut64 size = rz_analysis_function_linear_size_nocache(fcn);
 		if (realsize == size) {
 			msg = rz_str_newf("%-12" PFMT64u, size);
 		} else {
@@ -5644,7 +5645,7 @@ RZ_IPI RzCmdStatus rz_analyze_opcode_handler(RzCore *core, int argc, const char
 }
 
 RZ_IPI RzCmdStatus rz_display_opcode_handler(RzCore *core, int argc, const char **argv) {
-	sdb_foreach(core->rasm->pair, listOpDescriptions, core);
+	sdb_foreach(rz_asm_get_descriptions(core->rasm), listOpDescriptions, core);
 	return RZ_CMD_STATUS_OK;
 }
 
@@ -436,6 +436,39 @@ RZ_API bool rz_cmd_desc_set_default_mode(RzCmdDesc *cd, RzOutputMode mode) {
 	}
 }
 
+static int cd_modes(const RzCmdDesc *cd) {
+	return has_cd_submodes(cd) ? cd->d.argv_modes_data.modes : RZ_OUTPUT_MODE_STANDARD;
+}
+
+/**
+ * \brief Mark the command descriptor as read-only in the output modes \p modes,
+ * i.e. it does not modify the state of RzCore when called in those modes and
+ * it can run concurrently with other read-only commands.
+ *
+ * Commands without output modes are read-only when \p modes contains
+ * RZ_OUTPUT_MODE_STANDARD. For a group, the command executed by the group is
+ * marked as well.
+ */
+RZ_API void rz_cmd_desc_set_read_only_modes(RZ_NONNULL RzCmdDesc *cd, int modes) {
+	rz_return_if_fail(cd);
+	cd->read_only_modes = modes;
+	RzCmdDesc *exec_cd = rz_cmd_desc_get_exec(cd);
+	if (exec_cd) {
+		exec_cd->read_only_modes = modes;
+	}
+}
+
+/**
+ * \brief Mark the command descriptor as read-only in all its output modes.
+ *
+ * \see rz_cmd_desc_set_read_only_modes
+ */
+RZ_API void rz_cmd_desc_set_read_only(RZ_NONNULL RzCmdDesc *cd, bool read_only) {
+	rz_return_if_fail(cd);
+	RzCmdDesc *exec_cd = rz_cmd_desc_get_exec(cd);
+	rz_cmd_desc_set_read_only_modes(cd, read_only ? cd_modes(exec_cd ? exec_cd : cd) : 0);
+}
+
 RZ_API char **rz_cmd_alias_keys(RzCmd *cmd, int *sz) {
 	if (sz) {
 		*sz = cmd->aliases.count;
@@ -670,6 +703,21 @@ static RzOutputMode cd_suffix2mode(RzCmdDesc *cd, const char *cmdid) {
 	return mode;
 }
 
+/**
+ * \brief Returns true if calling \p cd as \p cmdid does not modify the state
+ * of RzCore, i.e. the output mode selected by the suffix of \p cmdid was
+ * marked as read-only.
+ */
+RZ_API bool rz_cmd_desc_is_read_only(RZ_NONNULL RzCmdDesc *cd, RZ_NONNULL const char *cmdid) {
+	rz_return_val_if_fail(cd && cmdid, false);
+	RzCmdDesc *exec_cd = rz_cmd_desc_get_exec(cd);
+	if (!exec_cd) {
+		return false;
+	}
+	RzOutputMode mode = has_cd_submodes(exec_cd) ? cd_suffix2mode(exec_cd, cmdid) : RZ_OUTPUT_MODE_STANDARD;
+	return exec_cd->read_only_modes & mode;
+}
+
 /**
  * Performs a preprocessing step on the user arguments.
  *
@@ -30,10 +30,11 @@ RZ_IPI RzCmdStatus rz_flirt_scan_handler(RzCore *core, int argc, const char **ar
 	RzListIter *iter = NULL;
 	RzList *files = rz_file_globsearch(argv[1], depth);
 	ut8 arch_id = rz_core_flirt_arch_from_name(arch);
+	size_t threads = rz_config_get_i(core->config, "flirt.threads");
 
 	old = rz_flag_count(core->flags, "flirt");
 	rz_list_foreach (files, iter, file) {
-		rz_sign_flirt_apply(core->analysis, file, arch_id);
+		rz_sign_flirt_apply(core->analysis, file, arch_id, threads);
 	}
 	rz_list_free(files);
 	new = rz_flag_count(core->flags, "flirt");
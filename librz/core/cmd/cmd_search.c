@@ -327,67 +327,443 @@ RZ_API int rz_core_search_prelude(RzCore *core, ut64 from, ut64 to, const ut8 *b
 	return preludecnt;
 }
 
-RZ_API int rz_core_search_preludes(RzCore *core, bool log) {
-	int ret = -1;
-	ut64 from = UT64_MAX;
-	ut64 to = UT64_MAX;
-	int keyword_length = 0;
-	ut8 *keyword = NULL;
-	const char *prelude = rz_config_get(core->config, "analysis.prelude");
-	const char *where = rz_config_get(core->config, "analysis.in");
-	ut64 limit = rz_config_get_i(core->config, "analysis.prelude.limit");
+#define SEARCH_CHUNK_SIZE 0x100000
+
+typedef struct search_raw_hit_t {
+	ut64 addr;
+	int kw; ///< index of the keyword in the search
+} SearchRawHit;
+
+typedef struct search_chunk_t {
+	ut64 from; ///< first address owned by the chunk
+	ut64 to; ///< end of the owned region, hits must start before it
+	ut64 end; ///< end of the readable region (includes the overlap with the next chunk)
+	RzVector /*<SearchRawHit>*/ hits;
+	bool done; ///< set once the chunk is scanned
+} SearchChunk;
+
+typedef struct search_shared_t {
+	RzIO *io;
+	RzThreadLock *lock; ///< guards io and all the fields below
+	RzThreadCond *cond; ///< signaled when a chunk is scanned or a worker exits
+	SearchChunk *chunks;
+	size_t n_chunks;
+	size_t next; ///< index of the next chunk to scan
+	size_t running; ///< number of workers still running
+	const RzSearch *search;
+	bool stop;
+} SearchShared;
+
+static int search_worker_hit(RzSearchKeyword *kw, void *user, ut64 addr) {
+	SearchChunk *chunk = (SearchChunk *)user;
+	if (addr < chunk->to) {
+		SearchRawHit hit = { addr, kw->kwidx };
+		rz_vector_push(&chunk->hits, &hit);
+	}
+	return 1;
+}
 
-	RzList *list = rz_core_get_boundaries_prot(core, RZ_PERM_X, where, "search");
-	RzList *arch_preludes = NULL;
-	RzListIter *iter = NULL, *iter2 = NULL;
-	RzIOMap *p = NULL;
-	RzSearchKeyword *kw = NULL;
+/**
+ * Clones the keywords and matching options of \p tpl. The clone reports every
+ * match (overlapping and contiguous ones too): the filtering honoring the
+ * options of \p tpl happens when the hits are replayed in address order.
+ */
+static RzSearch *search_worker_search_new(const RzSearch *tpl) {
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	RzSearch *search = rz_search_new(tpl->mode);
+	if (!search) {
+		return NULL;
+	}
+	rz_list_foreach (tpl->kws, iter, kw) {
+		RzSearchKeyword *copy = rz_search_keyword_new(kw->bin_keyword, kw->keyword_length, kw->bin_binmask, kw->binmask_length, NULL);
+		if (!copy) {
+			rz_search_free(search);
+			return NULL;
+		}
+		copy->icase = kw->icase;
+		copy->type = kw->type;
+		rz_search_kw_add(search, copy);
+	}
+	search->distance = tpl->distance;
+	search->overlap = true;
+	search->contiguous = true;
+	return search;
+}
 
-	if (!list) {
-		return -1;
+static void *search_worker_run(SearchShared *shared) {
+	ut8 *buf = NULL;
+	size_t bufsz = 0;
+
+	RzSearch *search = search_worker_search_new(shared->search);
+	if (!search) {
+		RZ_LOG_ERROR("core: cannot allocate search worker\n");
+		goto end;
 	}
+	while (true) {
+		rz_th_lock_enter(shared->lock);
+		if (shared->stop || shared->next >= shared->n_chunks) {
+			rz_th_lock_leave(shared->lock);
+			break;
+		}
+		SearchChunk *chunk = &shared->chunks[shared->next++];
+		rz_th_lock_leave(shared->lock);
 
-	if (RZ_STR_ISNOTEMPTY(prelude)) {
-		keyword = malloc(strlen(prelude) + 1);
-		if (!keyword) {
-			RZ_LOG_ERROR("aap: cannot allocate 'analysis.prelude' buffer\n");
-			rz_list_free(list);
-			return -1;
+		size_t size = chunk->end - chunk->from;
+		if (size > bufsz) {
+			ut8 *tmp = realloc(buf, size);
+			if (!tmp) {
+				RZ_LOG_ERROR("core: cannot allocate search buffer\n");
+				break;
+			}
+			buf = tmp;
+			bufsz = size;
 		}
-		keyword_length = rz_hex_str2bin(prelude, keyword);
-	} else {
-		arch_preludes = rz_analysis_preludes(core->analysis);
-		if (!arch_preludes) {
-			rz_list_free(list);
-			return -1;
+
+		rz_th_lock_enter(shared->lock);
+		(void)rz_io_read_at(shared->io, chunk->from, buf, size);
+		rz_th_lock_leave(shared->lock);
+
+		rz_search_set_callback(search, &search_worker_hit, chunk);
+		rz_search_begin(search);
+		rz_search_update(search, chunk->from, buf, size);
+
+		rz_th_lock_enter(shared->lock);
+		chunk->done = true;
+		rz_th_cond_signal_all(shared->cond);
+		rz_th_lock_leave(shared->lock);
+	}
+
+end:
+	rz_th_lock_enter(shared->lock);
+	shared->running--;
+	rz_th_cond_signal_all(shared->cond);
+	rz_th_lock_leave(shared->lock);
+	rz_search_free(search);
+	free(buf);
+	return NULL;
+}
+
+static int search_raw_hit_cmp(const void *a, const void *b) {
+	const SearchRawHit *x = a, *y = b;
+	if (x->addr != y->addr) {
+		return x->addr < y->addr ? -1 : 1;
+	}
+	return x->kw - y->kw;
+}
+
+static ut32 search_longest_keyword(const RzList /*<RzSearchKeyword *>*/ *keywords) {
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	ut32 longest = 0;
+	rz_list_foreach (keywords, iter, kw) {
+		longest = RZ_MAX(longest, kw->keyword_length);
+	}
+	return longest;
+}
+
+/**
+ * Splits [\p from, \p to) in chunks of \p chunk_size bytes overlapping by
+ * \p longest - 1, so that no hit is lost at the chunk boundaries, and
+ * appends them to \p chunks.
+ */
+static bool search_chunks_push(RzVector /*<SearchChunk>*/ *chunks, ut64 from, ut64 to, ut64 chunk_size, ut32 longest) {
+	for (ut64 at = from; at < to; at += chunk_size) {
+		SearchChunk *chunk = rz_vector_push(chunks, NULL);
+		if (!chunk) {
+			return false;
 		}
+		chunk->from = at;
+		chunk->to = RZ_MIN(to, at + chunk_size);
+		chunk->end = RZ_MIN(to, chunk->to + (longest ? longest - 1 : 0));
+		chunk->done = false;
+		rz_vector_init(&chunk->hits, sizeof(SearchRawHit), NULL, NULL);
+		if (chunk->to == to) {
+			break;
+		}
+	}
+	return true;
+}
+
+static void search_chunks_free(RzVector /*<SearchChunk>*/ *chunks) {
+	if (!chunks) {
+		return;
+	}
+	SearchChunk *chunk;
+	rz_vector_foreach(chunks, chunk) {
+		rz_vector_fini(&chunk->hits);
+	}
+	rz_vector_free(chunks);
+}
+
+/**
+ * \brief Starts the workers scanning the chunks of \p shared on \p pool
+ *
+ * \return false if the shared context could not be allocated
+ */
+static bool search_workers_start(SearchShared *shared, RzVector /*<SearchChunk>*/ *chunks, RzThreadPool *pool) {
+	shared->chunks = rz_vector_index_ptr(chunks, 0);
+	shared->n_chunks = rz_vector_len(chunks);
+	shared->lock = rz_th_lock_new(false);
+	shared->cond = rz_th_cond_new();
+	if (!shared->lock || !shared->cond) {
+		return false;
+	}
+	size_t started = 0;
+	shared->running = rz_th_pool_size(pool);
+	RZ_LOG_VERBOSE("core: using %u search threads\n", (ut32)shared->running);
+	for (; started < rz_th_pool_size(pool); started++) {
+		// the pool has room for all of them, so adding cannot fail
+		RzThread *th = rz_th_new((RzThreadFunction)search_worker_run, shared);
+		if (!th) {
+			RZ_LOG_ERROR("core: cannot start search worker thread\n");
+			break;
+		}
+		rz_th_pool_add_thread(pool, th);
+	}
+	rz_th_lock_enter(shared->lock);
+	shared->running -= rz_th_pool_size(pool) - started;
+	rz_th_lock_leave(shared->lock);
+	return true;
+}
+
+/**
+ * \brief Waits for \p chunk to be scanned, must be called with shared->lock held
+ *
+ * \return false if all the workers stopped before scanning \p chunk
+ */
+static bool search_chunk_wait(SearchShared *shared, SearchChunk *chunk) {
+	while (!chunk->done && shared->running) {
+		rz_th_cond_wait(shared->cond, shared->lock);
+	}
+	return chunk->done;
+}
+
+/**
+ * \brief Stops the workers and frees the shared context and \p chunks
+ */
+static void search_workers_fini(SearchShared *shared, RzVector /*<SearchChunk>*/ *chunks, RzThreadPool *pool) {
+	if (shared->lock) {
+		rz_th_lock_enter(shared->lock);
+		shared->stop = true;
+		rz_th_lock_leave(shared->lock);
+	}
+	if (pool) {
+		rz_th_pool_wait(pool);
+		rz_th_pool_free(pool);
+	}
+	search_chunks_free(chunks);
+	rz_th_cond_free(shared->cond);
+	rz_th_lock_free(shared->lock);
+}
+
+#define PRELUDE_CHUNK_SIZE 0x40000
+
+static RzSearch *prelude_search_new(const RzList /*<RzSearchKeyword *>*/ *keywords) {
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	RzSearch *search = rz_search_new(RZ_SEARCH_KEYWORD);
+	if (!search) {
+		return NULL;
+	}
+	rz_list_foreach (keywords, iter, kw) {
+		RzSearchKeyword *copy = rz_search_keyword_new(kw->bin_keyword, kw->keyword_length, kw->bin_binmask, kw->binmask_length, NULL);
+		if (!copy || !rz_search_kw_add(search, copy)) {
+			rz_search_keyword_free(copy);
+			rz_search_free(search);
+			return NULL;
+		}
+	}
+	return search;
+}
+
+/**
+ * Returns the end of the part of [\p from, \p to) scanned by the sequential
+ * search, which stops at the first block not starting at a valid offset.
+ */
+static ut64 prelude_range_end(RzCore *core, ut64 from, ut64 to) {
+	for (ut64 at = from; at < to; at += core->blocksize) {
+		if (!rz_io_is_valid_offset(core->io, at, 0)) {
+			return at;
+		}
+		if (to - at <= core->blocksize) {
+			break;
+		}
+	}
+	return to;
+}
+
+/**
+ * Splits the executable ranges in chunks to be scanned by the search workers.
+ */
+static RzVector /*<SearchChunk>*/ *prelude_chunks_new(RzCore *core, const RzList /*<RzIOMap *>*/ *ranges, const RzList /*<RzSearchKeyword *>*/ *keywords, ut64 limit) {
+	RzListIter *iter;
+	RzIOMap *map;
+
+	ut32 longest = search_longest_keyword(keywords);
+	RzVector *chunks = rz_vector_new(sizeof(SearchChunk), NULL, NULL);
+	if (!chunks || !longest) {
+		return chunks;
 	}
 
-	rz_list_foreach (list, iter, p) {
-		if (!(p->perm & RZ_PERM_X)) {
+	rz_list_foreach (ranges, iter, map) {
+		if (!(map->perm & RZ_PERM_X)) {
 			continue;
 		}
-		from = p->itv.addr;
-		to = rz_itv_end(p->itv);
+		ut64 from = map->itv.addr;
+		ut64 to = rz_itv_end(map->itv);
 		if ((to - from) >= limit) {
 			RZ_LOG_WARN("aap: search interval (from 0x%" PFMT64x
 				    " to 0x%" PFMT64x ") exeeds analysis.prelude.limit (0x%" PFMT64x "), skipping it.\n",
 				from, to, limit);
 			continue;
 		}
-		if (keyword && keyword_length > 0) {
-			ret = rz_core_search_prelude(core, from, to, keyword, keyword_length, NULL, 0);
-		} else {
-			rz_list_foreach (arch_preludes, iter2, kw) {
-				ret = rz_core_search_prelude(core, from, to,
-					kw->bin_keyword, kw->keyword_length,
-					kw->bin_binmask, kw->binmask_length);
-			}
+		to = prelude_range_end(core, from, to);
+		if (!search_chunks_push(chunks, from, to, PRELUDE_CHUNK_SIZE, longest)) {
+			RZ_LOG_ERROR("aap: cannot allocate prelude chunk\n");
+			search_chunks_free(chunks);
+			return NULL;
+		}
+	}
+	return chunks;
+}
+
+/**
+ * \brief Analyzes the functions starting at the hits of \p chunk, in address order
+ *
+ * \return The number of functions analyzed
+ */
+static int prelude_chunk_analyze(RzCore *core, SearchShared *shared, SearchChunk *chunk, int depth) {
+	int align = core->search->align;
+	int count = 0;
+	rz_vector_sort(&chunk->hits, search_raw_hit_cmp, false);
+	for (size_t i = 0; i < rz_vector_len(&chunk->hits); i++) {
+		SearchRawHit *hit = rz_vector_index_ptr(&chunk->hits, i);
+		// skip the duplicates, found when multiple preludes match at the same address
+		if (i > 0 && ((SearchRawHit *)rz_vector_index_ptr(&chunk->hits, i - 1))->addr == hit->addr) {
+			continue;
+		}
+		if (align && hit->addr % align) {
+			continue;
+		}
+		if (rz_cons_is_breaked()) {
+			break;
+		}
+		// the analysis reads through the io, which the workers use as well
+		rz_th_lock_enter(shared->lock);
+		rz_core_analysis_fcn(core, hit->addr, -1, RZ_ANALYSIS_XREF_TYPE_NULL, depth);
+		rz_th_lock_leave(shared->lock);
+		count++;
+	}
+	rz_vector_fini(&chunk->hits);
+	return count;
+}
+
+/**
+ * \brief Scans the ranges for the given preludes and analyzes the functions found
+ *
+ * The chunks are scanned by search.threads search workers, while the calling
+ * thread analyzes the functions of each chunk in address order as soon as it
+ * is scanned.
+ *
+ * \return The number of functions analyzed or -1 on failure
+ */
+static int prelude_scan_analyze(RzCore *core, const RzList /*<RzIOMap *>*/ *ranges, const RzList /*<RzSearchKeyword *>*/ *keywords, ut64 limit, int depth) {
+	SearchShared shared = { 0 };
+	RzThreadPool *pool = NULL;
+	RzSearch *search = NULL;
+	int ret = -1;
+
+	RzVector *chunks = prelude_chunks_new(core, ranges, keywords, limit);
+	if (!chunks) {
+		return -1;
+	}
+	if (rz_vector_empty(chunks)) {
+		rz_vector_free(chunks);
+		return 0;
+	}
+
+	search = prelude_search_new(keywords);
+	pool = rz_th_pool_new(rz_config_get_i(core->config, "search.threads"));
+	shared.io = core->io;
+	shared.search = search;
+	if (!search || !pool || !search_workers_start(&shared, chunks, pool)) {
+		RZ_LOG_ERROR("aap: cannot allocate prelude scan context\n");
+		goto end;
+	}
+
+	ret = 0;
+	for (size_t i = 0; i < shared.n_chunks && !rz_cons_is_breaked(); i++) {
+		SearchChunk *chunk = &shared.chunks[i];
+		rz_th_lock_enter(shared.lock);
+		bool done = search_chunk_wait(&shared, chunk);
+		rz_th_lock_leave(shared.lock);
+		if (!done) {
+			RZ_LOG_ERROR("aap: prelude workers stopped before the end of the ranges\n");
+			ret = -1;
+			break;
+		}
+		ret += prelude_chunk_analyze(core, &shared, chunk, depth);
+	}
+
+end:
+	search_workers_fini(&shared, chunks, pool);
+	rz_search_free(search);
+	return ret;
+}
+
+/**
+ * \brief Finds all the function preludes in the executable ranges and analyzes them ("aap").
+ *
+ * The discovery of the preludes is performed by search.threads workers over
+ * chunks of the executable ranges, while the functions are recovered in
+ * address order on the calling thread, since the analysis state is not
+ * thread-safe. As in a
+ * sequential search, the hits honor search.align and each range is scanned
+ * up to its first block not starting at a valid offset.
+ *
+ * \param core The RzCore to use
+ * \param log Unused
+ * \return The number of functions analyzed or -1 on failure
+ */
+RZ_API int rz_core_search_preludes(RzCore *core, bool log) {
+	rz_return_val_if_fail(core, -1);
+	const char *prelude = rz_config_get(core->config, "analysis.prelude");
+	const char *where = rz_config_get(core->config, "analysis.in");
+	ut64 limit = rz_config_get_i(core->config, "analysis.prelude.limit");
+	int depth = rz_config_get_i(core->config, "analysis.depth");
+	RzList *keywords = NULL;
+	int ret = -1;
+
+	RzList *list = rz_core_get_boundaries_prot(core, RZ_PERM_X, where, "search");
+	if (!list) {
+		return -1;
+	}
+
+	if (RZ_STR_ISNOTEMPTY(prelude)) {
+		ut8 *keyword = malloc(strlen(prelude) + 1);
+		if (!keyword) {
+			RZ_LOG_ERROR("aap: cannot allocate 'analysis.prelude' buffer\n");
+			goto end;
+		}
+		int keyword_length = rz_hex_str2bin(prelude, keyword);
+		keywords = rz_list_newf((RzListFree)rz_search_keyword_free);
+		if (keywords && keyword_length > 0) {
+			rz_list_append(keywords, rz_search_keyword_new(keyword, keyword_length, NULL, 0, NULL));
 		}
+		free(keyword);
+	} else {
+		keywords = rz_analysis_preludes(core->analysis);
+	}
+	if (!keywords) {
+		goto end;
 	}
-	free(keyword);
+
+	ret = prelude_scan_analyze(core, list, keywords, limit, depth);
+
+end:
+	rz_list_free(keywords);
 	rz_list_free(list);
-	rz_list_free(arch_preludes);
 	return ret;
 }
 
@@ -2308,6 +2684,90 @@ static void do_asm_search(RzCore *core, struct search_parameters *param, const c
 	rz_cons_break_pop();
 }
 
+static bool search_can_run_parallel(RzCore *core, struct search_parameters *param, ut64 size) {
+	const RzSearch *search = core->search;
+	if (rz_config_get_i(core->config, "search.threads") == 1 || size < 2 * SEARCH_CHUNK_SIZE) {
+		return false;
+	}
+	return (search->mode == RZ_SEARCH_KEYWORD || search->mode == RZ_SEARCH_MULTIKEY) &&
+		!search->bckwrds && !search->inverse && !param->aes_search && !param->privkey_search;
+}
+
+/**
+ * \brief Forward keyword search of [\p from, \p to) on a thread pool
+ *
+ * The range is split in chunks overlapping by the longest keyword length - 1,
+ * which are scanned concurrently. As soon as a chunk is scanned, the calling
+ * thread reports its hits through core->search in address order, so the hit
+ * callback and the overlap, contiguous, align and maxhits options behave as
+ * in a sequential search. The workers stop taking chunks once the replay
+ * stops, e.g. because search.maxhits is reached.
+ *
+ * \return false if the search must stop, i.e. maxhits was reached or the hit callback failed
+ */
+static bool search_keywords_parallel(RzCore *core, ut64 from, ut64 to) {
+	RzSearch *search = core->search;
+	SearchShared shared = { 0 };
+	RzThreadPool *pool = NULL;
+	RzPVector kws;
+	bool ret = true;
+
+	rz_pvector_init(&kws, NULL);
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	rz_list_foreach (search->kws, iter, kw) {
+		rz_pvector_push(&kws, kw);
+	}
+
+	RzVector *chunks = rz_vector_new(sizeof(SearchChunk), NULL, NULL);
+	if (chunks && !search_chunks_push(chunks, from, to, SEARCH_CHUNK_SIZE, search_longest_keyword(search->kws))) {
+		search_chunks_free(chunks);
+		chunks = NULL;
+	}
+	pool = rz_th_pool_new(rz_config_get_i(core->config, "search.threads"));
+	shared.io = core->io;
+	shared.search = search;
+	if (!chunks || !pool || !search_workers_start(&shared, chunks, pool)) {
+		RZ_LOG_ERROR("core: cannot allocate search context\n");
+		goto end;
+	}
+
+	// chunks are replayed in order as they are scanned, the lock also serializes
+	// the io accesses of the hit callback with the ones of the workers
+	rz_th_lock_enter(shared.lock);
+	for (size_t i = 0; ret && i < shared.n_chunks; i++) {
+		SearchChunk *chunk = &shared.chunks[i];
+		if (!search_chunk_wait(&shared, chunk)) {
+			RZ_LOG_ERROR("core: search workers stopped before the end of the range\n");
+			ret = false;
+			break;
+		}
+		if (rz_cons_is_breaked()) {
+			break;
+		}
+		rz_vector_sort(&chunk->hits, search_raw_hit_cmp, false);
+		SearchRawHit *hit;
+		rz_vector_foreach(&chunk->hits, hit) {
+			kw = rz_pvector_at(&kws, hit->kw);
+			if (!search->overlap && kw->count && hit->addr < kw->last) {
+				continue;
+			}
+			int t = rz_search_hit_new(search, kw, hit->addr);
+			if (t != 1) {
+				ret = false;
+				break;
+			}
+		}
+		rz_vector_fini(&chunk->hits);
+	}
+	rz_th_lock_leave(shared.lock);
+
+end:
+	search_workers_fini(&shared, chunks, pool);
+	rz_pvector_fini(&kws);
+	return ret;
+}
+
 static void do_string_search(RzCore *core, RzInterval search_itv, struct search_parameters *param) {
 	ut64 at;
 	ut8 *buf;
@@ -2369,7 +2829,11 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 				   from1 = search->bckwrds ? to : from,
 				   to1 = search->bckwrds ? from : to;
 			ut64 len;
-			for (at = from1; at != to1; at = search->bckwrds ? at - len : at + len) {
+			const bool parallel = search_can_run_parallel(core, param, to - from);
+			if (parallel && !search_keywords_parallel(core, from, to)) {
+				goto done;
+			}
+			for (at = parallel ? to1 : from1; at != to1; at = search->bckwrds ? at - len : at + len) {
 				print_search_progress(at, to1, search->nhits, param);
 				if (rz_cons_is_breaked()) {
 					eprintf("\n\n");
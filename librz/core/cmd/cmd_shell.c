@@ -598,6 +598,11 @@ RZ_IPI RzCmdStatus rz_print_init_time_values_handler(RzCore *core, int argc, con
 		core->times->loadlibs_init_time,
 		core->times->loadlibs_time,
 		core->times->file_open_time);
+	for (size_t i = 0; i < core->times->init_stages_count; i++) {
+		const RzCoreInitStage *stage = &core->times->init_stages[i];
+		rz_cons_printf("init.%s = %" PFMT64d "\n", stage->name, stage->time);
+	}
+	rz_cons_printf("init = %" PFMT64d "\n", core->times->init_time);
 	return RZ_CMD_STATUS_OK;
 }
 
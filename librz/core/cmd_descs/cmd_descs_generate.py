@@ -135,6 +135,10 @@ DEFINE_FAKE_TEMPLATE = """
 
 SET_DEFAULT_MODE_TEMPLATE = """
 \trz_cmd_desc_set_default_mode({cname}_cd, {default_mode});"""
+SET_READ_ONLY_TEMPLATE = """
+\trz_cmd_desc_set_read_only({cname}_cd, true);"""
+SET_READ_ONLY_MODES_TEMPLATE = """
+\trz_cmd_desc_set_read_only_modes({cname}_cd, {modes});"""
 
 
 def _escape(s):
@@ -395,6 +399,7 @@ class CmdDesc:
         self.modes = c.pop("modes", None)
         self.handler = c.pop("handler", None)
         self.default_mode = c.pop("default_mode", None)
+        self.read_only = c.pop("read_only", False)
         # RzCmdDescHelp fields
         self.summary = strip(c.pop("summary"))
         self.description = strip(c.pop("description", None))
@@ -604,6 +609,15 @@ class CmdDesc:
         return self.str_tab()
 
 
+def set_read_only(cname, read_only):
+    # read_only is either true or the list of the read-only output modes
+    if isinstance(read_only, list):
+        return SET_READ_ONLY_MODES_TEMPLATE.format(
+            cname=cname, modes=" | ".join(read_only)
+        )
+    return SET_READ_ONLY_TEMPLATE.format(cname=cname) if read_only else ""
+
+
 def createcd_typegroup(cd):
     if cd.exec_cd and cd.exec_cd.type == CD_TYPE_ARGV_MODES:
         formatted_string = DEFINE_GROUP_MODES_TEMPLATE.format(
@@ -620,6 +634,7 @@ def createcd_typegroup(cd):
                 cname=cd.cname,
                 default_mode=cd.exec_cd.default_mode,
             )
+        formatted_string += set_read_only(cd.cname, cd.exec_cd.read_only)
         formatted_string += "\n".join(
             [createcd(child) for child in cd.subcommands[1:] or []]
         )
@@ -638,6 +653,7 @@ def createcd_typegroup(cd):
                 cname=cd.cname,
                 default_mode=cd.exec_cd.default_mode,
             )
+        formatted_string += set_read_only(cd.cname, cd.exec_cd.read_only)
         formatted_string += "\n".join(
             [createcd(child) for child in cd.subcommands[1:] or []]
         )
@@ -650,6 +666,9 @@ def createcd_typegroup(cd):
             help_cname_ref=(cd.exec_cd and "&" + cd.exec_cd.get_help_cname()) or "NULL",
             group_help_cname=cd.get_help_cname(),
         )
+        formatted_string += set_read_only(
+            cd.cname, cd.exec_cd is not None and cd.exec_cd.read_only
+        )
         subcommands = (
             cd.exec_cd and cd.subcommands and cd.subcommands[1:]
         ) or cd.subcommands
@@ -669,6 +688,7 @@ def createcd(cd):
             handler_cname=cd.get_handler_cname(),
             help_cname=cd.get_help_cname(),
         )
+        formatted_string += set_read_only(cd.cname, cd.read_only)
     elif cd.type == CD_TYPE_ARGV_MODES:
         formatted_string = DEFINE_ARGV_MODES_TEMPLATE.format(
             cname=cd.cname,
@@ -683,6 +703,7 @@ def createcd(cd):
                 cname=cd.cname,
                 default_mode=cd.default_mode,
             )
+        formatted_string += set_read_only(cd.cname, cd.read_only)
     elif cd.type == CD_TYPE_ARGV_STATE:
         formatted_string = DEFINE_ARGV_STATE_TEMPLATE.format(
             cname=cd.cname,
@@ -697,6 +718,7 @@ def createcd(cd):
                 cname=cd.cname,
                 default_mode=cd.default_mode,
             )
+        formatted_string += set_read_only(cd.cname, cd.read_only)
     elif cd.type == CD_TYPE_FAKE:
         formatted_string = DEFINE_FAKE_TEMPLATE.format(
             cname=cd.cname,
@@ -2328,7 +2328,33 @@ RZ_IPI void rz_core_file_free(RzCoreFile *cf);
 
 RZ_IPI extern RzIOPlugin rz_core_io_plugin_vfile;
 
+/**
+ * Records the time spent since \p start in the rz_core_init() stage \p name
+ * and returns the start of the next stage.
+ */
+static ut64 init_stage_end(RzCore *core, const char *name, ut64 start) {
+	ut64 now = rz_time_now_mono();
+	RzCoreTimes *times = core->times;
+	if (times && times->init_stages_count < RZ_ARRAY_SIZE(times->init_stages)) {
+		RzCoreInitStage *stage = &times->init_stages[times->init_stages_count++];
+		stage->name = name;
+		stage->time = now - start;
+	}
+	return now;
+}
+
+static void init_stages_print(RzCore *core) {
+	RzCoreTimes *times = core->times;
+	for (size_t i = 0; i < times->init_stages_count; i++) {
+		eprintf("init.%s = %" PFMT64d "\n", times->init_stages[i].name, times->init_stages[i].time);
+	}
+	eprintf("init = %" PFMT64d "\n", times->init_time);
+}
+
 RZ_API bool rz_core_init(RzCore *core) {
+	ut64 init_start = rz_time_now_mono();
+	ut64 stage = init_start;
+	core->times = RZ_NEW0(RzCoreTimes);
 	core->blocksize = RZ_CORE_BLOCKSIZE;
 	core->block = (ut8 *)calloc(RZ_CORE_BLOCKSIZE + 1, 1);
 	if (!core->block) {
@@ -2377,7 +2403,6 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->watchers->free = (RzListFree)rz_core_cmpwatch_free;
 	core->scriptstack = rz_list_new();
 	core->scriptstack->free = (RzListFree)free;
-	core->times = RZ_NEW0(RzCoreTimes);
 	core->vmode = false;
 	core->lastcmd = NULL;
 	core->cmdlog = NULL;
@@ -2392,6 +2417,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 
 	core->fixedarch = false;
 	core->fixedbits = false;
+	stage = init_stage_end(core, "base", stage);
 
 	/* initialize libraries */
 	core->cons = rz_cons_new();
@@ -2415,6 +2441,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 	}
 	core->print->cons = core->cons;
 	rz_cons_bind(&core->print->consbind);
+	stage = init_stage_end(core, "cons", stage);
 
 	// We save the old num ad user, in order to restore it after free
 	core->lang = rz_lang_new();
@@ -2424,9 +2451,11 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->lang->cb_printf = rz_cons_printf;
 	rz_lang_define(core->lang, "RzCore", "core", core);
 	rz_lang_set_user_ptr(core->lang, core);
+	stage = init_stage_end(core, "lang", stage);
 	core->rasm = rz_asm_new();
 	core->rasm->num = core->num;
 	core->rasm->core = core;
+	stage = init_stage_end(core, "asm", stage);
 	core->analysis = rz_analysis_new();
 	core->gadgets = rz_list_newf((RzListFree)rz_core_gadget_free);
 	core->analysis->ev = core->ev;
@@ -2442,18 +2471,21 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->parser->var_expr_for_reg_access = rz_analysis_function_var_expr_for_reg_access_at;
 	/// XXX shouhld be using coreb
 	rz_parse_set_user_ptr(core->parser, core);
+	stage = init_stage_end(core, "analysis", stage);
 	core->bin = rz_bin_new();
 	rz_event_hook(core->bin->event, RZ_EVENT_BIN_FILE_DEL, ev_binfiledel_cb, core);
 	rz_cons_bind(&core->bin->consb);
 	// XXX we shuold use RzConsBind instead of this hardcoded pointer
 	core->bin->cb_printf = (PrintfCallback)rz_cons_printf;
 	rz_bin_set_user_ptr(core->bin, core);
+	stage = init_stage_end(core, "bin", stage);
 	core->io = rz_io_new();
 	rz_io_plugin_add(core->io, &rz_core_io_plugin_vfile);
 	rz_event_hook(core->io->event, RZ_EVENT_IO_WRITE, ev_iowrite_cb, core);
 	rz_event_hook(core->io->event, RZ_EVENT_IO_DESC_CLOSE, ev_iodescclose_cb, core);
 	rz_event_hook(core->io->event, RZ_EVENT_IO_MAP_DEL, ev_iomapdel_cb, core);
 	core->io->ff = 1;
+	stage = init_stage_end(core, "io", stage);
 	core->search = rz_search_new(RZ_SEARCH_KEYWORD);
 	core->flags = rz_flag_new();
 	core->graph = rz_agraph_new(rz_cons_canvas_new(1, 1));
@@ -2466,6 +2498,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 		core->asmqjmps = RZ_NEWS(ut64, core->asmqjmps_size);
 	}
 	core->hash = rz_hash_new();
+	stage = init_stage_end(core, "search/flags/hash", stage);
 
 	rz_bin_bind(core->bin, &(core->rasm->binb));
 	rz_bin_bind(core->bin, &(core->analysis->binb));
@@ -2490,8 +2523,11 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->files = rz_list_newf((RzListFree)rz_core_file_free);
 	core->offset = 0LL;
 	core->prompt_offset = 0LL;
+	stage = init_stage_end(core, "bind", stage);
 	rz_core_cmd_init(core);
+	stage = init_stage_end(core, "cmd", stage);
 	rz_core_plugin_init(core);
+	stage = init_stage_end(core, "core plugins", stage);
 
 	RzBreakpointContext bp_ctx = {
 		.user = core,
@@ -2516,10 +2552,13 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->dbg->ev = core->ev;
 	// Initialize visual modes after everything else but before config init
 	core->visual = rz_core_visual_new();
+	stage = init_stage_end(core, "debug", stage);
 	// initialize config before any corebind
 	rz_core_config_init(core);
+	stage = init_stage_end(core, "config", stage);
 
 	rz_core_loadlibs_init(core);
+	stage = init_stage_end(core, "lib", stage);
 
 	// TODO: get arch from rz_bin or from native arch
 	rz_asm_use(core->rasm, RZ_SYS_ARCH);
@@ -2533,6 +2572,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 	}
 	rz_config_set(core->config, "asm.arch", RZ_SYS_ARCH);
 	rz_bp_use(core->dbg->bp, RZ_SYS_ARCH);
+	stage = init_stage_end(core, "arch", stage);
 	update_sdb(core);
 	{
 		char *a = rz_path_system(RZ_FLAGS);
@@ -2543,8 +2583,17 @@ RZ_API bool rz_core_init(RzCore *core) {
 			free(a);
 		}
 	}
+	stage = init_stage_end(core, "tags", stage);
 	rz_core_analysis_type_init(core);
+	stage = init_stage_end(core, "types", stage);
 	__init_autocomplete(core);
+	stage = init_stage_end(core, "autocomplete", stage);
+	if (core->times) {
+		core->times->init_time = stage - init_start;
+		if (rz_sys_getenv_asbool("RZ_INITTIME")) {
+			init_stages_print(core);
+		}
+	}
 	return 0;
 }
 
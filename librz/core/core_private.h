@@ -224,6 +224,7 @@ RZ_IPI void rz_heap_list_w32(RzCore *core, RzOutputMode mode);
 #endif
 
 RZ_IPI bool rz_core_cmd_lastcmd_repeat(RzCore *core, bool next);
+RZ_IPI RzCmdStatus rz_core_cmd_read_only(RzCore *core, const char *cmd);
 
 static inline RzCmdStatus bool2status(bool val) {
 	return val ? RZ_CMD_STATUS_OK : RZ_CMD_STATUS_ERROR;
@@ -39,8 +39,15 @@ RZ_API RzProjectErr rz_project_save(RzCore *core, RzProject *prj, const char *fi
 	return RZ_PROJECT_ERR_SUCCESS;
 }
 
+/**
+ * \param compress whether to deflate the resulting file
+ *
+ * When prj.binary is set, the project is saved in the binary format, which
+ * only rewrites the changed parts of an existing uncompressed project.
+ */
 RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool compress) {
 	char *tmp_file = NULL;
+	bool binary = rz_config_get_b(core->config, "prj.binary");
 
 	if (compress) {
 		int mkstemp_fd = rz_file_mkstemp("svprj", &tmp_file);
@@ -62,7 +69,7 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 		sdb_free(prj);
 		return err;
 	}
-	if (!sdb_text_save(prj, save_file, true)) {
+	if (binary ? !rz_project_binary_save(prj, save_file) : !sdb_text_save(prj, save_file, true)) {
 		err = RZ_PROJECT_ERR_FILE;
 	}
 	sdb_free(prj);
@@ -115,7 +122,7 @@ RZ_API RzProject *rz_project_load_file_raw(const char *file) {
 		load_file = file;
 	}
 
-	if (!sdb_text_load(prj, load_file)) {
+	if (rz_project_is_binary_file(load_file) ? !rz_project_binary_load(prj, load_file) : !sdb_text_load(prj, load_file)) {
 		sdb_free(prj);
 		prj = NULL;
 	}
@@ -0,0 +1,439 @@
+// SPDX-FileCopyrightText: 2026 Rizin Organization
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "sdb.h"
+#include <rz_project.h>
+
+/**
+ * \file
+ * Binary container for the project database.
+ *
+ * It holds exactly the same Sdb tree as the text format, so project versions and
+ * migrations are independent of the container in use. Every namespace of the tree
+ * is stored as its own section and located through an index at the end of the file:
+ *
+ *   header:  magic[8] "RZPRJBIN", ut32 format, ut32 n_sections, ut64 index offset, ut64 index size
+ *   section: n records of (ut32 key len, key, '\0', ut32 value len, value, '\0')
+ *   index:   n entries of (ut32 parent, ut32 name len, name, ut64 offset, ut64 size, ut64 hash, ut32 n records)
+ *
+ * All integers are little endian. The sections are listed in pre-order, so the parent
+ * of a section always comes before it and the first one is the root namespace.
+ *
+ * Saving over an existing binary project only appends the sections whose contents
+ * changed, followed by a new index. The header is written last, so an interrupted
+ * save leaves the previous state intact. Once the stale data outweighs the live one,
+ * the file is rewritten from scratch into a temporary file, which then replaces it.
+ */
+
+#define PRJ_BIN_MAGIC       "RZPRJBIN"
+#define PRJ_BIN_MAGIC_SIZE  8
+#define PRJ_BIN_FORMAT      1
+#define PRJ_BIN_HEADER_SIZE 32
+#define PRJ_BIN_ROOT        UT32_MAX
+
+typedef struct {
+	ut32 parent;
+	char *name;
+	char *path; ///< full path of the namespace, to match the sections of a previous save
+	ut64 offset;
+	ut64 size;
+	ut64 hash;
+	ut32 n_records;
+	Sdb *db; ///< only while saving
+} PrjBinSection;
+
+typedef struct {
+	ut64 index_offset;
+	ut64 index_size;
+	ut32 n_sections;
+} PrjBinHeader;
+
+static void section_fini(void *e, void *user) {
+	PrjBinSection *s = e;
+	free(s->name);
+	free(s->path);
+}
+
+static char *section_path(RzVector *sections, ut32 parent, const char *name) {
+	if (parent == PRJ_BIN_ROOT) {
+		return strdup("");
+	}
+	const PrjBinSection *p = rz_vector_index_ptr(sections, parent);
+	return p->parent == PRJ_BIN_ROOT ? strdup(name) : rz_str_newf("%s/%s", p->path, name);
+}
+
+static ut64 section_hash(const ut8 *buf, ut64 size) {
+	// FNV-1a
+	ut64 h = 0xcbf29ce484222325ULL;
+	for (ut64 i = 0; i < size; i++) {
+		h = (h ^ buf[i]) * 0x100000001b3ULL;
+	}
+	return h;
+}
+
+static bool header_read(RzBuffer *b, PrjBinHeader *hdr) {
+	ut8 buf[PRJ_BIN_HEADER_SIZE];
+	if (rz_buf_read_at(b, 0, buf, sizeof(buf)) != sizeof(buf) || memcmp(buf, PRJ_BIN_MAGIC, PRJ_BIN_MAGIC_SIZE)) {
+		return false;
+	}
+	if (rz_read_le32(buf + 8) != PRJ_BIN_FORMAT) {
+		return false;
+	}
+	hdr->n_sections = rz_read_le32(buf + 12);
+	hdr->index_offset = rz_read_le64(buf + 16);
+	hdr->index_size = rz_read_le64(buf + 24);
+	ut64 size = rz_buf_size(b);
+	return hdr->n_sections && hdr->index_offset >= PRJ_BIN_HEADER_SIZE &&
+		hdr->index_offset <= size && hdr->index_size <= size - hdr->index_offset;
+}
+
+static bool header_write(RzBuffer *b, const PrjBinHeader *hdr) {
+	ut8 buf[PRJ_BIN_HEADER_SIZE];
+	memcpy(buf, PRJ_BIN_MAGIC, PRJ_BIN_MAGIC_SIZE);
+	rz_write_le32(buf + 8, PRJ_BIN_FORMAT);
+	rz_write_le32(buf + 12, hdr->n_sections);
+	rz_write_le64(buf + 16, hdr->index_offset);
+	rz_write_le64(buf + 24, hdr->index_size);
+	return rz_buf_write_at(b, 0, buf, sizeof(buf)) == sizeof(buf);
+}
+
+/* reads the index into a vector of PrjBinSection, validating it against the file */
+static RzVector /*<PrjBinSection>*/ *index_read(RzBuffer *b, const PrjBinHeader *hdr) {
+	ut8 *buf = malloc(hdr->index_size);
+	if (!buf) {
+		return NULL;
+	}
+	RzVector *sections = rz_vector_new(sizeof(PrjBinSection), section_fini, NULL);
+	if (!sections || !rz_vector_reserve(sections, hdr->n_sections) ||
+		rz_buf_read_at(b, hdr->index_offset, buf, hdr->index_size) != (st64)hdr->index_size) {
+		goto fail;
+	}
+	ut64 file_size = rz_buf_size(b);
+	const ut8 *p = buf;
+	const ut8 *end = buf + hdr->index_size;
+	for (ut32 i = 0; i < hdr->n_sections; i++) {
+		if (end - p < 8) {
+			goto fail;
+		}
+		PrjBinSection s = { 0 };
+		s.parent = rz_read_le32(p);
+		ut32 name_len = rz_read_le32(p + 4);
+		p += 8;
+		if ((i == 0) != (s.parent == PRJ_BIN_ROOT) || (i && s.parent >= i) || end - p < (st64)name_len + 28) {
+			goto fail;
+		}
+		s.name = rz_str_ndup((const char *)p, name_len);
+		s.path = s.name ? section_path(sections, s.parent, s.name) : NULL;
+		p += name_len;
+		s.offset = rz_read_le64(p);
+		s.size = rz_read_le64(p + 8);
+		s.hash = rz_read_le64(p + 16);
+		s.n_records = rz_read_le32(p + 24);
+		p += 28;
+		if (!s.name || !s.path || s.offset > file_size || s.size > file_size - s.offset) {
+			section_fini(&s, NULL);
+			goto fail;
+		}
+		rz_vector_push(sections, &s);
+	}
+	free(buf);
+	return sections;
+fail:
+	free(buf);
+	rz_vector_free(sections);
+	return NULL;
+}
+
+static int cmp_ns(const void *a, const void *b) {
+	const SdbNs *nsa = a;
+	const SdbNs *nsb = b;
+	return strcmp(nsa->name, nsb->name);
+}
+
+/* lists the namespaces of db in pre-order, sorted by name so the layout is stable */
+static bool sections_collect(RzVector *sections, Sdb *db, ut32 parent, const char *name) {
+	PrjBinSection s = { 0 };
+	s.parent = parent;
+	s.db = db;
+	s.name = strdup(name);
+	s.path = section_path(sections, parent, name);
+	if (!s.name || !s.path || !rz_vector_push(sections, &s)) {
+		section_fini(&s, NULL);
+		return false;
+	}
+	ut32 idx = (ut32)rz_vector_len(sections) - 1;
+	SdbList *l = ls_clone(db->ns);
+	if (!l) {
+		return false;
+	}
+	ls_sort(l, cmp_ns);
+	bool ret = true;
+	SdbListIter *it;
+	SdbNs *ns;
+	ls_foreach (l, it, ns) {
+		if (!sections_collect(sections, ns->sdb, idx, ns->name)) {
+			ret = false;
+			break;
+		}
+	}
+	ls_free(l);
+	return ret;
+}
+
+static bool payload_append(RzStrBuf *sb, const char *s, ut32 len) {
+	ut8 lenbuf[4];
+	rz_write_le32(lenbuf, len);
+	return rz_strbuf_append_n(sb, (const char *)lenbuf, sizeof(lenbuf)) &&
+		rz_strbuf_append_n(sb, s, len) &&
+		rz_strbuf_append_n(sb, "", 1);
+}
+
+typedef struct {
+	const char *k;
+	const char *v;
+} PrjBinRecord;
+
+static bool record_collect_cb(void *user, const char *k, const char *v) {
+	PrjBinRecord r = { k, v };
+	return rz_vector_push(user, &r);
+}
+
+static int record_cmp(const void *a, const void *b) {
+	return strcmp(((const PrjBinRecord *)a)->k, ((const PrjBinRecord *)b)->k);
+}
+
+/* the records are sorted by key, so unchanged contents give the same payload */
+static bool payload_encode(RzStrBuf *sb, Sdb *db, ut32 *n_records) {
+	// the project db lives in memory only, so the strings stay valid while iterating
+	RzVector records;
+	rz_vector_init(&records, sizeof(PrjBinRecord), NULL, NULL);
+	if (!sdb_foreach(db, record_collect_cb, &records)) {
+		rz_vector_fini(&records);
+		return false;
+	}
+	if (rz_vector_len(&records) > 1) {
+		rz_vector_sort(&records, record_cmp, false);
+	}
+	bool ret = true;
+	PrjBinRecord *r;
+	rz_vector_foreach(&records, r) {
+		if (!payload_append(sb, r->k, strlen(r->k)) || !payload_append(sb, r->v, strlen(r->v))) {
+			ret = false;
+			break;
+		}
+	}
+	*n_records = rz_vector_len(&records);
+	rz_vector_fini(&records);
+	return ret;
+}
+
+static bool payload_decode(Sdb *db, const ut8 *buf, ut64 size, ut32 n_records) {
+	sdb_reserve(db, n_records);
+	const ut8 *p = buf;
+	const ut8 *end = buf + size;
+	for (ut32 i = 0; i < n_records; i++) {
+		const char *kv[2];
+		for (int j = 0; j < 2; j++) {
+			if (end - p < 4) {
+				return false;
+			}
+			ut32 len = rz_read_le32(p);
+			p += 4;
+			if (end - p <= (st64)len || p[len]) {
+				return false;
+			}
+			kv[j] = (const char *)p;
+			p += len + 1;
+		}
+		sdb_set(db, kv[0], kv[1], 0);
+	}
+	return p == end;
+}
+
+static bool index_write(RzBuffer *b, RzVector *sections, PrjBinHeader *hdr) {
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	bool ret = true;
+	PrjBinSection *s;
+	rz_vector_foreach(sections, s) {
+		ut8 buf[28];
+		ut32 name_len = strlen(s->name);
+		rz_write_le32(buf, s->parent);
+		rz_write_le32(buf + 4, name_len);
+		if (!rz_strbuf_append_n(&sb, (const char *)buf, 8) || !rz_strbuf_append_n(&sb, s->name, name_len)) {
+			ret = false;
+			break;
+		}
+		rz_write_le64(buf, s->offset);
+		rz_write_le64(buf + 8, s->size);
+		rz_write_le64(buf + 16, s->hash);
+		rz_write_le32(buf + 24, s->n_records);
+		if (!rz_strbuf_append_n(&sb, (const char *)buf, sizeof(buf))) {
+			ret = false;
+			break;
+		}
+	}
+	hdr->index_size = rz_strbuf_length(&sb);
+	hdr->n_sections = rz_vector_len(sections);
+	if (ret) {
+		ret = rz_buf_write_at(b, hdr->index_offset, (const ut8 *)rz_strbuf_get(&sb), hdr->index_size) == (st64)hdr->index_size;
+	}
+	rz_strbuf_fini(&sb);
+	return ret;
+}
+
+static bool file_replace(const char *src, const char *dst) {
+#if __WINDOWS__
+	wchar_t *src_ = rz_utf8_to_utf16(src);
+	wchar_t *dst_ = rz_utf8_to_utf16(dst);
+	bool ret = src_ && dst_ && MoveFileExW(src_, dst_, MOVEFILE_REPLACE_EXISTING);
+	free(src_);
+	free(dst_);
+	return ret;
+#else
+	return !rename(src, dst);
+#endif
+}
+
+/**
+ * \brief Check whether \p file is a project in the binary format
+ */
+RZ_API bool rz_project_is_binary_file(RZ_NONNULL const char *file) {
+	rz_return_val_if_fail(file, false);
+	RzBuffer *b = rz_buf_new_file(file, O_RDONLY, 0);
+	if (!b) {
+		return false;
+	}
+	ut8 magic[PRJ_BIN_MAGIC_SIZE];
+	bool ret = rz_buf_read_at(b, 0, magic, sizeof(magic)) == sizeof(magic) && !memcmp(magic, PRJ_BIN_MAGIC, PRJ_BIN_MAGIC_SIZE);
+	rz_buf_free(b);
+	return ret;
+}
+
+/**
+ * \brief Save \p prj to \p file in the binary format
+ *
+ * If \p file already holds a binary project, only the namespaces whose contents
+ * differ from the saved ones are written, the others keep pointing to the data
+ * already in the file. Otherwise the project is written to a temporary file in
+ * the same directory, which then replaces \p file.
+ */
+RZ_API bool rz_project_binary_save(RZ_NONNULL RzProject *prj, RZ_NONNULL const char *file) {
+	rz_return_val_if_fail(prj && file, false);
+	RzVector *old = NULL;
+	HtPP *old_by_path = NULL;
+	PrjBinHeader hdr = { 0 };
+	RzBuffer *b = rz_file_exists(file) ? rz_buf_new_file(file, O_RDWR, 0) : NULL;
+	if (b && header_read(b, &hdr) && (old = index_read(b, &hdr))) {
+		ut64 live = hdr.index_size + PRJ_BIN_HEADER_SIZE;
+		PrjBinSection *s;
+		rz_vector_foreach(old, s) {
+			live += s->size;
+		}
+		// compact once more than half of the file is stale
+		if (rz_buf_size(b) <= 2 * live && (old_by_path = ht_pp_new0())) {
+			rz_vector_foreach(old, s) {
+				ht_pp_insert(old_by_path, s->path, s);
+			}
+		}
+	}
+	char *tmp_file = NULL;
+	if (!old_by_path) {
+		// written from scratch next to the previous file, which is replaced only once complete
+		rz_buf_free(b);
+		tmp_file = rz_str_newf("%s.tmp", file);
+		b = tmp_file ? rz_buf_new_file(tmp_file, O_RDWR | O_CREAT | O_TRUNC, 0644) : NULL;
+	}
+
+	bool ret = false;
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	RzVector *sections = rz_vector_new(sizeof(PrjBinSection), section_fini, NULL);
+	if (!b || !sections || !sections_collect(sections, prj, PRJ_BIN_ROOT, "")) {
+		goto beach;
+	}
+	ut64 end = old_by_path ? rz_buf_size(b) : PRJ_BIN_HEADER_SIZE;
+	PrjBinSection *s;
+	rz_vector_foreach(sections, s) {
+		rz_strbuf_fini(&sb);
+		rz_strbuf_init(&sb);
+		if (!payload_encode(&sb, s->db, &s->n_records)) {
+			goto beach;
+		}
+		const ut8 *payload = (const ut8 *)rz_strbuf_get(&sb);
+		s->size = rz_strbuf_length(&sb);
+		s->hash = section_hash(payload, s->size);
+		const PrjBinSection *prev = old_by_path ? ht_pp_find(old_by_path, s->path, NULL) : NULL;
+		if (prev && prev->size == s->size && prev->hash == s->hash && prev->n_records == s->n_records) {
+			s->offset = prev->offset;
+			continue;
+		}
+		if (s->size && rz_buf_write_at(b, end, payload, s->size) != (st64)s->size) {
+			goto beach;
+		}
+		s->offset = end;
+		end += s->size;
+	}
+	hdr.index_offset = end;
+	ret = index_write(b, sections, &hdr) && header_write(b, &hdr);
+
+beach:
+	rz_strbuf_fini(&sb);
+	rz_vector_free(sections);
+	ht_pp_free(old_by_path);
+	rz_vector_free(old);
+	rz_buf_free(b);
+	if (tmp_file) {
+		ret = ret && file_replace(tmp_file, file);
+		if (!ret) {
+			rz_file_rm(tmp_file);
+		}
+		free(tmp_file);
+	}
+	return ret;
+}
+
+/**
+ * \brief Load the binary project in \p file into \p prj
+ *
+ * The index is read first, then each namespace is read and decoded on its own,
+ * so the file is never held in memory as a whole.
+ */
+RZ_API bool rz_project_binary_load(RZ_NONNULL RzProject *prj, RZ_NONNULL const char *file) {
+	rz_return_val_if_fail(prj && file, false);
+	RzBuffer *b = rz_buf_new_file(file, O_RDONLY, 0);
+	if (!b) {
+		return false;
+	}
+	bool ret = false;
+	PrjBinHeader hdr;
+	RzVector *sections = NULL;
+	Sdb **dbs = NULL;
+	ut8 *buf = NULL;
+	if (!header_read(b, &hdr) || !(sections = index_read(b, &hdr)) ||
+		!(dbs = RZ_NEWS0(Sdb *, rz_vector_len(sections)))) {
+		goto beach;
+	}
+	PrjBinSection *s;
+	ut32 i = 0;
+	rz_vector_foreach(sections, s) {
+		dbs[i] = s->parent == PRJ_BIN_ROOT ? prj : sdb_ns(dbs[s->parent], s->name, true);
+		free(buf);
+		buf = malloc(s->size + 1);
+		if (!dbs[i] || !buf ||
+			rz_buf_read_at(b, s->offset, buf, s->size) != (st64)s->size ||
+			section_hash(buf, s->size) != s->hash ||
+			!payload_decode(dbs[i], buf, s->size, s->n_records)) {
+			goto beach;
+		}
+		i++;
+	}
+	ret = true;
+
+beach:
+	free(buf);
+	free(dbs);
+	rz_vector_free(sections);
+	rz_buf_free(b);
+	return ret;
+}
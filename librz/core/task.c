@@ -3,6 +3,14 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include <rz_core.h>
+#include "core_private.h"
+
+/**
+ * Read-only task currently running on this thread, if any.
+ * Read-only tasks run outside of the cooperative scheduling, so they can not
+ * be tracked with RzCoreTaskScheduler.current_task.
+ */
+static RZ_THREAD_LOCAL RzCoreTask *reader_task = NULL;
 
 RZ_API void rz_core_task_scheduler_init(RzCoreTaskScheduler *sched,
 	RzCoreTaskContextSwitch ctx_switch, void *ctx_switch_user,
@@ -19,6 +27,13 @@ RZ_API void rz_core_task_scheduler_init(RzCoreTaskScheduler *sched,
 	sched->lock = rz_th_lock_new(true);
 	sched->tasks_running = 0;
 	sched->oneshot_running = false;
+	sched->rw_lock = rz_th_lock_new(false);
+	sched->rw_cond = rz_th_cond_new();
+	sched->readers_running = 0;
+	sched->readers_waiting = 0;
+	sched->writers_waiting = 0;
+	sched->readers_gen = 0;
+	sched->writer_active = false;
 	sched->main_task = rz_core_task_new(sched, NULL, NULL, NULL);
 	rz_list_append(sched->tasks, sched->main_task);
 	sched->current_task = NULL;
@@ -29,6 +44,8 @@ RZ_API void rz_core_task_scheduler_fini(RzCoreTaskScheduler *tasks) {
 	rz_list_free(tasks->tasks_queue);
 	rz_list_free(tasks->oneshot_queue);
 	rz_th_lock_free(tasks->lock);
+	rz_th_cond_free(tasks->rw_cond);
+	rz_th_lock_free(tasks->rw_lock);
 }
 
 #if HAVE_PTHREAD
@@ -63,6 +80,73 @@ static void tasks_lock_leave(RzCoreTaskScheduler *scheduler, TASK_SIGSET_T *old_
 	tasks_lock_block_signals_reset(old_sigset);
 }
 
+/*
+ * The task holding the scheduling token (and any oneshot running immediately)
+ * is a writer: it may modify everything. Read-only tasks are readers and run
+ * concurrently with each other, but only while no writer is running, that is
+ * while all the cooperative tasks are sleeping or yielding.
+ * Readers must never take the tasks lock while they are admitted, since a
+ * writer may wait for them while holding it.
+ */
+static void rw_reader_enter(RzCoreTaskScheduler *sched) {
+	rz_th_lock_enter(sched->rw_lock);
+	if (!sched->writer_active && !sched->writers_waiting) {
+		sched->readers_running++;
+	} else {
+		// the writer leaving admits us and accounts for us in readers_running
+		ut32 gen = sched->readers_gen;
+		sched->readers_waiting++;
+		while (gen == sched->readers_gen) {
+			rz_th_cond_wait(sched->rw_cond, sched->rw_lock);
+		}
+	}
+	rz_th_lock_leave(sched->rw_lock);
+}
+
+static void rw_reader_leave(RzCoreTaskScheduler *sched) {
+	rz_th_lock_enter(sched->rw_lock);
+	sched->readers_running--;
+	if (!sched->readers_running) {
+		rz_th_cond_signal_all(sched->rw_cond);
+	}
+	rz_th_lock_leave(sched->rw_lock);
+}
+
+static bool rw_readers_waiting(RzCoreTaskScheduler *sched) {
+	rz_th_lock_enter(sched->rw_lock);
+	bool waiting = sched->readers_waiting > 0;
+	rz_th_lock_leave(sched->rw_lock);
+	return waiting;
+}
+
+static void rw_writer_enter(RzCoreTaskScheduler *sched) {
+	rz_th_lock_enter(sched->rw_lock);
+	sched->writers_waiting++;
+	while (sched->readers_running || sched->writer_active) {
+		rz_th_cond_wait(sched->rw_cond, sched->rw_lock);
+	}
+	sched->writers_waiting--;
+	sched->writer_active = true;
+	rz_th_lock_leave(sched->rw_lock);
+}
+
+/**
+ * \return true if the writer was active, i.e. if it must be entered again
+ */
+static bool rw_writer_leave(RzCoreTaskScheduler *sched) {
+	rz_th_lock_enter(sched->rw_lock);
+	bool was_active = sched->writer_active;
+	sched->writer_active = false;
+	if (sched->readers_waiting) {
+		sched->readers_running += sched->readers_waiting;
+		sched->readers_waiting = 0;
+		sched->readers_gen++;
+	}
+	rz_th_cond_signal_all(sched->rw_cond);
+	rz_th_lock_leave(sched->rw_lock);
+	return was_active;
+}
+
 typedef struct oneshot_t {
 	RzCoreTaskOneShot func;
 	void *user;
@@ -232,7 +316,11 @@ RZ_API void rz_core_task_schedule(RzCoreTask *current, RzTaskState next_state) {
 	RzCoreTaskScheduler *sched = current->sched;
 	bool stop = next_state != RZ_CORE_TASK_STATE_RUNNING;
 
-	if (sched->oneshot_running || (!stop && sched->tasks_running == 1 && sched->oneshots_enqueued == 0)) {
+	if (current == reader_task) {
+		// read-only tasks never hold the token, so there is nothing to hand over
+		return;
+	}
+	if (sched->oneshot_running || (!stop && sched->tasks_running == 1 && sched->oneshots_enqueued == 0 && !rw_readers_waiting(sched))) {
 		return;
 	}
 
@@ -260,6 +348,9 @@ RZ_API void rz_core_task_schedule(RzCoreTask *current, RzTaskState next_state) {
 		free(oneshot);
 	}
 
+	// let the read-only tasks waiting for us run until the next task wakes up
+	bool writer = rw_writer_leave(sched);
+
 	RzCoreTask *next = rz_list_pop_head(sched->tasks_queue);
 
 	if (next && !stop) {
@@ -288,6 +379,9 @@ RZ_API void rz_core_task_schedule(RzCoreTask *current, RzTaskState next_state) {
 	}
 
 	if (!stop) {
+		if (writer) {
+			rw_writer_enter(sched);
+		}
 		sched->current_task = current;
 		if (sched->ctx_switch) {
 			sched->ctx_switch(current, sched->ctx_switch_user);
@@ -297,6 +391,9 @@ RZ_API void rz_core_task_schedule(RzCoreTask *current, RzTaskState next_state) {
 
 static void task_wakeup(RzCoreTask *current) {
 	RzCoreTaskScheduler *sched = current->sched;
+	if (current == reader_task) {
+		return;
+	}
 
 	TASK_SIGSET_T old_sigset;
 	tasks_lock_enter(sched, &old_sigset);
@@ -326,6 +423,7 @@ static void task_wakeup(RzCoreTask *current) {
 
 	rz_th_lock_leave(current->dispatch_lock);
 
+	rw_writer_enter(sched);
 	sched->current_task = current;
 
 	if (sched->ctx_switch) {
@@ -371,6 +469,31 @@ nonstart:
 	return NULL;
 }
 
+static void *task_run_reader(RzCoreTask *task) {
+	RzCoreTaskScheduler *sched = task->sched;
+
+	TASK_SIGSET_T old_sigset;
+	tasks_lock_enter(sched, &old_sigset);
+	task->state = RZ_CORE_TASK_STATE_RUNNING;
+	tasks_lock_leave(sched, &old_sigset);
+
+	rw_reader_enter(sched);
+	if (!task->breaked) {
+		reader_task = task;
+		task->runner(sched, task->runner_user);
+		reader_task = NULL;
+	}
+	rw_reader_leave(sched);
+
+	tasks_lock_enter(sched, &old_sigset);
+	task->state = RZ_CORE_TASK_STATE_DONE;
+	if (task->running_sem) {
+		rz_th_sem_post(task->running_sem);
+	}
+	tasks_lock_leave(sched, &old_sigset);
+	return NULL;
+}
+
 RZ_API void rz_core_task_enqueue(RzCoreTaskScheduler *scheduler, RzCoreTask *task) {
 	if (!scheduler || !task) {
 		return;
@@ -384,7 +507,7 @@ RZ_API void rz_core_task_enqueue(RzCoreTaskScheduler *scheduler, RzCoreTask *tas
 		rz_th_sem_wait(task->running_sem);
 	}
 	rz_list_append(scheduler->tasks, task);
-	task->thread = rz_th_new((RzThreadFunction)task_run_thread, task);
+	task->thread = rz_th_new((RzThreadFunction)(task->read_only ? task_run_reader : task_run_thread), task);
 	tasks_lock_leave(scheduler, &old_sigset);
 }
 
@@ -397,9 +520,12 @@ RZ_API void rz_core_task_enqueue_oneshot(RzCoreTaskScheduler *scheduler, RzCoreT
 	if (scheduler->tasks_running == 0) {
 		// nothing is running right now and no other task can be scheduled
 		// while core->tasks_lock is locked => just run it
+		// once the read-only tasks are done.
+		rw_writer_enter(scheduler);
 		scheduler->oneshot_running = true;
 		func(user);
 		scheduler->oneshot_running = false;
+		rw_writer_leave(scheduler);
 	} else {
 		OneShot *oneshot = RZ_NEW(OneShot);
 		if (oneshot) {
@@ -444,6 +570,9 @@ RZ_API void rz_core_task_sleep_end(RzCoreTask *task) {
 }
 
 RZ_API RzCoreTask *rz_core_task_self(RzCoreTaskScheduler *scheduler) {
+	if (reader_task && reader_task->sched == scheduler) {
+		return reader_task;
+	}
 	return scheduler->current_task ? scheduler->current_task : scheduler->main_task;
 }
 
@@ -595,7 +724,15 @@ static void cmd_task_runner(RzCoreTaskScheduler *sched, void *user) {
 	RzCore *core = ctx->core_ctx.core;
 	RzCoreTask *task = rz_core_task_self(sched);
 	char *res_str;
-	if (task == sched->main_task) {
+	if (task == reader_task) {
+		// running concurrently, so the output can't go through the shared cons context
+		rz_cons_context_load_thread(ctx->core_ctx.cons_context);
+		rz_cons_push();
+		rz_core_cmd_read_only(core, ctx->cmd);
+		res_str = strdup(rz_str_get(rz_cons_get_buffer()));
+		rz_cons_pop();
+		rz_cons_context_load_thread(NULL);
+	} else if (task == sched->main_task) {
 		rz_core_cmd(core, ctx->cmd, ctx->cmd_log);
 		res_str = NULL;
 	} else {
@@ -636,6 +773,7 @@ RZ_API RzCoreTask *rz_core_cmd_task_new(RzCore *core, const char *cmd, RzCoreCmd
 		cmd_task_free(ctx);
 		return NULL;
 	}
+	task->read_only = rz_core_cmd_is_read_only(core, cmd);
 	return task;
 }
 
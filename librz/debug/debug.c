@@ -693,6 +693,10 @@ RZ_API RzDebugReasonType rz_debug_wait(RzDebug *dbg, RzBreakpointItem **bp) {
 	/* if our debugger plugin has wait */
 	if (dbg->cur && dbg->cur->wait) {
 		reason = dbg->cur->wait(dbg, dbg->pid);
+		// the debuggee ran, whatever was cached of its memory is stale now
+		if (dbg->iob.io) {
+			rz_io_page_cache_invalidate_all(dbg->iob.io);
+		}
 		if (reason == RZ_DEBUG_REASON_DEAD) {
 			eprintf("\n==> Process finished\n\n");
 			RzEventDebugProcessFinished event = {
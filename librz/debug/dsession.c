@@ -8,6 +8,8 @@
 #define CMP_CNUM_MEM(x, y)   ((x) >= ((RzDebugChangeMem *)y)->cnum ? 1 : -1)
 #define CMP_CNUM_CHKPT(x, y) ((x) >= ((RzDebugCheckpoint *)y)->cnum ? 1 : -1)
 
+#define PAGE_MASK ((ut64)RZ_DEBUG_SESSION_PAGE_SIZE - 1)
+
 RZ_API void rz_debug_session_free(RzDebugSession *session) {
 	if (session) {
 		rz_vector_free(session->checkpoints);
@@ -30,6 +32,64 @@ static void htup_vector_free(HtUPKv *kv) {
 	rz_vector_free(kv->value);
 }
 
+static void mem_page_free(RzDebugMemPage *page) {
+	if (!page) {
+		return;
+	}
+	rz_vector_fini(&page->changes);
+	rz_vector_fini(&page->data);
+	free(page);
+}
+
+static void htup_mem_page_free(HtUPKv *kv) {
+	mem_page_free(kv->value);
+}
+
+static RzDebugMemPage *mem_page_get(HtUP *memory, ut64 addr) {
+	RzDebugMemPage *page = ht_up_find(memory, addr, NULL);
+	if (page) {
+		return page;
+	}
+	page = RZ_NEW0(RzDebugMemPage);
+	if (!page) {
+		return NULL;
+	}
+	page->addr = addr;
+	rz_vector_init(&page->changes, sizeof(RzDebugChangeMem), NULL, NULL);
+	rz_vector_init(&page->data, sizeof(ut8), NULL, NULL);
+	if (!ht_up_insert(memory, addr, page)) {
+		mem_page_free(page);
+		return NULL;
+	}
+	return page;
+}
+
+/**
+ * Records \p size bytes written at \p offset of \p page by the step \p cnum.
+ * Only the written bytes are kept, consecutive writes of the same step
+ * are merged into a single change.
+ */
+static bool mem_page_add_change(RzDebugMemPage *page, int cnum, ut16 offset, const ut8 *bytes, ut16 size) {
+	size_t index;
+	size_t data_len = rz_vector_len(&page->data);
+	rz_vector_upper_bound(&page->changes, cnum, index, CMP_CNUM_MEM);
+	if (index > 0 && index == rz_vector_len(&page->changes)) {
+		RzDebugChangeMem *last = rz_vector_index_ptr(&page->changes, index - 1);
+		if (last->cnum == cnum && last->offset + last->size == offset && last->data + last->size == data_len) {
+			if (!rz_vector_insert_range(&page->data, data_len, (void *)bytes, size)) {
+				return false;
+			}
+			last->size += size;
+			return true;
+		}
+	}
+	RzDebugChangeMem change = { cnum, offset, size, data_len };
+	if (!rz_vector_insert_range(&page->data, data_len, (void *)bytes, size)) {
+		return false;
+	}
+	return rz_vector_insert(&page->changes, index, &change) != NULL;
+}
+
 RZ_API RzDebugSession *rz_debug_session_new(void) {
 	RzDebugSession *session = RZ_NEW0(RzDebugSession);
 	if (!session) {
@@ -46,7 +106,7 @@ RZ_API RzDebugSession *rz_debug_session_new(void) {
 		rz_debug_session_free(session);
 		return NULL;
 	}
-	session->memory = ht_up_new(NULL, htup_vector_free, NULL);
+	session->memory = ht_up_new(NULL, htup_mem_page_free, NULL);
 	if (!session->memory) {
 		rz_debug_session_free(session);
 		return NULL;
@@ -141,15 +201,37 @@ static void _set_initial_memory(RzDebug *dbg) {
 }
 
 static bool _restore_memory_cb(void *user, const ut64 key, const void *value) {
-	size_t index;
 	RzDebug *dbg = user;
-	RzVector *vmem = (RzVector *)value;
-
-	rz_vector_upper_bound(vmem, dbg->session->cnum, index, CMP_CNUM_MEM);
-	if (index > 0 && index <= vmem->len) {
-		RzDebugChangeMem *mem = rz_vector_index_ptr(vmem, index - 1);
-		if (mem->cnum > dbg->session->cur_chkpt->cnum) {
-			dbg->iob.write_at(dbg->iob.io, key, &mem->data, 1);
+	RzDebugMemPage *page = (RzDebugMemPage *)value;
+	ut8 bytes[RZ_DEBUG_SESSION_PAGE_SIZE];
+	bool written[RZ_DEBUG_SESSION_PAGE_SIZE];
+	bool dirty = false;
+	size_t index, i, j;
+
+	// Replay the changes made after the checkpoint, the last write of each byte wins
+	rz_vector_upper_bound(&page->changes, dbg->session->cur_chkpt->cnum, index, CMP_CNUM_MEM);
+	for (; index < rz_vector_len(&page->changes); index++) {
+		RzDebugChangeMem *mem = rz_vector_index_ptr(&page->changes, index);
+		if (mem->cnum > dbg->session->cnum) {
+			break;
+		}
+		if (!dirty) {
+			memset(written, 0, sizeof(written));
+			dirty = true;
+		}
+		memcpy(bytes + mem->offset, rz_vector_index_ptr(&page->data, mem->data), mem->size);
+		memset(written + mem->offset, true, mem->size);
+	}
+	if (!dirty) {
+		return true;
+	}
+	for (i = 0; i < RZ_DEBUG_SESSION_PAGE_SIZE; i = j) {
+		for (; i < RZ_DEBUG_SESSION_PAGE_SIZE && !written[i]; i++) {
+		}
+		for (j = i; j < RZ_DEBUG_SESSION_PAGE_SIZE && written[j]; j++) {
+		}
+		if (j > i) {
+			dbg->iob.write_at(dbg->iob.io, key + i, bytes + i, j - i);
 		}
 	}
 	return true;
@@ -231,17 +313,28 @@ RZ_API bool rz_debug_session_add_reg_change(RzDebugSession *session, int arena,
 }
 
 RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr, ut8 data) {
-	RzVector *vmem = ht_up_find(session->memory, addr, NULL);
-	if (!vmem) {
-		vmem = rz_vector_new(sizeof(RzDebugChangeMem), NULL, NULL);
-		if (!vmem) {
-			eprintf("Error: creating a memory vector.\n");
+	return rz_debug_session_add_mem_changes(session, addr, &data, 1);
+}
+
+/**
+ * \brief Records the \p len bytes of \p buf written at \p addr by the current step
+ *
+ * The changes are stored per page of RZ_DEBUG_SESSION_PAGE_SIZE bytes.
+ */
+RZ_API bool rz_debug_session_add_mem_changes(RZ_NONNULL RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *buf, size_t len) {
+	rz_return_val_if_fail(session && buf, false);
+	while (len > 0) {
+		ut16 offset = addr & PAGE_MASK;
+		ut16 size = RZ_MIN(len, RZ_DEBUG_SESSION_PAGE_SIZE - offset);
+		RzDebugMemPage *page = mem_page_get(session->memory, addr & ~PAGE_MASK);
+		if (!page || !mem_page_add_change(page, session->cnum, offset, buf, size)) {
+			eprintf("Error: recording a memory change at 0x%" PFMT64x ".\n", addr);
 			return false;
 		}
-		ht_up_insert(session->memory, addr, vmem);
+		addr += size;
+		buf += size;
+		len -= size;
 	}
-	RzDebugChangeMem mem = { session->cnum, data };
-	rz_vector_push(vmem, &mem);
 	return true;
 }
 
@@ -274,20 +367,23 @@ static void serialize_registers(Sdb *db, HtUP *registers) {
 	ht_up_foreach(registers, serialize_register_cb, db);
 }
 
-// 0x<addr>={"size":<size_t>, "a":[<RzDebugChangeMem>]}},
+// 0x<page>=[<RzDebugChangeMem>]
 static bool serialize_memory_cb(void *db, const ut64 k, const void *v) {
 	RzDebugChangeMem *mem;
-	RzVector *vmem = (RzVector *)v;
+	RzDebugMemPage *page = (RzDebugMemPage *)v;
 	PJ *j = pj_new();
 	if (!j) {
 		return false;
 	}
 	pj_a(j);
 
-	rz_vector_foreach(vmem, mem) {
+	rz_vector_foreach(&page->changes, mem) {
 		pj_o(j);
 		pj_kN(j, "cnum", mem->cnum);
-		pj_kn(j, "data", mem->data);
+		pj_kn(j, "offset", mem->offset);
+		char *edata = sdb_encode(rz_vector_index_ptr(&page->data, mem->data), mem->size);
+		pj_ks(j, "data", edata ? edata : "");
+		free(edata);
 		pj_end(j);
 	}
 
@@ -375,7 +471,7 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  *     0x<addr>={"size":<size_t>, "a":[<RzDebugChangeReg>]}
  *
  *   /memory
- *     0x<addr>={"size":<size_t>, "a":[<RzDebugChangeMem>]}
+ *     0x<page>=[<RzDebugChangeMem>]
  *
  *   /checkpoints
  *     0x<cnum>={
@@ -387,7 +483,7 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  * {"cnum":<int>, "data":<ut64>}
  *
  * RzDebugChangeMem JSON:
- * {"cnum":<int>, "data":<ut8>}
+ * {"cnum":<int>, "offset":<ut16>, "data":"<base64>"}
  *
  * RzRegArena JSON:
  * {"size":<int>, "bytes":"<base64>"}
@@ -406,54 +502,330 @@ RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db) {
 	serialize_checkpoints(sdb_ns(db, "checkpoints", true), session->checkpoints);
 }
 
-static bool session_sdb_save(Sdb *db, const char *path) {
-	char *filename;
+/*
+ * Binary session file, all the integers are little endian:
+ *
+ * "RZDS" <version:ut32> <maxcnum:ut32>
+ * <count:ut32> registers: <key:ut64> <count:ut32> (<cnum:ut32> <data:ut64>)*
+ * <count:ut32> pages: <addr:ut64> <count:ut32> (<cnum:ut32> <offset:ut16> <size:ut16> <bytes>)*
+ * <count:ut32> checkpoints:
+ *   <cnum:ut32>
+ *   RZ_REG_TYPE_LAST arenas: <size:ut32> <bytes>
+ *   <count:ut32> snaps:
+ *     <name_len:ut32> <name> <addr:ut64> <addr_end:ut64> <size:ut32>
+ *     <perm:ut32> <user:ut32> <shared:ut8>
+ *     for each page of the snap: <stored:ut8> [<bytes>]
+ *
+ * The pages of a snap that did not change since the snap of the same map
+ * in the previous checkpoint are not stored (stored = 0).
+ */
+
+#define SESSION_FILE_NAME    "session.rzds"
+#define SESSION_FILE_MAGIC   "RZDS"
+#define SESSION_FILE_VERSION 1
+
+typedef struct {
+	RzBuffer *b;
+	bool ok;
+} SessionWriter;
+
+static bool session_write_bytes(RzBuffer *b, const void *bytes, ut64 size) {
+	return !size || rz_buf_write(b, bytes, size) == size;
+}
+
+static RzDebugSnap *session_find_snap(RzDebugCheckpoint *chkpt, RzDebugSnap *snap) {
+	if (!chkpt) {
+		return NULL;
+	}
+	RzListIter *iter;
+	RzDebugSnap *s;
+	rz_list_foreach (chkpt->snaps, iter, s) {
+		if (s->addr == snap->addr && s->size == snap->size) {
+			return s;
+		}
+	}
+	return NULL;
+}
+
+static bool session_write_register_cb(void *user, const ut64 k, const void *v) {
+	SessionWriter *w = user;
+	RzVector *vreg = (RzVector *)v;
+	RzDebugChangeReg *reg;
+	w->ok = rz_buf_write_le64(w->b, k) && rz_buf_write_le32(w->b, rz_vector_len(vreg));
+	rz_vector_foreach(vreg, reg) {
+		w->ok = w->ok && rz_buf_write_le32(w->b, reg->cnum) && rz_buf_write_le64(w->b, reg->data);
+	}
+	return w->ok;
+}
+
+static bool session_write_page_cb(void *user, const ut64 k, const void *v) {
+	SessionWriter *w = user;
+	RzDebugMemPage *page = (RzDebugMemPage *)v;
+	RzDebugChangeMem *mem;
+	w->ok = rz_buf_write_le64(w->b, page->addr) && rz_buf_write_le32(w->b, rz_vector_len(&page->changes));
+	rz_vector_foreach(&page->changes, mem) {
+		w->ok = w->ok && rz_buf_write_le32(w->b, mem->cnum) &&
+			rz_buf_write_le16(w->b, mem->offset) &&
+			rz_buf_write_le16(w->b, mem->size) &&
+			session_write_bytes(w->b, rz_vector_index_ptr(&page->data, mem->data), mem->size);
+	}
+	return w->ok;
+}
+
+static bool session_write_snap(RzBuffer *b, RzDebugSnap *snap, RzDebugSnap *prev) {
+	size_t name_len = snap->name ? strlen(snap->name) : 0;
+	if (!rz_buf_write_le32(b, name_len) || !session_write_bytes(b, snap->name, name_len) ||
+		!rz_buf_write_le64(b, snap->addr) || !rz_buf_write_le64(b, snap->addr_end) ||
+		!rz_buf_write_le32(b, snap->size) || !rz_buf_write_le32(b, snap->perm) ||
+		!rz_buf_write_le32(b, snap->user) || !rz_buf_write8(b, snap->shared)) {
+		return false;
+	}
+	for (ut32 off = 0; off < snap->size; off += RZ_DEBUG_SESSION_PAGE_SIZE) {
+		ut32 size = RZ_MIN(snap->size - off, RZ_DEBUG_SESSION_PAGE_SIZE);
+		bool stored = !prev || memcmp(snap->data + off, prev->data + off, size);
+		if (!rz_buf_write8(b, stored) || (stored && !session_write_bytes(b, snap->data + off, size))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool session_write(RzDebugSession *session, RzBuffer *b) {
+	SessionWriter w = { b, true };
+	if (!session_write_bytes(b, SESSION_FILE_MAGIC, 4) ||
+		!rz_buf_write_le32(b, SESSION_FILE_VERSION) ||
+		!rz_buf_write_le32(b, session->maxcnum)) {
+		return false;
+	}
+
+	if (!rz_buf_write_le32(b, session->registers->count)) {
+		return false;
+	}
+	ht_up_foreach(session->registers, session_write_register_cb, &w);
+	if (!w.ok || !rz_buf_write_le32(b, session->memory->count)) {
+		return false;
+	}
+	ht_up_foreach(session->memory, session_write_page_cb, &w);
+	if (!w.ok || !rz_buf_write_le32(b, rz_vector_len(session->checkpoints))) {
+		return false;
+	}
+
+	RzDebugCheckpoint *chkpt, *prev = NULL;
+	rz_vector_foreach(session->checkpoints, chkpt) {
+		if (!rz_buf_write_le32(b, chkpt->cnum)) {
+			return false;
+		}
+		for (size_t i = 0; i < RZ_REG_TYPE_LAST; i++) {
+			RzRegArena *arena = chkpt->arena[i];
+			ut32 size = arena && arena->bytes ? arena->size : 0;
+			if (!rz_buf_write_le32(b, size) || (size && !session_write_bytes(b, arena->bytes, size))) {
+				return false;
+			}
+		}
+		if (!rz_buf_write_le32(b, rz_list_length(chkpt->snaps))) {
+			return false;
+		}
+		RzListIter *iter;
+		RzDebugSnap *snap;
+		rz_list_foreach (chkpt->snaps, iter, snap) {
+			if (!session_write_snap(b, snap, session_find_snap(prev, snap))) {
+				return false;
+			}
+		}
+		prev = chkpt;
+	}
+	return true;
+}
+
+/**
+ * \brief Saves \p session to the session.rzds file of the \p path directory
+ */
+RZ_API bool rz_debug_session_save(RzDebugSession *session, const char *path) {
 	if (!rz_file_is_directory(path)) {
 		eprintf("Error: %s is not a directory\n", path);
 		return false;
 	}
-
-	filename = rz_str_newf("%s%ssession.sdb", path, RZ_SYS_DIR);
-	sdb_file(db, filename);
-	if (!sdb_sync(db)) {
-		eprintf("Failed to sync session to %s\n", filename);
-		free(filename);
-		sdb_close(db);
+	RzBuffer *b = rz_buf_new_with_bytes(NULL, 0);
+	if (!b) {
 		return false;
 	}
+	bool ret = false;
+	char *filename = rz_str_newf("%s%s" SESSION_FILE_NAME, path, RZ_SYS_DIR);
+	if (!filename || !session_write(session, b)) {
+		eprintf("Error: failed to serialize the session\n");
+	} else if (!rz_buf_dump(b, filename)) {
+		eprintf("Failed to save session to %s\n", filename);
+	} else {
+		ret = true;
+	}
 	free(filename);
-	sdb_close(db);
-
-	SdbListIter *it;
-	SdbNs *ns;
-	ls_foreach (db->ns, it, ns) {
-		char *filename = rz_str_newf("%s%s%s.sdb", path, RZ_SYS_DIR, ns->name);
-		sdb_file(ns->sdb, filename);
-		if (!sdb_sync(ns->sdb)) {
-			eprintf("Failed to sync %s to %s\n", ns->name, filename);
-			free(filename);
-			sdb_close(ns->sdb);
+	rz_buf_free(b);
+	return ret;
+}
+
+static bool session_read_bytes(RzBuffer *b, void *bytes, ut64 size) {
+	return !size || rz_buf_read(b, bytes, size) == size;
+}
+
+/* Checks that \p size bytes can still be read, before allocating them */
+static bool session_can_read(RzBuffer *b, ut64 size) {
+	return rz_buf_size(b) - rz_buf_tell(b) >= size;
+}
+
+static bool session_read_snap(RzBuffer *b, RzDebugCheckpoint *chkpt, RzDebugCheckpoint *prev) {
+	ut32 name_len, size, perm, user;
+	ut64 addr, addr_end;
+	ut8 shared;
+	if (!rz_buf_read_le32(b, &name_len) || !session_can_read(b, name_len)) {
+		return false;
+	}
+	RzDebugSnap *snap = RZ_NEW0(RzDebugSnap);
+	if (!snap || !(snap->name = RZ_NEWS0(char, name_len + 1)) ||
+		!session_read_bytes(b, snap->name, name_len) ||
+		!rz_buf_read_le64(b, &addr) || !rz_buf_read_le64(b, &addr_end) ||
+		!rz_buf_read_le32(b, &size) || !rz_buf_read_le32(b, &perm) ||
+		!rz_buf_read_le32(b, &user) || !rz_buf_read8(b, &shared)) {
+		rz_debug_snap_free(snap);
+		return false;
+	}
+	snap->addr = addr;
+	snap->addr_end = addr_end;
+	snap->size = size;
+	snap->perm = perm;
+	snap->user = user;
+	snap->shared = shared;
+	RzDebugSnap *prev_snap = session_find_snap(prev, snap);
+	// at least one byte per page
+	if (!session_can_read(b, (size + RZ_DEBUG_SESSION_PAGE_SIZE - 1) / RZ_DEBUG_SESSION_PAGE_SIZE) ||
+		!(snap->data = malloc(RZ_MAX(size, 1)))) {
+		rz_debug_snap_free(snap);
+		return false;
+	}
+	for (ut32 off = 0; off < size; off += RZ_DEBUG_SESSION_PAGE_SIZE) {
+		ut32 psize = RZ_MIN(size - off, RZ_DEBUG_SESSION_PAGE_SIZE);
+		ut8 stored;
+		if (!rz_buf_read8(b, &stored) || (!stored && !prev_snap)) {
+			rz_debug_snap_free(snap);
+			return false;
+		}
+		if (!stored) {
+			memcpy(snap->data + off, prev_snap->data + off, psize);
+		} else if (!session_read_bytes(b, snap->data + off, psize)) {
+			rz_debug_snap_free(snap);
 			return false;
 		}
-		free(filename);
-		sdb_close(ns->sdb);
 	}
+	rz_list_append(chkpt->snaps, snap);
+	return true;
+}
 
+static bool session_read_checkpoint(RzBuffer *b, RzDebugSession *session) {
+	RzDebugCheckpoint checkpoint = { 0 };
+	ut32 cnum, count;
+	if (!rz_buf_read_le32(b, &cnum)) {
+		return false;
+	}
+	checkpoint.cnum = cnum;
+	checkpoint.snaps = rz_list_newf((RzListFree)rz_debug_snap_free);
+	// pushed first so that it is freed by the session on failure
+	if (!checkpoint.snaps || !rz_vector_push(session->checkpoints, &checkpoint)) {
+		rz_list_free(checkpoint.snaps);
+		return false;
+	}
+	size_t len = rz_vector_len(session->checkpoints);
+	RzDebugCheckpoint *chkpt = rz_vector_index_ptr(session->checkpoints, len - 1);
+	RzDebugCheckpoint *prev = len > 1 ? rz_vector_index_ptr(session->checkpoints, len - 2) : NULL;
+	for (size_t i = 0; i < RZ_REG_TYPE_LAST; i++) {
+		ut32 size;
+		if (!rz_buf_read_le32(b, &size) || !session_can_read(b, size)) {
+			return false;
+		}
+		if (!size) {
+			continue;
+		}
+		chkpt->arena[i] = rz_reg_arena_new(size);
+		if (!chkpt->arena[i] || !session_read_bytes(b, chkpt->arena[i]->bytes, size)) {
+			return false;
+		}
+	}
+	if (!rz_buf_read_le32(b, &count)) {
+		return false;
+	}
+	while (count--) {
+		if (!session_read_snap(b, chkpt, prev)) {
+			return false;
+		}
+	}
 	return true;
 }
 
-RZ_API bool rz_debug_session_save(RzDebugSession *session, const char *path) {
-	Sdb *db = sdb_new0();
-	if (!db) {
+static bool session_read(RzDebugSession *session, RzBuffer *b) {
+	ut8 magic[4];
+	ut32 version, maxcnum, count, n;
+	if (!session_read_bytes(b, magic, sizeof(magic)) || memcmp(magic, SESSION_FILE_MAGIC, sizeof(magic)) ||
+		!rz_buf_read_le32(b, &version) || version != SESSION_FILE_VERSION ||
+		!rz_buf_read_le32(b, &maxcnum)) {
+		eprintf("Error: not a session file of version %d\n", SESSION_FILE_VERSION);
 		return false;
 	}
-	rz_debug_session_serialize(session, db);
+	session->maxcnum = maxcnum;
 
-	if (!session_sdb_save(db, path)) {
-		sdb_free(db);
+	if (!rz_buf_read_le32(b, &count)) {
 		return false;
 	}
-	sdb_free(db);
+	while (count--) {
+		ut64 key;
+		if (!rz_buf_read_le64(b, &key) || !rz_buf_read_le32(b, &n) || !session_can_read(b, (ut64)n * 12)) {
+			return false;
+		}
+		RzVector *vreg = rz_vector_new(sizeof(RzDebugChangeReg), NULL, NULL);
+		if (!vreg || (n && !rz_vector_reserve(vreg, n)) || !ht_up_insert(session->registers, key, vreg)) {
+			rz_vector_free(vreg);
+			return false;
+		}
+		while (n--) {
+			ut32 cnum;
+			ut64 data;
+			if (!rz_buf_read_le32(b, &cnum) || !rz_buf_read_le64(b, &data)) {
+				return false;
+			}
+			RzDebugChangeReg reg = { cnum, data };
+			rz_vector_push(vreg, &reg);
+		}
+	}
+
+	if (!rz_buf_read_le32(b, &count)) {
+		return false;
+	}
+	while (count--) {
+		ut64 addr;
+		if (!rz_buf_read_le64(b, &addr) || !rz_buf_read_le32(b, &n)) {
+			return false;
+		}
+		RzDebugMemPage *page = mem_page_get(session->memory, addr & ~PAGE_MASK);
+		if (!page) {
+			return false;
+		}
+		while (n--) {
+			ut8 bytes[RZ_DEBUG_SESSION_PAGE_SIZE];
+			ut32 cnum;
+			ut16 offset, size;
+			if (!rz_buf_read_le32(b, &cnum) || !rz_buf_read_le16(b, &offset) || !rz_buf_read_le16(b, &size) ||
+				offset + size > RZ_DEBUG_SESSION_PAGE_SIZE || !session_read_bytes(b, bytes, size) ||
+				!mem_page_add_change(page, cnum, offset, bytes, size)) {
+				return false;
+			}
+		}
+	}
+
+	if (!rz_buf_read_le32(b, &count)) {
+		return false;
+	}
+	while (count--) {
+		if (!session_read_checkpoint(b, session)) {
+			return false;
+		}
+	}
 	return true;
 }
 
@@ -473,18 +845,10 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 		return true;
 	}
 
-	HtUP *memory = user;
-	// Insert a new vector into `memory` HtUP at `addr`
-	RzVector *vmem = rz_vector_new(sizeof(RzDebugChangeMem), NULL, NULL);
-	if (!vmem) {
-		eprintf("Error: failed to allocate RzVector vmem.\n");
-		free(json_str);
-		rz_json_free(reg_json);
-		return false;
-	}
-	ht_up_insert(memory, sdb_atoi(addr), vmem);
+	RzDebugSession *session = user;
+	ut64 page_addr = sdb_atoi(addr);
 
-	// Extract <RzDebugChangeMem>'s into the new vector
+	// Extract <RzDebugChangeMem>'s into the page at `addr`
 	for (child = reg_json->children.first; child; child = child->next) {
 		if (child->type != RZ_JSON_OBJECT) {
 			continue;
@@ -494,11 +858,29 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 		int cnum = baby->num.s_value;
 
 		baby = rz_json_get(child, "data");
-		CHECK_TYPE(baby, RZ_JSON_INTEGER);
-		ut64 data = baby->num.u_value;
-
-		RzDebugChangeMem mem = { cnum, data };
-		rz_vector_push(vmem, &mem);
+		if (baby && baby->type == RZ_JSON_INTEGER) {
+			// Sessions saved before the page store have one byte per address
+			ut8 data = baby->num.u_value;
+			RzDebugMemPage *page = mem_page_get(session->memory, page_addr & ~PAGE_MASK);
+			if (page) {
+				mem_page_add_change(page, cnum, page_addr & PAGE_MASK, &data, 1);
+			}
+			continue;
+		}
+		CHECK_TYPE(baby, RZ_JSON_STRING);
+		int size = 0;
+		ut8 *data = sdb_decode(baby->str_value, &size);
+		baby = rz_json_get(child, "offset");
+		if (!data || !baby || baby->type != RZ_JSON_INTEGER ||
+			baby->num.u_value + size > RZ_DEBUG_SESSION_PAGE_SIZE) {
+			free(data);
+			continue;
+		}
+		RzDebugMemPage *page = mem_page_get(session->memory, page_addr);
+		if (page) {
+			mem_page_add_change(page, cnum, baby->num.u_value, data, size);
+		}
+		free(data);
 	}
 
 	free(json_str);
@@ -506,8 +888,8 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 	return true;
 }
 
-static void deserialize_memory(Sdb *db, HtUP *memory) {
-	sdb_foreach(db, deserialize_memory_cb, memory);
+static void deserialize_memory(Sdb *db, RzDebugSession *session) {
+	sdb_foreach(db, deserialize_memory_cb, session);
 }
 
 static bool deserialize_registers_cb(void *user, const char *addr, const char *v) {
@@ -719,19 +1101,41 @@ RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
 		func; \
 	} while (0)
 
-	DESERIALIZE("memory", deserialize_memory(subdb, session->memory));
+	DESERIALIZE("memory", deserialize_memory(subdb, session));
 	DESERIALIZE("registers", deserialize_registers(subdb, session->registers));
 	DESERIALIZE("checkpoints", deserialize_checkpoints(subdb, session->checkpoints));
 }
 
+/**
+ * \brief Loads the session saved in the \p path directory into \p dbg
+ *
+ * The sdb files written by older versions are loaded too.
+ */
 RZ_API bool rz_debug_session_load(RzDebug *dbg, const char *path) {
-	Sdb *db = session_sdb_load(path);
-	if (!db) {
+	char *filename = rz_str_newf("%s%s" SESSION_FILE_NAME, path, RZ_SYS_DIR);
+	if (!filename) {
 		return false;
 	}
-	rz_debug_session_deserialize(dbg->session, db);
+	if (rz_file_exists(filename)) {
+		RzBuffer *b = rz_buf_new_slurp(filename);
+		bool ret = b && session_read(dbg->session, b);
+		rz_buf_free(b);
+		if (!ret) {
+			eprintf("Error: failed to load %s\n", filename);
+			free(filename);
+			return false;
+		}
+	} else {
+		Sdb *db = session_sdb_load(path);
+		if (!db) {
+			free(filename);
+			return false;
+		}
+		rz_debug_session_deserialize(dbg->session, db);
+		sdb_free(db);
+	}
+	free(filename);
 	// Restore debugger to the beginning of the session
 	rz_debug_session_restore_reg_mem(dbg, 0);
-	sdb_free(db);
 	return true;
 }
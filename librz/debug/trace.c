@@ -147,16 +147,14 @@ RZ_API bool rz_debug_trace_ins_after(RZ_NONNULL RzDebug *dbg) {
 		}
 		case RZ_ANALYSIS_VAL_MEM: {
 			ut8 buf[32] = { 0 };
-			if (!dbg->iob.read_at(dbg->iob.io, val->base, buf, val->memref)) {
+			size_t size = RZ_MIN((size_t)val->memref, sizeof(buf));
+			if (!dbg->iob.read_at(dbg->iob.io, val->base, buf, size)) {
 				eprintf("Error reading memory at 0x%" PFMT64x "\n", val->base);
 				break;
 			}
 
 			// add mem write
-			size_t i;
-			for (i = 0; i < val->memref; i++) {
-				rz_debug_session_add_mem_change(dbg->session, val->base + i, buf[i]);
-			}
+			rz_debug_session_add_mem_changes(dbg->session, val->base, buf, size);
 			break;
 		}
 		default:
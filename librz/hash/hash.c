@@ -16,14 +16,27 @@ RZ_LIB_VERSION(rz_hash);
 #define hash_cfg_can_final(c)   ((c)->status == RZ_MSG_DIGEST_STATUS_ALLOC || (c)->status == RZ_MSG_DIGEST_STATUS_INIT || (c)->status == RZ_MSG_DIGEST_STATUS_UPDATE)
 #define hash_cfg_has_finshed(c) ((c)->status == RZ_MSG_DIGEST_STATUS_FINAL)
 
+/**
+ * Buffers at least this large are fed to the configured algorithms
+ * in parallel, below it the threads cost more than they save.
+ */
+#define HASH_CFG_PARALLEL_MIN_SIZE (1024 * 1024)
+
 typedef struct hash_cfg_config_t {
 	void *context;
 	ut8 *digest;
 	ut8 *hmac_key;
 	RzHashSize digest_size;
 	const RzHashPlugin *plugin;
+	bool updated; ///< set by the thread that updated the context
+	bool failed; ///< the plugin update failed on that thread
 } HashCfgConfig;
 
+typedef struct {
+	const ut8 *data;
+	ut64 size;
+} HashCfgUpdate;
+
 static RzHashPlugin *hash_static_plugins[] = { RZ_HASH_STATIC_PLUGINS };
 
 /**
@@ -215,6 +228,7 @@ RZ_API RZ_OWN RzHashCfg *rz_hash_cfg_new(RZ_NONNULL RzHash *rh) {
 		return NULL;
 	}
 	md->hash = rh;
+	md->threads = 1;
 
 	return md;
 }
@@ -396,18 +410,52 @@ RZ_API bool rz_hash_cfg_init(RZ_NONNULL RzHashCfg *md) {
 	return true;
 }
 
+static void hash_cfg_config_update(HashCfgConfig *mdc, const HashCfgUpdate *update) {
+	mdc->failed = !mdc->plugin->update(mdc->context, update->data, update->size);
+	mdc->updated = true;
+}
+
+static void hash_cfg_update_parallel(RzHashCfg *md, const ut8 *data, ut64 size) {
+	RzListIter *iter = NULL;
+	HashCfgConfig *mdc = NULL;
+	rz_list_foreach (md->configurations, iter, mdc) {
+		mdc->updated = false;
+	}
+	HashCfgUpdate update = { data, size };
+	// one thread per algorithm at most, rz_th_pool_new() caps it to the cores
+	size_t threads = rz_list_length(md->configurations);
+	if (md->threads) {
+		threads = RZ_MIN(threads, md->threads);
+	}
+	rz_th_iterate_list(md->configurations, (RzThreadIterator)hash_cfg_config_update, threads, &update);
+}
+
 /**
  * \brief Inserts data into each the message digest contextes
  *
  * RzHashCfg contains a list of configurations; this method will call
  * the update method of all the plugins stored in its list.
+ * Large buffers are hashed by the configured algorithms in parallel,
+ * each one on its own thread (see RzHashCfg.threads).
  * */
 RZ_API bool rz_hash_cfg_update(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *data, ut64 size) {
 	rz_return_val_if_fail(md && hash_cfg_can_update(md), false);
 
 	RzListIter *iter = NULL;
 	HashCfgConfig *mdc = NULL;
+	bool parallel = md->threads != 1 && size >= HASH_CFG_PARALLEL_MIN_SIZE && rz_list_length(md->configurations) > 1;
+	if (parallel) {
+		hash_cfg_update_parallel(md, data, size);
+	}
 	rz_list_foreach (md->configurations, iter, mdc) {
+		if (parallel && mdc->updated) {
+			if (mdc->failed) {
+				RZ_LOG_ERROR("msg digest: failed to call update for %s.\n", mdc->plugin->name);
+				return false;
+			}
+			continue;
+		}
+		// serial update, also used for what no thread could take
 		if (!mdc->plugin->update(mdc->context, data, size)) {
 			RZ_LOG_ERROR("msg digest: failed to call update for %s.\n", mdc->plugin->name);
 			return false;
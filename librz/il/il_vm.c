@@ -9,6 +9,7 @@
  */
 
 #include <rz_il/rz_il_vm.h>
+#include "il_vm_private.h"
 
 extern RZ_IPI RzILOpPureHandler rz_il_op_handler_pure_table_default[RZ_IL_OP_PURE_MAX];
 extern RZ_IPI RzILOpEffectHandler rz_il_op_handler_effect_table_default[RZ_IL_OP_EFFECT_MAX];
@@ -110,6 +111,77 @@ RZ_API void rz_il_vm_fini(RzILVM *vm) {
 
 	rz_list_free(vm->events);
 	vm->events = NULL;
+
+	rz_il_vm_pools_fini(vm);
+}
+
+/**
+ * Get a zeroed bitvector of \p length bits, reusing a released one if possible
+ */
+RZ_IPI RZ_OWN RzBitVector *rz_il_vm_bv_new(RzILVM *vm, ut32 length) {
+	if (length > 64 || !vm->bv_pool_len) {
+		return rz_bv_new(length);
+	}
+	RzBitVector *bv = vm->bv_pool[--vm->bv_pool_len];
+	if (!rz_bv_init(bv, length)) {
+		free(bv);
+		return NULL;
+	}
+	return bv;
+}
+
+RZ_IPI RZ_OWN RzBitVector *rz_il_vm_bv_dup(RzILVM *vm, RZ_NONNULL const RzBitVector *bv) {
+	if (bv->len > 64) {
+		return rz_bv_dup(bv);
+	}
+	RzBitVector *r = rz_il_vm_bv_new(vm, bv->len);
+	if (r) {
+		r->bits.small_u = bv->bits.small_u;
+	}
+	return r;
+}
+
+/**
+ * Free \p bv, keeping it for rz_il_vm_bv_new() if it is small enough
+ */
+RZ_IPI void rz_il_vm_bv_release(RzILVM *vm, RZ_NULLABLE RZ_OWN RzBitVector *bv) {
+	if (!bv) {
+		return;
+	}
+	if (bv->len > 64 || vm->bv_pool_len == RZ_IL_VM_POOL_MAX) {
+		rz_bv_free(bv);
+		return;
+	}
+	vm->bv_pool[vm->bv_pool_len++] = bv;
+}
+
+RZ_IPI RZ_OWN RzILBool *rz_il_vm_bool_new(RzILVM *vm, bool b) {
+	if (!vm->bool_pool_len) {
+		return rz_il_bool_new(b);
+	}
+	RzILBool *r = vm->bool_pool[--vm->bool_pool_len];
+	r->b = b;
+	return r;
+}
+
+RZ_IPI void rz_il_vm_bool_release(RzILVM *vm, RZ_NULLABLE RZ_OWN RzILBool *b) {
+	if (!b) {
+		return;
+	}
+	if (vm->bool_pool_len == RZ_IL_VM_POOL_MAX) {
+		rz_il_bool_free(b);
+		return;
+	}
+	vm->bool_pool[vm->bool_pool_len++] = b;
+}
+
+RZ_IPI void rz_il_vm_pools_fini(RzILVM *vm) {
+	while (vm->bv_pool_len) {
+		free(vm->bv_pool[--vm->bv_pool_len]);
+	}
+	while (vm->bool_pool_len) {
+		rz_il_bool_free(vm->bool_pool[--vm->bool_pool_len]);
+	}
 }
 
 /**
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef RZ_IL_VM_PRIVATE_H
+#define RZ_IL_VM_PRIVATE_H
+
+#include <rz_il/rz_il_vm.h>
+
+/*
+ * Temporaries of the pure handlers. The values they return are still
+ * regular heap objects that may be freed with rz_bv_free()/rz_il_bool_free(),
+ * but the handlers give their operands back to the vm instead, so that the
+ * next ones can be reused without going through the allocator.
+ */
+RZ_IPI RZ_OWN RzBitVector *rz_il_vm_bv_new(RzILVM *vm, ut32 length);
+RZ_IPI RZ_OWN RzBitVector *rz_il_vm_bv_dup(RzILVM *vm, RZ_NONNULL const RzBitVector *bv);
+RZ_IPI void rz_il_vm_bv_release(RzILVM *vm, RZ_NULLABLE RZ_OWN RzBitVector *bv);
+RZ_IPI RZ_OWN RzILBool *rz_il_vm_bool_new(RzILVM *vm, bool b);
+RZ_IPI void rz_il_vm_bool_release(RzILVM *vm, RZ_NULLABLE RZ_OWN RzILBool *b);
+RZ_IPI void rz_il_vm_pools_fini(RzILVM *vm);
+
+#endif
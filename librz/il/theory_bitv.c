@@ -3,14 +3,31 @@
 
 #include <rz_il/rz_il_opcodes.h>
 #include <rz_il/rz_il_vm.h>
+#include "il_vm_private.h"
+
+/**
+ * Operands of at most 64 bits are computed in place, in the bitvector of the
+ * first operand, which the handler owns anyway.
+ */
+static inline bool small_unop(RzBitVector *x) {
+	return x && x->len <= 64;
+}
+
+static inline bool small_binop(RzBitVector *x, RzBitVector *y) {
+	return x && y && x->len <= 64 && x->len == y->len;
+}
+
+static inline ut64 small_mask(RzBitVector *x) {
+	return UT64_MAX >> (64 - x->len);
+}
 
 void *rz_il_handler_msb(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	rz_return_val_if_fail(vm && op && type, NULL);
 
 	RzILOpArgsMsb *op_msb = &op->op.msb;
 	RzBitVector *bv = rz_il_evaluate_bitv(vm, op_msb->bv);
-	RzILBool *result = bv ? rz_il_bool_new(rz_bv_msb(bv)) : NULL;
-	rz_bv_free(bv);
+	RzILBool *result = bv ? rz_il_vm_bool_new(vm, rz_bv_msb(bv)) : NULL;
+	rz_il_vm_bv_release(vm, bv);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -21,8 +38,8 @@ void *rz_il_handler_lsb(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzILOpArgsLsb *op_lsb = &op->op.lsb;
 	RzBitVector *bv = rz_il_evaluate_bitv(vm, op_lsb->bv);
-	RzILBool *result = bv ? rz_il_bool_new(rz_bv_lsb(bv)) : NULL;
-	rz_bv_free(bv);
+	RzILBool *result = bv ? rz_il_vm_bool_new(vm, rz_bv_lsb(bv)) : NULL;
+	rz_il_vm_bv_release(vm, bv);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -33,8 +50,8 @@ void *rz_il_handler_is_zero(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type)
 
 	RzILOpArgsLsb *op_lsb = &op->op.lsb;
 	RzBitVector *bv = rz_il_evaluate_bitv(vm, op_lsb->bv);
-	RzILBool *result = bv ? rz_il_bool_new(rz_bv_is_zero_vector(bv)) : NULL;
-	rz_bv_free(bv);
+	RzILBool *result = bv ? rz_il_vm_bool_new(vm, rz_bv_is_zero_vector(bv)) : NULL;
+	rz_il_vm_bv_release(vm, bv);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -46,8 +63,15 @@ void *rz_il_handler_neg(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	RzILOpArgsNeg *neg = &op->op.neg;
 
 	RzBitVector *bv_arg = rz_il_evaluate_bitv(vm, neg->bv);
-	RzBitVector *bv_result = bv_arg ? rz_bv_neg(bv_arg) : NULL;
-	rz_bv_free(bv_arg);
+	RzBitVector *bv_result = NULL;
+	if (small_unop(bv_arg)) {
+		bv_arg->bits.small_u = -bv_arg->bits.small_u & small_mask(bv_arg);
+		bv_result = bv_arg;
+		bv_arg = NULL;
+	} else if (bv_arg) {
+		bv_result = rz_bv_neg(bv_arg);
+	}
+	rz_il_vm_bv_release(vm, bv_arg);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return bv_result;
@@ -59,8 +83,15 @@ void *rz_il_handler_logical_not(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *t
 	RzILOpArgsLogNot *op_not = &op->op.lognot;
 
 	RzBitVector *bv = rz_il_evaluate_bitv(vm, op_not->bv);
-	RzBitVector *result = bv ? rz_bv_not(bv) : NULL;
-	rz_bv_free(bv);
+	RzBitVector *result = NULL;
+	if (small_unop(bv)) {
+		bv->bits.small_u = ~bv->bits.small_u & small_mask(bv);
+		result = bv;
+		bv = NULL;
+	} else if (bv) {
+		result = rz_bv_not(bv);
+	}
+	rz_il_vm_bv_release(vm, bv);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -73,9 +104,9 @@ void *rz_il_handler_eq(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_sle->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_sle->y);
-	RzILBool *result = x && y ? rz_il_bool_new(rz_bv_eq(x, y)) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzILBool *result = x && y ? rz_il_vm_bool_new(vm, rz_bv_eq(x, y)) : NULL;
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -88,9 +119,9 @@ void *rz_il_handler_sle(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_sle->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_sle->y);
-	RzILBool *result = x && y ? rz_il_bool_new(rz_bv_sle(x, y)) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzILBool *result = x && y ? rz_il_vm_bool_new(vm, rz_bv_sle(x, y)) : NULL;
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -103,9 +134,9 @@ void *rz_il_handler_ule(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_ule->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_ule->y);
-	RzILBool *result = x && y ? rz_il_bool_new(rz_bv_ule(x, y)) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzILBool *result = x && y ? rz_il_vm_bool_new(vm, rz_bv_ule(x, y)) : NULL;
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -118,10 +149,17 @@ void *rz_il_handler_add(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_add->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_add->y);
-	RzBitVector *result = x && y ? rz_bv_add(x, y, NULL) : NULL;
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = (x->bits.small_u + y->bits.small_u) & small_mask(x);
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_add(x, y, NULL);
+	}
 
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -135,8 +173,8 @@ void *rz_il_handler_append(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type)
 	RzBitVector *high = rz_il_evaluate_bitv(vm, op_append->high);
 	RzBitVector *low = rz_il_evaluate_bitv(vm, op_append->low);
 	RzBitVector *result = high && low ? rz_bv_append(high, low) : NULL;
-	rz_bv_free(low);
-	rz_bv_free(high);
+	rz_il_vm_bv_release(vm, low);
+	rz_il_vm_bv_release(vm, high);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -149,9 +187,16 @@ void *rz_il_handler_logical_and(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *t
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_add->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_add->y);
-	RzBitVector *result = x && y ? rz_bv_and(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = x->bits.small_u & y->bits.small_u;
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_and(x, y);
+	}
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -164,9 +209,16 @@ void *rz_il_handler_logical_or(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *ty
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_add->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_add->y);
-	RzBitVector *result = x && y ? rz_bv_or(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = x->bits.small_u | y->bits.small_u;
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_or(x, y);
+	}
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -179,9 +231,16 @@ void *rz_il_handler_logical_xor(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *t
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_add->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_add->y);
-	RzBitVector *result = x && y ? rz_bv_xor(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = x->bits.small_u ^ y->bits.small_u;
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_xor(x, y);
+	}
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -194,9 +253,16 @@ void *rz_il_handler_sub(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_sub->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_sub->y);
-	RzBitVector *result = x && y ? rz_bv_sub(x, y, NULL) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = (x->bits.small_u - y->bits.small_u) & small_mask(x);
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_sub(x, y, NULL);
+	}
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -209,10 +275,17 @@ void *rz_il_handler_mul(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_mul->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_mul->y);
-	RzBitVector *result = x && y ? rz_bv_mul(x, y) : NULL;
+	RzBitVector *result = NULL;
+	if (small_binop(x, y)) {
+		x->bits.small_u = (x->bits.small_u * y->bits.small_u) & small_mask(x);
+		result = x;
+		x = NULL;
+	} else if (x && y) {
+		result = rz_bv_mul(x, y);
+	}
 
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -228,7 +301,7 @@ void *rz_il_handler_div(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	RzBitVector *result = NULL;
 	if (x && y) {
 		if (rz_bv_is_zero_vector(y)) {
-			result = rz_bv_new(y->len);
+			result = rz_il_vm_bv_new(vm, y->len);
 			rz_bv_set_all(result, true);
 			rz_il_vm_event_add(vm, rz_il_event_exception_new("division by zero"));
 		} else {
@@ -236,8 +309,8 @@ void *rz_il_handler_div(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 		}
 	}
 
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -251,8 +324,8 @@ void *rz_il_handler_sdiv(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_sdiv->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_sdiv->y);
 	RzBitVector *result = x && y ? rz_bv_sdiv(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -266,8 +339,8 @@ void *rz_il_handler_mod(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_mod->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_mod->y);
 	RzBitVector *result = x && y ? rz_bv_mod(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -281,8 +354,8 @@ void *rz_il_handler_smod(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	RzBitVector *x = rz_il_evaluate_bitv(vm, op_smod->x);
 	RzBitVector *y = rz_il_evaluate_bitv(vm, op_smod->y);
 	RzBitVector *result = x && y ? rz_bv_smod(x, y) : NULL;
-	rz_bv_free(x);
-	rz_bv_free(y);
+	rz_il_vm_bv_release(vm, x);
+	rz_il_vm_bv_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -299,12 +372,13 @@ void *rz_il_handler_shiftl(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type)
 
 	RzBitVector *result = NULL;
 	if (bv && shift && fill_bit) {
-		result = rz_bv_dup(bv);
-		rz_bv_lshift_fill(result, rz_bv_to_ut32(shift), fill_bit->b);
+		rz_bv_lshift_fill(bv, rz_bv_to_ut32(shift), fill_bit->b);
+		result = bv;
+		bv = NULL;
 	}
-	rz_bv_free(shift);
-	rz_bv_free(bv);
-	rz_il_bool_free(fill_bit);
+	rz_il_vm_bv_release(vm, shift);
+	rz_il_vm_bv_release(vm, bv);
+	rz_il_vm_bool_release(vm, fill_bit);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -321,13 +395,14 @@ void *rz_il_handler_shiftr(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type)
 
 	RzBitVector *result = NULL;
 	if (bv && shift && fill_bit) {
-		result = rz_bv_dup(bv);
-		rz_bv_rshift_fill(result, rz_bv_to_ut32(shift), fill_bit->b);
+		rz_bv_rshift_fill(bv, rz_bv_to_ut32(shift), fill_bit->b);
+		result = bv;
+		bv = NULL;
 	}
 
-	rz_bv_free(shift);
-	rz_bv_free(bv);
-	rz_il_bool_free(fill_bit);
+	rz_il_vm_bv_release(vm, shift);
+	rz_il_vm_bv_release(vm, bv);
+	rz_il_vm_bool_release(vm, fill_bit);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return result;
@@ -337,7 +412,7 @@ void *rz_il_handler_bitv(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	rz_return_val_if_fail(vm && op && type, NULL);
 	RzILOpArgsBv *op_bitv = &op->op.bitv;
 
-	RzBitVector *bv = rz_bv_dup(op_bitv->value);
+	RzBitVector *bv = rz_il_vm_bv_dup(vm, op_bitv->value);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return bv;
@@ -353,15 +428,16 @@ void *rz_il_handler_cast(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 	}
 	RzBitVector *bv = rz_il_evaluate_bitv(vm, op_cast->val);
 	if (!bv) {
+		rz_il_vm_bool_release(vm, fill);
 		return NULL;
 	}
 
-	RzBitVector *ret = rz_bv_new(op_cast->length);
+	RzBitVector *ret = rz_il_vm_bv_new(vm, op_cast->length);
 	rz_bv_set_all(ret, fill->b);
 	rz_bv_copy_nbits(bv, 0, ret, 0, RZ_MIN(bv->len, ret->len));
 
-	rz_il_bool_free(fill);
-	rz_bv_free(bv);
+	rz_il_vm_bool_release(vm, fill);
+	rz_il_vm_bv_release(vm, bv);
 
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return ret;
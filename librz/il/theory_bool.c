@@ -3,6 +3,7 @@
 
 #include <rz_il/rz_il_opcodes.h>
 #include <rz_il/rz_il_vm.h>
+#include "il_vm_private.h"
 
 /**
  * \brief also known as b0
@@ -10,7 +11,7 @@
 void *rz_il_handler_bool_false(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 	rz_return_val_if_fail(vm && op && type, NULL);
 
-	RzILBool *ret = rz_il_bool_new(false);
+	RzILBool *ret = rz_il_vm_bool_new(vm, false);
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return ret;
 }
@@ -21,7 +22,7 @@ void *rz_il_handler_bool_false(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 void *rz_il_handler_bool_true(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 	rz_return_val_if_fail(vm && op && type, NULL);
 
-	RzILBool *ret = rz_il_bool_new(true);
+	RzILBool *ret = rz_il_vm_bool_new(vm, true);
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return ret;
 }
@@ -33,9 +34,15 @@ void *rz_il_handler_bool_and(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 	RzILBool *x = rz_il_evaluate_bool(vm, op_and->x);
 	RzILBool *y = rz_il_evaluate_bool(vm, op_and->y);
 
-	RzILBool *result = x && y ? rz_il_bool_and(x, y) : NULL;
-	rz_il_bool_free(x);
-	rz_il_bool_free(y);
+	RzILBool *result = NULL;
+	if (x && y) {
+		// computed in place, the operands are owned by the handler
+		x->b = x->b && y->b;
+		result = x;
+		x = NULL;
+	}
+	rz_il_vm_bool_release(vm, x);
+	rz_il_vm_bool_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -48,9 +55,14 @@ void *rz_il_handler_bool_or(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 	RzILBool *x = rz_il_evaluate_bool(vm, op_or->x);
 	RzILBool *y = rz_il_evaluate_bool(vm, op_or->y);
 
-	RzILBool *result = x && y ? rz_il_bool_or(x, y) : NULL;
-	rz_il_bool_free(x);
-	rz_il_bool_free(y);
+	RzILBool *result = NULL;
+	if (x && y) {
+		x->b = x->b || y->b;
+		result = x;
+		x = NULL;
+	}
+	rz_il_vm_bool_release(vm, x);
+	rz_il_vm_bool_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -63,9 +75,14 @@ void *rz_il_handler_bool_xor(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 	RzILBool *x = rz_il_evaluate_bool(vm, op_xor->x);
 	RzILBool *y = rz_il_evaluate_bool(vm, op_xor->y);
 
-	RzILBool *result = x && y ? rz_il_bool_xor(x, y) : NULL;
-	rz_il_bool_free(x);
-	rz_il_bool_free(y);
+	RzILBool *result = NULL;
+	if (x && y) {
+		x->b = x->b != y->b;
+		result = x;
+		x = NULL;
+	}
+	rz_il_vm_bool_release(vm, x);
+	rz_il_vm_bool_release(vm, y);
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
 	return result;
@@ -79,9 +96,10 @@ void *rz_il_handler_bool_inv(RzILVM *vm, RzILOpBool *op, RzILTypePure *type) {
 
 	RzILOpArgsBoolInv *op_inv = &op->op.boolinv;
 	RzILBool *x = rz_il_evaluate_bool(vm, op_inv->x);
-	RzILBool *result = x ? rz_il_bool_not(x) : NULL;
-	rz_il_bool_free(x);
+	if (x) {
+		x->b = !x->b;
+	}
 
 	*type = RZ_IL_TYPE_PURE_BOOL;
-	return result;
+	return x;
 }
@@ -4,6 +4,7 @@
 
 #include <rz_il/rz_il_opcodes.h>
 #include <rz_il/rz_il_vm.h>
+#include "il_vm_private.h"
 
 static RzILEvent *il_event_new_write_from_var(RzILVM *vm, RzILVar *var, RzILVal *new_val) {
 	rz_return_val_if_fail(vm && var && new_val, NULL);
@@ -49,7 +50,7 @@ bool rz_il_handler_set(RzILVM *vm, RzILOpEffect *op) {
 
 static void perform_jump(RzILVM *vm, RZ_OWN RzBitVector *dst) {
 	rz_il_vm_event_add(vm, rz_il_event_pc_write_new(vm->pc, dst));
-	rz_bv_free(vm->pc);
+	rz_il_vm_bv_release(vm, vm->pc);
 	vm->pc = dst;
 }
 
@@ -108,9 +109,9 @@ bool rz_il_handler_repeat(RzILVM *vm, RzILOpEffect *op) {
 			break;
 		}
 		res = res && rz_il_evaluate_effect(vm, op_repeat->data_eff);
-		rz_il_bool_free(condition);
+		rz_il_vm_bool_release(vm, condition);
 	}
-	rz_il_bool_free(condition);
+	rz_il_vm_bool_release(vm, condition);
 
 	return res;
 }
@@ -130,7 +131,7 @@ bool rz_il_handler_branch(RzILVM *vm, RzILOpEffect *op) {
 	} else {
 		ret = rz_il_evaluate_effect(vm, op_branch->false_eff);
 	}
-	rz_il_bool_free(condition);
+	rz_il_vm_bool_release(vm, condition);
 
 	return ret;
 }
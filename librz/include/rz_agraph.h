@@ -41,6 +41,9 @@ typedef struct rz_core_graph_hits_t {
 #define RZ_AGRAPH_MODE_COMMENTS 4
 #define RZ_AGRAPH_MODE_MAX      5
 
+/* number of nodes from which the scalable layout is used by default */
+#define RZ_AGRAPH_SCALABLE_NODES 512
+
 typedef void (*RzANodeCallback)(RzANode *n, void *user);
 typedef void (*RAEdgeCallback)(RzANode *from, RzANode *to, void *user);
 
@@ -75,6 +78,7 @@ typedef struct rz_ascii_graph_t {
 	RzANodeCallback on_curnode_change;
 	void *on_curnode_change_data;
 	bool dummy; // enable the dummy nodes for better layouting
+	int scalable; // number of nodes from which the scalable layout is used, 0 to never use it
 	bool show_node_titles;
 	bool show_node_body;
 
@@ -88,6 +92,7 @@ typedef struct rz_ascii_graph_t {
 	unsigned int n_layers;
 	RzList /*<struct dist_t *>*/ *dists;
 	RzList /*<AEdge *>*/ *edges;
+	HtUP /*<ut64, struct agraph_layout_cache_t *>*/ *layout_cache; // scalable layouts by graph signature
 	RzAGraphHits ghits;
 } RzAGraph;
 
@@ -452,6 +452,8 @@ typedef struct rz_analysis_hint_cb_t {
 } RHintCb;
 
 typedef struct rz_analysis_il_vm_t RzAnalysisILVM;
+typedef struct rz_analysis_xref_store_t RzAnalysisXRefStore;
+typedef struct rz_analysis_op_cache_t RzAnalysisOpCache;
 
 typedef struct rz_analysis_t {
 	char *cpu; // analysis.cpu
@@ -488,8 +490,7 @@ typedef struct rz_analysis_t {
 	RzList /*<RzAnalysisPlugin *>*/ *plugins;
 	Sdb *sdb_noret;
 	Sdb *sdb_fmts;
-	HtUP *ht_xrefs_from;
-	HtUP *ht_xrefs_to;
+	RzAnalysisXRefStore *xrefs; ///< replaces the removed ht_xrefs_from and ht_xrefs_to tables, use the rz_analysis_xrefs_*() API instead
 	bool recursive_noreturn; // analysis.rnr
 	// moved from RzAnalysisFcn
 	Sdb *sdb; // root
@@ -522,6 +523,7 @@ typedef struct rz_analysis_t {
 	HtPP *ht_global_var; // global variables
 	RBTree global_var_tree; // global variables by address. must not overlap
 	RzHash *hash;
+	RzAnalysisOpCache *op_cache; ///< decoded ops, NULL if disabled
 } RzAnalysis;
 
 typedef enum rz_analysis_addr_hint_type_t {
@@ -1053,6 +1055,7 @@ typedef struct rz_analysis_esil_t {
 	ut8 lastsz; // in bits //used for signature-flag
 	/* native ops and custom ops */
 	HtPP *ops;
+	HtPP *programs; // compiled expressions, by expression string
 	RzStrBuf current_opstr;
 	RzIDStorage *sources;
 	HtUP *interrupts;
@@ -1129,6 +1132,9 @@ typedef struct rz_analysis_il_config_t {
 	// more information might go in here, for example additional memories, etc.
 } RzAnalysisILConfig;
 
+#define RZ_ANALYSIS_IL_VM_CODE_MAX   32 ///< bytes read to lift a single instruction
+#define RZ_ANALYSIS_IL_VM_LIFTED_MAX 0x4000 ///< default maximum of lifted instructions kept by a vm
+
 /**
  * \brief High-level RzIL vm to emulate disassembled code
  *
@@ -1140,6 +1146,10 @@ struct rz_analysis_il_vm_t {
 	RZ_NONNULL RzILVM *vm; ///< low-level vm to execute IL code
 	RZ_NONNULL RzBuffer *io_buf; ///< buffer to use for memory 0 (io)
 	RZ_NONNULL RzILRegBinding *reg_binding; ///< specifies which (global) variables are bound to registers
+	RZ_NULLABLE HtUP *lifted; ///< pc -> lifted instruction, reused by rz_analysis_il_vm_step_while()
+	size_t lifted_max; ///< maximum number of lifted instructions to keep, 0 to lift every step
+	ut64 ops_lifted; ///< number of instructions lifted by the steps
+	ut64 ops_reused; ///< number of steps that reused a lifted instruction
 } /* RzAnalysisILVM */;
 
 typedef enum {
@@ -1411,6 +1421,7 @@ RZ_API void rz_analysis_function_remove_block(RzAnalysisFunction *fcn, RzAnalysi
 // size of the entire range that the function spans, including holes.
 // this is exactly rz_analysis_function_max_addr() - rz_analysis_function_min_addr()
 RZ_API ut64 rz_analysis_function_linear_size(RzAnalysisFunction *fcn);
+RZ_API ut64 rz_analysis_function_linear_size_nocache(RZ_NONNULL const RzAnalysisFunction *fcn);
 
 // lowest address covered by the function
 RZ_API ut64 rz_analysis_function_min_addr(RzAnalysisFunction *fcn);
@@ -1474,6 +1485,12 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 RZ_API RzAnalysisOp *rz_analysis_op_hexstr(RzAnalysis *analysis, ut64 addr, const char *hexstr);
 RZ_API char *rz_analysis_op_to_string(RzAnalysis *analysis, RzAnalysisOp *op);
 
+/* op_cache.c */
+RZ_API bool rz_analysis_op_cache_resize(RZ_NONNULL RzAnalysis *analysis, size_t slots);
+RZ_API void rz_analysis_op_cache_invalidate(RZ_NONNULL RzAnalysis *analysis, ut64 addr);
+RZ_API void rz_analysis_op_cache_invalidate_all(RZ_NONNULL RzAnalysis *analysis);
+RZ_API void rz_analysis_op_cache_stats(RZ_NONNULL RzAnalysis *analysis, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses);
+
 RZ_API RzAnalysisEsil *rz_analysis_esil_new(int stacksize, int iotrap, unsigned int addrsize);
 RZ_API bool rz_analysis_esil_set_pc(RzAnalysisEsil *esil, ut64 addr);
 RZ_API bool rz_analysis_esil_setup(RzAnalysisEsil *esil, RzAnalysis *analysis, int romem, int stats, int nonull);
@@ -1576,6 +1593,8 @@ RZ_API RZ_OWN RzAnalysisILVM *rz_analysis_il_vm_new(RzAnalysis *a, RZ_NULLABLE R
 RZ_API void rz_analysis_il_vm_free(RZ_NULLABLE RzAnalysisILVM *vm);
 RZ_API void rz_analysis_il_vm_sync_from_reg(RzAnalysisILVM *vm, RZ_NONNULL RzReg *reg);
 RZ_API bool rz_analysis_il_vm_sync_to_reg(RzAnalysisILVM *vm, RZ_NONNULL RzReg *reg);
+RZ_API void rz_analysis_il_vm_cache_set_max(RZ_NONNULL RzAnalysisILVM *vm, size_t max);
+RZ_API void rz_analysis_il_vm_cache_clear(RZ_NONNULL RzAnalysisILVM *vm);
 RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisILVM *vm, RZ_NULLABLE RzReg *reg);
 RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisILVM *vm, RZ_NULLABLE RzReg *reg,
 	bool (*cond)(RzAnalysisILVM *vm, void *user), void *user);
@@ -1629,6 +1648,7 @@ RZ_API int rz_analysis_function_resize(RzAnalysisFunction *fcn, int newsize);
 RZ_API bool rz_analysis_function_purity(RzAnalysisFunction *fcn);
 
 typedef bool (*RzAnalysisRefCmp)(RzAnalysisXRef *ref, void *data);
+typedef bool (*RzAnalysisXRefCb)(const RzAnalysisXRef *xref, void *user);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xref_list_new(void);
 RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis);
 RZ_API const char *rz_analysis_xrefs_type_tostring(RzAnalysisXRefType type);
@@ -1638,7 +1658,11 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalys
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_list(RzAnalysis *analysis);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_from(RzAnalysisFunction *fcn);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_to(RzAnalysisFunction *fcn);
+RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to_range(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to);
+RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from_range(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to);
+RZ_API bool rz_analysis_xrefs_foreach(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisXRefCb cb, void *user);
 RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type);
+RZ_API size_t rz_analysis_xrefs_set_bulk(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const RzVector /*<RzAnalysisXRef>*/ *xrefs);
 RZ_API bool rz_analysis_xrefs_deln(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type);
 RZ_API bool rz_analysis_xref_del(RzAnalysis *analysis, ut64 from, ut64 to);
 
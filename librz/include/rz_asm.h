@@ -176,6 +176,7 @@ RZ_API char *rz_asm_to_string(RzAsm *a, ut64 addr, const ut8 *b, int l);
 RZ_API ut8 *rz_asm_from_string(RzAsm *a, ut64 addr, const char *b, int *l);
 RZ_API int rz_asm_sub_names_input(RzAsm *a, const char *f);
 RZ_API int rz_asm_sub_names_output(RzAsm *a, const char *f);
+RZ_API RZ_BORROW Sdb *rz_asm_get_descriptions(RzAsm *a);
 RZ_API char *rz_asm_describe(RzAsm *a, const char *str);
 RZ_API RzList /*<RzAsmPlugin *>*/ *rz_asm_get_plugins(RzAsm *a);
 RZ_API void rz_asm_list_directives(void);
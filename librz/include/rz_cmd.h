@@ -421,6 +421,18 @@ typedef struct rz_cmd_desc_t {
 	 * Reference to the help structure of this command descriptor.
 	 */
 	const RzCmdDescHelp *help;
+	/**
+	 * Combination of the RzOutputMode values in which the command does not
+	 * modify the state of RzCore, thus it can run in a task concurrently with
+	 * other read-only commands. Commands without output modes use
+	 * RZ_OUTPUT_MODE_STANDARD.
+	 *
+	 * TODO: pdf, axt and afij cannot be marked yet. pdf writes the shared
+	 * RzAsm/RzPrint state, core->num and core->block, and afij goes through
+	 * the archbits callback and the op cache. These writes must be removed
+	 * before they can run alongside a background `aaa`.
+	 */
+	int read_only_modes;
 
 	/**
 	 * Type-specific fields.
@@ -544,6 +556,9 @@ RZ_API RzCmdDesc *rz_cmd_desc_fake_new(RzCmd *cmd, RzCmdDesc *parent, const char
 RZ_API RzCmdDesc *rz_cmd_desc_parent(RzCmdDesc *cd);
 RZ_API RzCmdDesc *rz_cmd_desc_get_exec(RzCmdDesc *cd);
 RZ_API bool rz_cmd_desc_set_default_mode(RzCmdDesc *cd, RzOutputMode mode);
+RZ_API void rz_cmd_desc_set_read_only(RZ_NONNULL RzCmdDesc *cd, bool read_only);
+RZ_API void rz_cmd_desc_set_read_only_modes(RZ_NONNULL RzCmdDesc *cd, int modes);
+RZ_API bool rz_cmd_desc_is_read_only(RZ_NONNULL RzCmdDesc *cd, RZ_NONNULL const char *cmdid);
 RZ_API bool rz_cmd_desc_has_handler(const RzCmdDesc *cd);
 RZ_API bool rz_cmd_desc_remove(RzCmd *cmd, RzCmdDesc *cd);
 RZ_API void rz_cmd_foreach_cmdname(RzCmd *cmd, RzCmdDesc *begin, RzCmdForeachNameCb cb, void *user);
@@ -485,6 +485,8 @@ typedef struct rz_cons_context_t {
 	bool is_interactive;
 	bool pageable;
 	bool noflush;
+	bool streamed; ///< part of the output was already written by rz_cons_memcat()
+	bool stream_show; ///< state of the grep line range across the streamed chunks
 
 	int color_mode;
 	RzConsPalette cpal;
@@ -574,6 +576,7 @@ typedef struct rz_cons_t {
 	bool dotted_lines;
 	int linesleep;
 	int pagesize;
+	int stream_size; // write the complete lines once the buffer grows beyond this, 0 to buffer the whole output
 	char *break_word;
 	int break_word_len;
 	ut64 timeout; // must come from rz_time_now_mono()
@@ -905,6 +908,8 @@ RZ_API void rz_cons_pop(void);
 RZ_API RzConsContext *rz_cons_context_new(RZ_NULLABLE RzConsContext *parent);
 RZ_API void rz_cons_context_free(RzConsContext *context);
 RZ_API void rz_cons_context_load(RzConsContext *context);
+RZ_API void rz_cons_context_load_thread(RZ_NULLABLE RzConsContext *context);
+RZ_API RZ_BORROW RzConsContext *rz_cons_context(void);
 RZ_API void rz_cons_context_reset(void);
 RZ_API bool rz_cons_context_is_main(void);
 RZ_API void rz_cons_context_break(RzConsContext *context);
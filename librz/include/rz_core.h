@@ -151,10 +151,20 @@ typedef struct rz_core_io_map_info_t {
 	int perm_orig;
 } RzCoreIOMapInfo;
 
+#define RZ_CORE_INIT_STAGES_MAX 24
+
+typedef struct rz_core_init_stage_t {
+	const char *name; ///< name of the rz_core_init() stage
+	ut64 time; ///< microseconds spent in the stage
+} RzCoreInitStage;
+
 typedef struct rz_core_times_t {
 	ut64 loadlibs_init_time;
 	ut64 loadlibs_time;
 	ut64 file_open_time;
+	ut64 init_time; ///< microseconds spent in rz_core_init()
+	RzCoreInitStage init_stages[RZ_CORE_INIT_STAGES_MAX];
+	size_t init_stages_count;
 } RzCoreTimes;
 
 #define RZ_CORE_ASMQJMPS_NUM         10
@@ -225,6 +235,13 @@ typedef struct rz_core_tasks_t {
 	RzThreadLock *lock;
 	int tasks_running;
 	bool oneshot_running;
+	RzThreadLock *rw_lock; ///< Protects the fields below, which let the read-only tasks run concurrently
+	RzThreadCond *rw_cond;
+	int readers_running; ///< Number of read-only tasks running
+	int readers_waiting; ///< Number of read-only tasks waiting for the running task to yield
+	int writers_waiting; ///< Number of tasks waiting for the read-only tasks to end
+	ut32 readers_gen; ///< Incremented each time the waiting read-only tasks are admitted
+	bool writer_active; ///< True while a task which can modify the state is running
 } RzCoreTaskScheduler;
 
 /**
@@ -1148,6 +1165,7 @@ struct rz_core_task_t {
 	RzThreadLock *dispatch_lock;
 	RzThread *thread;
 	bool breaked;
+	bool read_only; ///< The task does not modify the state and runs concurrently with the other read-only tasks
 
 	RzCoreTaskRunner runner; // will be NULL for main task
 	RzCoreTaskRunnerFree runner_free;
@@ -1187,6 +1205,7 @@ RZ_API int rz_core_search_value_in_range(RzCore *core, RzInterval search_itv,
 // core-specific tasks
 typedef void (*RzCoreCmdTaskFinished)(const char *res, void *user);
 RZ_API RzCoreTask *rz_core_cmd_task_new(RzCore *core, const char *cmd, RzCoreCmdTaskFinished finished_cb, void *finished_cb_user);
+RZ_API bool rz_core_cmd_is_read_only(RZ_NONNULL RzCore *core, RZ_NONNULL const char *cmd);
 RZ_API const char *rz_core_cmd_task_get_result(RzCoreTask *task);
 typedef void *(*RzCoreTaskFunction)(RzCore *core, void *user);
 RZ_API RzCoreTask *rz_core_function_task_new(RzCore *core, RzCoreTaskFunction fcn, void *fcn_user);
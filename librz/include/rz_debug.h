@@ -175,11 +175,27 @@ typedef struct {
 	ut64 data;
 } RzDebugChangeReg;
 
+#define RZ_DEBUG_SESSION_PAGE_SIZE 0x1000
+
+/**
+ * \brief Consecutive bytes of a page written by the same step
+ */
 typedef struct {
 	int cnum;
-	ut8 data;
+	ut16 offset; ///< offset of the first byte in the page
+	ut16 size; ///< number of bytes written
+	ut32 data; ///< index of the bytes in RzDebugMemPage.data
 } RzDebugChangeMem;
 
+/**
+ * \brief Write history of a page, stored as deltas sorted by cnum
+ */
+typedef struct rz_debug_mem_page_t {
+	ut64 addr; ///< aligned to RZ_DEBUG_SESSION_PAGE_SIZE
+	RzVector /*<RzDebugChangeMem>*/ changes;
+	RzVector /*<ut8>*/ data; ///< bytes of all the changes
+} RzDebugMemPage;
+
 typedef struct rz_debug_checkpoint_t {
 	int cnum;
 	RzRegArena *arena[RZ_REG_TYPE_LAST];
@@ -191,7 +207,7 @@ typedef struct rz_debug_session_t {
 	ut32 maxcnum;
 	RzDebugCheckpoint *cur_chkpt;
 	RzVector /*<RzDebugCheckpoint>*/ *checkpoints;
-	HtUP *memory; /* RzVector<RzDebugChangeMem> */
+	HtUP *memory; /* RzDebugMemPage by page address */
 	HtUP *registers; /* RzVector<RzDebugChangeReg> */
 	int reasontype /*RzDebugReasonType*/;
 	RzBreakpointItem *bp;
@@ -573,6 +589,7 @@ RZ_API void rz_debug_esil_prestep(RzDebug *d, int p);
 RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg);
 RZ_API bool rz_debug_session_add_reg_change(RzDebugSession *session, int arena, ut64 offset, ut64 data);
 RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr, ut8 data);
+RZ_API bool rz_debug_session_add_mem_changes(RZ_NONNULL RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *buf, size_t len);
 RZ_API void rz_debug_session_restore_reg_mem(RzDebug *dbg, ut32 cnum);
 RZ_API void rz_debug_session_list_memory(RzDebug *dbg);
 RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db);
@@ -219,7 +219,9 @@ RZ_API RZ_OWN RzFlirtNode *rz_sign_flirt_node_from_function(RZ_NONNULL RzAnalysi
 RZ_API void rz_sign_flirt_node_free(RZ_NULLABLE RzFlirtNode *node);
 RZ_API void rz_sign_flirt_info_fini(RZ_NULLABLE RzFlirtInfo *info);
 
-RZ_API bool rz_sign_flirt_apply(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const char *flirt_file, ut8 expected_arch);
+RZ_API RZ_OWN RzFlirtNode *rz_sign_flirt_parse_file(RZ_NONNULL const char *flirt_file, ut8 expected_arch);
+RZ_API bool rz_sign_flirt_apply(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const char *flirt_file, ut8 expected_arch, size_t max_threads);
+RZ_API bool rz_sign_flirt_apply_nodes(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const RzPVector /*<RzFlirtNode *>*/ *trees, size_t max_threads);
 
 typedef struct rz_flirt_compressed_options_t {
 	ut8 version; ///< FLIRT version (supported only from v5 to v10)
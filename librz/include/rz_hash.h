@@ -46,6 +46,7 @@ typedef struct rz_hash_cfg_t {
 	RzList /*<HashCfgConfig *>*/ *configurations;
 	RzHashStatus status;
 	RzHash *hash;
+	size_t threads; ///< max threads updating the algorithms of a large buffer in parallel (1 by default, 0 means all cores)
 } RzHashCfg;
 
 #ifdef RZ_API
@@ -31,6 +31,8 @@ typedef bool (*RzILOpEffectHandler)(RzILVM *vm, RzILOpEffect *op);
 
 typedef void (*RzILVmHook)(RzILVM *vm, RzILOpEffect *op);
 
+#define RZ_IL_VM_POOL_MAX 32 ///< number of freed temporaries of each kind kept for reuse
+
 /**
  * \brief Low-level VM to execute raw IL code
  */
@@ -48,6 +50,10 @@ struct rz_il_vm_t {
 	RzILOpEffectHandler *op_handler_effect_table; ///< Array of Handler, handler can be indexed by opcode
 	RzList /*<RzILEvent *>*/ *events; ///< List of events that has happened in the last step
 	bool big_endian; ///< Sets the endianness of the memory reads/writes operations
+	RzBitVector *bv_pool[RZ_IL_VM_POOL_MAX]; ///< Freed bitvectors of at most 64 bits, reused by the evaluation
+	ut32 bv_pool_len;
+	RzILBool *bool_pool[RZ_IL_VM_POOL_MAX]; ///< Freed bools, reused by the evaluation
+	ut32 bool_pool_len;
 };
 
 // VM high level operations
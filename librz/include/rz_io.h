@@ -16,6 +16,8 @@
 #define RZ_IO_SEEK_CUR 1
 #define RZ_IO_SEEK_END 2
 
+#define RZ_IO_PAGE_CACHE_PAGE_SIZE 0x1000
+
 #define rz_io_map_get_from(map) map->itv.addr
 #define rz_io_map_get_to(map)   (rz_itv_size(map->itv) ? rz_itv_end(map->itv) - 1 : 0)
 
@@ -56,6 +58,8 @@ extern "C" {
 
 RZ_LIB_VERSION_HEADER(rz_io);
 
+typedef struct rz_io_page_cache_t RzIOPageCache;
+
 typedef struct rz_io_t {
 	struct rz_io_desc_t *desc; // XXX deprecate... we should use only the fd integer, not hold a weak pointer
 	ut64 off;
@@ -75,6 +79,7 @@ typedef struct rz_io_t {
 	RzIDStorage *files;
 	RzPVector /*<RzIOCache *>*/ cache;
 	RzSkyline cache_skyline;
+	RzIOPageCache *page_cache; ///< read cache of plugin pages, disabled while it has no slots
 	ut8 *write_mask;
 	int write_mask_len;
 	RzList /*<RzIOPlugin *>*/ *plugins;
@@ -140,6 +145,7 @@ typedef struct rz_io_plugin_t {
 	int (*create)(RzIO *io, const char *file, int mode, int type);
 	bool (*check)(RzIO *io, const char *, bool many);
 	ut8 *(*get_buf)(RzIODesc *desc, ut64 *size);
+	const ut8 *(*borrow)(RzIODesc *desc, ut64 addr, ut64 len); ///< optional, pointer to [addr, addr + len) without copying it
 } RzIOPlugin;
 
 typedef struct rz_io_map_t {
@@ -327,6 +333,7 @@ RZ_API bool rz_io_vread_at_mapped(RzIO *io, ut64 vaddr, ut8 *buf, int len);
 RZ_API bool rz_io_read_at(RzIO *io, ut64 addr, ut8 *buf, int len);
 RZ_API bool rz_io_read_at_mapped(RzIO *io, ut64 addr, ut8 *buf, int len);
 RZ_API int rz_io_nread_at(RzIO *io, ut64 addr, ut8 *buf, int len);
+RZ_API RZ_BORROW const ut8 *rz_io_borrow_at(RZ_NONNULL RzIO *io, ut64 addr, ut64 len);
 RZ_API bool rz_io_write_at(RzIO *io, ut64 addr, const ut8 *buf, int len);
 RZ_API bool rz_io_read(RzIO *io, ut8 *buf, int len);
 RZ_API bool rz_io_write(RzIO *io, const ut8 *buf, int len);
@@ -368,6 +375,7 @@ RZ_API ut64 rz_io_desc_seek(RzIODesc *desc, ut64 offset, int whence);
 RZ_API bool rz_io_desc_resize(RzIODesc *desc, ut64 newsize);
 RZ_API ut64 rz_io_desc_size(RzIODesc *desc);
 RZ_API ut8 *rz_io_desc_get_buf(RzIODesc *desc, RZ_OUT RZ_NONNULL ut64 *size);
+RZ_API RZ_BORROW const ut8 *rz_io_desc_borrow_at(RZ_NULLABLE RzIODesc *desc, ut64 addr, ut64 len);
 RZ_API bool rz_io_desc_is_blockdevice(RzIODesc *desc);
 RZ_API bool rz_io_desc_is_chardevice(RzIODesc *desc);
 RZ_API bool rz_io_desc_exchange(RzIO *io, int fd, int fdx); // this should get 2 descs
@@ -392,6 +400,13 @@ RZ_API void rz_io_cache_reset(RzIO *io, int set);
 RZ_API bool rz_io_cache_write(RzIO *io, ut64 addr, const ut8 *buf, int len);
 RZ_API bool rz_io_cache_read(RzIO *io, ut64 addr, ut8 *buf, int len);
 
+/* io/io_page_cache.c */
+RZ_API bool rz_io_page_cache_resize(RZ_NONNULL RzIO *io, size_t pages);
+RZ_API void rz_io_page_cache_invalidate(RZ_NONNULL RzIO *io, int fd, ut64 from, ut64 to);
+RZ_API void rz_io_page_cache_invalidate_fd(RZ_NONNULL RzIO *io, int fd);
+RZ_API void rz_io_page_cache_invalidate_all(RZ_NONNULL RzIO *io);
+RZ_API void rz_io_page_cache_stats(RZ_NONNULL RzIO *io, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses);
+
 /* io/p_cache.c */
 RZ_API bool rz_io_desc_cache_init(RzIODesc *desc);
 RZ_API int rz_io_desc_cache_write(RzIODesc *desc, ut64 paddr, const ut8 *buf, int len);
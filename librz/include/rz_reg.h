@@ -156,6 +156,7 @@ typedef struct rz_reg_t {
 	int size;
 	bool is_thumb;
 	bool big_endian;
+	ut32 generation; ///< incremented whenever the register items are freed
 } RzReg;
 
 typedef struct rz_reg_flags_t {
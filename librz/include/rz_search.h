@@ -23,11 +23,18 @@ enum {
 	RZ_SEARCH_PRIV_KEY,
 	RZ_SEARCH_DELTAKEY,
 	RZ_SEARCH_MAGIC,
+	RZ_SEARCH_MULTIKEY,
 	RZ_SEARCH_LAST
 };
 
 #define RZ_SEARCH_DISTANCE_MAX 10
 
+/**
+ * Number of keywords from which RZ_SEARCH_KEYWORD switches to the
+ * multi-pattern matcher of RZ_SEARCH_MULTIKEY
+ */
+#define RZ_SEARCH_MULTIKEY_MIN 8
+
 #define RZ_SEARCH_KEYWORD_TYPE_BINARY 'i'
 #define RZ_SEARCH_KEYWORD_TYPE_STRING 's'
 
@@ -51,6 +58,8 @@ typedef struct rz_search_hit_t {
 
 typedef int (*RzSearchCallback)(RzSearchKeyword *kw, void *user, ut64 where);
 
+typedef struct rz_search_multi_t RzSearchMulti;
+
 typedef struct rz_search_t {
 	int n_kws; // hit${n_kws}_${count}
 	int mode;
@@ -70,6 +79,7 @@ typedef struct rz_search_t {
 	int align;
 	int (*update)(struct rz_search_t *s, ut64 from, const ut8 *buf, int len);
 	RzList /*<RzSearchKeyword *>*/ *kws; // TODO: Use rz_search_kw_new ()
+	RzSearchMulti *multi; // automaton over kws, built on demand by the keyword search
 	RzIOBind iob;
 	char bckwrds;
 } RzSearch;
@@ -102,6 +112,7 @@ RZ_API void rz_search_string_prepare_backward(RzSearch *s);
 
 // TODO: is this an internal API?
 RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
+RZ_API int rz_search_multikey_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_aes_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_privkey_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_magic_update(RzSearch *_s, ut64 from, const ut8 *buf, int len);
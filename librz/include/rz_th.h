@@ -28,8 +28,12 @@ typedef struct rz_th_cond_t RzThreadCond;
 typedef struct rz_th_t RzThread;
 typedef struct rz_th_pool_t RzThreadPool;
 typedef struct rz_th_queue_t RzThreadQueue;
+typedef struct rz_th_scheduler_t RzThreadScheduler;
+typedef struct rz_th_task_t RzThreadTask;
+typedef struct rz_th_task_group_t RzThreadTaskGroup;
 typedef void *(*RzThreadFunction)(void *user);
 typedef void (*RzThreadIterator)(void *element, void *user);
+typedef bool (*RzThreadBreakCheck)(void *user);
 
 typedef struct rz_atomic_bool_t RzAtomicBool;
 
@@ -59,6 +63,7 @@ RZ_API RZ_OWN RzThreadCond *rz_th_cond_new(void);
 RZ_API void rz_th_cond_signal(RZ_NONNULL RzThreadCond *cond);
 RZ_API void rz_th_cond_signal_all(RZ_NONNULL RzThreadCond *cond);
 RZ_API void rz_th_cond_wait(RZ_NONNULL RzThreadCond *cond, RZ_NONNULL RzThreadLock *lock);
+RZ_API bool rz_th_cond_timedwait(RZ_NONNULL RzThreadCond *cond, RZ_NONNULL RzThreadLock *lock, ut32 timeout_ms);
 RZ_API void rz_th_cond_free(RZ_NULLABLE RzThreadCond *cond);
 
 RZ_API size_t rz_th_physical_core_number();
@@ -81,6 +86,21 @@ RZ_API RZ_OWN RzList /*<void *>*/ *rz_th_queue_pop_all(RZ_NONNULL RzThreadQueue
 RZ_API bool rz_th_queue_is_empty(RZ_NONNULL RzThreadQueue *queue);
 RZ_API bool rz_th_queue_is_full(RZ_NONNULL RzThreadQueue *queue);
 
+RZ_API RZ_OWN RzThreadScheduler *rz_th_scheduler_new(size_t max_threads);
+RZ_API void rz_th_scheduler_free(RZ_NULLABLE RzThreadScheduler *scheduler);
+RZ_API size_t rz_th_scheduler_size(RZ_NONNULL RzThreadScheduler *scheduler);
+RZ_API RZ_OWN RzThreadTask *rz_th_scheduler_submit(RZ_NONNULL RzThreadScheduler *scheduler, RZ_NONNULL RzThreadFunction function, RZ_NULLABLE void *user);
+RZ_API RZ_OWN void *rz_th_task_join(RZ_NONNULL RzThreadTask *task);
+RZ_API bool rz_th_task_is_done(RZ_NONNULL RzThreadTask *task);
+RZ_API void rz_th_task_free(RZ_NULLABLE RzThreadTask *task);
+RZ_API RZ_OWN RzThreadTaskGroup *rz_th_task_group_new(RZ_NONNULL RzThreadScheduler *scheduler);
+RZ_API void rz_th_task_group_free(RZ_NULLABLE RzThreadTaskGroup *group);
+RZ_API void rz_th_task_group_set_break_check(RZ_NONNULL RzThreadTaskGroup *group, RZ_NULLABLE RzThreadBreakCheck check, RZ_NULLABLE void *user);
+RZ_API bool rz_th_task_group_submit(RZ_NONNULL RzThreadTaskGroup *group, RZ_NONNULL RzThreadFunction function, RZ_NULLABLE void *user);
+RZ_API void rz_th_task_group_cancel(RZ_NONNULL RzThreadTaskGroup *group);
+RZ_API bool rz_th_task_group_is_cancelled(RZ_NONNULL RzThreadTaskGroup *group);
+RZ_API bool rz_th_task_group_wait(RZ_NONNULL RzThreadTaskGroup *group);
+
 RZ_API RZ_OWN RzAtomicBool *rz_atomic_bool_new(bool value);
 RZ_API void rz_atomic_bool_free(RZ_NULLABLE RzAtomicBool *tbool);
 RZ_API bool rz_atomic_bool_get(RZ_NONNULL RzAtomicBool *tbool);
@@ -10,6 +10,7 @@
 #include <rz_bind.h>
 #include <rz_io.h>
 #include <rz_list.h>
+#include <rz_th.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,9 @@ typedef struct rz_type_db_t {
 	HtPP /*<char *, RzBaseType *>*/ *types; //< name -> base type
 	HtPP /*<char *, char *>*/ *formats; //< name -> `pf` format
 	HtPP /*<char *, RzCallable *>*/ *callables; //< name -> RzCallable (function type)
+	RzList /*<Sdb *>*/ *lazy_callables; //< compiled callable databases, loaded into `callables` on lookup
+	RzThreadLock *lazy_lock; //< serializes the lookups of callables with their loading from `lazy_callables`
+	bool pin_all; //< load the shipped databases eagerly instead of on lookup
 	RzTypeTarget *target;
 	RzTypeParser *parser;
 	RzNum *num;
@@ -238,6 +242,8 @@ RZ_API bool rz_type_db_load_sdb(RzTypeDB *typedb, RZ_NONNULL const char *path);
 RZ_API bool rz_type_db_load_sdb_str(RzTypeDB *typedb, RZ_NONNULL const char *str);
 RZ_API bool rz_type_db_load_callables_sdb(RzTypeDB *typedb, RZ_NONNULL const char *path);
 RZ_API bool rz_type_db_load_callables_sdb_str(RzTypeDB *typedb, RZ_NONNULL const char *str);
+RZ_API bool rz_type_db_open_callables_sdb(RzTypeDB *typedb, RZ_NONNULL const char *path);
+RZ_API void rz_type_db_pin_all(RzTypeDB *typedb);
 RZ_API void rz_type_db_set_bits(RzTypeDB *typedb, int bits);
 RZ_API void rz_type_db_set_address_bits(RzTypeDB *typedb, int addr_bits);
 RZ_API void rz_type_db_set_os(RzTypeDB *typedb, const char *os);
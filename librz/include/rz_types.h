@@ -73,6 +73,12 @@ typedef enum {
 #define RZ_UNUSED /* unused */
 #endif
 
+#ifdef _MSC_VER
+#define RZ_THREAD_LOCAL __declspec(thread)
+#else
+#define RZ_THREAD_LOCAL __thread
+#endif
+
 #ifdef RZ_NEW
 #undef RZ_NEW
 #endif
@@ -116,6 +116,7 @@ RZ_API RzIO *rz_io_init(RzIO *io) {
 	rz_skyline_init(&io->map_skyline);
 	rz_io_map_init(io);
 	rz_io_cache_init(io);
+	rz_io_page_cache_init(io);
 	rz_io_plugin_init(io);
 	io->event = rz_event_new(io);
 	return io;
@@ -261,6 +262,7 @@ RZ_API int rz_io_close_all(RzIO *io) { // what about undo?
 	rz_io_map_reset(io);
 	rz_io_desc_init(io);
 	rz_io_cache_fini(io);
+	rz_io_page_cache_invalidate_all(io);
 	return true;
 }
 
@@ -353,6 +355,43 @@ RZ_API int rz_io_nread_at(RzIO *io, ut64 addr, ut8 *buf, int len) {
 	return ret;
 }
 
+/**
+ * \brief Get a read-only pointer to the bytes at [\p addr, \p addr + \p len) without copying them
+ *
+ * This only succeeds when the whole range is served by a single map (or by
+ * the current descriptor in physical mode) whose plugin can lend its memory,
+ * e.g. a mmapped file, and no io cache or patch overlays any of it. Callers
+ * must fall back to rz_io_nread_at() or similar when NULL is returned.
+ *
+ * The pointer stays valid until the next write, resize or close of the
+ * underlying descriptor.
+ *
+ * \return The borrowed bytes or NULL if the range cannot be lent
+ */
+RZ_API RZ_BORROW const ut8 *rz_io_borrow_at(RZ_NONNULL RzIO *io, ut64 addr, ut64 len) {
+	rz_return_val_if_fail(io, NULL);
+	if (!len || UT64_ADD_OVFCHK(addr, len - 1) || io->p_cache || io->cachemode) {
+		return NULL;
+	}
+	if (io->cached & RZ_PERM_R && rz_skyline_get_item_intersect(&io->cache_skyline, addr, len)) {
+		return NULL;
+	}
+	if (!io->va) {
+		return rz_io_desc_borrow_at(io->desc, addr, len);
+	}
+	const RzSkylineItem *part = rz_skyline_get_item(&io->map_skyline, addr);
+	if (!part) {
+		return NULL;
+	}
+	ut64 part_last = rz_itv_end(part->itv) - 1;
+	RzIOMap *map = part->user;
+	if (addr + len - 1 > part_last || !(map->perm & RZ_PERM_R)) {
+		return NULL;
+	}
+	RzIODesc *desc = rz_io_desc_get(io, map->fd);
+	return rz_io_desc_borrow_at(desc, map->delta + addr - map->itv.addr, len);
+}
+
 RZ_API bool rz_io_write_at(RzIO *io, ut64 addr, const ut8 *buf, int len) {
 	int i;
 	bool ret = false;
@@ -728,6 +767,7 @@ RZ_API int rz_io_fini(RzIO *io) {
 	rz_io_map_fini(io);
 	rz_list_free(io->plugins);
 	rz_io_cache_fini(io);
+	rz_io_page_cache_fini(io);
 	if (io->runprofile) {
 		RZ_FREE(io->runprofile);
 	}
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include <rz_io.h>
+#include "io_private.h"
 #include <sdb.h>
 #include <string.h>
 
@@ -38,6 +39,9 @@ RZ_API void rz_io_desc_free(RzIODesc *desc) {
 		free(desc->referer);
 		free(desc->name);
 		rz_io_desc_cache_fini(desc);
+		if (desc->io) {
+			rz_io_page_cache_invalidate_fd(desc->io, desc->fd);
+		}
 		if (desc->io && desc->io->files) {
 			rz_id_storage_delete(desc->io->files, desc->fd);
 		}
@@ -247,9 +251,31 @@ RZ_API ut8 *rz_io_desc_get_buf(RzIODesc *desc, RZ_OUT RZ_NONNULL ut64 *size) {
 	return desc->plugin->get_buf(desc, size);
 }
 
+/**
+ * \brief Returns a pointer to the bytes [\p addr, \p addr + \p len) of the descriptor without copying them
+ *
+ * Only plugins that keep the whole content in memory (e.g. mmapped files)
+ * can lend their data. The pointer stays valid until the next write, resize
+ * or close of \p desc.
+ *
+ * \return The borrowed bytes or NULL if the range cannot be lent, in which case a read is needed
+ */
+RZ_API RZ_BORROW const ut8 *rz_io_desc_borrow_at(RZ_NULLABLE RzIODesc *desc, ut64 addr, ut64 len) {
+	if (!desc || !desc->plugin || !desc->plugin->borrow || !(desc->perm & RZ_PERM_R)) {
+		return NULL;
+	}
+	if (!len || addr + len < addr || (desc->io && desc->io->p_cache)) {
+		return NULL;
+	}
+	return desc->plugin->borrow(desc, addr, len);
+}
+
 RZ_API bool rz_io_desc_resize(RzIODesc *desc, ut64 newsize) {
 	if (desc && desc->plugin && desc->plugin->resize) {
 		bool ret = desc->plugin->resize(desc->io, desc, newsize);
+		if (desc->io) {
+			rz_io_page_cache_invalidate_fd(desc->io, desc->fd);
+		}
 		if (desc->io && desc->io->p_cache) {
 			rz_io_desc_cache_cleanup(desc);
 		}
@@ -281,6 +307,8 @@ RZ_API bool rz_io_desc_exchange(RzIO *io, int fd, int fdx) {
 	descx->fd = fd;
 	rz_id_storage_set(io->files, desc, fdx);
 	rz_id_storage_set(io->files, descx, fd);
+	rz_io_page_cache_invalidate_fd(io, fd);
+	rz_io_page_cache_invalidate_fd(io, fdx);
 	if (io->p_cache) {
 		HtUP *cache = desc->cache;
 		desc->cache = descx->cache;
@@ -349,6 +377,16 @@ RZ_API bool rz_io_desc_get_base(RzIODesc *desc, ut64 *base) {
 }
 
 RZ_API int rz_io_desc_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
+	if (desc && buf && desc->io && !desc->io->cachemode && rz_io_page_cache_enabled(desc->io)) {
+		if (!desc->plugin || !(desc->perm & RZ_PERM_R)) {
+			return -1;
+		}
+		int ret = rz_io_page_cache_read(desc, addr, buf, len);
+		if (ret > 0 && (desc->io->p_cache & 1)) {
+			ret = rz_io_desc_cache_read(desc, addr, buf, ret);
+		}
+		return ret;
+	}
 	ut64 val = rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET);
 	if (desc && buf && val != UT64_MAX && val == addr) {
 		return rz_io_desc_read(desc, buf, len);
@@ -17,5 +17,6 @@ int io_memory_read(RzIO *io, RzIODesc *fd, ut8 *buf, int count);
 ut64 io_memory_lseek(RzIO *io, RzIODesc *fd, ut64 offset, int whence);
 int io_memory_write(RzIO *io, RzIODesc *fd, const ut8 *buf, int count);
 bool io_memory_resize(RzIO *io, RzIODesc *fd, ut64 count);
+const ut8 *io_memory_borrow(RzIODesc *fd, ut64 addr, ut64 len);
 
 #endif
@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+#include <ht_uu.h>
+#include "io_private.h"
+
+/*
+ * Page granular read cache sitting between rz_io_desc_read_at() and the io
+ * plugins. Pages are keyed by (fd, physical page number), so map changes do
+ * not affect them; only writes to the descriptor, resizes and closing it
+ * drop cached pages. Eviction uses the CLOCK algorithm over a fixed set of
+ * slots.
+ *
+ * The cache lives as long as the RzIO and is disabled by having no slots, so
+ * that resizing it only swaps the slots under its lock and is safe against
+ * concurrent readers.
+ */
+
+#define IO_PAGE_SHIFT    12
+#define IO_PAGE_SIZE     RZ_IO_PAGE_CACHE_PAGE_SIZE
+#define IO_PAGE_MASK     ((ut64)IO_PAGE_SIZE - 1)
+#define IO_PAGE_FD_SHIFT 40
+#define IO_PAGE_FD_MAX   (1 << (64 - IO_PAGE_FD_SHIFT))
+#define IO_PAGE_NUM_MAX  (1ULL << IO_PAGE_FD_SHIFT)
+#define IO_PAGE_FREE     UT64_MAX
+
+typedef struct {
+	ut64 key; ///< (fd << IO_PAGE_FD_SHIFT) | page number, IO_PAGE_FREE for unused slots
+	int size; ///< valid bytes in the page, less than IO_PAGE_SIZE at the end of the file
+	bool referenced; ///< CLOCK bit
+} IOPage;
+
+struct rz_io_page_cache_t {
+	RzThreadLock *lock;
+	HtUU *index; ///< key -> slot
+	IOPage *pages;
+	ut8 *data; ///< count * IO_PAGE_SIZE bytes
+	size_t count; ///< 0 if disabled
+	size_t hand;
+	ut64 hits;
+	ut64 misses;
+};
+
+static inline ut64 page_key(int fd, ut64 paddr) {
+	return ((ut64)fd << IO_PAGE_FD_SHIFT) | (paddr >> IO_PAGE_SHIFT);
+}
+
+static inline bool page_cacheable(int fd, ut64 paddr, int len) {
+	return fd >= 0 && fd < IO_PAGE_FD_MAX && (paddr >> IO_PAGE_SHIFT) < IO_PAGE_NUM_MAX - 1 && paddr + len > paddr;
+}
+
+static void page_drop(RzIOPageCache *pc, size_t slot) {
+	IOPage *page = &pc->pages[slot];
+	if (page->key != IO_PAGE_FREE) {
+		ht_uu_delete(pc->index, page->key);
+		page->key = IO_PAGE_FREE;
+	}
+}
+
+static size_t page_evict(RzIOPageCache *pc) {
+	for (;;) {
+		size_t slot = pc->hand;
+		IOPage *page = &pc->pages[slot];
+		pc->hand = (pc->hand + 1) % pc->count;
+		if (page->key == IO_PAGE_FREE) {
+			return slot;
+		}
+		if (page->referenced) {
+			page->referenced = false;
+			continue;
+		}
+		page_drop(pc, slot);
+		return slot;
+	}
+}
+
+/**
+ * Reads a whole page from the plugin into a free slot.
+ * \return the slot or -1 if the plugin could not read anything
+ */
+static st64 page_fill(RzIOPageCache *pc, RzIODesc *desc, ut64 key, ut64 page_addr) {
+	size_t slot = page_evict(pc);
+	ut8 *data = pc->data + slot * IO_PAGE_SIZE;
+	if (rz_io_desc_seek(desc, page_addr, RZ_IO_SEEK_SET) != page_addr) {
+		return -1;
+	}
+	int size = rz_io_plugin_read(desc, data, IO_PAGE_SIZE);
+	if (size <= 0) {
+		return -1;
+	}
+	if (!ht_uu_insert(pc->index, key, slot)) {
+		return -1;
+	}
+	IOPage *page = &pc->pages[slot];
+	page->key = key;
+	page->size = size;
+	page->referenced = true;
+	return slot;
+}
+
+static void page_cache_free(RzIOPageCache *pc) {
+	if (!pc) {
+		return;
+	}
+	ht_uu_free(pc->index);
+	rz_th_lock_free(pc->lock);
+	free(pc->pages);
+	free(pc->data);
+	free(pc);
+}
+
+RZ_IPI void rz_io_page_cache_init(RzIO *io) {
+	RzIOPageCache *pc = RZ_NEW0(RzIOPageCache);
+	if (!pc) {
+		return;
+	}
+	pc->lock = rz_th_lock_new(true);
+	pc->index = ht_uu_new0();
+	if (!pc->lock || !pc->index) {
+		page_cache_free(pc);
+		return;
+	}
+	io->page_cache = pc;
+}
+
+/**
+ * \brief Enable, resize or disable the page cache
+ *
+ * The cached pages are dropped. Readers may run concurrently.
+ *
+ * \param io The RzIO instance
+ * \param pages Number of pages of RZ_IO_PAGE_CACHE_PAGE_SIZE bytes to keep, 0 disables the cache
+ * \return false if the cache could not be allocated, in which case it stays disabled
+ */
+RZ_API bool rz_io_page_cache_resize(RZ_NONNULL RzIO *io, size_t pages) {
+	rz_return_val_if_fail(io, false);
+	RzIOPageCache *pc = io->page_cache;
+	if (!pc) {
+		return !pages;
+	}
+	rz_th_lock_enter(pc->lock);
+	if (pc->count == pages) {
+		rz_th_lock_leave(pc->lock);
+		return true;
+	}
+	ht_uu_free(pc->index);
+	free(pc->pages);
+	free(pc->data);
+	pc->index = ht_uu_new0();
+	pc->pages = pages ? RZ_NEWS(IOPage, pages) : NULL;
+	pc->data = pages ? malloc(pages * IO_PAGE_SIZE) : NULL;
+	pc->count = pages;
+	pc->hand = 0;
+	pc->hits = 0;
+	pc->misses = 0;
+	bool ret = pc->index && (!pages || (pc->pages && pc->data));
+	if (!ret) {
+		RZ_FREE(pc->pages);
+		RZ_FREE(pc->data);
+		pc->count = 0;
+	}
+	for (size_t i = 0; i < pc->count; i++) {
+		pc->pages[i].key = IO_PAGE_FREE;
+		pc->pages[i].referenced = false;
+	}
+	rz_th_lock_leave(pc->lock);
+	return ret;
+}
+
+RZ_IPI void rz_io_page_cache_fini(RzIO *io) {
+	page_cache_free(io->page_cache);
+	io->page_cache = NULL;
+}
+
+/**
+ * \return true if the reads go through the page cache
+ */
+RZ_IPI bool rz_io_page_cache_enabled(RzIO *io) {
+	RzIOPageCache *pc = io->page_cache;
+	if (!pc) {
+		return false;
+	}
+	rz_th_lock_enter(pc->lock);
+	bool enabled = pc->count > 0;
+	rz_th_lock_leave(pc->lock);
+	return enabled;
+}
+
+/**
+ * \brief Drop the cached pages of \p fd overlapping [\p from, \p to)
+ */
+RZ_API void rz_io_page_cache_invalidate(RZ_NONNULL RzIO *io, int fd, ut64 from, ut64 to) {
+	rz_return_if_fail(io);
+	RzIOPageCache *pc = io->page_cache;
+	if (!pc || from >= to || fd < 0 || fd >= IO_PAGE_FD_MAX) {
+		return;
+	}
+	rz_th_lock_enter(pc->lock);
+	ut64 first = from >> IO_PAGE_SHIFT;
+	ut64 last = (to - 1) >> IO_PAGE_SHIFT;
+	if (last - first < pc->count) {
+		for (ut64 n = first; n <= last && n < IO_PAGE_NUM_MAX; n++) {
+			bool found = false;
+			ut64 slot = ht_uu_find(pc->index, ((ut64)fd << IO_PAGE_FD_SHIFT) | n, &found);
+			if (found) {
+				page_drop(pc, slot);
+			}
+		}
+	} else {
+		for (size_t i = 0; i < pc->count; i++) {
+			ut64 key = pc->pages[i].key;
+			if (key == IO_PAGE_FREE || (int)(key >> IO_PAGE_FD_SHIFT) != fd) {
+				continue;
+			}
+			ut64 n = key & (IO_PAGE_NUM_MAX - 1);
+			if (n >= first && n <= last) {
+				page_drop(pc, i);
+			}
+		}
+	}
+	rz_th_lock_leave(pc->lock);
+}
+
+/**
+ * \brief Drop all the cached pages of \p fd
+ */
+RZ_API void rz_io_page_cache_invalidate_fd(RZ_NONNULL RzIO *io, int fd) {
+	rz_io_page_cache_invalidate(io, fd, 0, UT64_MAX);
+}
+
+/**
+ * \brief Drop every cached page, e.g. after a debuggee ran and changed its memory
+ */
+RZ_API void rz_io_page_cache_invalidate_all(RZ_NONNULL RzIO *io) {
+	rz_return_if_fail(io);
+	RzIOPageCache *pc = io->page_cache;
+	if (!pc) {
+		return;
+	}
+	rz_th_lock_enter(pc->lock);
+	for (size_t i = 0; i < pc->count; i++) {
+		page_drop(pc, i);
+	}
+	rz_th_lock_leave(pc->lock);
+}
+
+/**
+ * \brief Get the number of reads served from the page cache and of pages read from the plugins
+ */
+RZ_API void rz_io_page_cache_stats(RZ_NONNULL RzIO *io, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses) {
+	rz_return_if_fail(io);
+	RzIOPageCache *pc = io->page_cache;
+	if (pc) {
+		rz_th_lock_enter(pc->lock);
+	}
+	if (hits) {
+		*hits = pc ? pc->hits : 0;
+	}
+	if (misses) {
+		*misses = pc ? pc->misses : 0;
+	}
+	if (pc) {
+		rz_th_lock_leave(pc->lock);
+	}
+}
+
+/**
+ * Reads through the page cache. Behaves like a plugin read at \p paddr:
+ * returns the number of bytes of the read prefix, or a value <= 0 if
+ * nothing could be read. Ranges the cache cannot hold are read directly.
+ */
+RZ_IPI int rz_io_page_cache_read(RzIODesc *desc, ut64 paddr, ut8 *buf, int len) {
+	RzIOPageCache *pc = desc->io->page_cache;
+	if (!pc || !page_cacheable(desc->fd, paddr, len) || rz_io_desc_is_chardevice(desc)) {
+		return rz_io_plugin_read_at(desc, paddr, buf, len);
+	}
+	rz_th_lock_enter(pc->lock);
+	if (!pc->count) {
+		// disabled since the caller checked
+		rz_th_lock_leave(pc->lock);
+		return rz_io_plugin_read_at(desc, paddr, buf, len);
+	}
+	int done = 0;
+	while (done < len) {
+		ut64 addr = paddr + done;
+		ut64 page_addr = addr & ~IO_PAGE_MASK;
+		ut64 key = page_key(desc->fd, addr);
+		bool found = false;
+		st64 slot = ht_uu_find(pc->index, key, &found);
+		if (found) {
+			pc->hits++;
+			pc->pages[slot].referenced = true;
+		} else {
+			pc->misses++;
+			slot = page_fill(pc, desc, key, page_addr);
+		}
+		int chunk = RZ_MIN(len - done, (int)(IO_PAGE_SIZE - (addr - page_addr)));
+		if (slot < 0) {
+			// the plugin refused a whole page, fall back to what was asked
+			int ret = rz_io_plugin_read_at(desc, addr, buf + done, chunk);
+			if (ret <= 0) {
+				rz_th_lock_leave(pc->lock);
+				return done ? done : ret;
+			}
+			done += ret;
+			if (ret < chunk) {
+				break;
+			}
+			continue;
+		}
+		const IOPage *page = &pc->pages[slot];
+		int avail = page->size - (int)(addr - page_addr);
+		if (avail <= 0) {
+			break;
+		}
+		chunk = RZ_MIN(chunk, avail);
+		memcpy(buf + done, pc->data + slot * IO_PAGE_SIZE + (addr - page_addr), chunk);
+		done += chunk;
+		if (page->size < IO_PAGE_SIZE) {
+			break;
+		}
+	}
+	rz_th_lock_leave(pc->lock);
+	return done;
+}
@@ -97,6 +97,13 @@ RZ_API int rz_io_plugin_write(RzIODesc *desc, const ut8 *buf, int len) {
 	}
 	const ut64 cur_addr = rz_io_desc_seek(desc, 0LL, RZ_IO_SEEK_CUR);
 	int ret = desc->plugin->write(desc->io, desc, buf, len);
+	if (desc->io->page_cache) {
+		if (cur_addr == UT64_MAX || cur_addr + len < cur_addr) {
+			rz_io_page_cache_invalidate_fd(desc->io, desc->fd);
+		} else {
+			rz_io_page_cache_invalidate(desc->io, desc->fd, cur_addr, cur_addr + len);
+		}
+	}
 	RzEventIOWrite iow = { cur_addr, buf, len };
 	rz_event_send(desc->io->event, RZ_EVENT_IO_WRITE, &iow);
 	return ret;
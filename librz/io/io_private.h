@@ -8,4 +8,9 @@ RzIOMap *io_map_new(RzIO *io, int fd, int perm, ut64 delta, ut64 addr, ut64 size
 RzIOMap *io_map_add(RzIO *io, int fd, int flags, ut64 delta, ut64 addr, ut64 size, bool do_skyline);
 void io_map_calculate_skyline(RzIO *io);
 
+RZ_IPI int rz_io_page_cache_read(RzIODesc *desc, ut64 paddr, ut8 *buf, int len);
+RZ_IPI void rz_io_page_cache_init(RzIO *io);
+RZ_IPI void rz_io_page_cache_fini(RzIO *io);
+RZ_IPI bool rz_io_page_cache_enabled(RzIO *io);
+
 #endif
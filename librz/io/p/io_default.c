@@ -11,6 +11,7 @@ typedef struct rz_io_mmo_t {
 	int mode;
 	int perm;
 	bool nocache;
+	bool mmapped; ///< buf is backed by a mapping of the file, so its data can be lent
 	ut8 modified;
 	RzBuffer *buf;
 } RzIOMMapFileObj;
@@ -77,6 +78,7 @@ RzIOMMapFileObj *rz_io_def_mmap_create_new_file(RzIO *io, const char *filename,
 	mmo->mode = mode;
 	if (!mmo->nocache) {
 		mmo->buf = rz_buf_new_mmap(mmo->filename, mmo->perm, mmo->mode);
+		mmo->mmapped = mmo->buf != NULL;
 	}
 	if (!mmo->buf) {
 		mmo->buf = rz_buf_new_file(mmo->filename, mmo->perm, mmo->mode);
@@ -200,6 +202,21 @@ static ut8 *io_default_get_buf(RzIODesc *desc, ut64 *size) {
 	return rz_buf_data(mmo->buf, size);
 }
 
+static const ut8 *io_default_borrow(RzIODesc *desc, ut64 addr, ut64 len) {
+	rz_return_val_if_fail(desc, NULL);
+	RzIOMMapFileObj *mmo = desc->data;
+	if (!mmo || !mmo->mmapped) {
+		// file buffers would have to copy the whole file
+		return NULL;
+	}
+	ut64 size;
+	const ut8 *data = rz_buf_data(mmo->buf, &size);
+	if (!data || addr > size || len > size - addr) {
+		return NULL;
+	}
+	return data + addr;
+}
+
 RzIOPlugin rz_io_plugin_default = {
 	.name = "default",
 	.desc = "Open local files",
@@ -215,7 +232,8 @@ RzIOPlugin rz_io_plugin_default = {
 #if __UNIX__
 	.is_blockdevice = __is_blockdevice,
 #endif
-	.get_buf = io_default_get_buf
+	.get_buf = io_default_get_buf,
+	.borrow = io_default_borrow
 };
 
 #ifndef RZ_PLUGIN_INCORE
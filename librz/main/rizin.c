@@ -175,6 +175,7 @@ static int main_help(int line) {
 			"Environment:\n"
 			" RZ_DEBUG      if defined, show error messages and crash signal\n"
 			" RZ_DEBUG_ASSERT=1 set a breakpoint when hitting an assert\n"
+			" RZ_INITTIME=1 print the time spent in each stage of the core initialization\n"
 			" RZ_MAGICPATH %s\n"
 			" RZ_NOPLUGINS do not load rizin shared plugins\n"
 			" RZ_RCFILE    %s (user preferences, batch script)\n"
@@ -12,6 +12,12 @@
 #include <rz_lib.h>
 
 #define RZ_HASH_DEFAULT_BLOCK_SIZE 0x1000
+/* size of the reads when hashing a whole range, large enough to update several algorithms in parallel */
+#define RZ_HASH_STREAM_SIZE 0x400000
+/* memory budget of the blocks hashed in parallel by -B */
+#define RZ_HASH_BATCH_SIZE 0x4000000
+/* blocks queued per thread by -B */
+#define RZ_HASH_BATCH_BLOCKS_PER_THREAD 16
 
 typedef struct {
 	ut8 *buf;
@@ -64,6 +70,7 @@ typedef struct rz_hash_context {
 	ut32 nfiles;
 	ut64 block_size;
 	ut64 iterate;
+	ut64 threads;
 	/* Output here */
 	PJ *pj;
 } RzHashContext;
@@ -71,7 +78,7 @@ typedef struct rz_hash_context {
 typedef bool (*RzHashRun)(RzHashContext *ctx, RzIO *io, const char *filename);
 
 static void rz_hash_show_help(bool usage_only) {
-	printf("Usage: rz-hash [-vhBkjLq] [-b S] [-a A] [-c H] [-E A] [-D A] [-s S] [-x S] [-f O] [-t O] [files|-] ...\n");
+	printf("Usage: rz-hash [-vhBkjLq] [-b S] [-a A] [-c H] [-E A] [-D A] [-s S] [-x S] [-f O] [-t O] [-T N] [files|-] ...\n");
 	if (usage_only) {
 		return;
 	}
@@ -89,6 +96,7 @@ static void rz_hash_show_help(bool usage_only) {
 		" -E algo     Encrypt the given input; use -S to set key and -I to set IV (if needed)\n"
 		" -f from     Starts the calculation at given offset\n"
 		" -t to       Stops the calculation at given offset\n"
+		" -T threads  Max number of threads (default: 1, 0 uses all the cores)\n"
 		" -I iv       Sets the initialization vector (IV)\n"
 		" -i times    Repeat the calculation N times\n"
 		" -j          Outputs the result as a JSON structure\n"
@@ -205,6 +213,15 @@ static void rz_hash_show_algorithms(RzHashContext *ctx) {
 		} \
 	} while (0)
 
+#define rz_hash_ctx_set_threads(x, i) \
+	do { \
+		char *end = NULL; \
+		(x)->threads = strtoull((i), &end, 0); \
+		if (!isdigit((ut8)*(i)) || *end) { \
+			rz_hash_error(x, RZ_HASH_OP_UNKNOWN, "invalid number of threads '%s'\n", (i)); \
+		} \
+	} while (0)
+
 #define rz_hash_ctx_set_input(x, k, s, h) \
 	do { \
 		if ((x)->k) { \
@@ -322,7 +339,7 @@ static void hash_parse_cmdline(int argc, const char **argv, RzHashContext *ctx)
 
 	RzGetopt opt;
 	int c;
-	rz_getopt_init(&opt, argc, argv, "jD:e:vE:a:i:I:S:K:s:x:b:nBhf:t:kLqc:");
+	rz_getopt_init(&opt, argc, argv, "jD:e:vE:a:i:I:S:K:s:x:b:nBhf:t:T:kLqc:");
 	while ((c = rz_getopt_next(&opt)) != -1) {
 		switch (c) {
 		case 'q': rz_hash_ctx_set_quiet(ctx); break;
@@ -350,6 +367,7 @@ static void hash_parse_cmdline(int argc, const char **argv, RzHashContext *ctx)
 		case 'b': rz_hash_ctx_set_unsigned(ctx, block_size, opt.arg); break;
 		case 'f': rz_hash_ctx_set_unsigned(ctx, offset.from, opt.arg); break;
 		case 't': rz_hash_ctx_set_unsigned(ctx, offset.to, opt.arg); break;
+		case 'T': rz_hash_ctx_set_threads(ctx, opt.arg); break;
 		case 'v': ctx->operation = RZ_HASH_OP_VERSION; break;
 		case 'h': ctx->operation = RZ_HASH_OP_HELP; break;
 		case 's': rz_hash_ctx_set_input(ctx, input, opt.arg, false); break;
@@ -799,6 +817,146 @@ static RzList /*<char *>*/ *parse_hash_algorithms(RzHashContext *ctx) {
 	return rz_str_split_list(ctx->algorithm, ",", 0);
 }
 
+/**
+ * Returns \p len bytes at \p addr, lent straight from the io plugin when the
+ * file is mmapped, otherwise read into \p block.
+ */
+static const ut8 *hash_read_block(RzIO *io, ut64 addr, ut8 *block, ut64 len, int *read) {
+	const ut8 *data = rz_io_borrow_at(io, addr, len);
+	if (data) {
+		*read = (int)len;
+		return data;
+	}
+	*read = rz_io_pread_at(io, addr, block, (int)len);
+	return block;
+}
+
+static RzHashCfg *hash_cfg_new_configured(RzHashContext *ctx, RzList /*<char *>*/ *algorithms) {
+	RzListIter *it;
+	const char *algorithm;
+	RzHashCfg *md = rz_hash_cfg_new(ctx->rh);
+	if (!md) {
+		RZ_LOG_ERROR("rz-hash: error, cannot allocate hash context memory\n");
+		return NULL;
+	}
+	md->threads = ctx->threads;
+	rz_list_foreach (algorithms, it, algorithm) {
+		if (!rz_hash_cfg_configure(md, algorithm)) {
+			rz_hash_cfg_free(md);
+			return NULL;
+		}
+	}
+	if (ctx->key.len > 0 && !rz_hash_cfg_hmac(md, ctx->key.buf, ctx->key.len)) {
+		rz_hash_cfg_free(md);
+		return NULL;
+	}
+	return md;
+}
+
+typedef struct {
+	RzHashCfg *md;
+	ut8 *block; ///< used when the data cannot be borrowed from the io
+	const ut8 *data;
+	int read;
+	ut64 addr;
+	ut64 iterate;
+	bool result;
+} HashBlockJob;
+
+static void hash_block_job_run(HashBlockJob *job, void *user) {
+	job->result = rz_hash_cfg_init(job->md) &&
+		rz_hash_cfg_update(job->md, job->data, job->read) &&
+		rz_hash_cfg_final(job->md) &&
+		rz_hash_cfg_iterate(job->md, job->iterate);
+}
+
+/**
+ * Hashes each block of \p bsize bytes between \p from and \p to on its own.
+ * The blocks are read serially in batches, then hashed on a thread pool and
+ * printed in order once the whole batch is done.
+ */
+static bool calculate_hash_blocks(RzHashContext *ctx, RzIO *io, RzList /*<char *>*/ *algorithms, ut64 from, ut64 to, ut64 bsize, const char *filename) {
+	if (!bsize) {
+		RZ_LOG_ERROR("rz-hash: error, invalid block size\n");
+		return false;
+	}
+	bool result = false;
+	size_t threads = rz_th_request_physical_cores(ctx->threads);
+	ut64 nblocks = (to - from + bsize - 1) / bsize;
+	size_t njobs = RZ_MAX(1, RZ_MIN(threads * RZ_HASH_BATCH_BLOCKS_PER_THREAD, RZ_HASH_BATCH_SIZE / bsize));
+	njobs = RZ_MIN(njobs, nblocks);
+	if (njobs < 1) {
+		return true;
+	}
+
+	RzPVector batch;
+	rz_pvector_init(&batch, NULL);
+	HashBlockJob *jobs = RZ_NEWS0(HashBlockJob, njobs);
+	if (!jobs || !rz_pvector_reserve(&batch, njobs)) {
+		RZ_LOG_ERROR("rz-hash: error, cannot allocate block memory\n");
+		goto calculate_hash_blocks_end;
+	}
+	for (size_t i = 0; i < njobs; i++) {
+		jobs[i].iterate = ctx->iterate;
+		jobs[i].block = malloc(bsize);
+		jobs[i].md = hash_cfg_new_configured(ctx, algorithms);
+		if (!jobs[i].block || !jobs[i].md) {
+			RZ_LOG_ERROR("rz-hash: error, cannot allocate block memory\n");
+			goto calculate_hash_blocks_end;
+		}
+		// the blocks are already spread over the threads
+		jobs[i].md->threads = 1;
+	}
+
+	for (ut64 j = from; j < to;) {
+		rz_pvector_clear(&batch);
+		for (size_t i = 0; i < njobs && j < to; i++, j += bsize) {
+			HashBlockJob *job = &jobs[i];
+			job->addr = j;
+			job->data = hash_read_block(io, j, job->block, to - j > bsize ? bsize : (to - j), &job->read);
+			rz_pvector_push(&batch, job);
+		}
+		void **it;
+		if (threads > 1 && rz_pvector_len(&batch) > 1) {
+			rz_th_iterate_pvector(&batch, (RzThreadIterator)hash_block_job_run, threads, NULL);
+		} else {
+			rz_pvector_foreach (&batch, it) {
+				hash_block_job_run(*it, NULL);
+			}
+		}
+
+		rz_pvector_foreach (&batch, it) {
+			HashBlockJob *job = *it;
+			if (!job->result) {
+				goto calculate_hash_blocks_end;
+			}
+			RzListIter *ait;
+			const char *algorithm;
+			rz_list_foreach (algorithms, ait, algorithm) {
+				if (ctx->mode == RZ_HASH_MODE_JSON) {
+					pj_o(ctx->pj);
+				}
+				hash_print_digest(ctx, job->md, algorithm, job->addr, job->addr + bsize, filename);
+				if (ctx->mode == RZ_HASH_MODE_JSON) {
+					pj_end(ctx->pj);
+				}
+			}
+		}
+	}
+	result = true;
+
+calculate_hash_blocks_end:
+	for (size_t i = 0; jobs && i < njobs; i++) {
+		free(jobs[i].block);
+		if (jobs[i].md) {
+			rz_hash_cfg_free(jobs[i].md);
+		}
+	}
+	free(jobs);
+	rz_pvector_fini(&batch);
+	return result;
+}
+
 static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 	bool result = false;
 	const char *algorithm;
@@ -820,12 +978,6 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 
 	filesize = rz_io_desc_size(io->desc);
 
-	md = rz_hash_cfg_new(ctx->rh);
-	if (!md) {
-		RZ_LOG_ERROR("rz-hash: error, cannot allocate hash context memory\n");
-		goto calculate_hash_end;
-	}
-
 	if (ctx->offset.to > filesize) {
 		RZ_LOG_ERROR("rz-hash: error, -t value is greater than file size\n");
 		goto calculate_hash_end;
@@ -836,20 +988,23 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		goto calculate_hash_end;
 	}
 
-	bsize = ctx->block_size;
-	block = malloc(bsize);
-	if (!block) {
-		RZ_LOG_ERROR("rz-hash: error, cannot allocate block memory\n");
+	if (ctx->show_blocks) {
+		ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
+		result = calculate_hash_blocks(ctx, io, algorithms, ctx->offset.from, to, ctx->block_size, filename);
 		goto calculate_hash_end;
 	}
 
-	rz_list_foreach (algorithms, it, algorithm) {
-		if (!rz_hash_cfg_configure(md, algorithm)) {
-			goto calculate_hash_end;
-		}
+	md = hash_cfg_new_configured(ctx, algorithms);
+	if (!md) {
+		goto calculate_hash_end;
 	}
 
-	if (ctx->key.len > 0 && !rz_hash_cfg_hmac(md, ctx->key.buf, ctx->key.len)) {
+	// the block size does not change the digest of a whole range,
+	// so it is read in large chunks that can be hashed in parallel
+	bsize = RZ_MAX(ctx->block_size, RZ_HASH_STREAM_SIZE);
+	block = malloc(bsize);
+	if (!block) {
+		RZ_LOG_ERROR("rz-hash: error, cannot allocate block memory\n");
 		goto calculate_hash_end;
 	}
 
@@ -873,8 +1028,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		}
 
 		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-			if (!rz_hash_cfg_update(md, block, read)) {
+			int read = 0;
+			const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+			if (!rz_hash_cfg_update(md, data, read)) {
 				goto calculate_hash_end;
 			}
 		}
@@ -904,28 +1060,6 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 				pj_end(ctx->pj);
 			}
 		}
-	} else if (ctx->show_blocks) {
-		ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
-		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-			if (!rz_hash_cfg_init(md) ||
-				!rz_hash_cfg_update(md, block, read) ||
-				!rz_hash_cfg_final(md) ||
-				!rz_hash_cfg_iterate(md, ctx->iterate)) {
-				goto calculate_hash_end;
-			}
-
-			rz_list_foreach (algorithms, it, algorithm) {
-				digest = rz_hash_cfg_get_result(md, algorithm, &digest_size);
-				if (ctx->mode == RZ_HASH_MODE_JSON) {
-					pj_o(ctx->pj);
-				}
-				hash_print_digest(ctx, md, algorithm, j, j + bsize, filename);
-				if (ctx->mode == RZ_HASH_MODE_JSON) {
-					pj_end(ctx->pj);
-				}
-			}
-		}
 	} else {
 		ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
 		if (!rz_hash_cfg_init(md)) {
@@ -938,8 +1072,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		}
 
 		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-			if (!rz_hash_cfg_update(md, block, read)) {
+			int read = 0;
+			const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+			if (!rz_hash_cfg_update(md, data, read)) {
 				goto calculate_hash_end;
 			}
 		}
@@ -972,7 +1107,9 @@ calculate_hash_end:
 	rz_list_free(algorithms);
 	free(block);
 	free(cmphash);
-	rz_hash_cfg_free(md);
+	if (md) {
+		rz_hash_cfg_free(md);
+	}
 	return result;
 }
 
@@ -1027,8 +1164,9 @@ static bool calculate_decrypt(RzHashContext *ctx, RzIO *io, const char *filename
 
 	ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
 	for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-		int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-		rz_crypto_update(ctx->rc, block, read);
+		int read = 0;
+		const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+		rz_crypto_update(ctx->rc, data, read);
 	}
 
 	rz_crypto_final(ctx->rc, NULL, 0);
@@ -1102,8 +1240,9 @@ static bool calculate_encrypt(RzHashContext *ctx, RzIO *io, const char *filename
 
 	ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
 	for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-		int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-		rz_crypto_update(ctx->rc, block, read);
+		int read = 0;
+		const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+		rz_crypto_update(ctx->rc, data, read);
 	}
 
 	rz_crypto_final(ctx->rc, NULL, 0);
@@ -1204,6 +1343,7 @@ static void hash_load_plugins(RzHashContext *ctx) {
 RZ_API int rz_main_rz_hash(int argc, const char **argv) {
 	int result = 1;
 	RzHashContext ctx = { 0 };
+	ctx.threads = 1;
 	ctx.rh = rz_hash_new();
 	ctx.rc = rz_crypto_new();
 	hash_load_plugins(&ctx);
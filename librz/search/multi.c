@@ -0,0 +1,258 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include <ctype.h>
+#include "search_private.h"
+
+/*
+ * Multi-pattern keyword scanner based on the Aho-Corasick automaton.
+ *
+ * Keywords may carry a binary mask or ignore case, which a plain automaton
+ * cannot express, so only a literal part of each keyword (its "anchor":
+ * the longest run of bytes with a full mask) is put in the automaton. Every
+ * anchor hit is returned as a candidate that the caller verifies against the
+ * whole keyword. Keywords without any fully masked byte are not anchored and
+ * have to be matched the slow way.
+ *
+ * The automaton is stored as a dense DFA over byte classes: all the bytes not
+ * appearing in any anchor share class 0, so the table stays small even with
+ * hundreds of keywords.
+ */
+
+#define MULTI_ANCHOR_MAX 16
+
+struct rz_search_multi_t {
+	int n_kws;
+	int *kw_len;
+	int *anchor_off; ///< offset of the anchor inside the keyword
+	int *anchor_len; ///< 0 if the keyword is not anchored
+	int *next; ///< next keyword whose anchor ends in the same state, -1 terminated
+	int *counts; ///< scratch space to sort the candidates
+	ut8 cls[256]; ///< byte -> class, case folded if any keyword ignores case
+	int n_classes;
+	int n_states;
+	int *delta; ///< n_states * n_classes transitions
+	int *out; ///< first keyword whose anchor ends in the state, -1 if none
+	int *dict; ///< nearest proper suffix state having an output, 0 if none
+	RzVector /*<RzSearchMultiCandidate>*/ raw;
+};
+
+static inline bool kw_byte_fixed(const RzSearchKeyword *kw, ut32 j) {
+	return !kw->binmask_length || kw->bin_binmask[j % kw->binmask_length] == 0xff;
+}
+
+static void kw_find_anchor(const RzSearchKeyword *kw, int *off, int *len) {
+	*off = 0;
+	*len = 0;
+	int run = 0;
+	for (int j = 0; j < kw->keyword_length; j++) {
+		run = kw_byte_fixed(kw, j) ? run + 1 : 0;
+		if (run > *len) {
+			*len = run;
+			*off = j + 1 - run;
+		}
+	}
+	if (*len > MULTI_ANCHOR_MAX) {
+		*len = MULTI_ANCHOR_MAX;
+	}
+}
+
+RZ_IPI void rz_search_multi_free(RzSearchMulti *m) {
+	if (!m) {
+		return;
+	}
+	free(m->kw_len);
+	free(m->anchor_off);
+	free(m->anchor_len);
+	free(m->next);
+	free(m->counts);
+	free(m->delta);
+	free(m->out);
+	free(m->dict);
+	rz_vector_fini(&m->raw);
+	free(m);
+}
+
+static bool multi_build(RzSearchMulti *m, RzList /*<RzSearchKeyword *>*/ *kws, bool fold) {
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	int k = 0, max_states = 1;
+	ut8 map[256] = { 0 };
+	rz_list_foreach (kws, iter, kw) {
+		m->kw_len[k] = kw->keyword_length;
+		m->next[k] = -1;
+		kw_find_anchor(kw, &m->anchor_off[k], &m->anchor_len[k]);
+		for (int j = 0; j < m->anchor_len[k]; j++) {
+			ut8 b = kw->bin_keyword[m->anchor_off[k] + j];
+			b = fold ? tolower(b) : b;
+			if (!map[b]) {
+				map[b] = ++m->n_classes;
+			}
+		}
+		max_states += m->anchor_len[k];
+		k++;
+	}
+	m->n_classes++;
+	for (int b = 0; b < 256; b++) {
+		m->cls[b] = map[fold ? tolower(b) : b];
+	}
+
+	m->delta = malloc(sizeof(int) * max_states * m->n_classes);
+	m->out = malloc(sizeof(int) * max_states);
+	m->dict = calloc(max_states, sizeof(int));
+	int *fail = calloc(max_states, sizeof(int));
+	if (!m->delta || !m->out || !m->dict || !fail) {
+		free(fail);
+		return false;
+	}
+	memset(m->delta, 0xff, sizeof(int) * max_states * m->n_classes);
+	memset(m->out, 0xff, sizeof(int) * max_states);
+
+	// goto function of the trie
+	m->n_states = 1;
+	k = 0;
+	rz_list_foreach (kws, iter, kw) {
+		if (!m->anchor_len[k]) {
+			k++;
+			continue;
+		}
+		int st = 0;
+		for (int j = 0; j < m->anchor_len[k]; j++) {
+			int *t = &m->delta[st * m->n_classes + m->cls[kw->bin_keyword[m->anchor_off[k] + j]]];
+			if (*t < 0) {
+				*t = m->n_states++;
+			}
+			st = *t;
+		}
+		m->next[k] = m->out[st];
+		m->out[st] = k;
+		k++;
+	}
+
+	// failure links in breadth first order, turning the trie into a DFA
+	RzVector bfs;
+	rz_vector_init(&bfs, sizeof(int), NULL, NULL);
+	for (int c = 0; c < m->n_classes; c++) {
+		int *t = &m->delta[c];
+		if (*t < 0) {
+			*t = 0;
+		} else {
+			fail[*t] = 0;
+			rz_vector_push(&bfs, t);
+		}
+	}
+	for (size_t head = 0; head < rz_vector_len(&bfs); head++) {
+		int u = *(int *)rz_vector_index_ptr(&bfs, head);
+		for (int c = 0; c < m->n_classes; c++) {
+			int *t = &m->delta[u * m->n_classes + c];
+			int f = m->delta[fail[u] * m->n_classes + c];
+			if (*t < 0) {
+				*t = f;
+				continue;
+			}
+			int v = *t;
+			fail[v] = f;
+			m->dict[v] = m->out[f] >= 0 ? f : m->dict[f];
+			if (!rz_vector_push(&bfs, &v)) {
+				rz_vector_fini(&bfs);
+				free(fail);
+				return false;
+			}
+		}
+	}
+	rz_vector_fini(&bfs);
+	free(fail);
+	return true;
+}
+
+/**
+ * Build the automaton for the anchors of \p kws.
+ * The automaton must be rebuilt whenever the keyword list changes.
+ */
+RZ_IPI RzSearchMulti *rz_search_multi_new(RzList /*<RzSearchKeyword *>*/ *kws) {
+	rz_return_val_if_fail(kws, NULL);
+	RzSearchMulti *m = RZ_NEW0(RzSearchMulti);
+	if (!m) {
+		return NULL;
+	}
+	rz_vector_init(&m->raw, sizeof(RzSearchMultiCandidate), NULL, NULL);
+	m->n_kws = rz_list_length(kws);
+	bool fold = false;
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	rz_list_foreach (kws, iter, kw) {
+		fold |= kw->icase;
+	}
+	m->kw_len = RZ_NEWS(int, m->n_kws);
+	m->anchor_off = RZ_NEWS(int, m->n_kws);
+	m->anchor_len = RZ_NEWS(int, m->n_kws);
+	m->next = RZ_NEWS(int, m->n_kws);
+	m->counts = RZ_NEWS(int, m->n_kws + 1);
+	if (!m->n_kws || !m->kw_len || !m->anchor_off || !m->anchor_len || !m->next || !m->counts ||
+		!multi_build(m, kws, fold)) {
+		rz_search_multi_free(m);
+		return NULL;
+	}
+	return m;
+}
+
+/**
+ * \return true if keyword number \p kw is found by rz_search_multi_scan()
+ */
+RZ_IPI bool rz_search_multi_is_anchored(RzSearchMulti *m, int kw) {
+	rz_return_val_if_fail(m && kw >= 0 && kw < m->n_kws, false);
+	return m->anchor_len[kw] > 0;
+}
+
+/**
+ * \brief Find the candidate positions of all the anchored keywords in \p buf
+ *
+ * Only keywords starting before \p max_start and ending inside \p buf are
+ * reported. The candidates are stored in \p out sorted by keyword and then
+ * by position.
+ */
+RZ_IPI bool rz_search_multi_scan(RzSearchMulti *m, const ut8 *buf, int len, int max_start, RzVector /*<RzSearchMultiCandidate>*/ *out) {
+	rz_return_val_if_fail(m && buf && out, false);
+	RzVector *raw = &m->raw;
+	rz_vector_clear(raw);
+	rz_vector_clear(out);
+	int st = 0;
+	for (int e = 0; e < len; e++) {
+		st = m->delta[st * m->n_classes + m->cls[buf[e]]];
+		for (int t = st; t; t = m->dict[t]) {
+			for (int k = m->out[t]; k >= 0; k = m->next[k]) {
+				RzSearchMultiCandidate c = {
+					.kw = k,
+					.pos = e + 1 - m->anchor_len[k] - m->anchor_off[k]
+				};
+				if (c.pos < 0 || c.pos >= max_start || c.pos + m->kw_len[k] > len) {
+					continue;
+				}
+				if (!rz_vector_push(raw, &c)) {
+					return false;
+				}
+			}
+		}
+	}
+	if (rz_vector_empty(raw)) {
+		return true;
+	}
+	// candidates come out sorted by position, a stable counting sort on the keyword keeps that order
+	memset(m->counts, 0, sizeof(int) * (m->n_kws + 1));
+	RzSearchMultiCandidate *c;
+	rz_vector_foreach(raw, c) {
+		m->counts[c->kw + 1]++;
+	}
+	for (int k = 0; k < m->n_kws; k++) {
+		m->counts[k + 1] += m->counts[k];
+	}
+	if (!rz_vector_reserve(out, rz_vector_len(raw))) {
+		return false;
+	}
+	out->len = rz_vector_len(raw);
+	rz_vector_foreach(raw, c) {
+		*(RzSearchMultiCandidate *)rz_vector_index_ptr(out, m->counts[c->kw]++) = *c;
+	}
+	return true;
+}
@@ -4,6 +4,7 @@
 #include <rz_search.h>
 #include <rz_list.h>
 #include <ctype.h>
+#include "search_private.h"
 
 // Experimental search engine (fails, because stops at first hit of every block read
 #define USE_BMH 0
@@ -55,6 +56,7 @@ RZ_API RzSearch *rz_search_free(RzSearch *s) {
 	}
 	rz_list_free(s->hits);
 	rz_list_free(s->kws);
+	rz_search_multi_free(s->multi);
 	// rz_io_free(s->iob.io); this is supposed to be a weak reference
 	free(s->data);
 	free(s);
@@ -120,6 +122,7 @@ RZ_API int rz_search_set_mode(RzSearch *s, int mode) {
 	case RZ_SEARCH_STRING: s->update = rz_search_strings_update; break;
 	case RZ_SEARCH_DELTAKEY: s->update = rz_search_deltakey_update; break;
 	case RZ_SEARCH_MAGIC: s->update = rz_search_magic_update; break;
+	case RZ_SEARCH_MULTIKEY: s->update = rz_search_multikey_update; break;
 	}
 	if (s->update || mode == RZ_SEARCH_PATTERN) {
 		s->mode = mode;
@@ -390,8 +393,47 @@ static bool brute_force_match(RzSearch *s, RzSearchKeyword *kw, const ut8 *buf,
 	return j == kw->keyword_length;
 }
 
-// Supported search variants: backward, binmask, icase, inverse, overlap
-RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, int len) {
+static RzSearchMulti *multi_get(RzSearch *s) {
+	if (!s->multi) {
+		s->multi = rz_search_multi_new(s->kws);
+	}
+	return s->multi;
+}
+
+static void multi_reset(RzSearch *s) {
+	rz_search_multi_free(s->multi);
+	s->multi = NULL;
+}
+
+static ut64 hit_addr(RzSearch *s, RzSearchKeyword *kw, ut64 from, int i, int left_len) {
+	return s->bckwrds ? from - kw->keyword_length - i + left_len : from + i - left_len;
+}
+
+/**
+ * Reports the verified \p cands of keyword number \p k starting from offset \p i
+ * of \p buf, exactly like the brute force loop would.
+ * \return the last result of rz_search_hit_new()
+ */
+static int multi_hits(RzSearch *s, RzSearchKeyword *kw, int k, const ut8 *buf, int i, RzVector /*<RzSearchMultiCandidate>*/ *cands, size_t *idx, ut64 from, int left_len) {
+	int t = 1;
+	for (; *idx < rz_vector_len(cands); (*idx)++) {
+		const RzSearchMultiCandidate *c = rz_vector_index_ptr(cands, *idx);
+		if (c->kw != k) {
+			break;
+		}
+		if (c->pos < i || !brute_force_match(s, kw, buf, c->pos)) {
+			continue;
+		}
+		t = rz_search_hit_new(s, kw, hit_addr(s, kw, from, c->pos, left_len));
+		if (t != 1) {
+			break;
+		}
+		i = s->overlap ? c->pos + 1 : c->pos + kw->keyword_length;
+	}
+	return t;
+}
+
+static int keyword_update(RzSearch *s, ut64 from, const ut8 *buf, int len, bool multi) {
 	RzSearchKeyword *kw;
 	RzListIter *iter;
 	RzSearchLeftover *left;
@@ -429,41 +471,85 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 
 	ut64 len1 = left->len + RZ_MIN(longest - 1, len);
 	memcpy(left->data + left->len, buf, len1 - left->len);
+
+	// with many keywords, find the candidates of all of them in a single pass
+	RzSearchMulti *m = multi ? multi_get(s) : NULL;
+	RzVector left_cands, buf_cands;
+	size_t left_idx = 0, buf_idx = 0;
+	rz_vector_init(&left_cands, sizeof(RzSearchMultiCandidate), NULL, NULL);
+	rz_vector_init(&buf_cands, sizeof(RzSearchMultiCandidate), NULL, NULL);
+	if (m && (!rz_search_multi_scan(m, left->data, len1, left->len, &left_cands) ||
+			 !rz_search_multi_scan(m, buf, len, len, &buf_cands))) {
+		m = NULL;
+	}
+
+	int k = 0;
+	int ret = 0;
 	rz_list_foreach (s->kws, iter, kw) {
+		bool anchored = m && rz_search_multi_is_anchored(m, k);
 		i = s->overlap || !kw->count ? 0 : s->bckwrds ? kw->last - from < left->len ? from + left->len - kw->last : 0
 			: from - kw->last < left->len         ? kw->last + left->len - from
 							      : 0;
-		for (; i + kw->keyword_length <= len1 && i < left->len; i++) {
-			if (brute_force_match(s, kw, left->data, i) != s->inverse) {
-				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i + left->len : from + i - left->len);
-				if (!t) {
-					return -1;
-				}
-				if (t > 1) {
-					return s->nhits - old_nhits;
-				}
-				if (!s->overlap) {
-					i += kw->keyword_length - 1;
+		if (anchored) {
+			int t = multi_hits(s, kw, k, left->data, i, &left_cands, &left_idx, from, left->len);
+			if (!t) {
+				ret = -1;
+				goto beach;
+			}
+			if (t > 1) {
+				ret = s->nhits - old_nhits;
+				goto beach;
+			}
+		} else {
+			for (; i + kw->keyword_length <= len1 && i < left->len; i++) {
+				if (brute_force_match(s, kw, left->data, i) != s->inverse) {
+					int t = rz_search_hit_new(s, kw, hit_addr(s, kw, from, i, left->len));
+					if (!t) {
+						ret = -1;
+						goto beach;
+					}
+					if (t > 1) {
+						ret = s->nhits - old_nhits;
+						goto beach;
+					}
+					if (!s->overlap) {
+						i += kw->keyword_length - 1;
+					}
 				}
 			}
 		}
 		i = s->overlap || !kw->count ? 0 : s->bckwrds ? from > kw->last ? from - kw->last : 0
 			: from < kw->last                     ? kw->last - from
 							      : 0;
-		for (; i + kw->keyword_length <= len; i++) {
-			if (brute_force_match(s, kw, buf, i) != s->inverse) {
-				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i : from + i);
-				if (!t) {
-					return -1;
-				}
-				if (t > 1) {
-					return s->nhits - old_nhits;
-				}
-				if (!s->overlap) {
-					i += kw->keyword_length - 1;
+		if (anchored) {
+			int t = multi_hits(s, kw, k, buf, i, &buf_cands, &buf_idx, from, 0);
+			if (!t) {
+				ret = -1;
+				goto beach;
+			}
+			if (t > 1) {
+				ret = s->nhits - old_nhits;
+				goto beach;
+			}
+		} else {
+			for (; i + kw->keyword_length <= len; i++) {
+				if (brute_force_match(s, kw, buf, i) != s->inverse) {
+					int t = rz_search_hit_new(s, kw, hit_addr(s, kw, from, i, 0));
+					if (!t) {
+						ret = -1;
+						goto beach;
+					}
+					if (t > 1) {
+						ret = s->nhits - old_nhits;
+						goto beach;
+					}
+					if (!s->overlap) {
+						i += kw->keyword_length - 1;
+					}
 				}
 			}
 		}
+		k++;
 	}
 	if (len < longest - 1) {
 		if (len1 < longest) {
@@ -477,8 +563,29 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 		memcpy(left->data, buf + len - longest + 1, longest - 1);
 	}
 	left->end = s->bckwrds ? from - len : from + len;
+	ret = s->nhits - old_nhits;
+beach:
+	rz_vector_fini(&left_cands);
+	rz_vector_fini(&buf_cands);
+	return ret;
+}
 
-	return s->nhits - old_nhits;
+// Supported search variants: backward, binmask, icase, inverse, overlap
+RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, int len) {
+	bool multi = !s->distance && !s->inverse && rz_list_length(s->kws) >= RZ_SEARCH_MULTIKEY_MIN;
+	return keyword_update(s, from, buf, len, multi);
+}
+
+/**
+ * \brief Keyword search matching all the keywords in a single pass over \p buf
+ *
+ * Same as rz_search_mybinparse_update() but always uses the Aho-Corasick
+ * matcher, which makes the cost mostly independent of the number of
+ * keywords. Keywords fully covered by a partial binmask, searches with a
+ * distance and inverse searches still match byte by byte.
+ */
+RZ_API int rz_search_multikey_update(RzSearch *s, ut64 from, const ut8 *buf, int len) {
+	return keyword_update(s, from, buf, len, !s->distance && !s->inverse);
 }
 
 RZ_API void rz_search_set_distance(RzSearch *s, int dist) {
@@ -544,6 +651,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 	}
 	kw->kwidx = s->n_kws++;
 	rz_list_append(s->kws, kw);
+	multi_reset(s);
 	return true;
 }
 
@@ -551,6 +659,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 RZ_API void rz_search_string_prepare_backward(RzSearch *s) {
 	RzListIter *iter;
 	RzSearchKeyword *kw;
+	multi_reset(s);
 	// Precondition: !kw->binmask_length || kw->keyword_length % kw->binmask_length == 0
 	rz_list_foreach (s->kws, iter, kw) {
 		ut8 *i = kw->bin_keyword, *j = kw->bin_keyword + kw->keyword_length;
@@ -580,4 +689,5 @@ RZ_API void rz_search_kw_reset(RzSearch *s) {
 	rz_list_purge(s->kws);
 	rz_list_purge(s->hits);
 	RZ_FREE(s->data);
+	multi_reset(s);
 }
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef RZ_SEARCH_PRIVATE_H
+#define RZ_SEARCH_PRIVATE_H
+
+#include <rz_search.h>
+
+/**
+ * A possible keyword match found by the multi-pattern scanner. Only a
+ * literal part of the keyword has been matched, so it must still be
+ * verified against the whole keyword.
+ */
+typedef struct {
+	int kw; ///< index of the keyword in RzSearch.kws
+	int pos; ///< offset of the first byte of the keyword in the scanned buffer
+} RzSearchMultiCandidate;
+
+RZ_IPI RzSearchMulti *rz_search_multi_new(RzList /*<RzSearchKeyword *>*/ *kws);
+RZ_IPI void rz_search_multi_free(RzSearchMulti *m);
+RZ_IPI bool rz_search_multi_is_anchored(RzSearchMulti *m, int kw);
+RZ_IPI bool rz_search_multi_scan(RzSearchMulti *m, const ut8 *buf, int len, int max_start, RzVector /*<RzSearchMultiCandidate>*/ *out);
+
+#endif
@@ -102,6 +102,7 @@
 
 #include <rz_lib.h>
 #include <rz_flirt.h>
+#include <rz_th.h>
 #define MAX_WBITS 15
 
 #if 0
@@ -347,7 +348,7 @@ static bool is_pattern_matching(ut32 p_size, const ut8 *pattern, const ut8 *mask
 	return true;
 }
 
-static bool check_crc16(const RzFlirtModule *module, ut8 *b, ut32 b_size) {
+static bool check_crc16(const RzFlirtModule *module, const ut8 *b, ut32 b_size) {
 	if (!module->crc_length) {
 		return true;
 	} else if ((b_size - RZ_FLIRT_MAX_PRELUDE_SIZE) < module->crc_length) {
@@ -366,22 +367,17 @@ static bool try_rename_function(RzAnalysis *analysis, RzAnalysisFunction *fcn, c
 }
 
 /**
- * \brief Checks if the module matches the buffer and renames the matched functions
+ * \brief Checks if the crc16 and the tail bytes of the module match the buffer
  *
- * \param analysis  The RzAnalysis struct from where to fetch and modify the functions
  * \param module    The FLIRT module to match against the buffer
  * \param b         Buffer to check
- * \param address   Function address
  * \param buf_size  Size of the buffer to check
  *
  * \return True if pattern does match, false otherwise.
  */
-static int module_match_buffer(RzAnalysis *analysis, const RzFlirtModule *module, ut8 *b, ut64 address, ut32 buf_size) {
-	RzFlirtFunction *flirt_func = NULL;
-	RzAnalysisFunction *next_module_function = NULL;
+static bool module_match_buffer(const RzFlirtModule *module, const ut8 *b, ut32 buf_size) {
 	RzListIter *it = NULL;
 	RzFlirtTailByte *tail_byte = NULL;
-	ut32 name_index = 0;
 
 	if (!check_crc16(module, b, buf_size)) {
 		return false;
@@ -395,6 +391,21 @@ static int module_match_buffer(RzAnalysis *analysis, const RzFlirtModule *module
 			}
 		}
 	}
+	return true;
+}
+
+/**
+ * \brief Renames the functions of a module matched at the given address
+ *
+ * \param analysis  The RzAnalysis struct from where to fetch and modify the functions
+ * \param module    The matched FLIRT module
+ * \param address   Function address
+ */
+static void module_apply(RzAnalysis *analysis, const RzFlirtModule *module, ut64 address) {
+	RzFlirtFunction *flirt_func = NULL;
+	RzAnalysisFunction *next_module_function = NULL;
+	RzListIter *it = NULL;
+	ut32 name_index = 0;
 
 	rz_list_foreach (module->public_functions, it, flirt_func) {
 		if (next_module_function && (address + flirt_func->offset) == next_module_function->addr) {
@@ -451,7 +462,7 @@ static int module_match_buffer(RzAnalysis *analysis, const RzFlirtModule *module
 			char *name = rz_str_newf("flirt.%s", flirt_func->name);
 			if (!name) {
 				RZ_LOG_ERROR("FLIRT: cannot allocate string buffer for name\n");
-				return false;
+				return;
 			}
 
 			while (!try_rename_function(analysis, next_module_function, name)) {
@@ -460,7 +471,7 @@ static int module_match_buffer(RzAnalysis *analysis, const RzFlirtModule *module
 				name = rz_str_newf("flirt.%s_%u", flirt_func->name, name_index);
 				if (!name) {
 					RZ_LOG_ERROR("FLIRT: cannot allocate string buffer for name\n");
-					return false;
+					return;
 				}
 			}
 
@@ -476,10 +487,12 @@ static int module_match_buffer(RzAnalysis *analysis, const RzFlirtModule *module
 			free(name);
 		}
 	}
-	return true;
 }
 
-static int node_match_buffer(RzAnalysis *analysis, const RzFlirtNode *node, ut8 *b, ut64 address, ut32 buf_size, ut32 buf_idx) {
+/**
+ * \brief Finds the first module below the node matching the buffer
+ */
+static const RzFlirtModule *node_match_buffer(const RzFlirtNode *node, const ut8 *b, ut32 buf_size, ut32 buf_idx) {
 	RzListIter *node_child_it, *module_it;
 	RzFlirtNode *child;
 	RzFlirtModule *module;
@@ -487,70 +500,230 @@ static int node_match_buffer(RzAnalysis *analysis, const RzFlirtNode *node, ut8
 	if (is_pattern_matching(node->length, node->pattern_bytes, node->pattern_mask, b + buf_idx, buf_size - buf_idx)) {
 		if (node->child_list) {
 			rz_list_foreach (node->child_list, node_child_it, child) {
-				if (node_match_buffer(analysis, child, b, address, buf_size, buf_idx + node->length)) {
-					return true;
+				const RzFlirtModule *found = node_match_buffer(child, b, buf_size, buf_idx + node->length);
+				if (found) {
+					return found;
 				}
 			}
 		} else if (node->module_list) {
 			rz_list_foreach (node->module_list, module_it, module) {
-				if (module_match_buffer(analysis, module, b, address, buf_size)) {
-					return true;
+				if (module_match_buffer(module, b, buf_size)) {
+					return module;
 				}
 			}
 		}
 	}
 
-	return false;
+	return NULL;
 }
 
-/**
- * \brief Tries to find matching functions between the signature infos in root_node and the analyzed functions in analysis
+/*
+ * Matching of the analyzed functions against several signature trees.
  *
- * \param analysis   The analysis
- * \param root_node  The root node
+ * The bytes of every function are read once, then all the trees are
+ * matched against them in parallel: the root nodes of every tree are
+ * indexed by the first byte they can match, so each function only walks
+ * the roots that can match its first byte. The matched modules are applied
+ * at the end on the calling thread, tree after tree, as if each tree was
+ * matched on its own.
+ */
+
+typedef struct {
+	size_t tree;
+	const RzFlirtNode *node;
+} FlirtRoot;
+
+typedef struct {
+	size_t n_trees;
+	RzVector /*<FlirtRoot>*/ roots[256]; ///< roots able to match a first byte, sorted by tree
+} FlirtIndex;
+
+typedef struct {
+	ut64 addr;
+	ut64 size; ///< linear size of the function when its bytes were read
+	ut8 *buf;
+	ut32 buf_size;
+	const RzFlirtModule **hits; ///< first module of each tree matching the function
+} FlirtTarget;
+
+static void flirt_index_fini(FlirtIndex *index) {
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(index->roots); i++) {
+		rz_vector_fini(&index->roots[i]);
+	}
+}
+
+static bool flirt_index_init(FlirtIndex *index, const RzPVector /*<RzFlirtNode *>*/ *trees) {
+	index->n_trees = rz_pvector_len(trees);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(index->roots); i++) {
+		rz_vector_init(&index->roots[i], sizeof(FlirtRoot), NULL, NULL);
+	}
+	for (size_t t = 0; t < index->n_trees; t++) {
+		const RzFlirtNode *tree = rz_pvector_at(trees, t);
+		RzListIter *it;
+		RzFlirtNode *child;
+		rz_list_foreach (tree->child_list, it, child) {
+			FlirtRoot root = { t, child };
+			if (child->length && child->pattern_mask[0] == 0xFF) {
+				if (!rz_vector_push(&index->roots[child->pattern_bytes[0]], &root)) {
+					return false;
+				}
+				continue;
+			}
+			// variant first byte
+			for (size_t i = 0; i < RZ_ARRAY_SIZE(index->roots); i++) {
+				if (!rz_vector_push(&index->roots[i], &root)) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+static void flirt_target_free(FlirtTarget *target) {
+	if (!target) {
+		return;
+	}
+	free(target->buf);
+	free(target->hits);
+	free(target);
+}
+
+static bool flirt_target_read(RzAnalysis *analysis, FlirtTarget *target, RzAnalysisFunction *func) {
+	ut64 func_size = rz_analysis_function_linear_size(func);
+	ut64 buf_size = RZ_MAX(func_size, RZ_FLIRT_MAX_PRELUDE_SIZE);
+	ut8 *buf = calloc(1, buf_size);
+	if (!buf) {
+		return false;
+	}
+	if (!analysis->iob.read_at(analysis->iob.io, func->addr, buf, (int)func_size)) {
+		RZ_LOG_WARN("FLIRT: Couldn't read function %s at 0x%" PFMT64x ", skipping it\n", func->name, func->addr);
+		free(buf);
+		return false;
+	}
+	free(target->buf);
+	target->addr = func->addr;
+	target->size = func_size;
+	target->buf = buf;
+	target->buf_size = buf_size;
+	return true;
+}
+
+static const RzFlirtModule *flirt_target_match_tree(const FlirtIndex *index, const FlirtTarget *target, size_t tree) {
+	const RzVector *roots = &index->roots[target->buf[0]];
+	const FlirtRoot *root;
+	rz_vector_foreach(roots, root) {
+		if (root->tree != tree) {
+			continue;
+		}
+		const RzFlirtModule *module = node_match_buffer(root->node, target->buf, target->buf_size, 0);
+		if (module) {
+			return module;
+		}
+	}
+	return NULL;
+}
+
+static void flirt_target_match(FlirtTarget *target, const FlirtIndex *index) {
+	const RzVector *roots = &index->roots[target->buf[0]];
+	const FlirtRoot *root;
+	rz_vector_foreach(roots, root) {
+		if (!target->hits[root->tree]) {
+			target->hits[root->tree] = node_match_buffer(root->node, target->buf, target->buf_size, 0);
+		}
+	}
+}
+
+static bool is_flirt_function(const RzAnalysisFunction *func) {
+	return func->name && !strncmp(func->name, "flirt.", strlen("flirt."));
+}
+
+/**
+ * \brief Tries to find matching functions between the signature trees and the analyzed functions in analysis
  *
+ * \param  analysis     The RzAnalysis structure
+ * \param  trees        The root nodes of the signature trees, applied in order
+ * \param  max_threads  The maximum number of threads matching the functions (RZ_THREAD_POOL_ALL_CORES for all cores)
  * \return False on error, otherwise true
  */
-static bool node_match_functions(RzAnalysis *analysis, const RzFlirtNode *root_node) {
-	bool ret = true;
-
+RZ_API bool rz_sign_flirt_apply_nodes(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const RzPVector /*<RzFlirtNode *>*/ *trees, size_t max_threads) {
+	rz_return_val_if_fail(analysis && trees, false);
 	if (rz_list_length(analysis->fcns) == 0) {
 		RZ_LOG_ERROR("FLIRT: There are no analyzed functions. Have you run 'aa'?\n");
-		return ret;
+		return true;
+	}
+	if (!rz_pvector_len(trees)) {
+		return true;
 	}
 
-	analysis->flb.push_fs(analysis->flb.f, "flirt");
+	bool ret = false;
+	FlirtIndex *index = RZ_NEW0(FlirtIndex);
+	RzPVector *targets = rz_pvector_new((RzPVectorFree)flirt_target_free);
+	if (!index || !targets || !flirt_index_init(index, trees)) {
+		goto fail;
+	}
+
+	// the io is not thread safe, all the bytes are read here
 	RzListIter *it_func;
 	RzAnalysisFunction *func;
 	rz_list_foreach (analysis->fcns, it_func, func) {
-		if (func->name && !strncmp(func->name, "flirt.", strlen("flirt."))) {
+		if (is_flirt_function(func)) {
 			continue;
 		}
-
-		ut64 func_size = rz_analysis_function_linear_size(func);
-		ut64 malloc_size = RZ_MAX(func_size, RZ_FLIRT_MAX_PRELUDE_SIZE);
-		ut8 *func_buf = calloc(1, malloc_size);
-		if (!func_buf) {
-			ret = false;
-			break;
+		FlirtTarget *target = RZ_NEW0(FlirtTarget);
+		if (!target || !rz_pvector_push(targets, target)) {
+			free(target);
+			goto fail;
 		}
-		if (!analysis->iob.read_at(analysis->iob.io, func->addr, func_buf, (int)func_size)) {
-			RZ_LOG_ERROR("FLIRT: Couldn't read function %s at 0x%" PFMT64x "\n", func->name, func->addr);
-			RZ_FREE(func_buf);
-			ret = false;
-			break;
+		target->hits = RZ_NEWS0(const RzFlirtModule *, index->n_trees);
+		if (!target->hits) {
+			goto fail;
 		}
-		RzListIter *node_child_it;
-		RzFlirtNode *child;
-		rz_list_foreach (root_node->child_list, node_child_it, child) {
-			if (node_match_buffer(analysis, child, func_buf, func->addr, malloc_size, 0)) {
-				break;
+		if (!flirt_target_read(analysis, target, func)) {
+			// skip only this function, the others can still be matched
+			rz_pvector_pop(targets);
+			flirt_target_free(target);
+			continue;
+		}
+	}
+	if (!rz_th_iterate_pvector(targets, (RzThreadIterator)flirt_target_match, max_threads, index)) {
+		goto fail;
+	}
+
+	analysis->flb.push_fs(analysis->flb.f, "flirt");
+	for (size_t t = 0; t < index->n_trees; t++) {
+		void **it;
+		rz_pvector_foreach (targets, it) {
+			FlirtTarget *target = *it;
+			func = rz_analysis_get_function_at(analysis, target->addr);
+			if (!func || is_flirt_function(func)) {
+				continue;
+			}
+			const RzFlirtModule *module = target->hits[t];
+			if (rz_analysis_function_linear_size(func) != target->size) {
+				// resized by a previous module, match again with its new bytes
+				if (!flirt_target_read(analysis, target, func)) {
+					continue;
+				}
+				for (size_t j = t; j < index->n_trees; j++) {
+					target->hits[j] = flirt_target_match_tree(index, target, j);
+				}
+				module = target->hits[t];
+			}
+			if (module) {
+				module_apply(analysis, module, target->addr);
 			}
 		}
-		RZ_FREE(func_buf);
 	}
 	analysis->flb.pop_fs(analysis->flb.f);
+	ret = true;
 
+fail:
+	rz_pvector_free(targets);
+	if (index) {
+		flirt_index_fini(index);
+		free(index);
+	}
 	return ret;
 }
 
@@ -1305,31 +1478,31 @@ exit:
 }
 
 /**
- * \brief Parses the FLIRT file and applies the signatures
+ * \brief Parses a FLIRT file
  *
- * \param  analysis    The RzAnalysis structure
- * \param  flirt_file  The FLIRT file to parse
- * \return true if the signatures were sucessfully applied to the file
+ * \param  flirt_file     The FLIRT file to parse, either a .sig or a .pat file
+ * \param  expected_arch  The expected architecture of a .sig file
+ * \return The root node of the signatures tree, NULL on error
  */
-RZ_API bool rz_sign_flirt_apply(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const char *flirt_file, ut8 expected_arch) {
-	rz_return_val_if_fail(analysis && RZ_STR_ISNOTEMPTY(flirt_file), false);
+RZ_API RZ_OWN RzFlirtNode *rz_sign_flirt_parse_file(RZ_NONNULL const char *flirt_file, ut8 expected_arch) {
+	rz_return_val_if_fail(RZ_STR_ISNOTEMPTY(flirt_file), NULL);
 	RzBuffer *flirt_buf = NULL;
 	RzFlirtNode *node = NULL;
 
 	if (expected_arch > RZ_FLIRT_SIG_ARCH_ANY) {
 		RZ_LOG_ERROR("FLIRT: unknown architecture %u\n", expected_arch);
-		return false;
+		return NULL;
 	}
 
 	const char *extension = rz_str_lchr(flirt_file, '.');
 	if (RZ_STR_ISEMPTY(extension) || (strcmp(extension, ".sig") != 0 && strcmp(extension, ".pat") != 0)) {
 		RZ_LOG_ERROR("FLIRT: unknown extension '%s'\n", extension);
-		return false;
+		return NULL;
 	}
 
 	if (!(flirt_buf = rz_buf_new_slurp(flirt_file))) {
 		RZ_LOG_ERROR("FLIRT: Can't open %s\n", flirt_file);
-		return false;
+		return NULL;
 	}
 
 	if (!strcmp(extension, ".pat")) {
@@ -1339,15 +1512,35 @@ RZ_API bool rz_sign_flirt_apply(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL cons
 	}
 
 	rz_buf_free(flirt_buf);
-	if (node) {
-		if (!node_match_functions(analysis, node)) {
-			RZ_LOG_ERROR("FLIRT: Error while scanning the file %s\n", flirt_file);
-		}
-		rz_sign_flirt_node_free(node);
-		return true;
+	if (!node) {
+		RZ_LOG_ERROR("FLIRT: We encountered an error while parsing the file %s. Sorry.\n", flirt_file);
 	}
-	RZ_LOG_ERROR("FLIRT: We encountered an error while parsing the file %s. Sorry.\n", flirt_file);
-	return false;
+	return node;
+}
+
+/**
+ * \brief Parses the FLIRT file and applies the signatures
+ *
+ * \param  analysis       The RzAnalysis structure
+ * \param  flirt_file     The FLIRT file to parse
+ * \param  expected_arch  The expected architecture of the signatures
+ * \param  max_threads    The maximum number of threads matching the functions (RZ_THREAD_POOL_ALL_CORES for all cores)
+ * \return true if the signatures were sucessfully applied to the file
+ */
+RZ_API bool rz_sign_flirt_apply(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL const char *flirt_file, ut8 expected_arch, size_t max_threads) {
+	rz_return_val_if_fail(analysis && RZ_STR_ISNOTEMPTY(flirt_file), false);
+	RzFlirtNode *node = rz_sign_flirt_parse_file(flirt_file, expected_arch);
+	if (!node) {
+		return false;
+	}
+	RzPVector trees;
+	rz_pvector_init(&trees, NULL);
+	if (!rz_pvector_push(&trees, node) || !rz_sign_flirt_apply_nodes(analysis, &trees, max_threads)) {
+		RZ_LOG_ERROR("FLIRT: Error while scanning the file %s\n", flirt_file);
+	}
+	rz_pvector_fini(&trees);
+	rz_sign_flirt_node_free(node);
+	return true;
 }
 
 /**
@@ -8,6 +8,8 @@
 #include <rz_type.h>
 #include <string.h>
 
+#include "type_private.h"
+
 /**
  * \brief Creates a new RzCallable type
  *
@@ -161,9 +163,8 @@ RZ_API bool rz_type_func_save(RzTypeDB *typedb, RZ_NONNULL RzCallable *callable)
  */
 RZ_API RZ_BORROW RzCallable *rz_type_func_get(RzTypeDB *typedb, RZ_NONNULL const char *name) {
 	rz_return_val_if_fail(typedb && name, NULL);
-	bool found = false;
-	RzCallable *callable = ht_pp_find(typedb->callables, name, &found);
-	if (!found || !callable) {
+	RzCallable *callable = rz_type_func_find(typedb, typedb->callables, name);
+	if (!callable) {
 		RZ_LOG_DEBUG("Cannot find function type \"%s\"\n", name);
 		return NULL;
 	}
@@ -179,6 +180,7 @@ RZ_API RZ_BORROW RzCallable *rz_type_func_get(RzTypeDB *typedb, RZ_NONNULL const
 RZ_API bool rz_type_func_delete(RzTypeDB *typedb, RZ_NONNULL const char *name) {
 	rz_return_val_if_fail(typedb && name, false);
 	ht_pp_delete(typedb->callables, name);
+	rz_type_func_forget_lazy(typedb, name);
 	return true;
 }
 
@@ -190,6 +192,8 @@ static void callables_ht_free(HtPPKv *kv) {
  * \brief Removes all RzCallable types
  */
 RZ_API void rz_type_func_delete_all(RzTypeDB *typedb) {
+	rz_list_free(typedb->lazy_callables);
+	typedb->lazy_callables = NULL;
 	ht_pp_free(typedb->callables);
 	typedb->callables = ht_pp_new(NULL, callables_ht_free, NULL);
 }
@@ -202,8 +206,7 @@ RZ_API void rz_type_func_delete_all(RzTypeDB *typedb) {
  */
 RZ_API bool rz_type_func_exist(RzTypeDB *typedb, RZ_NONNULL const char *name) {
 	rz_return_val_if_fail(typedb && name, false);
-	bool found = false;
-	return ht_pp_find(typedb->callables, name, &found) && found;
+	return rz_type_func_find(typedb, typedb->callables, name);
 }
 
 /**
@@ -567,6 +570,7 @@ static bool function_names_collect_cb(void *user, const void *k, const void *v)
  */
 RZ_API RZ_OWN RzList /*<char *>*/ *rz_type_function_names(RzTypeDB *typedb) {
 	rz_return_val_if_fail(typedb, NULL);
+	rz_type_db_pin_all(typedb);
 	RzList *result = rz_list_newf(free);
 	ht_pp_foreach(typedb->callables, function_names_collect_cb, result);
 	return result;
@@ -589,6 +593,9 @@ static bool noreturn_function_names_collect_cb(void *user, const void *k, const
 RZ_API RZ_OWN RzList /*<char *>*/ *rz_type_noreturn_function_names(RzTypeDB *typedb) {
 	rz_return_val_if_fail(typedb, NULL);
 	RzList *noretl = rz_list_newf(free);
+	rz_th_lock_enter(typedb->lazy_lock);
 	ht_pp_foreach(typedb->callables, noreturn_function_names_collect_cb, noretl);
+	rz_type_func_lazy_noreturn_names(typedb, noretl);
+	rz_th_lock_leave(typedb->lazy_lock);
 	return noretl;
 }
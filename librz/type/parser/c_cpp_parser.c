@@ -285,6 +285,7 @@ RZ_API int rz_type_parse_string(RzTypeDB *typedb, const char *code, char **error
 		eprintf("CParserState initialization error!\n");
 		return -1;
 	}
+	state->typedb = typedb;
 	state->verbose = verbose;
 	int ret = type_parse_string(state, code, error_msg);
 	c_parser_state_free_keep_ht(state);
@@ -12,6 +12,7 @@ typedef struct {
 	bool verbose;
 	HtPP *types;
 	HtPP *callables;
+	RzTypeDB *typedb; //< if set, callables missing from `callables` are looked up in its lazy databases
 	HtPP *forward;
 	RzStrBuf *errors;
 	RzStrBuf *warnings;
@@ -9,6 +9,7 @@
 #include <tree_sitter/api.h>
 
 #include <types_parser.h>
+#include "../type_private.h"
 
 // Searching and storing types in the context of the parser (types and callables hashables)
 
@@ -83,12 +84,10 @@ bool c_parser_forward_definition_remove(CParserState *state, RZ_NONNULL const ch
 // Callable types
 
 RzCallable *c_parser_callable_type_find(CParserState *state, RZ_NONNULL const char *name) {
-	bool found = false;
-	RzCallable *callable = ht_pp_find(state->callables, name, &found);
-	if (!found || !callable) {
-		return NULL;
+	if (state->typedb) {
+		return rz_type_func_find(state->typedb, state->callables, name);
 	}
-	return callable;
+	return ht_pp_find(state->callables, name, NULL);
 }
 
 bool c_parser_callable_type_exists(CParserState *state, RZ_NONNULL const char *name) {
@@ -806,9 +805,8 @@ RZ_OWN RzType *c_parser_new_callable(CParserState *state, RZ_NONNULL const char
 		return NULL;
 	}
 	// We check if there is already a callable in the hashtable with the same name
-	bool found = false;
-	RzCallable *callable = ht_pp_find(state->callables, name, &found);
-	if (!found || !callable) {
+	RzCallable *callable = c_parser_callable_type_find(state, name);
+	if (!callable) {
 		// If not found - create a new one
 		callable = RZ_NEW0(RzCallable);
 		if (!callable) {
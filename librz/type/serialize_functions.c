@@ -7,6 +7,8 @@
 #include <rz_type.h>
 #include <sdb.h>
 
+#include "type_private.h"
+
 /**
  * Parse a type or take it from the cache if it has been parsed before already.
  * This cache is really only relevant because types are stored in the sdb as their C expression,
@@ -284,6 +286,200 @@ RZ_API bool rz_type_db_load_callables_sdb_str(RzTypeDB *typedb, RZ_NONNULL const
 	return sdb_load_from_string(typedb, str);
 }
 
+/**
+ * \brief Opens the compiled SDB specified by path as a lazily loaded callable types database
+ *
+ * Unlike rz_type_db_load_callables_sdb(), the signatures are not parsed upfront:
+ * the database stays mapped and every callable is loaded the first time it is
+ * looked up by name. Databases opened later take precedence over the earlier ones,
+ * as they would if they were loaded in the same order. Opening a database that
+ * is open already does nothing, so that initializing the types again is idempotent.
+ *
+ * \param typedb RzTypeDB instance
+ * \param path A path to the compiled SDB containing serialized types
+ */
+RZ_API bool rz_type_db_open_callables_sdb(RzTypeDB *typedb, RZ_NONNULL const char *path) {
+	rz_return_val_if_fail(typedb && path, false);
+	if (!rz_file_exists(path)) {
+		return false;
+	}
+	if (!typedb->lazy_callables) {
+		typedb->lazy_callables = rz_list_newf((RzListFree)sdb_free);
+		if (!typedb->lazy_callables) {
+			return false;
+		}
+	}
+	RzListIter *it;
+	Sdb *db;
+	rz_list_foreach (typedb->lazy_callables, it, db) {
+		if (db->dir && !strcmp(db->dir, path)) {
+			return true;
+		}
+	}
+	db = sdb_new(0, path, 0);
+	if (!db) {
+		return false;
+	}
+	rz_th_lock_enter(typedb->lazy_lock);
+	rz_list_append(typedb->lazy_callables, db);
+	rz_th_lock_leave(typedb->lazy_lock);
+	return true;
+}
+
+/**
+ * \brief Loads the callable \p name from the lazily opened databases
+ *
+ * Every entry is parsed at most once: it is unset in its database afterwards,
+ * so that a broken signature is not parsed again on the next lookup.
+ * Must be called with typedb->lazy_lock held.
+ */
+static RzCallable *func_load_lazy(RzTypeDB *typedb, RZ_NONNULL const char *name) {
+	if (rz_list_empty(typedb->lazy_callables) || RZ_STR_ISEMPTY(name)) {
+		return NULL;
+	}
+	RzListIter *it;
+	Sdb *db;
+	rz_list_foreach_prev (typedb->lazy_callables, it, db) {
+		const char *kind = sdb_const_get(db, name, NULL);
+		if (!kind || strcmp(kind, "func")) {
+			continue;
+		}
+		HtPP *type_str_cache = ht_pp_new0();
+		if (!type_str_cache) {
+			return NULL;
+		}
+		RzCallable *callable = get_callable_type(typedb, db, name, type_str_cache);
+		ht_pp_free(type_str_cache);
+		sdb_unset(db, name, 0);
+		if (callable) {
+			ht_pp_insert(typedb->callables, callable->name, callable);
+			RZ_LOG_DEBUG("loaded the \"%s\" callable type on lookup\n", callable->name);
+			return callable;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * \brief Finds the callable \p name in \p callables, loading it from the lazily opened databases if needed
+ *
+ * Loading a callable changes the database, so the lookups are serialized with
+ * typedb->lazy_lock: looking up callables from several threads is safe as long
+ * as the callables are not added or removed concurrently.
+ */
+RZ_IPI RZ_BORROW RzCallable *rz_type_func_find(RzTypeDB *typedb, HtPP *callables, RZ_NONNULL const char *name) {
+	rz_th_lock_enter(typedb->lazy_lock);
+	bool found = false;
+	RzCallable *callable = ht_pp_find(callables, name, &found);
+	if (!found) {
+		callable = func_load_lazy(typedb, name);
+	}
+	rz_th_lock_leave(typedb->lazy_lock);
+	return callable;
+}
+
+/**
+ * \brief Hides the callable \p name in the lazily opened databases
+ *
+ * Used when a callable is deleted, so that it is not loaded again by the next lookup.
+ */
+RZ_IPI void rz_type_func_forget_lazy(RzTypeDB *typedb, RZ_NONNULL const char *name) {
+	RzListIter *it;
+	Sdb *db;
+	rz_th_lock_enter(typedb->lazy_lock);
+	rz_list_foreach (typedb->lazy_callables, it, db) {
+		sdb_unset(db, name, 0);
+	}
+	rz_th_lock_leave(typedb->lazy_lock);
+}
+
+/**
+ * \brief Appends to \p names the noreturn callables of the lazily opened databases
+ *
+ * Only the callables that are not loaded yet are considered,
+ * and their signatures are not parsed.
+ * Must be called with typedb->lazy_lock held.
+ */
+RZ_IPI void rz_type_func_lazy_noreturn_names(RzTypeDB *typedb, RZ_NONNULL RzList /*<char *>*/ *names) {
+	if (rz_list_empty(typedb->lazy_callables)) {
+		return;
+	}
+	HtPP *seen = ht_pp_new0();
+	if (!seen) {
+		return;
+	}
+	RzStrBuf key;
+	rz_strbuf_init(&key);
+	RzListIter *it;
+	Sdb *db;
+	rz_list_foreach_prev (typedb->lazy_callables, it, db) {
+		SdbKv *kv;
+		SdbListIter *iter;
+		SdbList *l = sdb_foreach_list_filter(db, filter_func, false);
+		ls_foreach (l, iter, kv) {
+			const char *name = sdbkv_key(kv);
+			bool found = false;
+			ht_pp_find(typedb->callables, name, &found);
+			if (found || !ht_pp_insert(seen, name, NULL)) {
+				// loaded already or shadowed by a later database
+				continue;
+			}
+			if (sdb_bool_get(db, rz_strbuf_setf(&key, "func.%s.noreturn", name), 0)) {
+				rz_list_append(names, strdup(name));
+			}
+		}
+		ls_free(l);
+	}
+	rz_strbuf_fini(&key);
+	ht_pp_free(seen);
+}
+
+/**
+ * \brief Loads all the callables of the lazily opened databases
+ *
+ * Afterwards the databases are closed and all the callable types
+ * are in the database, as if they had been loaded eagerly.
+ * Callables that were already loaded or defined are kept.
+ *
+ * \param typedb RzTypeDB instance
+ */
+RZ_API void rz_type_db_pin_all(RzTypeDB *typedb) {
+	rz_return_if_fail(typedb);
+	rz_th_lock_enter(typedb->lazy_lock);
+	if (!typedb->lazy_callables) {
+		rz_th_lock_leave(typedb->lazy_lock);
+		return;
+	}
+	HtPP *type_str_cache = ht_pp_new0();
+	if (!type_str_cache) {
+		rz_th_lock_leave(typedb->lazy_lock);
+		return;
+	}
+	RzListIter *it;
+	Sdb *db;
+	rz_list_foreach_prev (typedb->lazy_callables, it, db) {
+		SdbKv *kv;
+		SdbListIter *iter;
+		SdbList *l = sdb_foreach_list_filter(db, filter_func, false);
+		ls_foreach (l, iter, kv) {
+			bool found = false;
+			ht_pp_find(typedb->callables, sdbkv_key(kv), &found);
+			if (found) {
+				continue;
+			}
+			RzCallable *callable = get_callable_type(typedb, db, sdbkv_key(kv), type_str_cache);
+			if (callable) {
+				ht_pp_insert(typedb->callables, callable->name, callable);
+			}
+		}
+		ls_free(l);
+	}
+	ht_pp_free(type_str_cache);
+	rz_list_free(typedb->lazy_callables);
+	typedb->lazy_callables = NULL;
+	rz_th_lock_leave(typedb->lazy_lock);
+}
+
 /**
  * \brief Saves the callable types into SDB
  *
@@ -292,6 +488,7 @@ RZ_API bool rz_type_db_load_callables_sdb_str(RzTypeDB *typedb, RZ_NONNULL const
  */
 RZ_API void rz_serialize_callables_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzTypeDB *typedb) {
 	rz_return_if_fail(db && typedb);
+	rz_type_db_pin_all(typedb);
 	callable_export_sdb(db, typedb);
 }
 
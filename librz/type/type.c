@@ -62,6 +62,11 @@ RZ_API RzTypeDB *rz_type_db_new() {
 	if (!typedb->parser) {
 		goto rz_type_db_new_fail;
 	}
+	// recursive: loading a callable parses its signature, which may look up callables
+	typedb->lazy_lock = rz_th_lock_new(true);
+	if (!typedb->lazy_lock) {
+		goto rz_type_db_new_fail;
+	}
 	rz_io_bind_init(typedb->iob);
 	return typedb;
 
@@ -71,6 +76,9 @@ rz_type_db_new_fail:
 	ht_pp_free(typedb->types);
 	ht_pp_free(typedb->formats);
 	ht_pp_free(typedb->callables);
+	if (typedb->parser) {
+		rz_type_parser_free(typedb->parser);
+	}
 	free(typedb);
 	return NULL;
 }
@@ -82,6 +90,8 @@ rz_type_db_new_fail:
  */
 RZ_API void rz_type_db_free(RzTypeDB *typedb) {
 	rz_type_parser_free(typedb->parser);
+	rz_list_free(typedb->lazy_callables);
+	rz_th_lock_free(typedb->lazy_lock);
 	ht_pp_free(typedb->callables);
 	ht_pp_free(typedb->types);
 	ht_pp_free(typedb->formats);
@@ -98,6 +108,8 @@ RZ_API void rz_type_db_free(RzTypeDB *typedb) {
  * Destroys all loaded base types and callable types.
  */
 RZ_API void rz_type_db_purge(RzTypeDB *typedb) {
+	rz_list_free(typedb->lazy_callables);
+	typedb->lazy_callables = NULL;
 	ht_pp_free(typedb->callables);
 	typedb->callables = ht_pp_new(NULL, callables_ht_free, NULL);
 	ht_pp_free(typedb->types);
@@ -239,6 +251,13 @@ RZ_API bool rz_type_db_del(RzTypeDB *typedb, RZ_NONNULL const char *name) {
 	return true;
 }
 
+static bool load_callables_sdb(RzTypeDB *typedb, const char *path) {
+	if (typedb->pin_all) {
+		return rz_type_db_load_callables_sdb(typedb, path);
+	}
+	return rz_type_db_open_callables_sdb(typedb, path);
+}
+
 /**
  * \brief Initializes the types database for specified arch, bits, OS
  *
@@ -333,16 +352,17 @@ RZ_API void rz_type_db_init(RzTypeDB *typedb, const char *types_dir, const char
 	}
 
 	// Then, after all basic types are initialized, we load function types
-	// that use loaded previously base types for return and arguments
+	// that use loaded previously base types for return and arguments.
+	// Unless pinned, the signatures are only parsed when looked up.
 	dbpath = rz_file_path_join(types_dir, "functions-libc.sdb");
-	if (rz_type_db_load_callables_sdb(typedb, dbpath)) {
+	if (load_callables_sdb(typedb, dbpath)) {
 		RZ_LOG_DEBUG("callable types: loaded \"%s\"\n", dbpath);
 	}
 	free(dbpath);
 	// OS-specific function types
 	if (os) {
 		dbpath = rz_file_path_join(types_dir, rz_strf(tmp, "functions-%s.sdb", os));
-		if (rz_type_db_load_callables_sdb(typedb, dbpath)) {
+		if (load_callables_sdb(typedb, dbpath)) {
 			RZ_LOG_DEBUG("callable types: loaded \"%s\"\n", dbpath);
 		}
 		free(dbpath);
@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef RZ_TYPE_PRIVATE_H
+#define RZ_TYPE_PRIVATE_H
+
+#include <rz_type.h>
+
+RZ_IPI RZ_BORROW RzCallable *rz_type_func_find(RzTypeDB *typedb, HtPP *callables, RZ_NONNULL const char *name);
+RZ_IPI void rz_type_func_forget_lazy(RzTypeDB *typedb, RZ_NONNULL const char *name);
+RZ_IPI void rz_type_func_lazy_noreturn_names(RzTypeDB *typedb, RZ_NONNULL RzList /*<char *>*/ *names);
+
+#endif // RZ_TYPE_PRIVATE_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include <rz_util.h>
+#include <set.h>
 
 enum {
 	WHITE_COLOR = 0,
@@ -172,14 +173,9 @@ RZ_API RzGraphNode *rz_graph_add_nodef(RzGraph *graph, void *data, RzListFree us
 	return node;
 }
 
-/* remove the node from the graph and free the node */
-/* users of this function should be aware they can't access n anymore */
-RZ_API void rz_graph_del_node(RzGraph *t, RzGraphNode *n) {
+static void graph_node_unlink(RzGraph *t, RzGraphNode *n) {
 	RzGraphNode *gn;
 	RzListIter *it;
-	if (!n) {
-		return;
-	}
 	rz_list_foreach (n->in_nodes, it, gn) {
 		rz_list_delete_data(gn->out_nodes, n);
 		rz_list_delete_data(gn->all_neighbours, n);
@@ -191,11 +187,48 @@ RZ_API void rz_graph_del_node(RzGraph *t, RzGraphNode *n) {
 		rz_list_delete_data(gn->all_neighbours, n);
 		t->n_edges--;
 	}
+}
 
+/* remove the node from the graph and free the node */
+/* users of this function should be aware they can't access n anymore */
+RZ_API void rz_graph_del_node(RzGraph *t, RzGraphNode *n) {
+	if (!n) {
+		return;
+	}
+	graph_node_unlink(t, n);
 	rz_list_delete_data(t->nodes, n);
 	t->n_nodes--;
 }
 
+/**
+ * \brief Remove all the nodes in \p nodes from the graph and free them
+ *
+ * Same as calling rz_graph_del_node() on each of them, but the list of the
+ * nodes of the graph is traversed only once.
+ */
+RZ_API void rz_graph_del_nodes(RzGraph *t, RZ_NONNULL const RzList /*<RzGraphNode *>*/ *nodes) {
+	rz_return_if_fail(t && nodes);
+	RzGraphNode *gn;
+	RzListIter *it, *tmp;
+	SetP *del = set_p_new();
+	if (!del) {
+		return;
+	}
+	rz_list_foreach (nodes, it, gn) {
+		if (!set_p_contains(del, gn)) {
+			set_p_add(del, gn);
+			graph_node_unlink(t, gn);
+		}
+	}
+	rz_list_foreach_safe (t->nodes, it, tmp, gn) {
+		if (set_p_contains(del, gn)) {
+			rz_list_delete(t->nodes, it);
+			t->n_nodes--;
+		}
+	}
+	set_p_free(del);
+}
+
 RZ_API void rz_graph_add_edge(RzGraph *t, RzGraphNode *from, RzGraphNode *to) {
 	rz_graph_add_edge_at(t, from, to, -1);
 }
@@ -14,6 +14,7 @@
 #undef VALUE_TYPE
 #undef KEY_TO_HASH
 #undef HT_NULL_VALUE
+#undef HT_OPEN_ADDRESSING
 
 #if HT_TYPE == 1
 #define HtName_(name)  name##PP
@@ -52,6 +53,13 @@
 #include "ls.h"
 #include <rz_types.h>
 
+// HtUP and HtUU can use an open addressing layout (see ht_oa_inc.c)
+#if WITH_HT_OPEN_ADDRESSING && (HT_TYPE == 2 || HT_TYPE == 3)
+#define HT_OPEN_ADDRESSING 1
+#else
+#define HT_OPEN_ADDRESSING 0
+#endif
+
 /* Kv represents a single key/value element in the hashtable */
 typedef struct Ht_(kv) {
 	KEY_TYPE key;
@@ -97,6 +105,18 @@ typedef struct Ht_(options_t) {
 HT_(Options);
 
 /* Ht is the hashtable structure */
+#if HT_OPEN_ADDRESSING
+typedef struct Ht_(t) {
+	ut32 size; // size of the hash table in slots, always a power of 2.
+	ut32 count; // number of stored elements.
+	ut32 growth_left; // number of elements which can be added before a rehash.
+	ut8 *ctrl; // control bytes, one for each slot.
+	HT_(Kv) * table; // Actual table.
+	HT_(Options)
+	opt;
+}
+HtName_(Ht);
+#else
 typedef struct Ht_(t) {
 	ut32 size; // size of the hash table in buckets.
 	ut32 count; // number of stored elements.
@@ -106,6 +126,7 @@ typedef struct Ht_(t) {
 	opt;
 }
 HtName_(Ht);
+#endif
 
 // Create a new Ht with the provided Options
 RZ_API HtName_(Ht) * Ht_(new_opt)(HT_(Options) * opt);
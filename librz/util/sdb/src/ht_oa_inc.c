@@ -0,0 +1,442 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*
+ * Open addressing implementation of the hashtable template, used by HtUP and
+ * HtUU when rizin is built with WITH_HT_OPEN_ADDRESSING.
+ *
+ * The layout follows the SwissTable design: the slots are split in groups of
+ * HT_GROUP_WIDTH elements and every slot owns a control byte, which is either
+ * EMPTY, DELETED or the lowest 7 bits of the hash of the stored key (H2).
+ * The remaining bits of the hash (H1) select the first group to probe; a
+ * lookup compares the control bytes of a whole group at once (with SSE2 when
+ * available) and only compares the keys of the slots whose H2 matches.
+ * Probing stops at the first group which contains an EMPTY slot.
+ *
+ * Keys are mixed to 64 bits before use, so addresses which differ only in
+ * their high bits (e.g. 0xffffffff8xxxxxxx kernel addresses) do not cluster.
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define HT_GROUP_WIDTH  16
+#define HT_MIN_SIZE     HT_GROUP_WIDTH
+#define HT_MAX_SIZE     (1U << 31)
+#define HT_CTRL_EMPTY   ((ut8)0x80)
+#define HT_CTRL_DELETED ((ut8)0xfe)
+#define HT_H1(hash)     ((ut32)((hash) >> 7))
+#define HT_H2(hash)     ((ut8)((hash)&0x7f))
+#define HT_IS_FULL(c)   (!((c)&0x80))
+
+// Bit i is set when the i-th slot of the group matches
+typedef ut32 HtGroupMask;
+
+static inline ut64 ht_mix64(ut64 x) {
+	// finalizer of MurmurHash3
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+static inline ut32 ht_mask_first(HtGroupMask mask) {
+#if defined(__GNUC__)
+	return (ut32)__builtin_ctz(mask);
+#else
+	ut32 i = 0;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+#if defined(__SSE2__)
+static inline HtGroupMask group_match(const ut8 *ctrl, ut8 h2) {
+	__m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+	return (HtGroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+static inline HtGroupMask group_match_unused(const ut8 *ctrl) {
+	// EMPTY and DELETED are the only control bytes with the highest bit set
+	return (HtGroupMask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+#else
+static inline HtGroupMask group_match(const ut8 *ctrl, ut8 h2) {
+	HtGroupMask mask = 0;
+	for (ut32 i = 0; i < HT_GROUP_WIDTH; i++) {
+		mask |= (HtGroupMask)(ctrl[i] == h2) << i;
+	}
+	return mask;
+}
+
+static inline HtGroupMask group_match_unused(const ut8 *ctrl) {
+	HtGroupMask mask = 0;
+	for (ut32 i = 0; i < HT_GROUP_WIDTH; i++) {
+		mask |= (HtGroupMask)(ctrl[i] >> 7) << i;
+	}
+	return mask;
+}
+#endif
+
+static inline ut64 hashfn(HtName_(Ht) * ht, const KEY_TYPE k) {
+	return ht_mix64(ht->opt.hashfn ? ht->opt.hashfn(k) : (ut64)k);
+}
+
+static inline KEY_TYPE dupkey(HtName_(Ht) * ht, const KEY_TYPE k) {
+	return ht->opt.dupkey ? ht->opt.dupkey(k) : (KEY_TYPE)k;
+}
+
+static inline VALUE_TYPE dupval(HtName_(Ht) * ht, const VALUE_TYPE v) {
+	return ht->opt.dupvalue ? ht->opt.dupvalue(v) : (VALUE_TYPE)v;
+}
+
+static inline ut32 calcsize_key(HtName_(Ht) * ht, const KEY_TYPE k) {
+	return ht->opt.calcsizeK ? ht->opt.calcsizeK(k) : 0;
+}
+
+static inline ut32 calcsize_val(HtName_(Ht) * ht, const VALUE_TYPE v) {
+	return ht->opt.calcsizeV ? ht->opt.calcsizeV(v) : 0;
+}
+
+static inline void freefn(HtName_(Ht) * ht, HT_(Kv) * kv) {
+	if (ht->opt.freefn) {
+		ht->opt.freefn(kv);
+	}
+}
+
+static inline bool is_kv_equal(HtName_(Ht) * ht, const KEY_TYPE key, const ut32 key_len, const HT_(Kv) * kv) {
+	if (key_len != kv->key_len) {
+		return false;
+	}
+
+	bool res = key == kv->key;
+	if (!res && ht->opt.cmp) {
+		res = !ht->opt.cmp(key, kv->key);
+	}
+	return res;
+}
+
+static inline HT_(Kv) * kv_at(HtName_(Ht) * ht, ut32 i) {
+	return (HT_(Kv) *)((char *)ht->table + (size_t)i * ht->opt.elem_size);
+}
+
+// Maximum number of used slots (elements + tombstones), i.e. a load factor of 7/8
+static inline ut32 max_load(ut32 size) {
+	return size - size / 8;
+}
+
+// Smallest power of two number of slots able to hold `count` elements
+static inline ut32 size_for(ut32 count) {
+	ut32 size = HT_MIN_SIZE;
+	while (size < HT_MAX_SIZE && max_load(size) < count) {
+		size <<= 1;
+	}
+	return size;
+}
+
+/*
+ * Returns the index of the slot containing `key` or UT32_MAX if not found.
+ * The groups are visited following a triangular sequence, which visits every
+ * group exactly once when the number of groups is a power of two.
+ */
+static ut32 find_slot(HtName_(Ht) * ht, const KEY_TYPE key, ut32 key_len, ut64 hash) {
+	const ut32 gmask = ht->size / HT_GROUP_WIDTH - 1;
+	const ut8 h2 = HT_H2(hash);
+	ut32 g = HT_H1(hash) & gmask;
+
+	for (ut32 step = 1; step <= gmask + 1; step++) {
+		const ut8 *ctrl = ht->ctrl + (size_t)g * HT_GROUP_WIDTH;
+		HtGroupMask mask = group_match(ctrl, h2);
+		while (mask) {
+			ut32 i = g * HT_GROUP_WIDTH + ht_mask_first(mask);
+			if (is_kv_equal(ht, key, key_len, kv_at(ht, i))) {
+				return i;
+			}
+			mask &= mask - 1;
+		}
+		if (group_match(ctrl, HT_CTRL_EMPTY)) {
+			return UT32_MAX;
+		}
+		g = (g + step) & gmask;
+	}
+	return UT32_MAX;
+}
+
+// Returns the index of the first EMPTY or DELETED slot in the probe sequence of `hash`
+static ut32 find_unused_slot(HtName_(Ht) * ht, ut64 hash) {
+	const ut32 gmask = ht->size / HT_GROUP_WIDTH - 1;
+	ut32 g = HT_H1(hash) & gmask;
+
+	for (ut32 step = 1; step <= gmask + 1; step++) {
+		HtGroupMask mask = group_match_unused(ht->ctrl + (size_t)g * HT_GROUP_WIDTH);
+		if (mask) {
+			return g * HT_GROUP_WIDTH + ht_mask_first(mask);
+		}
+		g = (g + step) & gmask;
+	}
+	return UT32_MAX;
+}
+
+static bool table_init(HtName_(Ht) * ht, ut32 size) {
+	ut8 *ctrl = malloc(size);
+	HT_(Kv) *table = calloc(size, ht->opt.elem_size);
+	if (!ctrl || !table) {
+		free(ctrl);
+		free(table);
+		return false;
+	}
+	memset(ctrl, HT_CTRL_EMPTY, size);
+	ht->ctrl = ctrl;
+	ht->table = table;
+	ht->size = size;
+	ht->growth_left = max_load(size) - ht->count;
+	return true;
+}
+
+// Moves all the elements into a new table, dropping the tombstones and growing when needed.
+static bool internal_ht_rehash(HtName_(Ht) * ht) {
+	ut32 size = ht->size;
+	if ((ut64)ht->count * 32 > (ut64)ht->size * 25) {
+		// the table is full of elements and not of tombstones, so it needs to grow
+		if (size >= HT_MAX_SIZE) {
+			return false;
+		}
+		size <<= 1;
+	}
+
+	HtName_(Ht) old = *ht;
+	if (!table_init(ht, size)) {
+		*ht = old;
+		return false;
+	}
+
+	for (ut32 i = 0; i < old.size; i++) {
+		if (!HT_IS_FULL(old.ctrl[i])) {
+			continue;
+		}
+		HT_(Kv) *kv = (HT_(Kv) *)((char *)old.table + (size_t)i * old.opt.elem_size);
+		ut64 hash = hashfn(ht, kv->key);
+		ut32 j = find_unused_slot(ht, hash);
+		ht->ctrl[j] = HT_H2(hash);
+		memcpy(kv_at(ht, j), kv, ht->opt.elem_size);
+	}
+	free(old.ctrl);
+	free(old.table);
+	return true;
+}
+
+static void erase_slot(HtName_(Ht) * ht, ut32 i) {
+	const ut8 *group = ht->ctrl + (size_t)(i / HT_GROUP_WIDTH) * HT_GROUP_WIDTH;
+	// A group containing an EMPTY slot has never been full since the last
+	// rehash, thus no probe sequence went past it and the slot can be reused
+	// freely; otherwise a tombstone is needed to keep the probe sequences intact.
+	if (group_match(group, HT_CTRL_EMPTY)) {
+		ht->ctrl[i] = HT_CTRL_EMPTY;
+		ht->growth_left++;
+	} else {
+		ht->ctrl[i] = HT_CTRL_DELETED;
+	}
+	ht->count--;
+}
+
+// Create a new hashtable able to hold `size` elements without rehashing.
+// prime_idx is unused and kept only for compatibility with the chained implementation.
+static HtName_(Ht) * internal_ht_new(ut32 size, ut32 prime_idx, HT_(Options) * opt) {
+	HtName_(Ht) *ht = calloc(1, sizeof(*ht));
+	if (!ht) {
+		return NULL;
+	}
+	ht->opt = *opt;
+	// if not provided, assume we are dealing with a regular HtName_(Ht), with
+	// HT_(Kv) as elements
+	if (ht->opt.elem_size == 0) {
+		ht->opt.elem_size = sizeof(HT_(Kv));
+	}
+	if (!table_init(ht, size_for(size))) {
+		free(ht);
+		return NULL;
+	}
+	return ht;
+}
+
+RZ_API HtName_(Ht) * Ht_(new_opt)(HT_(Options) * opt) {
+	return internal_ht_new(0, 0, opt);
+}
+
+RZ_API void Ht_(free)(HtName_(Ht) * ht) {
+	if (!ht) {
+		return;
+	}
+
+	if (ht->opt.freefn) {
+		for (ut32 i = 0; i < ht->size; i++) {
+			if (HT_IS_FULL(ht->ctrl[i])) {
+				ht->opt.freefn(kv_at(ht, i));
+			}
+		}
+	}
+	free(ht->ctrl);
+	free(ht->table);
+	free(ht);
+}
+
+static HT_(Kv) * reserve_kv(HtName_(Ht) * ht, const KEY_TYPE key, const int key_len, bool update) {
+	ut64 hash = hashfn(ht, key);
+	ut32 i = find_slot(ht, key, key_len, hash);
+	if (i != UT32_MAX) {
+		if (update) {
+			HT_(Kv) *kv = kv_at(ht, i);
+			freefn(ht, kv);
+			return kv;
+		}
+		return NULL;
+	}
+
+	if (!ht->growth_left && !internal_ht_rehash(ht)) {
+		return NULL;
+	}
+
+	i = find_unused_slot(ht, hash);
+	if (i == UT32_MAX) {
+		return NULL;
+	}
+	if (ht->ctrl[i] == HT_CTRL_EMPTY) {
+		ht->growth_left--;
+	}
+	ht->ctrl[i] = HT_H2(hash);
+	ht->count++;
+	return kv_at(ht, i);
+}
+
+RZ_API bool Ht_(insert_kv)(HtName_(Ht) * ht, HT_(Kv) * kv, bool update) {
+	HT_(Kv) *kv_dst = reserve_kv(ht, kv->key, kv->key_len, update);
+	if (!kv_dst) {
+		return false;
+	}
+
+	memcpy(kv_dst, kv, ht->opt.elem_size);
+	return true;
+}
+
+static bool insert_update(HtName_(Ht) * ht, const KEY_TYPE key, VALUE_TYPE value, bool update) {
+	ut32 key_len = calcsize_key(ht, key);
+	HT_(Kv) *kv_dst = reserve_kv(ht, key, key_len, update);
+	if (!kv_dst) {
+		return false;
+	}
+
+	kv_dst->key = dupkey(ht, key);
+	kv_dst->key_len = key_len;
+	kv_dst->value = dupval(ht, value);
+	kv_dst->value_len = calcsize_val(ht, value);
+	return true;
+}
+
+// Inserts the key value pair key, value into the hashtable.
+// Doesn't allow for "update" of the value.
+RZ_API bool Ht_(insert)(HtName_(Ht) * ht, const KEY_TYPE key, VALUE_TYPE value) {
+	return insert_update(ht, key, value, false);
+}
+
+// Inserts the key value pair key, value into the hashtable.
+// Does allow for "update" of the value.
+RZ_API bool Ht_(update)(HtName_(Ht) * ht, const KEY_TYPE key, VALUE_TYPE value) {
+	return insert_update(ht, key, value, true);
+}
+
+// Update the key of an element that has old_key as key and replace it with new_key
+RZ_API bool Ht_(update_key)(HtName_(Ht) * ht, const KEY_TYPE old_key, const KEY_TYPE new_key) {
+	// First look for the value associated with old_key
+	bool found;
+	VALUE_TYPE value = Ht_(find)(ht, old_key, &found);
+	if (!found) {
+		return false;
+	}
+
+	// Associate the existing value with new_key
+	bool inserted = insert_update(ht, new_key, value, false);
+	if (!inserted) {
+		return false;
+	}
+
+	// Remove the old_key kv, paying attention to not double free the value
+	// (the slot has to be looked up again, since the insertion may have rehashed the table)
+	const ut32 old_key_len = calcsize_key(ht, old_key);
+	ut32 i = find_slot(ht, old_key, old_key_len, hashfn(ht, old_key));
+	if (i == UT32_MAX) {
+		return false;
+	}
+
+	HT_(Kv) *kv = kv_at(ht, i);
+	if (!ht->opt.dupvalue) {
+		// do not free the value part if dupvalue is not
+		// set, because the old value has been
+		// associated with the new key and it should not
+		// be freed
+		kv->value = HT_NULL_VALUE;
+		kv->value_len = 0;
+	}
+	freefn(ht, kv);
+	erase_slot(ht, i);
+	return true;
+}
+
+// Returns the corresponding Kv entry from the key.
+// If `found` is not NULL, it will be set to true if the entry was found, false
+// otherwise.
+RZ_API HT_(Kv) * Ht_(find_kv)(HtName_(Ht) * ht, const KEY_TYPE key, bool *found) {
+	if (found) {
+		*found = false;
+	}
+	if (!ht) {
+		return NULL;
+	}
+
+	ut32 i = find_slot(ht, key, calcsize_key(ht, key), hashfn(ht, key));
+	if (i == UT32_MAX) {
+		return NULL;
+	}
+	if (found) {
+		*found = true;
+	}
+	return kv_at(ht, i);
+}
+
+// Looks up the corresponding value from the key.
+// If `found` is not NULL, it will be set to true if the entry was found, false
+// otherwise.
+RZ_API VALUE_TYPE Ht_(find)(HtName_(Ht) * ht, const KEY_TYPE key, bool *found) {
+	HT_(Kv) *res = Ht_(find_kv)(ht, key, found);
+	return res ? res->value : HT_NULL_VALUE;
+}
+
+// Deletes a entry from the hash table from the key, if the pair exists.
+RZ_API bool Ht_(delete)(HtName_(Ht) * ht, const KEY_TYPE key) {
+	ut32 i = find_slot(ht, key, calcsize_key(ht, key), hashfn(ht, key));
+	if (i == UT32_MAX) {
+		return false;
+	}
+	freefn(ht, kv_at(ht, i));
+	erase_slot(ht, i);
+	return true;
+}
+
+// Deleting elements from the callback is safe, since the elements are never
+// moved unless the table is rehashed, which happens only on insertion.
+RZ_API void Ht_(foreach)(HtName_(Ht) * ht, HT_(ForeachCallback) cb, void *user) {
+	for (ut32 i = 0; i < ht->size; ++i) {
+		if (!HT_IS_FULL(ht->ctrl[i])) {
+			continue;
+		}
+		HT_(Kv) *kv = kv_at(ht, i);
+		if (!cb(user, kv->key, kv->value)) {
+			return;
+		}
+	}
+}
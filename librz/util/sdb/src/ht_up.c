@@ -4,7 +4,11 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "ht_up.h"
+#if HT_OPEN_ADDRESSING
+#include "ht_oa_inc.c"
+#else
 #include "ht_inc.c"
+#endif
 
 static HtName_(Ht) * internal_ht_default_new(ut32 size, ut32 prime_idx, HT_(DupValue) valdup, HT_(KvFreeFunc) pair_free, HT_(CalcSizeV) calcsizeV) {
 	HT_(Options)
@@ -22,7 +26,11 @@ static HtName_(Ht) * internal_ht_default_new(ut32 size, ut32 prime_idx, HT_(DupV
 }
 
 RZ_API HtName_(Ht) * Ht_(new)(HT_(DupValue) valdup, HT_(KvFreeFunc) pair_free, HT_(CalcSizeV) calcsizeV) {
+#if HT_OPEN_ADDRESSING
+	return internal_ht_default_new(0, 0, valdup, pair_free, calcsizeV);
+#else
 	return internal_ht_default_new(ht_primes_sizes[0], 0, valdup, pair_free, calcsizeV);
+#endif
 }
 
 // creates a default HtUP that does not dup, nor free the values
@@ -31,6 +39,10 @@ RZ_API HtName_(Ht) * Ht_(new0)(void) {
 }
 
 RZ_API HtName_(Ht) * Ht_(new_size)(ut32 initial_size, HT_(DupValue) valdup, HT_(KvFreeFunc) pair_free, HT_(CalcSizeV) calcsizeV) {
+#if HT_OPEN_ADDRESSING
+	// the open addressing table rounds the size to the next power of 2 by itself
+	return internal_ht_default_new(initial_size, 0, valdup, pair_free, calcsizeV);
+#else
 	ut32 i = 0;
 
 	while (i < S_ARRAY_SIZE(ht_primes_sizes) &&
@@ -43,4 +55,5 @@ RZ_API HtName_(Ht) * Ht_(new_size)(ut32 initial_size, HT_(DupValue) valdup, HT_(
 
 	ut32 sz = compute_size(i, (ut32)(initial_size * (2 - LOAD_FACTOR)));
 	return internal_ht_default_new(sz, i, valdup, pair_free, calcsizeV);
+#endif
 }
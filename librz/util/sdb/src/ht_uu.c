@@ -5,7 +5,11 @@
 
 #include "ht_uu.h"
 
+#if HT_OPEN_ADDRESSING
+#include "ht_oa_inc.c"
+#else
 #include "ht_inc.c"
+#endif
 
 RZ_API HtName_(Ht) * Ht_(new0)(void) {
 	HT_(Options)
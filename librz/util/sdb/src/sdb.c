@@ -442,6 +442,19 @@ RZ_API void sdb_reset(Sdb *s) {
 	s->ht = sdb_ht_new();
 }
 
+// sizes the hashtable of an empty sdb to hold count records without growing,
+// which costs far more than the inserts themselves when loading many records
+RZ_API void sdb_reserve(Sdb *s, ut32 count) {
+	if (!s || s->ht->count || count <= s->ht->size) {
+		return;
+	}
+	HtPP *ht = sdb_ht_new_size(count);
+	if (ht) {
+		sdb_ht_free(s->ht);
+		s->ht = ht;
+	}
+}
+
 static char lastChar(const char *str) {
 	int len = strlen(str);
 	return str[(len > 0) ? len - 1 : 0];
@@ -103,6 +103,7 @@ RZ_API void sdb_file(Sdb *s, const char *dir);
 RZ_API bool sdb_merge(Sdb *d, Sdb *s);
 RZ_API int sdb_count(Sdb *s);
 RZ_API void sdb_reset(Sdb *s);
+RZ_API void sdb_reserve(Sdb *s, ut32 count);
 RZ_API void sdb_setup(Sdb *s, int options);
 RZ_API void sdb_drain(Sdb *, Sdb *);
 
@@ -16,6 +16,15 @@ RZ_API HtPP *sdb_ht_new(void) {
 	return ht;
 }
 
+// same as sdb_ht_new(), but sized to hold initial_size elements without growing
+RZ_API HtPP *sdb_ht_new_size(ut32 initial_size) {
+	HtPP *ht = ht_pp_new_size(initial_size, (HtPPDupValue)strdup, (HtPPKvFreeFunc)sdbkv_fini, (HtPPCalcSizeV)strlen);
+	if (ht) {
+		ht->opt.elem_size = sizeof(SdbKv);
+	}
+	return ht;
+}
+
 static bool sdb_ht_internal_insert(HtPP *ht, const char *key, const char *value, bool update) {
 	if (!ht || !key || !value) {
 		return false;
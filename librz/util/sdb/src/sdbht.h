@@ -41,6 +41,7 @@ extern RZ_API void sdbkv_free(SdbKv *kv);
 extern RZ_API ut32 sdb_hash(const char *key);
 
 RZ_API HtPP *sdb_ht_new(void);
+RZ_API HtPP *sdb_ht_new_size(ut32 initial_size);
 // Destroy a hashtable and all of its entries.
 RZ_API void sdb_ht_free(HtPP *ht);
 // Insert a new Key-Value pair into the hashtable. If the key already exists, returns false.
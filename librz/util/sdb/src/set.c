@@ -5,8 +5,10 @@
 
 // p
 
+// the keys are the pointers themselves, neither hashed as strings nor copied
 RZ_API SetP *set_p_new(void) {
-	return ht_pp_new0();
+	HtPPOptions opt = { 0 };
+	return ht_pp_new_opt(&opt);
 }
 
 RZ_API void set_p_add(SetP *s, const void *u) {
@@ -228,6 +228,26 @@ typedef struct {
 	bool unescape; // whether the prev char was a backslash, i.e. the current one is escaped
 } LoadCtx;
 
+// presizes the current namespace for the lines from the offset from up to
+// the next path line, which is an upper bound of its records.
+static void load_reserve(LoadCtx *ctx, size_t from) {
+	if (from >= ctx->bufsz) {
+		return;
+	}
+	ut32 lines = 0;
+	const char *p = ctx->buf + from;
+	const char *end = ctx->buf + ctx->bufsz;
+	while (p < end && *p != '/') {
+		lines++;
+		p = memchr(p, '\n', end - p);
+		if (!p) {
+			break;
+		}
+		p++;
+	}
+	sdb_reserve(ctx->cur_db, lines);
+}
+
 // to be called at the end of a line.
 // save all the data processed from the line into the database.
 // assumes that the ctx->buf is allocated until ctx->buf[ctx->pos] inclusive!
@@ -253,6 +273,7 @@ static void load_process_line(LoadCtx *ctx) {
 			}
 		}
 		ls_destroy(ctx->path);
+		load_reserve(ctx, ctx->pos + 1);
 		break;
 	}
 	case STATE_VALUE: {
@@ -392,6 +413,7 @@ RZ_API bool sdb_text_load_buf(Sdb *s, char *buf, size_t sz) {
 		return false;
 	}
 	bool ret = true;
+	load_reserve(&ctx, 0);
 	while (ctx.pos < ctx.bufsz) {
 		load_process_single_char(&ctx);
 	}
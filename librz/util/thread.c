@@ -33,6 +33,20 @@ RZ_IPI RZ_TH_TID rz_th_self(void) {
 #endif
 }
 
+/**
+ * \brief Returns true when called from the thread \p th
+ */
+RZ_IPI bool rz_th_is_self(RZ_NONNULL RzThread *th) {
+#if HAVE_PTHREAD
+	return pthread_equal(th->tid, pthread_self());
+#elif __WINDOWS__
+	// GetCurrentThread() returns a pseudo handle which cannot be compared
+	return GetThreadId(th->tid) == GetCurrentThreadId();
+#else
+	return false;
+#endif
+}
+
 /**
  * \brief Sets the name of the thread
  *
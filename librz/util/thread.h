@@ -89,5 +89,6 @@ struct rz_th_t {
 };
 
 RZ_IPI RZ_TH_TID rz_th_self(void);
+RZ_IPI bool rz_th_is_self(RZ_NONNULL RzThread *th);
 
 #endif /* RZ_THREAD_INTERNAL_H */
@@ -2,6 +2,8 @@
 // SPDX-FileCopyrightText: 2022 deroad <wargio@libero.it>
 // SPDX-License-Identifier: LGPL-3.0-only
 
+#include <errno.h>
+#include <rz_util/rz_time.h>
 #include "thread.h"
 
 /**
@@ -69,6 +71,31 @@ RZ_API void rz_th_cond_wait(RZ_NONNULL RzThreadCond *cond, RZ_NONNULL RzThreadLo
 #endif
 }
 
+/**
+ * \brief  Like rz_th_cond_wait, but gives up after \p timeout_ms milliseconds
+ *
+ * \param  cond        The RzThreadCond to use for waiting the signal
+ * \param  lock        The RzThreadLock lock to use (the lock must be already taken by the thread)
+ * \param  timeout_ms  The maximum time to wait in milliseconds
+ *
+ * \return Returns false when the wait timed out, otherwise true
+ */
+RZ_API bool rz_th_cond_timedwait(RZ_NONNULL RzThreadCond *cond, RZ_NONNULL RzThreadLock *lock, ut32 timeout_ms) {
+	rz_return_val_if_fail(cond && lock, false);
+#if HAVE_PTHREAD
+	ut64 deadline = rz_time_now() + (ut64)timeout_ms * RZ_USEC_PER_MSEC;
+	struct timespec ts = {
+		.tv_sec = deadline / RZ_USEC_PER_SEC,
+		.tv_nsec = (deadline % RZ_USEC_PER_SEC) * RZ_NSEC_PER_USEC,
+	};
+	return pthread_cond_timedwait(&cond->cond, &lock->lock, &ts) != ETIMEDOUT;
+#elif __WINDOWS__
+	return SleepConditionVariableCS(&cond->cond, &lock->lock, timeout_ms);
+#else
+	return true;
+#endif
+}
+
 /**
  * \brief  Frees a RzThreadCond struct
  *
@@ -10,53 +10,86 @@
 #include <rz_th.h>
 #include <rz_util.h>
 
-static bool th_run_iterator(RzThreadFunction th_cb, void *context, size_t max_threads) {
-	RzThreadPool *pool = rz_th_pool_new(max_threads);
-	if (!pool) {
-		RZ_LOG_ERROR("th: failed to allocate thread pool\n");
-		return false;
-	}
+/**
+ * Each thread gets this number of chunks on average, so that the workers
+ * which are done early can steal the chunks of the slower ones.
+ */
+#define TH_ITERATE_CHUNKS_PER_THREAD 4
 
-	ut32 pool_size = rz_th_pool_size(pool);
-	RZ_LOG_VERBOSE("th: using %u threads for threaded iteration\n", pool_size);
-	for (ut32 i = 0; i < pool_size; ++i) {
-		RzThread *th = rz_th_new(th_cb, context);
-		rz_th_pool_add_thread(pool, th);
-	}
+typedef struct th_chunk_s {
+	RzThreadIterator iterator;
+	void *user;
+	const RzPVector /*<void *>*/ *pvec;
+	RzListIter /*<void *>*/ *head;
+	size_t index;
+	size_t length;
+} th_chunk_t;
 
-	rz_th_pool_wait(pool);
-	rz_th_pool_free(pool);
-	return true;
+static void *thread_iterate_chunk_cb(th_chunk_t *chunk) {
+	void *element = NULL;
+	RzListIter *it = chunk->head;
+	for (size_t i = 0; i < chunk->length; i++) {
+		if (chunk->pvec) {
+			element = rz_pvector_at(chunk->pvec, chunk->index + i);
+		} else {
+			element = rz_list_iter_get_data(it);
+			it = rz_list_iter_get_next(it);
+		}
+		if (element) {
+			chunk->iterator(element, chunk->user);
+		}
+	}
+	return NULL;
 }
 
-typedef struct th_list_ctx_s {
-	RzThreadLock *lock;
-	RzListIter /*<void *>*/ *head;
-	void *user;
-	RzThreadIterator iterator;
-} th_list_ctx_t;
+/**
+ * Splits the \p length elements of the list \p head or of \p pvec in
+ * chunks and runs them on a work-stealing scheduler.
+ */
+static bool th_run_iterator(RzListIter /*<void *>*/ *head, const RzPVector /*<void *>*/ *pvec, size_t length, RzThreadIterator iterator, size_t max_threads, void *user) {
+	RzThreadScheduler *scheduler = rz_th_scheduler_new(max_threads);
+	if (!scheduler) {
+		RZ_LOG_ERROR("th: failed to allocate task scheduler\n");
+		return false;
+	}
 
-static void *thread_iterate_list_cb(th_list_ctx_t *context) {
-	void *element = NULL;
-	void *user = context->user;
-	RzThreadIterator iterator = context->iterator;
-	RzThreadLock *lock = context->lock;
+	size_t n_chunks = RZ_MIN(length, rz_th_scheduler_size(scheduler) * TH_ITERATE_CHUNKS_PER_THREAD);
+	th_chunk_t *chunks = RZ_NEWS0(th_chunk_t, n_chunks);
+	RzThreadTaskGroup *group = rz_th_task_group_new(scheduler);
+	if (!chunks || !group) {
+		RZ_LOG_ERROR("th: failed to allocate threaded iteration chunks\n");
+		rz_th_task_group_free(group);
+		rz_th_scheduler_free(scheduler);
+		free(chunks);
+		return false;
+	}
 
-	do {
-		rz_th_lock_enter(lock);
-		if (!context->head) {
-			rz_th_lock_leave(lock);
+	RZ_LOG_VERBOSE("th: using %u threads for threaded iteration\n", (ut32)rz_th_scheduler_size(scheduler));
+	bool retval = true;
+	size_t index = 0;
+	for (size_t i = 0; i < n_chunks; ++i) {
+		th_chunk_t *chunk = &chunks[i];
+		chunk->iterator = iterator;
+		chunk->user = user;
+		chunk->pvec = pvec;
+		chunk->head = head;
+		chunk->index = index;
+		chunk->length = length / n_chunks + (i < length % n_chunks);
+		index += chunk->length;
+		for (size_t j = 0; head && j < chunk->length; j++) {
+			head = rz_list_iter_get_next(head);
+		}
+		if (!rz_th_task_group_submit(group, (RzThreadFunction)thread_iterate_chunk_cb, chunk)) {
+			RZ_LOG_ERROR("th: failed to submit threaded iteration chunk\n");
+			retval = false;
 			break;
 		}
-		element = rz_list_iter_get_data(context->head);
-		context->head = rz_list_iter_get_next(context->head);
-		rz_th_lock_leave(lock);
+	}
 
-		if (element) {
-			iterator(element, user);
-		}
-	} while (true);
-	return NULL;
+	rz_th_task_group_free(group);
+	rz_th_scheduler_free(scheduler);
+	free(chunks);
+	return retval;
 }
 
 /**
@@ -76,55 +109,7 @@ RZ_API bool rz_th_iterate_list(RZ_NONNULL const RzList /*<void *>*/ *list, RZ_NO
 		// nothing to do, but return true
 		return true;
 	}
-
-	th_list_ctx_t context = {
-		.lock = rz_th_lock_new(true),
-		.head = list->head,
-		.iterator = iterator,
-		.user = user,
-	};
-
-	if (!context.lock) {
-		RZ_LOG_ERROR("th: failed to allocate list lock\n");
-		return false;
-	}
-
-	bool retval = th_run_iterator((RzThreadFunction)thread_iterate_list_cb, &context, max_threads);
-	rz_th_lock_free(context.lock);
-	return retval;
-}
-
-typedef struct th_vec_ctx_s {
-	RzThreadLock *lock;
-	size_t index;
-	const RzPVector /*<void *>*/ *pvec;
-	void *user;
-	RzThreadIterator iterator;
-} th_vec_ctx_t;
-
-static void *thread_iterate_pvec_cb(th_vec_ctx_t *context) {
-	void *element = NULL;
-	void *user = context->user;
-	RzThreadIterator iterator = context->iterator;
-	RzThreadLock *lock = context->lock;
-	const RzPVector *pvec = context->pvec;
-	size_t length = rz_pvector_len(pvec);
-
-	do {
-		rz_th_lock_enter(lock);
-		if (context->index >= length) {
-			rz_th_lock_leave(lock);
-			break;
-		}
-		element = rz_pvector_at(pvec, context->index);
-		context->index++;
-		rz_th_lock_leave(lock);
-
-		if (element) {
-			iterator(element, user);
-		}
-	} while (true);
-	return NULL;
+	return th_run_iterator(list->head, NULL, rz_list_length(list), iterator, max_threads, user);
 }
 
 /**
@@ -144,21 +129,5 @@ RZ_API bool rz_th_iterate_pvector(RZ_NONNULL const RzPVector /*<void *>*/ *pvec,
 		// nothing to do, but return true
 		return true;
 	}
-
-	th_vec_ctx_t context = {
-		.lock = rz_th_lock_new(true),
-		.index = 0,
-		.pvec = pvec,
-		.iterator = iterator,
-		.user = user,
-	};
-
-	if (!context.lock) {
-		RZ_LOG_ERROR("th: failed to allocate vector lock\n");
-		return false;
-	}
-
-	bool retval = th_run_iterator((RzThreadFunction)thread_iterate_pvec_cb, &context, max_threads);
-	rz_th_lock_free(context.lock);
-	return retval;
+	return th_run_iterator(NULL, pvec, rz_pvector_len(pvec), iterator, max_threads, user);
 }
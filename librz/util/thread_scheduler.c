@@ -0,0 +1,589 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/** \file thread_scheduler.c
+ * RzThreadScheduler is a work-stealing task scheduler.
+ *
+ * Each worker owns a deque of tasks: the worker pushes and pops its own
+ * tasks from the tail (LIFO, which keeps the data hot in its cache) while
+ * the idle workers steal from the head of the other deques (FIFO, which
+ * takes the oldest and usually largest pieces of work).
+ * Tasks submitted from outside of the scheduler are spread round-robin
+ * over the deques, tasks submitted by a running task go to the deque of
+ * the worker which runs it.
+ *
+ * rz_th_scheduler_submit    Submits a task and returns a handle to join it.
+ * rz_th_task_join           Waits the end of a task and returns its result.
+ * rz_th_task_group_submit   Submits a task which belongs to a group.
+ * rz_th_task_group_wait     Waits the end of all the tasks of a group.
+ * rz_th_task_group_cancel   Cancels the group, its tasks which did not start yet are skipped.
+ *
+ * When a worker waits for a task or a group, it runs the pending tasks
+ * meanwhile, thus tasks can submit and join other tasks without deadlocks.
+ */
+
+#include <rz_th.h>
+#include <rz_util.h>
+#include "thread.h"
+
+#define TH_DEQUE_MIN_CAPACITY 32
+#define TH_WORKER_NONE        SIZE_MAX
+#define TH_BREAK_POLL_MS      50
+
+typedef struct th_deque_s {
+	RzThreadLock *lock;
+	RzThreadTask **tasks; ///< Ring buffer of tasks
+	size_t head; ///< Index of the oldest task, where thieves steal
+	size_t length; ///< Number of tasks
+	size_t capacity; ///< Always a power of 2
+} th_deque_t;
+
+typedef struct th_worker_s {
+	RzThreadScheduler *scheduler;
+	RzThread *thread;
+	th_deque_t deque;
+	size_t index;
+} th_worker_t;
+
+struct rz_th_scheduler_t {
+	RzThreadLock *lock; ///< Protects all the fields below and the state of tasks and groups
+	RzThreadCond *cond; ///< Signaled when a task is submitted or completed
+	th_worker_t *workers;
+	size_t size;
+	size_t next; ///< Next deque used for the tasks submitted from outside
+	ut64 epoch; ///< Incremented at each submission or completion
+	size_t sleeping; ///< Number of threads waiting on cond
+	bool shutdown;
+};
+
+struct rz_th_task_t {
+	RzThreadScheduler *scheduler;
+	RzThreadTaskGroup *group;
+	RzThreadFunction function;
+	void *user;
+	void *retv;
+	bool detached; ///< Group tasks have no handle and are freed when completed
+	bool done;
+};
+
+struct rz_th_task_group_t {
+	RzThreadScheduler *scheduler;
+	RzAtomicBool *cancelled;
+	RzThreadBreakCheck check;
+	void *check_user;
+	size_t pending; ///< Number of submitted tasks not completed yet
+};
+
+static bool deque_init(th_deque_t *deque) {
+	deque->lock = rz_th_lock_new(false);
+	deque->tasks = RZ_NEWS0(RzThreadTask *, TH_DEQUE_MIN_CAPACITY);
+	deque->capacity = TH_DEQUE_MIN_CAPACITY;
+	return deque->lock && deque->tasks;
+}
+
+static void deque_fini(th_deque_t *deque) {
+	rz_th_lock_free(deque->lock);
+	free(deque->tasks);
+}
+
+static bool deque_push(th_deque_t *deque, RzThreadTask *task) {
+	bool ret = true;
+	rz_th_lock_enter(deque->lock);
+	if (deque->length == deque->capacity) {
+		RzThreadTask **tasks = RZ_NEWS(RzThreadTask *, deque->capacity * 2);
+		if (!tasks) {
+			ret = false;
+			goto end;
+		}
+		for (size_t i = 0; i < deque->length; i++) {
+			tasks[i] = deque->tasks[(deque->head + i) & (deque->capacity - 1)];
+		}
+		free(deque->tasks);
+		deque->tasks = tasks;
+		deque->head = 0;
+		deque->capacity *= 2;
+	}
+	deque->tasks[(deque->head + deque->length) & (deque->capacity - 1)] = task;
+	deque->length++;
+end:
+	rz_th_lock_leave(deque->lock);
+	return ret;
+}
+
+static RzThreadTask *deque_pop(th_deque_t *deque, bool tail) {
+	RzThreadTask *task = NULL;
+	rz_th_lock_enter(deque->lock);
+	if (deque->length > 0) {
+		deque->length--;
+		if (tail) {
+			task = deque->tasks[(deque->head + deque->length) & (deque->capacity - 1)];
+		} else {
+			task = deque->tasks[deque->head];
+			deque->head = (deque->head + 1) & (deque->capacity - 1);
+		}
+	}
+	rz_th_lock_leave(deque->lock);
+	return task;
+}
+
+/**
+ * Returns the index of the worker running on the calling thread,
+ * otherwise TH_WORKER_NONE.
+ */
+static size_t scheduler_current_worker(RzThreadScheduler *scheduler) {
+	for (size_t i = 0; i < scheduler->size; i++) {
+		if (scheduler->workers[i].thread && rz_th_is_self(scheduler->workers[i].thread)) {
+			return i;
+		}
+	}
+	return TH_WORKER_NONE;
+}
+
+/**
+ * Pops a task from the deque of the worker \p self, or steals one from
+ * the other deques.
+ */
+static RzThreadTask *scheduler_find_task(RzThreadScheduler *scheduler, size_t self) {
+	RzThreadTask *task = NULL;
+	size_t start = 0;
+	if (self != TH_WORKER_NONE) {
+		task = deque_pop(&scheduler->workers[self].deque, true);
+		if (task) {
+			return task;
+		}
+		start = self + 1;
+	}
+	for (size_t i = 0; i < scheduler->size; i++) {
+		size_t victim = (start + i) % scheduler->size;
+		if (victim == self) {
+			continue;
+		}
+		task = deque_pop(&scheduler->workers[victim].deque, false);
+		if (task) {
+			return task;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Notifies the threads waiting on the scheduler, must be called with the lock held.
+ */
+static void scheduler_notify(RzThreadScheduler *scheduler) {
+	scheduler->epoch++;
+	if (scheduler->sleeping > 0) {
+		rz_th_cond_signal_all(scheduler->cond);
+	}
+}
+
+/**
+ * Waits for a submission or a completion newer than \p epoch, or at most
+ * \p timeout_ms milliseconds when it is not 0; must be called with the lock held.
+ */
+static void scheduler_sleep(RzThreadScheduler *scheduler, ut64 epoch, ut32 timeout_ms) {
+	while (scheduler->epoch == epoch && !scheduler->shutdown) {
+		scheduler->sleeping++;
+		bool signaled = true;
+		if (timeout_ms) {
+			signaled = rz_th_cond_timedwait(scheduler->cond, scheduler->lock, timeout_ms);
+		} else {
+			rz_th_cond_wait(scheduler->cond, scheduler->lock);
+		}
+		scheduler->sleeping--;
+		if (!signaled) {
+			break;
+		}
+	}
+}
+
+static void scheduler_run_task(RzThreadScheduler *scheduler, RzThreadTask *task) {
+	RzThreadTaskGroup *group = task->group;
+	if (!group || !rz_atomic_bool_get(group->cancelled)) {
+		task->retv = task->function(task->user);
+	}
+
+	bool detached = task->detached;
+	rz_th_lock_enter(scheduler->lock);
+	task->done = true;
+	if (group) {
+		group->pending--;
+	}
+	scheduler_notify(scheduler);
+	rz_th_lock_leave(scheduler->lock);
+	if (detached) {
+		free(task);
+	}
+}
+
+static bool scheduler_push(RzThreadScheduler *scheduler, RzThreadTask *task) {
+	size_t self = scheduler_current_worker(scheduler);
+	rz_th_lock_enter(scheduler->lock);
+	// the task can be stolen and completed as soon as it is pushed
+	if (task->group) {
+		task->group->pending++;
+	}
+	size_t index = self != TH_WORKER_NONE ? self : scheduler->next++ % scheduler->size;
+	bool ret = deque_push(&scheduler->workers[index].deque, task);
+	if (ret) {
+		scheduler_notify(scheduler);
+	} else if (task->group) {
+		task->group->pending--;
+	}
+	rz_th_lock_leave(scheduler->lock);
+	return ret;
+}
+
+typedef bool (*SchedulerWaitDone)(void *user);
+
+/**
+ * Waits until \p is_done returns true, which is called with the lock held
+ * at each submission or completion and, when \p poll_ms is not 0, at least
+ * every \p poll_ms milliseconds. A worker runs the pending tasks meanwhile.
+ */
+static void scheduler_wait(RzThreadScheduler *scheduler, SchedulerWaitDone is_done, void *user, ut32 poll_ms) {
+	size_t self = scheduler_current_worker(scheduler);
+	while (true) {
+		rz_th_lock_enter(scheduler->lock);
+		if (is_done(user)) {
+			rz_th_lock_leave(scheduler->lock);
+			break;
+		}
+		ut64 epoch = scheduler->epoch;
+		rz_th_lock_leave(scheduler->lock);
+
+		if (self != TH_WORKER_NONE) {
+			RzThreadTask *task = scheduler_find_task(scheduler, self);
+			if (task) {
+				scheduler_run_task(scheduler, task);
+				continue;
+			}
+		}
+
+		rz_th_lock_enter(scheduler->lock);
+		if (!is_done(user)) {
+			scheduler_sleep(scheduler, epoch, poll_ms);
+		}
+		rz_th_lock_leave(scheduler->lock);
+	}
+}
+
+static void *scheduler_worker_main(th_worker_t *worker) {
+	RzThreadScheduler *scheduler = worker->scheduler;
+	while (true) {
+		rz_th_lock_enter(scheduler->lock);
+		ut64 epoch = scheduler->epoch;
+		rz_th_lock_leave(scheduler->lock);
+
+		RzThreadTask *task = scheduler_find_task(scheduler, worker->index);
+		if (task) {
+			scheduler_run_task(scheduler, task);
+			continue;
+		}
+
+		rz_th_lock_enter(scheduler->lock);
+		if (scheduler->shutdown) {
+			rz_th_lock_leave(scheduler->lock);
+			break;
+		}
+		scheduler_sleep(scheduler, epoch, 0);
+		rz_th_lock_leave(scheduler->lock);
+	}
+	return NULL;
+}
+
+/**
+ * \brief      Allocates a new work-stealing scheduler and starts its workers
+ *
+ * \param[in]  max_threads  The maximum number of workers, use RZ_THREAD_POOL_ALL_CORES to use all the cores
+ *
+ * \return     On success returns a valid pointer, otherwise NULL
+ */
+RZ_API RZ_OWN RzThreadScheduler *rz_th_scheduler_new(size_t max_threads) {
+	RzThreadScheduler *scheduler = RZ_NEW0(RzThreadScheduler);
+	if (!scheduler) {
+		return NULL;
+	}
+
+	scheduler->lock = rz_th_lock_new(false);
+	scheduler->cond = rz_th_cond_new();
+	size_t size = rz_th_request_physical_cores(max_threads);
+	scheduler->workers = RZ_NEWS0(th_worker_t, size);
+	if (!scheduler->lock || !scheduler->cond || !scheduler->workers) {
+		goto fail;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		th_worker_t *worker = &scheduler->workers[i];
+		worker->scheduler = scheduler;
+		worker->index = i;
+		scheduler->size++;
+		if (!deque_init(&worker->deque)) {
+			goto fail;
+		}
+	}
+
+	// the workers cannot identify themselves until all the threads are assigned
+	rz_th_lock_enter(scheduler->lock);
+	for (size_t i = 0; i < size; i++) {
+		th_worker_t *worker = &scheduler->workers[i];
+		worker->thread = rz_th_new((RzThreadFunction)scheduler_worker_main, worker);
+		if (!worker->thread) {
+			RZ_LOG_ERROR("th: failed to start scheduler worker %" PFMTSZu "\n", i);
+			rz_th_lock_leave(scheduler->lock);
+			goto fail;
+		}
+	}
+	rz_th_lock_leave(scheduler->lock);
+	RZ_LOG_VERBOSE("th: using %" PFMTSZu " workers for the task scheduler\n", size);
+	return scheduler;
+
+fail:
+	rz_th_scheduler_free(scheduler);
+	return NULL;
+}
+
+/**
+ * \brief  Runs all the pending tasks, then stops the workers and frees the scheduler.
+ *
+ * The task handles are not owned by the scheduler and must be freed by the caller.
+ *
+ * \param  scheduler  The RzThreadScheduler to free
+ */
+RZ_API void rz_th_scheduler_free(RZ_NULLABLE RzThreadScheduler *scheduler) {
+	if (!scheduler) {
+		return;
+	}
+	if (scheduler->lock) {
+		rz_th_lock_enter(scheduler->lock);
+		scheduler->shutdown = true;
+		if (scheduler->cond) {
+			rz_th_cond_signal_all(scheduler->cond);
+		}
+		rz_th_lock_leave(scheduler->lock);
+	}
+	for (size_t i = 0; i < scheduler->size; i++) {
+		th_worker_t *worker = &scheduler->workers[i];
+		if (worker->thread) {
+			rz_th_wait(worker->thread);
+		}
+	}
+	// the deques can be freed only when no worker can steal from them
+	for (size_t i = 0; i < scheduler->size; i++) {
+		th_worker_t *worker = &scheduler->workers[i];
+		rz_th_free(worker->thread);
+		deque_fini(&worker->deque);
+	}
+	free(scheduler->workers);
+	rz_th_cond_free(scheduler->cond);
+	rz_th_lock_free(scheduler->lock);
+	free(scheduler);
+}
+
+/**
+ * \brief  Returns the number of workers of the scheduler
+ *
+ * \param  scheduler  The RzThreadScheduler to use
+ *
+ * \return The number of workers (always >= 1).
+ */
+RZ_API size_t rz_th_scheduler_size(RZ_NONNULL RzThreadScheduler *scheduler) {
+	rz_return_val_if_fail(scheduler, 1);
+	return scheduler->size;
+}
+
+static RzThreadTask *task_new(RzThreadScheduler *scheduler, RzThreadTaskGroup *group, RzThreadFunction function, void *user) {
+	RzThreadTask *task = RZ_NEW0(RzThreadTask);
+	if (!task) {
+		return NULL;
+	}
+	task->scheduler = scheduler;
+	task->group = group;
+	task->function = function;
+	task->user = user;
+	task->detached = group != NULL;
+	return task;
+}
+
+/**
+ * \brief      Submits a task to the scheduler
+ *
+ * \param      scheduler  The RzThreadScheduler to use
+ * \param[in]  function   The function to run
+ * \param      user       The user pointer passed to the function
+ *
+ * \return     On success returns the handle of the task which must be freed
+ *             via rz_th_task_free, otherwise NULL
+ */
+RZ_API RZ_OWN RzThreadTask *rz_th_scheduler_submit(RZ_NONNULL RzThreadScheduler *scheduler, RZ_NONNULL RzThreadFunction function, RZ_NULLABLE void *user) {
+	rz_return_val_if_fail(scheduler && function, NULL);
+	RzThreadTask *task = task_new(scheduler, NULL, function, user);
+	if (!task || !scheduler_push(scheduler, task)) {
+		free(task);
+		return NULL;
+	}
+	return task;
+}
+
+static bool task_is_done(RzThreadTask *task) {
+	return task->done;
+}
+
+/**
+ * \brief      Waits the end of a task; when called from a task, the pending tasks are run meanwhile
+ *
+ * \param      task  The task to wait for
+ *
+ * \return     Returns the value returned by the task function
+ */
+RZ_API RZ_OWN void *rz_th_task_join(RZ_NONNULL RzThreadTask *task) {
+	rz_return_val_if_fail(task, NULL);
+	scheduler_wait(task->scheduler, (SchedulerWaitDone)task_is_done, task, 0);
+	return task->retv;
+}
+
+/**
+ * \brief      Returns true when the task has completed
+ *
+ * \param      task  The task to check
+ */
+RZ_API bool rz_th_task_is_done(RZ_NONNULL RzThreadTask *task) {
+	rz_return_val_if_fail(task, false);
+	rz_th_lock_enter(task->scheduler->lock);
+	bool done = task->done;
+	rz_th_lock_leave(task->scheduler->lock);
+	return done;
+}
+
+/**
+ * \brief  Waits the end of the task (when not joined yet) and frees its handle
+ *
+ * \param  task  The task to free
+ */
+RZ_API void rz_th_task_free(RZ_NULLABLE RzThreadTask *task) {
+	if (!task) {
+		return;
+	}
+	rz_th_task_join(task);
+	free(task);
+}
+
+/**
+ * \brief      Allocates a new group of tasks
+ *
+ * \param      scheduler  The RzThreadScheduler which runs the tasks of the group
+ *
+ * \return     On success returns a valid pointer, otherwise NULL
+ */
+RZ_API RZ_OWN RzThreadTaskGroup *rz_th_task_group_new(RZ_NONNULL RzThreadScheduler *scheduler) {
+	rz_return_val_if_fail(scheduler, NULL);
+	RzThreadTaskGroup *group = RZ_NEW0(RzThreadTaskGroup);
+	if (!group) {
+		return NULL;
+	}
+	group->scheduler = scheduler;
+	group->cancelled = rz_atomic_bool_new(false);
+	if (!group->cancelled) {
+		free(group);
+		return NULL;
+	}
+	return group;
+}
+
+/**
+ * \brief  Waits the end of all the tasks of the group and frees it
+ *
+ * \param  group  The RzThreadTaskGroup to free
+ */
+RZ_API void rz_th_task_group_free(RZ_NULLABLE RzThreadTaskGroup *group) {
+	if (!group) {
+		return;
+	}
+	rz_th_task_group_wait(group);
+	rz_atomic_bool_free(group->cancelled);
+	free(group);
+}
+
+/**
+ * \brief  Sets the function polled to cancel the group, i.e. a wrapper of rz_cons_is_breaked
+ *
+ * The function is polled while waiting the group, at least every 50ms, and by
+ * rz_th_task_group_is_cancelled; when it returns true the group is cancelled.
+ *
+ * \param  group  The RzThreadTaskGroup to use
+ * \param  check  The function to poll, or NULL
+ * \param  user   The user pointer passed to the function
+ */
+RZ_API void rz_th_task_group_set_break_check(RZ_NONNULL RzThreadTaskGroup *group, RZ_NULLABLE RzThreadBreakCheck check, RZ_NULLABLE void *user) {
+	rz_return_if_fail(group);
+	group->check = check;
+	group->check_user = user;
+}
+
+/**
+ * \brief      Submits a task which belongs to the group
+ *
+ * The task has no handle, its results must be stored via the user pointer.
+ *
+ * \param      group     The RzThreadTaskGroup to use
+ * \param[in]  function  The function to run
+ * \param      user      The user pointer passed to the function
+ *
+ * \return     Returns false when the group is cancelled or on allocation failure, otherwise true
+ */
+RZ_API bool rz_th_task_group_submit(RZ_NONNULL RzThreadTaskGroup *group, RZ_NONNULL RzThreadFunction function, RZ_NULLABLE void *user) {
+	rz_return_val_if_fail(group && function, false);
+	if (rz_atomic_bool_get(group->cancelled)) {
+		return false;
+	}
+	RzThreadTask *task = task_new(group->scheduler, group, function, user);
+	if (!task || !scheduler_push(group->scheduler, task)) {
+		free(task);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * \brief  Cancels the group; the tasks which did not start yet are not run
+ *
+ * \param  group  The RzThreadTaskGroup to cancel
+ */
+RZ_API void rz_th_task_group_cancel(RZ_NONNULL RzThreadTaskGroup *group) {
+	rz_return_if_fail(group);
+	rz_atomic_bool_set(group->cancelled, true);
+}
+
+/**
+ * \brief      Returns true when the group was cancelled; long tasks should poll it to stop early
+ *
+ * \param      group  The RzThreadTaskGroup to check
+ */
+RZ_API bool rz_th_task_group_is_cancelled(RZ_NONNULL RzThreadTaskGroup *group) {
+	rz_return_val_if_fail(group, true);
+	if (group->check && group->check(group->check_user)) {
+		rz_th_task_group_cancel(group);
+	}
+	return rz_atomic_bool_get(group->cancelled);
+}
+
+static bool task_group_is_done(RzThreadTaskGroup *group) {
+	if (group->check && group->check(group->check_user)) {
+		rz_atomic_bool_set(group->cancelled, true);
+	}
+	return group->pending == 0;
+}
+
+/**
+ * \brief      Waits the end of all the tasks of the group; when called from a task,
+ *             the pending tasks are run meanwhile
+ *
+ * \param      group  The RzThreadTaskGroup to wait for
+ *
+ * \return     Returns false when the group was cancelled, otherwise true
+ */
+RZ_API bool rz_th_task_group_wait(RZ_NONNULL RzThreadTaskGroup *group) {
+	rz_return_val_if_fail(group, false);
+	// the break check must be polled even when no task starts or ends for a while
+	scheduler_wait(group->scheduler, (SchedulerWaitDone)task_group_is_done, group, group->check ? TH_BREAK_POLL_MS : 0);
+	return !rz_atomic_bool_get(group->cancelled);
+}
@@ -27,7 +27,11 @@ RZ_API RZ_OWN RzAtomicBool *rz_atomic_bool_new(bool value) {
 		return NULL;
 	}
 	tbool->lock = rz_th_lock_new(false);
-	tbool->value = true;
+	if (!tbool->lock) {
+		free(tbool);
+		return NULL;
+	}
+	tbool->value = value;
 	return tbool;
 }
 
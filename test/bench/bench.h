@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+// Minimal harness for the benchmarks in test/bench.
+//
+// Each benchmark executable runs a fixed, seeded workload and prints one
+// JSON object on stdout:
+//
+// {"suite":"<name>","scale":<n>,"results":[
+//   {"name":"<bench>","ops":<n>,"usec":<n>,"ns_per_op":<n>,"ops_per_sec":<n>[,"bytes":<n>,"mb_per_sec":<n>]},
+//   {"name":"<bench>","skipped":"<reason>"}
+// ]}
+//
+// The environment variable RZ_BENCH_SCALE multiplies the size of every
+// workload (default 1), RZ_BENCH_FILTER only runs the benchmarks whose
+// name contains the given string.
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <rz_util.h>
+
+typedef struct {
+	PJ *pj;
+	ut64 scale;
+	const char *filter;
+	ut64 start;
+	ut64 rng;
+} RzBench;
+
+#define BENCH_SEED 0x5eed5eed5eed5eedULL
+
+static inline void bench_init(RzBench *b, const char *suite) {
+	memset(b, 0, sizeof(*b));
+	char *scale = rz_sys_getenv("RZ_BENCH_SCALE");
+	b->scale = scale ? rz_num_get(NULL, scale) : 1;
+	b->scale = RZ_MAX(b->scale, 1);
+	free(scale);
+	b->filter = getenv("RZ_BENCH_FILTER");
+	b->rng = BENCH_SEED;
+	b->pj = pj_new();
+	pj_o(b->pj);
+	pj_ks(b->pj, "suite", suite);
+	pj_kn(b->pj, "scale", b->scale);
+	pj_ka(b->pj, "results");
+}
+
+/**
+ * Deterministic xorshift64 generator, so that every run gets the same input.
+ */
+static inline ut64 bench_rand(RzBench *b) {
+	b->rng ^= b->rng << 13;
+	b->rng ^= b->rng >> 7;
+	b->rng ^= b->rng << 17;
+	return b->rng;
+}
+
+static inline void bench_rand_bytes(RzBench *b, ut8 *buf, size_t len) {
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = bench_rand(b) >> 56;
+	}
+}
+
+/**
+ * Returns true if the benchmark \p name should run, and starts its clock.
+ */
+static inline bool bench_start(RzBench *b, const char *name) {
+	if (b->filter && !strstr(name, b->filter)) {
+		return false;
+	}
+	b->rng = BENCH_SEED;
+	b->start = rz_time_now_mono();
+	return true;
+}
+
+/**
+ * Stops the clock of the benchmark \p name, which did \p ops operations
+ * over \p bytes bytes (0 when it is not a throughput benchmark).
+ */
+static inline void bench_stop(RzBench *b, const char *name, ut64 ops, ut64 bytes) {
+	ut64 usec = rz_time_now_mono() - b->start;
+	double sec = RZ_MAX(usec, 1) / 1e6;
+	pj_o(b->pj);
+	pj_ks(b->pj, "name", name);
+	pj_kn(b->pj, "ops", ops);
+	pj_kn(b->pj, "usec", usec);
+	pj_kd(b->pj, "ns_per_op", ops ? usec * 1e3 / ops : 0);
+	pj_kd(b->pj, "ops_per_sec", ops / sec);
+	if (bytes) {
+		pj_kn(b->pj, "bytes", bytes);
+		pj_kd(b->pj, "mb_per_sec", bytes / sec / (1024 * 1024));
+	}
+	pj_end(b->pj);
+}
+
+static inline void bench_skip(RzBench *b, const char *name, const char *reason) {
+	if (b->filter && !strstr(name, b->filter)) {
+		return;
+	}
+	pj_o(b->pj);
+	pj_ks(b->pj, "name", name);
+	pj_ks(b->pj, "skipped", reason);
+	pj_end(b->pj);
+}
+
+static inline int bench_fini(RzBench *b) {
+	pj_end(b->pj);
+	pj_end(b->pj);
+	printf("%s\n", pj_string(b->pj));
+	pj_free(b->pj);
+	return 0;
+}
+
+#endif
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include "bench.h"
+
+// relative to test/, where the benchmarks run, fetched with the test bins
+static const char *fixtures[] = {
+	"bins/elf/analysis/hello-linux-x86_64",
+	"bins/elf/analysis/x86-helloworld-gcc",
+	"bins/elf/ls",
+	"bins/pe/base.exe",
+	"bins/mach0/mac-ls2",
+};
+
+static void bench_aaa(RzBench *b, const char *path) {
+	char name[128];
+	snprintf(name, sizeof(name), "aaa_%s", rz_file_basename(path));
+	if (!rz_file_exists(path)) {
+		bench_skip(b, name, "missing fixture, run from test/ with the test bins");
+		return;
+	}
+	if (!bench_start(b, name)) {
+		return;
+	}
+	ut64 ops = 0;
+	for (ut64 i = 0; i < b->scale; i++) {
+		RzCore *core = rz_core_new();
+		rz_config_set_b(core->config, "scr.interactive", false);
+		if (!rz_core_file_open_load(core, path, 0, RZ_PERM_R, false)) {
+			rz_core_free(core);
+			break;
+		}
+		rz_core_perform_auto_analysis(core, RZ_CORE_ANALYSIS_DEEP);
+		ops += rz_list_length(core->analysis->fcns);
+		rz_core_free(core);
+	}
+	// ops is the number of functions found
+	bench_stop(b, name, ops, 0);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "aaa");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(fixtures); i++) {
+		bench_aaa(&b, fixtures[i]);
+	}
+	return bench_fini(&b);
+}
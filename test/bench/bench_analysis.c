@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "bench.h"
+
+#define OP_BUF_SIZE (256 * 1024)
+
+typedef struct {
+	const char *arch;
+	int bits;
+	bool big_endian;
+} BenchArch;
+
+static const BenchArch archs[] = {
+	{ "x86", 64, false },
+	{ "x86", 32, false },
+	{ "arm", 64, false },
+	{ "arm", 32, false },
+	{ "arm", 16, false },
+	{ "mips", 32, true },
+	{ "ppc", 64, true },
+	{ "riscv", 64, false },
+};
+
+static void bench_analysis_op(RzBench *b, const BenchArch *arch, ut8 *buf, ut64 size, RzAnalysisOpMask mask, const char *mask_name) {
+	char name[64];
+	snprintf(name, sizeof(name), "analysis_op_%s_%d_%s", arch->arch, arch->bits, mask_name);
+	RzAnalysis *analysis = rz_analysis_new();
+	if (!rz_analysis_use(analysis, arch->arch)) {
+		bench_skip(b, name, "plugin not available");
+		rz_analysis_free(analysis);
+		return;
+	}
+	rz_analysis_set_bits(analysis, arch->bits);
+	rz_analysis_set_big_endian(analysis, arch->big_endian);
+	if (bench_start(b, name)) {
+		RzAnalysisOp op;
+		ut64 ops = 0;
+		ut64 off = 0;
+		while (off < size) {
+			rz_analysis_op_init(&op);
+			int len = rz_analysis_op(analysis, &op, 0x1000 + off, buf + off, size - off, mask);
+			rz_analysis_op_fini(&op);
+			off += len > 0 ? len : 1;
+			ops++;
+		}
+		bench_stop(b, name, ops, size);
+	}
+	rz_analysis_free(analysis);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "analysis");
+	ut64 size = OP_BUF_SIZE * b.scale;
+	ut8 *buf = malloc(size);
+	if (!buf) {
+		return 1;
+	}
+	bench_rand_bytes(&b, buf, size);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(archs); i++) {
+		bench_analysis_op(&b, &archs[i], buf, size, RZ_ANALYSIS_OP_MASK_BASIC, "basic");
+		bench_analysis_op(&b, &archs[i], buf, size, RZ_ANALYSIS_OP_MASK_ESIL | RZ_ANALYSIS_OP_MASK_VAL, "esil");
+		bench_analysis_op(&b, &archs[i], buf, size, RZ_ANALYSIS_OP_MASK_IL, "il");
+	}
+	free(buf);
+	return bench_fini(&b);
+}
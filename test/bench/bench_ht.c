@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_util.h>
+#include "bench.h"
+
+#define HT_KEYS (1000 * 1000)
+
+// kernel-like addresses, sharing their high bits
+#define KEY(i) (0xffffffff81000000ULL + (ut64)(i)*16)
+
+static void bench_ht_up(RzBench *b) {
+	ut64 n = HT_KEYS * b->scale;
+	HtUP *ht = ht_up_new0();
+	if (bench_start(b, "ht_up_insert")) {
+		for (ut64 i = 0; i < n; i++) {
+			ht_up_insert(ht, KEY(i), (void *)(size_t)(i + 1));
+		}
+		bench_stop(b, "ht_up_insert", n, 0);
+	}
+	if (bench_start(b, "ht_up_find")) {
+		ut64 sum = 0;
+		for (ut64 i = 0; i < n; i++) {
+			sum += (size_t)ht_up_find(ht, KEY(bench_rand(b) % n), NULL);
+		}
+		bench_stop(b, "ht_up_find", n, 0);
+		if (!sum) {
+			eprintf("ht_up_find: nothing found\n");
+		}
+	}
+	if (bench_start(b, "ht_up_find_miss")) {
+		ut64 sum = 0;
+		for (ut64 i = 0; i < n; i++) {
+			sum += (size_t)ht_up_find(ht, KEY(n + bench_rand(b) % n), NULL);
+		}
+		bench_stop(b, "ht_up_find_miss", n, 0);
+		if (sum) {
+			eprintf("ht_up_find_miss: found missing keys\n");
+		}
+	}
+	if (bench_start(b, "ht_up_delete")) {
+		for (ut64 i = 0; i < n; i++) {
+			ht_up_delete(ht, KEY(i));
+		}
+		bench_stop(b, "ht_up_delete", n, 0);
+	}
+	ht_up_free(ht);
+}
+
+static void bench_ht_pp(RzBench *b) {
+	ut64 n = HT_KEYS / 4 * b->scale;
+	char **keys = RZ_NEWS(char *, n);
+	if (!keys) {
+		return;
+	}
+	for (ut64 i = 0; i < n; i++) {
+		keys[i] = rz_str_newf("sym.imp.function_%" PFMT64x, i * 0x9e3779b1);
+	}
+	HtPP *ht = ht_pp_new0();
+	if (bench_start(b, "ht_pp_insert")) {
+		for (ut64 i = 0; i < n; i++) {
+			ht_pp_insert(ht, keys[i], keys[i]);
+		}
+		bench_stop(b, "ht_pp_insert", n, 0);
+	}
+	if (bench_start(b, "ht_pp_find")) {
+		ut64 found = 0;
+		for (ut64 i = 0; i < n; i++) {
+			found += ht_pp_find(ht, keys[bench_rand(b) % n], NULL) != NULL;
+		}
+		bench_stop(b, "ht_pp_find", n, 0);
+		if (found != n) {
+			eprintf("ht_pp_find: missing keys\n");
+		}
+	}
+	ht_pp_free(ht);
+	for (ut64 i = 0; i < n; i++) {
+		free(keys[i]);
+	}
+	free(keys);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "ht");
+	bench_ht_up(&b);
+	bench_ht_pp(&b);
+	return bench_fini(&b);
+}
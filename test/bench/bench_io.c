@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+#include <rz_skyline.h>
+#include "bench.h"
+
+#define IO_MAPS      4096
+#define IO_MAP_SIZE  0x1000
+#define IO_MAP_GAP   0x3000
+#define IO_READS     (500 * 1000)
+#define SKYLINE_ITEMS (64 * 1024)
+
+static void bench_io_read_at(RzBench *b) {
+	ut64 nmaps = IO_MAPS * b->scale;
+	ut64 nreads = IO_READS * b->scale;
+	RzIO *io = rz_io_new();
+	io->va = true;
+	char *uri = rz_str_newf("malloc://0x%" PFMT64x, nmaps * IO_MAP_SIZE);
+	RzIOMap *map = NULL;
+	RzIODesc *desc = rz_io_open_at(io, uri, RZ_PERM_RW, 0644, 0, &map);
+	free(uri);
+	if (!desc) {
+		bench_skip(b, "io_read_at_maps", "cannot open malloc://");
+		rz_io_free(io);
+		return;
+	}
+	// the maps are sparse, and listed in the reverse order of their addresses
+	if (map) {
+		rz_io_map_del(io, map->id);
+	}
+	for (ut64 i = nmaps; i > 0; i--) {
+		rz_io_map_add(io, desc->fd, RZ_PERM_R, (i - 1) * IO_MAP_SIZE, 0x100000 + (i - 1) * (IO_MAP_SIZE + IO_MAP_GAP), IO_MAP_SIZE);
+	}
+	ut8 buf[64];
+	if (bench_start(b, "io_read_at_maps")) {
+		for (ut64 i = 0; i < nreads; i++) {
+			ut64 map = bench_rand(b) % nmaps;
+			ut64 addr = 0x100000 + map * (IO_MAP_SIZE + IO_MAP_GAP) + bench_rand(b) % (IO_MAP_SIZE - sizeof(buf));
+			rz_io_read_at(io, addr, buf, sizeof(buf));
+		}
+		bench_stop(b, "io_read_at_maps", nreads, nreads * sizeof(buf));
+	}
+	if (bench_start(b, "io_read_at_cross_maps")) {
+		ut8 big[IO_MAP_SIZE * 4];
+		ut64 n = nreads / 64;
+		for (ut64 i = 0; i < n; i++) {
+			ut64 map = bench_rand(b) % (nmaps - 4);
+			rz_io_read_at(io, 0x100000 + map * (IO_MAP_SIZE + IO_MAP_GAP), big, sizeof(big));
+		}
+		bench_stop(b, "io_read_at_cross_maps", n, n * sizeof(big));
+	}
+	rz_io_free(io);
+}
+
+static void bench_skyline(RzBench *b) {
+	ut64 nitems = SKYLINE_ITEMS * b->scale;
+	RzSkyline sky;
+	rz_skyline_init(&sky);
+	if (bench_start(b, "skyline_add")) {
+		for (ut64 i = 0; i < nitems; i++) {
+			RzInterval itv = { (bench_rand(b) % nitems) * 0x100, 0x80 + bench_rand(b) % 0x100 };
+			rz_skyline_add(&sky, itv, (void *)(size_t)(i + 1));
+		}
+		bench_stop(b, "skyline_add", nitems, 0);
+	}
+	if (bench_start(b, "skyline_get")) {
+		ut64 n = nitems * 16;
+		ut64 found = 0;
+		for (ut64 i = 0; i < n; i++) {
+			found += rz_skyline_get(&sky, bench_rand(b) % (nitems * 0x100)) != NULL;
+		}
+		bench_stop(b, "skyline_get", n, 0);
+		if (!found) {
+			eprintf("skyline_get: nothing found\n");
+		}
+	}
+	rz_skyline_fini(&sky);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "io");
+	bench_io_read_at(&b);
+	bench_skyline(&b);
+	return bench_fini(&b);
+}
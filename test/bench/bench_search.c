@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include "bench.h"
+
+#define SEARCH_BUF_SIZE (16 * 1024 * 1024)
+#define SEARCH_CHUNK    (64 * 1024)
+
+static const char *hex_kws[] = {
+	"4889e5",
+	"c3c3c3c3",
+	"e8..ff..",
+	"b8........c3",
+	"deadbeef",
+	"cafebabe00",
+	"ffd0",
+	"0f0b",
+};
+
+static int hit_cb(RzSearchKeyword *kw, void *user, ut64 where) {
+	(*(ut64 *)user)++;
+	return 1;
+}
+
+static void bench_search_mode(RzBench *b, const char *name, int mode, const ut8 *buf, ut64 size, size_t nkws) {
+	if (!bench_start(b, name)) {
+		return;
+	}
+	RzSearch *s = rz_search_new(mode);
+	ut64 hits = 0;
+	for (size_t i = 0; i < nkws; i++) {
+		// past the table, a suffix keeps the keywords distinct
+		const size_t n = RZ_ARRAY_SIZE(hex_kws);
+		char *hex = i < n ? strdup(hex_kws[i]) : rz_str_newf("%s%02x", hex_kws[i % n], (ut32)(i / n));
+		rz_search_kw_add(s, rz_search_keyword_new_hexmask(hex, NULL));
+		free(hex);
+	}
+	rz_search_set_callback(s, hit_cb, &hits);
+	rz_search_begin(s);
+	for (ut64 off = 0; off < size; off += SEARCH_CHUNK) {
+		rz_search_update(s, off, buf + off, RZ_MIN(SEARCH_CHUNK, size - off));
+	}
+	rz_search_free(s);
+	bench_stop(b, name, size / SEARCH_CHUNK, size);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "search");
+	ut64 size = SEARCH_BUF_SIZE * b.scale;
+	ut8 *buf = malloc(size);
+	if (!buf) {
+		return 1;
+	}
+	bench_rand_bytes(&b, buf, size);
+	bench_search_mode(&b, "search_keyword_1", RZ_SEARCH_KEYWORD, buf, size, 1);
+	bench_search_mode(&b, "search_keyword_8", RZ_SEARCH_KEYWORD, buf, size, RZ_ARRAY_SIZE(hex_kws));
+	bench_search_mode(&b, "search_multikey_8", RZ_SEARCH_MULTIKEY, buf, size, RZ_ARRAY_SIZE(hex_kws));
+	bench_search_mode(&b, "search_multikey_64", RZ_SEARCH_MULTIKEY, buf, size, 64);
+	free(buf);
+	return bench_fini(&b);
+}
@@ -102,8 +102,81 @@ bool test_graph_to_agraph() {
 	mu_end;
 }
 
+static bool first_cached_layout(void *user, const ut64 k, const void *v) {
+	*(const void **)user = v;
+	return false;
+}
+
+static const void *cached_layout(RzAGraph *g) {
+	const void *c = NULL;
+	if (g->layout_cache) {
+		ht_up_foreach(g->layout_cache, first_cached_layout, &c);
+	}
+	return c;
+}
+
+bool test_agraph_scalable_layout() {
+	static const char *edges[][2] = {
+		{ "a", "b" }, { "a", "c" }, { "a", "d" }, { "b", "d" }, { "c", "d" },
+		{ "b", "e" }, { "d", "e" }, { "c", "f" }, { "e", "f" }
+	};
+	RzAGraph *g = rz_agraph_new(rz_cons_canvas_new(1, 1));
+	mu_assert_notnull(g, "agraph");
+	g->scalable = 1;
+	const char *titles[] = { "a", "b", "c", "d", "e", "f" };
+	size_t i, j;
+	for (i = 0; i < RZ_ARRAY_SIZE(titles); i++) {
+		rz_agraph_add_node(g, titles[i], "body of the node");
+	}
+	for (i = 0; i < RZ_ARRAY_SIZE(edges); i++) {
+		rz_agraph_add_edge(g, rz_agraph_get_node(g, edges[i][0]), rz_agraph_get_node(g, edges[i][1]));
+	}
+	rz_agraph_get_sdb(g);
+	for (i = 0; i < RZ_ARRAY_SIZE(edges); i++) {
+		RzANode *from = rz_agraph_get_node(g, edges[i][0]);
+		RzANode *to = rz_agraph_get_node(g, edges[i][1]);
+		mu_assert_true(from->layer < to->layer, "edges go down the layers");
+		mu_assert_true(from->y < to->y, "layers are placed top to bottom");
+	}
+	for (i = 0; i < RZ_ARRAY_SIZE(titles); i++) {
+		RzANode *n = rz_agraph_get_node(g, titles[i]);
+		for (j = i + 1; j < RZ_ARRAY_SIZE(titles); j++) {
+			RzANode *m = rz_agraph_get_node(g, titles[j]);
+			if (n->layer != m->layer) {
+				continue;
+			}
+			mu_assert_true(n->x + n->w <= m->x || m->x + m->w <= n->x, "nodes of a layer do not overlap");
+		}
+	}
+
+	const void *cache = cached_layout(g);
+	mu_assert_notnull(cache, "layout cached");
+	int x[RZ_ARRAY_SIZE(titles)];
+	for (i = 0; i < RZ_ARRAY_SIZE(titles); i++) {
+		x[i] = rz_agraph_get_node(g, titles[i])->x;
+	}
+	rz_agraph_get_sdb(g);
+	mu_assert_eq(g->layout_cache->count, 1, "unchanged graph not cached again");
+	mu_assert_ptreq(cached_layout(g), cache, "cached layout reused");
+	for (i = 0; i < RZ_ARRAY_SIZE(titles); i++) {
+		mu_assert_eq(rz_agraph_get_node(g, titles[i])->x, x[i], "same placement from the cache");
+	}
+
+	// back edge, reversed during the layout and restored afterwards
+	RzANode *f = rz_agraph_get_node(g, "f");
+	RzANode *a = rz_agraph_get_node(g, "a");
+	rz_agraph_add_edge(g, f, a);
+	rz_agraph_get_sdb(g);
+	mu_assert_eq(g->layout_cache->count, 2, "changed graph laid out again");
+	mu_assert_true(rz_list_contains(f->gnode->out_nodes, a->gnode), "back edge restored");
+	mu_assert_false(rz_list_contains(a->gnode->out_nodes, f->gnode), "reversed edge removed");
+	rz_agraph_free(g);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_graph_to_agraph);
+	mu_run_test(test_agraph_scalable_layout);
 	return tests_passed != tests_run;
 }
 
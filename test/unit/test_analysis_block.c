@@ -456,8 +456,11 @@ bool test_rz_analysis_block_set_size() {
 	assert_block_invariants(analysis);
 	rz_analysis_function_add_block(fcn, block);
 	assert_block_invariants(analysis);
+	mu_assert_eq(rz_analysis_function_linear_size_nocache(fcn), 300, "linear size");
+	mu_assert_eq(fcn->meta._min, UT64_MAX, "range not cached");
 	rz_analysis_function_linear_size(fcn); // trigger lazy calculation of min/max cache
 	assert_block_invariants(analysis);
+	mu_assert_eq(rz_analysis_function_linear_size_nocache(fcn), 300, "linear size from the cache");
 
 	rz_analysis_block_set_size(second, 500);
 	assert_block_invariants(analysis);
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "minunit.h"
+
+static RzAnalysisEsil *esil_new(RzAnalysis *analysis) {
+	RzAnalysisEsil *esil = rz_analysis_esil_new(32, 0, 64);
+	rz_analysis_esil_setup(esil, analysis, 0, 0, 0);
+	return esil;
+}
+
+/**
+ * Parses \p expr and returns the stack joined with ' ', bottom first.
+ */
+static char *esil_eval(RzAnalysisEsil *esil, const char *expr, bool *ret) {
+	rz_analysis_esil_stack_free(esil);
+	*ret = rz_analysis_esil_parse(esil, expr);
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	for (int i = 0; i < esil->stackptr; i++) {
+		rz_strbuf_appendf(&sb, i ? " %s" : "%s", esil->stack[i]);
+	}
+	rz_analysis_esil_stack_free(esil);
+	return rz_strbuf_drain_nofree(&sb);
+}
+
+bool test_analysis_esil_parse_repeated(void) {
+	const struct {
+		const char *expr;
+		bool ret;
+		const char *stack;
+	} tests[] = {
+		{ "1,2,+", true, "0x3" },
+		{ "1,2,+,", true, "0x3" },
+		{ "0,?{,1,}{,2,}", true, "2" },
+		{ "1,?{,1,}{,2,}", true, "1" },
+		{ "0,?{,1,?{,5,},},6", true, "6" },
+		{ "3,4,5,GOTO,9,10", true, "3 4 10" },
+		{ "4,3,GOTO,", true, "4" },
+		{ "1,99,GOTO", false, "1" },
+		{ "0,GOTO", false, "0" },
+		{ "1,BREAK,2", false, "1" },
+		// not compiled
+		{ "1,2;3", false, "1 2" },
+		{ "1,,2", true, "1" },
+	};
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisEsil *esil = esil_new(analysis);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(tests); i++) {
+		// the first parse compiles the expression, the second one runs the cached program
+		for (int run = 0; run < 2; run++) {
+			bool ret;
+			char *stack = esil_eval(esil, tests[i].expr, &ret);
+			mu_assert_eq(ret, tests[i].ret, tests[i].expr);
+			mu_assert_streq(stack, tests[i].stack, tests[i].expr);
+			free(stack);
+		}
+	}
+	rz_analysis_esil_free(esil);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+static bool esil_answer(RzAnalysisEsil *esil) {
+	return rz_analysis_esil_pushnum(esil, 42);
+}
+
+bool test_analysis_esil_set_op_after_parse(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisEsil *esil = esil_new(analysis);
+	bool ret;
+	char *stack = esil_eval(esil, "1,ANSWER", &ret);
+	mu_assert_streq(stack, "1 ANSWER", "unknown words are values");
+	free(stack);
+	rz_analysis_esil_set_op(esil, "ANSWER", esil_answer, 1, 0, RZ_ANALYSIS_ESIL_OP_TYPE_CUSTOM);
+	stack = esil_eval(esil, "1,ANSWER", &ret);
+	mu_assert_streq(stack, "1 0x2a", "new operation is run");
+	free(stack);
+	rz_analysis_esil_free(esil);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool all_tests(void) {
+	mu_run_test(test_analysis_esil_parse_repeated);
+	mu_run_test(test_analysis_esil_set_op_after_parse);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include <rz_io.h>
+#include "minunit.h"
+
+static bool read_at(RzAnalysis *analysis, ut64 addr, ut8 *buf, int len) {
+	return analysis->iob.read_at(analysis->iob.io, addr, buf, len);
+}
+
+static bool pc_not_at(RzAnalysisILVM *vm, void *user) {
+	return rz_bv_to_ut64(vm->vm->pc) != *(ut64 *)user;
+}
+
+static ut64 var_u64(RzAnalysisILVM *vm, const char *name) {
+	RzILVal *val = rz_il_vm_get_var_value(vm->vm, RZ_IL_VAR_KIND_GLOBAL, name);
+	return val && val->type == RZ_IL_TYPE_PURE_BITVECTOR ? rz_bv_to_ut64(val->data.bv) : UT64_MAX;
+}
+
+bool test_analysis_il_vm_lifted_cache(void) {
+	RzIO *io = rz_io_new();
+	rz_io_open_at(io, "malloc://0x100", RZ_PERM_RW, 0644, 0, NULL);
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_io_bind(io, &analysis->iob);
+	analysis->read_at = read_at;
+	rz_analysis_use(analysis, "x86");
+	rz_analysis_set_bits(analysis, 64);
+
+	// 0: inc rax; 3: cmp rax, 10; 7: jne 0
+	rz_io_write_at(io, 0, (const ut8 *)"\x48\xff\xc0\x48\x83\xf8\x0a\x75\xf7", 9);
+	RzAnalysisILVM *vm = rz_analysis_il_vm_new(analysis, NULL);
+	mu_assert_notnull(vm, "vm");
+	ut64 end = 9;
+	RzAnalysisILStepResult res = rz_analysis_il_vm_step_while(analysis, vm, NULL, pc_not_at, &end);
+	mu_assert_eq(res, RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS, "step result");
+	mu_assert_eq(var_u64(vm, "rax"), 10, "rax");
+	mu_assert_eq(vm->ops_lifted, 3, "lifted once");
+	mu_assert_eq(vm->ops_reused, 27, "reused in the loop");
+
+	// self-modifying code: cmp rax, 20
+	rz_io_write_at(io, 6, (const ut8 *)"\x14", 1);
+	rz_bv_set_from_ut64(vm->vm->pc, 0);
+	res = rz_analysis_il_vm_step_while(analysis, vm, NULL, pc_not_at, &end);
+	mu_assert_eq(res, RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS, "step result");
+	mu_assert_eq(var_u64(vm, "rax"), 20, "rax with the written code");
+	mu_assert_eq(vm->ops_lifted, 4, "written instruction lifted again");
+	mu_assert_eq(vm->ops_reused, 27 + 29, "others reused");
+
+	// disabled cache lifts every step
+	rz_analysis_il_vm_cache_set_max(vm, 0);
+	rz_io_write_at(io, 6, (const ut8 *)"\x1e", 1);
+	rz_bv_set_from_ut64(vm->vm->pc, 0);
+	res = rz_analysis_il_vm_step_while(analysis, vm, NULL, pc_not_at, &end);
+	mu_assert_eq(res, RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS, "step result");
+	mu_assert_eq(var_u64(vm, "rax"), 30, "rax without cache");
+	mu_assert_eq(vm->ops_lifted, 4 + 30, "lifted every step");
+	mu_assert_eq(vm->ops_reused, 27 + 29, "nothing reused");
+	mu_assert_null(vm->lifted, "no cache");
+
+	rz_analysis_il_vm_free(vm);
+	rz_analysis_free(analysis);
+	rz_io_free(io);
+	mu_end;
+}
+
+bool all_tests(void) {
+	mu_run_test(test_analysis_il_vm_lifted_cache);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
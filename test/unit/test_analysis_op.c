@@ -171,8 +171,89 @@ bool test_rz_core_print_disasm() {
 	mu_end;
 }
 
+bool test_rz_analysis_op_cache() {
+	RzAnalysis *analysis = rz_analysis_new();
+	SWITCH_TO_ARCH_BITS("x86", 64);
+	mu_assert_true(rz_analysis_op_cache_resize(analysis, 16), "enable cache");
+	const RzAnalysisOpMask mask = RZ_ANALYSIS_OP_MASK_ESIL | RZ_ANALYSIS_OP_MASK_VAL | RZ_ANALYSIS_OP_MASK_HINT;
+	// mov rax, [rbx+rcx+4]
+	ut8 bytes[] = { 0x48, 0x8b, 0x44, 0x0b, 0x04, 0x90 };
+	RzAnalysisOp op;
+	ut64 hits, misses;
+	char *esil = NULL;
+	for (int i = 0; i < 2; i++) {
+		int len = rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+		mu_assert_eq(len, 5, "op size");
+		mu_assert_eq(op.addr, 0x1000, "op addr");
+		if (!esil) {
+			esil = rz_strbuf_drain_nofree(&op.esil);
+		} else {
+			mu_assert_streq(rz_strbuf_get(&op.esil), esil, "same esil");
+		}
+		mu_assert_streq(op.dst->reg->name, "rax", "dst reg");
+		mu_assert_streq(op.src[0]->regdelta->name, "rcx", "src reg delta");
+		rz_analysis_op_fini(&op);
+	}
+	rz_analysis_op_cache_stats(analysis, &hits, &misses);
+	mu_assert_eq(hits, 1, "second decoding is cached");
+	mu_assert_eq(misses, 1, "first decoding is not cached");
+
+	// bytes after the op do not matter, the op bytes and the mask do
+	bytes[5] = 0xcc;
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	rz_analysis_op_fini(&op);
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), RZ_ANALYSIS_OP_MASK_BASIC);
+	rz_analysis_op_fini(&op);
+	bytes[4] = 0x08;
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	mu_assert_eq(op.src[0]->delta, 8, "changed bytes are decoded again");
+	char *esil8 = rz_strbuf_drain_nofree(&op.esil);
+	mu_assert_true(strcmp(esil8, esil), "changed esil");
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis, &hits, &misses);
+	mu_assert_eq(hits, 2, "hits");
+	mu_assert_eq(misses, 3, "misses");
+
+	// hints are applied to the cached op
+	rz_analysis_hint_set_esil(analysis, 0x1000, "1,rax,=");
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	mu_assert_streq(rz_strbuf_get(&op.esil), "1,rax,=", "hint is applied");
+	rz_analysis_op_fini(&op);
+	rz_analysis_hint_unset_esil(analysis, 0x1000);
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	mu_assert_streq(rz_strbuf_get(&op.esil), esil8, "hint is removed");
+	rz_analysis_op_fini(&op);
+
+	// ranged hints set before the op drop it
+	ut64 misses_before;
+	rz_analysis_op_cache_stats(analysis, NULL, &misses_before);
+	rz_analysis_hint_set_bits(analysis, 0x800, 64);
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	rz_analysis_op_fini(&op);
+	rz_analysis_hint_unset_bits(analysis, 0x800);
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis, &hits, &misses);
+	mu_assert_eq(misses, misses_before + 2, "ranged hints invalidate the cache");
+
+	// register items of the cached ops die with the profile
+	SWITCH_TO_ARCH_BITS("x86", 32);
+	SWITCH_TO_ARCH_BITS("x86", 64);
+	rz_analysis_op(analysis, &op, 0x1000, bytes, sizeof(bytes), mask);
+	mu_assert_streq(op.dst->reg->name, "rax", "dst reg after profile change");
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis, &hits, &misses);
+	mu_assert_eq(hits, 2, "no hit across profile changes");
+
+	free(esil);
+	free(esil8);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_op_val);
+	mu_run_test(test_rz_analysis_op_cache);
 	mu_run_test(test_rz_core_analysis_bytes);
 	mu_run_test(test_rz_core_print_disasm);
 	return tests_passed != tests_run;
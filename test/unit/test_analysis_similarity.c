@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include <rz_io.h>
+#include "minunit.h"
+
+#define FCN_STRIDE 0x80
+#define B_BASE     0x100000
+
+static bool read_at(RzAnalysis *analysis, ut64 addr, ut8 *buf, int len) {
+	return analysis->iob.read_at(analysis->iob.io, addr, buf, len);
+}
+
+static RzAnalysisFunction *add_function(RzAnalysis *analysis, const char *name, ut64 addr, ut64 size) {
+	RzAnalysisFunction *fcn = rz_analysis_create_function(analysis, name, addr, RZ_ANALYSIS_FCN_TYPE_NULL);
+	RzAnalysisBlock *block = rz_analysis_create_block(analysis, addr, size);
+	rz_analysis_function_add_block(fcn, block);
+	rz_analysis_block_unref(block);
+	return fcn;
+}
+
+/**
+ * Function i of A is at i * FCN_STRIDE, its counterpart in B is the
+ * function n - 1 - i, so that the lists are not in the same order.
+ * One function out of 3 is patched in B, one out of 50 is rewritten
+ * in B but keeps its name, and the functions of A at 17 mod 50 are
+ * unrelated to anything in B.
+ */
+static void build_functions(RzAnalysis *analysis, RzIO *io, size_t n, RzList *list_a, RzList *list_b) {
+	ut8 buf[FCN_STRIDE];
+	char name[32];
+	ut32 seed = 0x1337;
+	for (size_t i = 0; i < n; i++) {
+		ut64 size = 32 + i % 64;
+		for (size_t j = 0; j < size; j++) {
+			seed = seed * 1103515245 + 12345;
+			buf[j] = seed >> 16;
+		}
+		ut64 addr_a = i * FCN_STRIDE;
+		ut64 addr_b = B_BASE + (n - 1 - i) * FCN_STRIDE;
+		rz_io_write_at(io, addr_a, buf, size);
+		if (i % 50 == 17) {
+			buf[0] ^= 0xff;
+			for (size_t j = 1; j < size; j++) {
+				buf[j] = buf[j - 1] * 7 + j;
+			}
+		} else if (i % 50 == 0) {
+			memset(buf, 0xcc, size);
+		} else if (i % 3 == 0) {
+			buf[5] ^= 0x11;
+			buf[size / 2] ^= 0xff;
+		}
+		rz_io_write_at(io, addr_b, buf, size);
+		snprintf(name, sizeof(name), i % 50 ? "fcn.a%" PFMTSZu : "sym.f%" PFMTSZu, i);
+		rz_list_append(list_a, add_function(analysis, name, addr_a, size));
+		snprintf(name, sizeof(name), i % 50 ? "fcn.b%" PFMTSZu : "sym.f%" PFMTSZu, i);
+		add_function(analysis, name, addr_b, size);
+	}
+	for (size_t i = 0; i < n; i++) {
+		rz_list_append(list_b, rz_analysis_get_function_at(analysis, B_BASE + i * FCN_STRIDE));
+	}
+}
+
+static bool check_match_functions(size_t n) {
+	RzIO *io = rz_io_new();
+	rz_io_open_at(io, "malloc://0x200000", RZ_PERM_RW, 0644, 0, NULL);
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_io_bind(io, &analysis->iob);
+	analysis->read_at = read_at;
+	RzList *list_a = rz_list_new();
+	RzList *list_b = rz_list_new();
+	build_functions(analysis, io, n, list_a, list_b);
+
+	RzAnalysisMatchResult *result = rz_analysis_match_functions(analysis, list_a, list_b);
+	mu_assert_notnull(result, "result");
+	size_t unrelated = n / 50 + (n % 50 > 17);
+	size_t related = 0;
+	RzListIter *it;
+	RzAnalysisMatchPair *pair;
+	rz_list_foreach (result->matches, it, pair) {
+		const RzAnalysisFunction *fa = pair->pair_a, *fb = pair->pair_b;
+		size_t i = fa->addr / FCN_STRIDE;
+		if (i % 50 == 17) {
+			mu_assert_true(pair->similarity < RZ_ANALYSIS_SIMILARITY_THRESHOLD, "unrelated function");
+			continue;
+		}
+		related++;
+		mu_assert_eq(fb->addr, B_BASE + (n - 1 - i) * FCN_STRIDE, "matched the counterpart");
+		if (i % 50 == 0) {
+			mu_assert_true(pair->similarity < RZ_ANALYSIS_SIMILARITY_THRESHOLD, "matched by name");
+		} else if (i % 3 == 0) {
+			mu_assert_true(pair->similarity > 0.9 && pair->similarity < 1.0, "patched");
+		} else {
+			mu_assert_eq(pair->similarity, 1.0, "identical");
+		}
+	}
+	mu_assert_eq(related, n - unrelated, "all the counterparts matched");
+	mu_assert_eq(rz_list_length(result->matches) + rz_list_length(result->unmatch_a), n, "all the functions of A");
+	RzAnalysisFunction *fcn;
+	rz_list_foreach (result->unmatch_a, it, fcn) {
+		mu_assert_eq(fcn->addr / FCN_STRIDE % 50, 17, "unmatched function");
+	}
+	rz_analysis_match_result_free(result);
+
+	rz_list_free(list_a);
+	rz_list_free(list_b);
+	rz_analysis_free(analysis);
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_analysis_match_functions(void) {
+	return check_match_functions(200);
+}
+
+bool test_analysis_match_functions_indexed(void) {
+	// large enough to be matched through the index
+	return check_match_functions(1100);
+}
+
+bool all_tests(void) {
+	mu_run_test(test_analysis_match_functions);
+	mu_run_test(test_analysis_match_functions_indexed);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -21,8 +21,148 @@ bool test_rz_analysis_xrefs_count() {
 	mu_end;
 }
 
+bool test_rz_analysis_xrefs_update_del() {
+	RzAnalysis *analysis = rz_analysis_new();
+
+	mu_assert_true(rz_analysis_xrefs_set(analysis, 0x100, 0x200, RZ_ANALYSIS_XREF_TYPE_CODE), "set");
+	mu_assert_false(rz_analysis_xrefs_set(analysis, 0x100, 0x100, RZ_ANALYSIS_XREF_TYPE_CODE), "self xref");
+	mu_assert_true(rz_analysis_xrefs_set(analysis, 0x100, 0x200, RZ_ANALYSIS_XREF_TYPE_CALL), "update");
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 1, "same pair is stored once");
+
+	RzList *xrefs = rz_analysis_xrefs_get_to(analysis, 0x200);
+	mu_assert_eq(rz_list_length(xrefs), 1, "xrefs to");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_first(xrefs))->type, RZ_ANALYSIS_XREF_TYPE_CALL, "updated type");
+	rz_list_free(xrefs);
+
+	rz_analysis_xref_del(analysis, 0x100, 0x200);
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 0, "deleted");
+	mu_assert_null(rz_analysis_xrefs_get_to(analysis, 0x200), "no xrefs to");
+	mu_assert_null(rz_analysis_xrefs_get_from(analysis, 0x100), "no xrefs from");
+
+	// enough entries to go through the sorted runs and not only the write buffer
+	for (ut64 i = 0; i < 1000; i++) {
+		rz_analysis_xrefs_set(analysis, 0x1000 + i, 0x8000 + (i % 10), RZ_ANALYSIS_XREF_TYPE_DATA);
+	}
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 1000, "count");
+	for (ut64 i = 0; i < 1000; i += 2) {
+		rz_analysis_xrefs_deln(analysis, 0x1000 + i, 0x8000 + (i % 10), RZ_ANALYSIS_XREF_TYPE_DATA);
+	}
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 500, "count after delete");
+	rz_analysis_xrefs_set(analysis, 0x1000, 0x8000, RZ_ANALYSIS_XREF_TYPE_STRING);
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 501, "count after re-adding");
+
+	xrefs = rz_analysis_xrefs_get_to(analysis, 0x8000);
+	mu_assert_eq(rz_list_length(xrefs), 1, "xrefs to");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_first(xrefs))->type, RZ_ANALYSIS_XREF_TYPE_STRING, "re-added type");
+	rz_list_free(xrefs);
+	xrefs = rz_analysis_xrefs_get_to(analysis, 0x8001);
+	mu_assert_eq(rz_list_length(xrefs), 100, "xrefs to");
+	ut64 prev = 0;
+	RzListIter *it;
+	RzAnalysisXRef *xref;
+	rz_list_foreach (xrefs, it, xref) {
+		mu_assert_true(xref->from > prev, "sorted by source");
+		prev = xref->from;
+	}
+	rz_list_free(xrefs);
+
+	xrefs = rz_analysis_xrefs_list(analysis);
+	mu_assert_eq(rz_list_length(xrefs), 501, "all xrefs");
+	rz_list_free(xrefs);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_xrefs_range() {
+	RzAnalysis *analysis = rz_analysis_new();
+
+	rz_analysis_xrefs_set(analysis, 0x10, 0x100, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x20, 0x1ff, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x30, 0x200, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x40, 0xff, RZ_ANALYSIS_XREF_TYPE_CODE);
+
+	RzList *xrefs = rz_analysis_xrefs_get_to_range(analysis, 0x100, 0x200);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs into [0x100, 0x200)");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_get_n(xrefs, 0))->from, 0x10, "xref from");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_get_n(xrefs, 1))->from, 0x20, "xref from");
+	rz_list_free(xrefs);
+
+	xrefs = rz_analysis_xrefs_get_from_range(analysis, 0x20, 0x40);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs from [0x20, 0x40)");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_get_n(xrefs, 0))->to, 0x1ff, "xref to");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_get_n(xrefs, 1))->to, 0x200, "xref to");
+	rz_list_free(xrefs);
+
+	mu_assert_null(rz_analysis_xrefs_get_to_range(analysis, 0x300, 0x400), "empty range");
+	mu_assert_null(rz_analysis_xrefs_get_to_range(analysis, 0x200, 0x100), "inverted range");
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_xrefs_set_bulk() {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_xrefs_set(analysis, 0x10, 0x20, RZ_ANALYSIS_XREF_TYPE_CODE);
+
+	RzVector xrefs;
+	rz_vector_init(&xrefs, sizeof(RzAnalysisXRef), NULL, NULL);
+	RzAnalysisXRef in[] = {
+		{ 0x30, 0x40, RZ_ANALYSIS_XREF_TYPE_DATA },
+		{ 0x10, 0x20, RZ_ANALYSIS_XREF_TYPE_CALL },
+		{ 0x30, 0x40, RZ_ANALYSIS_XREF_TYPE_STRING },
+		{ 0x50, 0x50, RZ_ANALYSIS_XREF_TYPE_CODE },
+		{ 0x1, 0x2, RZ_ANALYSIS_XREF_TYPE_NULL },
+		{ 0x60, 0x70, (RzAnalysisXRefType)-1 },
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(in); i++) {
+		rz_vector_push(&xrefs, &in[i]);
+	}
+	mu_assert_eq(rz_analysis_xrefs_set_bulk(analysis, &xrefs), 4, "accepted");
+	rz_vector_fini(&xrefs);
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 3, "count");
+
+	RzList *list = rz_analysis_xrefs_list(analysis);
+	mu_assert_eq(rz_list_length(list), 3, "all xrefs");
+	RzAnalysisXRef *xref = rz_list_get_n(list, 0);
+	mu_assert_eq(xref->from, 0x1, "xref from");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_NULL, "xref type");
+	xref = rz_list_get_n(list, 1);
+	mu_assert_eq(xref->from, 0x10, "xref from");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_CALL, "existing xref updated");
+	xref = rz_list_get_n(list, 2);
+	mu_assert_eq(xref->from, 0x30, "xref from");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_STRING, "last duplicate wins");
+	rz_list_free(list);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_xrefs_invalid_type() {
+	RzAnalysis *analysis = rz_analysis_new();
+
+	mu_assert_false(rz_analysis_xrefs_set(analysis, 0x100, 0x200, (RzAnalysisXRefType)-1), "-1 is not a xref type");
+	mu_assert_false(rz_analysis_xrefs_set(analysis, 0x100, 0x200, (RzAnalysisXRefType)'x'), "unknown xref type");
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 0, "nothing stored");
+
+	mu_assert_true(rz_analysis_xrefs_set(analysis, 0x100, 0x200, RZ_ANALYSIS_XREF_TYPE_DATA), "set");
+	mu_assert_false(rz_analysis_xrefs_set(analysis, 0x100, 0x200, (RzAnalysisXRefType)-1), "no update with an invalid type");
+	RzList *xrefs = rz_analysis_xrefs_get_from(analysis, 0x100);
+	mu_assert_eq(rz_list_length(xrefs), 1, "xrefs from");
+	mu_assert_eq(((RzAnalysisXRef *)rz_list_first(xrefs))->type, RZ_ANALYSIS_XREF_TYPE_DATA, "type kept");
+	rz_list_free(xrefs);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_xrefs_count);
+	mu_run_test(test_rz_analysis_xrefs_update_del);
+	mu_run_test(test_rz_analysis_xrefs_range);
+	mu_run_test(test_rz_analysis_xrefs_set_bulk);
+	mu_run_test(test_rz_analysis_xrefs_invalid_type);
 	return tests_passed != tests_run;
 }
 
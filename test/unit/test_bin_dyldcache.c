@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 Rizin Organization
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_util.h>
+#include "../../librz/bin/format/mach0/dyldcache.h"
+#include "minunit.h"
+
+#define PAGE_SIZE 0x1000
+#define DATA_SIZE (8 * PAGE_SIZE)
+#define PTR_OFF   0x10
+#define SLIDE_A   0x10000
+#define SLIDE_B   0x20000
+
+static ut16 page_starts_a[] = { PTR_OFF, PTR_OFF };
+static ut16 page_starts_b[] = { PTR_OFF, PTR_OFF, PTR_OFF };
+
+static RzDyldRebaseInfo3 info_a = {
+	.version = 3,
+	.slide = SLIDE_A,
+	.page_size = PAGE_SIZE,
+	.start_of_data = 1 * PAGE_SIZE,
+	.page_starts = page_starts_a,
+	.page_starts_count = RZ_ARRAY_SIZE(page_starts_a),
+};
+
+static RzDyldRebaseInfo3 info_b = {
+	.version = 3,
+	.slide = SLIDE_B,
+	.page_size = PAGE_SIZE,
+	.start_of_data = 3 * PAGE_SIZE,
+	.page_starts = page_starts_b,
+	.page_starts_count = RZ_ARRAY_SIZE(page_starts_b),
+};
+
+static ut64 raw_ptr(ut64 page) {
+	return 0x100000 + page;
+}
+
+/* expected pointer read through the rebasing buffer in the page at \p page */
+static ut64 rebased_ptr(ut64 page) {
+	if (page >= info_b.start_of_data && page < 6 * PAGE_SIZE) {
+		return raw_ptr(page) + SLIDE_B;
+	}
+	if (page >= info_a.start_of_data && page < info_b.start_of_data) {
+		return raw_ptr(page) + SLIDE_A;
+	}
+	return raw_ptr(page);
+}
+
+static ut64 read_ptr(RzBuffer *b, ut64 addr) {
+	ut8 tmp[8] = { 0 };
+	rz_buf_read_at(b, addr, tmp, sizeof(tmp));
+	return rz_read_le64(tmp);
+}
+
+bool test_dyldcache_rebase_cache() {
+	ut8 *data = malloc(DATA_SIZE);
+	mu_assert_notnull(data, "data");
+	for (ut64 i = 0; i < DATA_SIZE; i++) {
+		data[i] = (ut8)(i * 7);
+	}
+	for (ut64 page = 0; page < DATA_SIZE; page += PAGE_SIZE) {
+		rz_write_le64(data + page + PTR_OFF, raw_ptr(page));
+	}
+
+	RzDyldRebaseInfosEntry entries[] = {
+		{ 1 * PAGE_SIZE, 3 * PAGE_SIZE, (RzDyldRebaseInfo *)&info_a },
+		{ 3 * PAGE_SIZE, 6 * PAGE_SIZE, (RzDyldRebaseInfo *)&info_b },
+	};
+	RzDyldRebaseInfos infos = { entries, RZ_ARRAY_SIZE(entries) };
+	RzDyldCache cache = { 0 };
+	cache.buf = rz_buf_new_with_bytes(data, DATA_SIZE);
+	cache.rebase_infos = &infos;
+	RzBuffer *b = rz_dyldcache_new_rebasing_buf(&cache);
+	mu_assert_notnull(b, "rebasing buffer");
+
+	// miss, then hit
+	mu_assert_eq(read_ptr(b, PAGE_SIZE + PTR_OFF), rebased_ptr(PAGE_SIZE), "rebased pointer");
+	RzDyldRebaseCache *rc = cache.rebase_cache;
+	mu_assert_notnull(rc, "cache created by the first read");
+	mu_assert_eq(rc->misses, 1, "first read of a page");
+	mu_assert_eq(read_ptr(b, PAGE_SIZE + PTR_OFF), rebased_ptr(PAGE_SIZE), "rebased pointer from the cache");
+	mu_assert_eq(rc->hits, 1, "page served from the cache");
+	mu_assert_eq(rc->count, 1, "one cached page");
+
+	// a read spanning both ranges and the bytes around them, with a cache too small to hold it
+	rc->max_pages = 3;
+	ut8 *out = malloc(DATA_SIZE);
+	mu_assert_notnull(out, "out");
+	mu_assert_eq(rz_buf_read_at(b, 0, out, DATA_SIZE), DATA_SIZE, "whole read");
+	for (ut64 page = 0; page < DATA_SIZE; page += PAGE_SIZE) {
+		mu_assert_eq(rz_read_le64(out + page + PTR_OFF), rebased_ptr(page), "pointer of each page");
+		rz_write_le64(out + page + PTR_OFF, raw_ptr(page));
+	}
+	mu_assert_memeq(out, data, DATA_SIZE, "bytes other than the pointers unchanged");
+	mu_assert_eq(rc->hits, 2, "first page still cached");
+	mu_assert_eq(rc->misses, 5, "one miss per other rebased page");
+	mu_assert_eq(rc->evictions, 2, "least recently used pages evicted");
+	mu_assert_eq(rc->count, 3, "cache bounded");
+	mu_assert_eq(read_ptr(b, PAGE_SIZE + PTR_OFF), rebased_ptr(PAGE_SIZE), "evicted page rebased again");
+	mu_assert_eq(rc->misses, 6, "evicted page missed");
+	mu_assert_eq(read_ptr(b, 5 * PAGE_SIZE + PTR_OFF), rebased_ptr(5 * PAGE_SIZE), "most recent page");
+	mu_assert_eq(rc->hits, 3, "most recent page kept");
+
+	// writes drop the rebased pages
+	ut8 ptr[8];
+	rz_write_le64(ptr, 0x200000);
+	mu_assert_eq(rz_buf_write_at(b, 2 * PAGE_SIZE + PTR_OFF, ptr, sizeof(ptr)), sizeof(ptr), "write");
+	mu_assert_eq(rc->count, 0, "cache purged by the write");
+	mu_assert_eq(read_ptr(b, 2 * PAGE_SIZE + PTR_OFF), 0x200000 + SLIDE_A, "written pointer rebased");
+
+	rz_buf_free(b);
+	rz_dyldcache_rebase_cache_free(cache.rebase_cache);
+	rz_buf_free(cache.buf);
+	free(out);
+	free(data);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_dyldcache_rebase_cache);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -0,0 +1,288 @@
+// SPDX-FileCopyrightText: 2026 Rizin Organization
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_bin.h>
+#include <rz_io.h>
+#include "../../librz/bin/format/elf/elf_specs.h"
+#include "minunit.h"
+
+#define ELF_BASE      0x10000
+#define ELF_TEXT_SIZE 0x2000
+#define N_SYMBOLS     1100 // more than the symbol entries decoded at once
+
+typedef struct {
+	const char *name;
+	int bits;
+	bool big_endian;
+	ut16 machine;
+	ut64 syment; ///< DT_SYMENT of the dynamic symbols, 0 to use the size of the entries
+	ut64 stride; ///< distance between the dynamic symbols in the file
+} ElfSpec;
+
+typedef struct {
+	const ElfSpec *spec;
+	ut8 *data;
+	size_t size;
+	size_t text_off;
+} ElfImage;
+
+static void put16(ElfImage *img, size_t off, ut16 v) {
+	rz_write_ble16(img->data + off, v, img->spec->big_endian);
+}
+
+static void put32(ElfImage *img, size_t off, ut32 v) {
+	rz_write_ble32(img->data + off, v, img->spec->big_endian);
+}
+
+static void put64(ElfImage *img, size_t off, ut64 v) {
+	rz_write_ble64(img->data + off, v, img->spec->big_endian);
+}
+
+static void put_addr(ElfImage *img, size_t off, ut64 v) {
+	if (img->spec->bits == 64) {
+		put64(img, off, v);
+	} else {
+		put32(img, off, v);
+	}
+}
+
+static void put_sym(ElfImage *img, size_t off, ut32 name, ut64 value, ut64 size, ut8 info, ut16 shndx) {
+	put32(img, off, name);
+	if (img->spec->bits == 64) {
+		img->data[off + 4] = info;
+		img->data[off + 5] = 0;
+		put16(img, off + 6, shndx);
+		put64(img, off + 8, value);
+		put64(img, off + 16, size);
+	} else {
+		put32(img, off + 4, value);
+		put32(img, off + 8, size);
+		img->data[off + 12] = info;
+		img->data[off + 13] = 0;
+		put16(img, off + 14, shndx);
+	}
+}
+
+static void put_section(ElfImage *img, size_t off, ut32 name, ut32 type, ut64 flags, ut64 addr, ut64 offset, ut64 size, ut32 link, ut32 info, ut64 align, ut64 entsize) {
+	const size_t w = img->spec->bits / 8;
+	put32(img, off, name);
+	put32(img, off + 4, type);
+	put_addr(img, off + 8, flags);
+	put_addr(img, off + 8 + w, addr);
+	put_addr(img, off + 8 + 2 * w, offset);
+	put_addr(img, off + 8 + 3 * w, size);
+	put32(img, off + 8 + 4 * w, link);
+	put32(img, off + 12 + 4 * w, info);
+	put_addr(img, off + 16 + 4 * w, align);
+	put_addr(img, off + 16 + 5 * w, entsize);
+}
+
+static void put_segment(ElfImage *img, size_t off, ut32 type, ut32 flags, ut64 offset, ut64 addr, ut64 size) {
+	put32(img, off, type);
+	if (img->spec->bits == 64) {
+		put32(img, off + 4, flags);
+		put64(img, off + 8, offset);
+		put64(img, off + 16, addr);
+		put64(img, off + 24, addr);
+		put64(img, off + 32, size);
+		put64(img, off + 40, size);
+		put64(img, off + 48, 8);
+	} else {
+		put32(img, off + 4, offset);
+		put32(img, off + 8, addr);
+		put32(img, off + 12, addr);
+		put32(img, off + 16, size);
+		put32(img, off + 20, size);
+		put32(img, off + 24, flags);
+		put32(img, off + 28, 4);
+	}
+}
+
+static size_t strtab_size(const char *prefix) {
+	size_t size = 1;
+	for (int i = 0; i < N_SYMBOLS; i++) {
+		size += snprintf(NULL, 0, "%s%d", prefix, i) + 1;
+	}
+	return size;
+}
+
+static ut64 symbol_value(const ElfImage *img, int i, bool dynamic) {
+	return ELF_BASE + img->text_off + i * 4 + (dynamic ? 2 : 0);
+}
+
+static ut8 symbol_info(int i) {
+	return i % 3 ? (STB_GLOBAL << 4 | STT_FUNC) : (STB_LOCAL << 4 | STT_OBJECT);
+}
+
+/* symbol table and its string table, with the entries every stride bytes */
+static void put_symbols(ElfImage *img, size_t sym_off, size_t stride, size_t str_off, const char *prefix, bool dynamic) {
+	size_t name = 1;
+	for (int i = 0; i < N_SYMBOLS; i++) {
+		size_t off = sym_off + (i + 1) * stride;
+		put_sym(img, off, name, symbol_value(img, i, dynamic), 4, symbol_info(i), 1);
+		name += sprintf((char *)img->data + str_off + name, "%s%d", prefix, i) + 1;
+	}
+}
+
+#define ALIGN(x, a) (((x) + (a)-1) & ~((size_t)(a)-1))
+
+/**
+ * Builds an executable with a section symbol table (ssym*) and a dynamic
+ * symbol table (dsym*) found through DT_SYMTAB, DT_SYMENT and DT_HASH.
+ */
+static bool elf_image_build(ElfImage *img, const ElfSpec *spec) {
+	static const char shstrtab[] = "\0.text\0.symtab\0.strtab\0.shstrtab";
+	const bool b64 = spec->bits == 64;
+	const size_t w = spec->bits / 8;
+	const size_t ehsize = b64 ? 64 : 52;
+	const size_t phentsize = b64 ? 56 : 32;
+	const size_t shentsize = b64 ? 64 : 40;
+	const size_t symsize = b64 ? 24 : 16;
+
+	memset(img, 0, sizeof(*img));
+	img->spec = spec;
+	size_t off = ehsize + 2 * phentsize;
+	img->text_off = off = ALIGN(off, 16);
+	const size_t symtab_off = off = ALIGN(off + ELF_TEXT_SIZE, 8);
+	const size_t symtab_size = (N_SYMBOLS + 1) * symsize;
+	const size_t strtab_off = off = off + symtab_size;
+	const size_t strtab_len = strtab_size("ssym");
+	const size_t dynsym_off = off = ALIGN(off + strtab_len, 8);
+	const size_t dynstr_off = off = off + (N_SYMBOLS + 1) * spec->stride;
+	const size_t dynstr_len = strtab_size("dsym");
+	const size_t hash_off = off = ALIGN(off + dynstr_len, 8);
+	const size_t dynamic_off = off = ALIGN(off + (3 + N_SYMBOLS + 1) * 4, 8);
+	const size_t dynamic_size = 6 * 2 * w;
+	const size_t shstrtab_off = off = off + dynamic_size;
+	const size_t sh_off = off = ALIGN(off + sizeof(shstrtab), 8);
+	img->size = off + 5 * shentsize;
+	img->data = calloc(1, img->size);
+	if (!img->data) {
+		return false;
+	}
+
+	memcpy(img->data, ELFMAG, SELFMAG);
+	img->data[EI_CLASS] = b64 ? ELFCLASS64 : ELFCLASS32;
+	img->data[EI_DATA] = spec->big_endian ? ELFDATA2MSB : ELFDATA2LSB;
+	img->data[EI_VERSION] = EV_CURRENT;
+	put16(img, 16, ET_EXEC);
+	put16(img, 18, spec->machine);
+	put32(img, 20, EV_CURRENT);
+	put_addr(img, 24, ELF_BASE + img->text_off);
+	put_addr(img, 24 + w, ehsize);
+	put_addr(img, 24 + 2 * w, sh_off);
+	put16(img, 28 + 3 * w, ehsize);
+	put16(img, 30 + 3 * w, phentsize);
+	put16(img, 32 + 3 * w, 2);
+	put16(img, 34 + 3 * w, shentsize);
+	put16(img, 36 + 3 * w, 5);
+	put16(img, 38 + 3 * w, 4);
+
+	put_segment(img, ehsize, PT_LOAD, PF_R | PF_W | PF_X, 0, ELF_BASE, img->size);
+	put_segment(img, ehsize + phentsize, PT_DYNAMIC, PF_R | PF_W, dynamic_off, ELF_BASE + dynamic_off, dynamic_size);
+
+	put_symbols(img, symtab_off, symsize, strtab_off, "ssym", false);
+	// the bytes after each dynamic symbol must be skipped
+	memset(img->data + dynsym_off, 0xcc, (N_SYMBOLS + 1) * spec->stride);
+	put_sym(img, dynsym_off, 0, 0, 0, 0, 0);
+	put_symbols(img, dynsym_off, spec->stride, dynstr_off, "dsym", true);
+
+	put32(img, hash_off, 1); // nbucket
+	put32(img, hash_off + 4, N_SYMBOLS + 1); // nchain
+
+	const ut64 dynamic[][2] = {
+		{ DT_HASH, ELF_BASE + hash_off },
+		{ DT_STRTAB, ELF_BASE + dynstr_off },
+		{ DT_SYMTAB, ELF_BASE + dynsym_off },
+		{ DT_STRSZ, dynstr_len },
+		{ DT_SYMENT, spec->syment },
+		{ DT_NULL, 0 },
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(dynamic); i++) {
+		put_addr(img, dynamic_off + 2 * i * w, dynamic[i][0]);
+		put_addr(img, dynamic_off + (2 * i + 1) * w, dynamic[i][1]);
+	}
+
+	memcpy(img->data + shstrtab_off, shstrtab, sizeof(shstrtab));
+	put_section(img, sh_off + shentsize, 1, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, ELF_BASE + img->text_off, img->text_off, ELF_TEXT_SIZE, 0, 0, 16, 0);
+	put_section(img, sh_off + 2 * shentsize, 7, SHT_SYMTAB, 0, 0, symtab_off, symtab_size, 3, 1, 8, symsize);
+	put_section(img, sh_off + 3 * shentsize, 15, SHT_STRTAB, 0, 0, strtab_off, strtab_len, 0, 0, 1, 0);
+	put_section(img, sh_off + 4 * shentsize, 23, SHT_STRTAB, 0, 0, shstrtab_off, sizeof(shstrtab), 0, 0, 1, 0);
+	return true;
+}
+
+static bool check_symbols(const ElfSpec *spec) {
+	char message[256];
+	ElfImage img;
+	mu_assert_true(elf_image_build(&img, spec), "build elf");
+
+	RzBin *bin = rz_bin_new();
+	RzIO *io = rz_io_new();
+	rz_io_bind(io, &bin->iob);
+	RzBuffer *buf = rz_buf_new_with_bytes(img.data, img.size);
+	RzBinOptions opt;
+	rz_bin_options_init(&opt, 0, UT64_MAX, 0, false);
+	RzBinFile *bf = rz_bin_open_buf(bin, buf, &opt);
+	snprintf(message, sizeof(message), "%s: load", spec->name);
+	mu_assert_notnull(bf, message);
+
+	int found[2][N_SYMBOLS] = { 0 };
+	const RzList *symbols = rz_bin_object_get_symbols(bf->o);
+	RzListIter *it;
+	RzBinSymbol *sym;
+	rz_list_foreach (symbols, it, sym) {
+		bool dynamic = rz_str_startswith(sym->name, "dsym");
+		if (!dynamic && !rz_str_startswith(sym->name, "ssym")) {
+			continue;
+		}
+		int i = atoi(sym->name + 4);
+		snprintf(message, sizeof(message), "%s: %s", spec->name, sym->name);
+		mu_assert_true(i >= 0 && i < N_SYMBOLS, message);
+		found[dynamic][i]++;
+		mu_assert_eq(sym->vaddr, symbol_value(&img, i, dynamic), message);
+		mu_assert_eq(sym->paddr, symbol_value(&img, i, dynamic) - ELF_BASE, message);
+		mu_assert_eq(sym->size, 4, message);
+		mu_assert_streq(sym->bind, i % 3 ? RZ_BIN_BIND_GLOBAL_STR : RZ_BIN_BIND_LOCAL_STR, message);
+		mu_assert_streq(sym->type, i % 3 ? RZ_BIN_TYPE_FUNC_STR : RZ_BIN_TYPE_OBJECT_STR, message);
+	}
+	for (int i = 0; i < N_SYMBOLS; i++) {
+		snprintf(message, sizeof(message), "%s: ssym%d", spec->name, i);
+		mu_assert_eq(found[false][i], 1, message);
+		// with a null DT_SYMENT, there is only the null symbol
+		snprintf(message, sizeof(message), "%s: dsym%d", spec->name, i);
+		mu_assert_eq(found[true][i], spec->syment ? 1 : 0, message);
+	}
+
+	rz_bin_free(bin);
+	rz_io_free(io);
+	rz_buf_free(buf);
+	free(img.data);
+	return true;
+}
+
+bool test_elf_symbols() {
+	static const ElfSpec specs[] = {
+		{ "elf32 le", 32, false, EM_386, 16, 16 },
+		{ "elf32 be", 32, true, EM_PPC, 16, 16 },
+		{ "elf64 le", 64, false, EM_X86_64, 24, 24 },
+		{ "elf64 be", 64, true, EM_PPC64, 24, 24 },
+		{ "elf32 null syment", 32, false, EM_386, 0, 16 },
+		{ "elf64 null syment", 64, true, EM_PPC64, 0, 24 },
+		{ "elf32 big syment", 32, true, EM_PPC, 20, 20 },
+		{ "elf64 big syment", 64, false, EM_X86_64, 40, 40 },
+		{ "elf64 huge syment", 64, true, EM_PPC64, 0x100, 0x100 },
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(specs); i++) {
+		if (!check_symbols(&specs[i])) {
+			return false;
+		}
+	}
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_elf_symbols);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
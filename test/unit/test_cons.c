@@ -365,9 +365,68 @@ bool test_line_undo(void) {
 	mu_end;
 }
 
+/**
+ * Prints 2000 lines through \p grep, writing the output once the buffer
+ * exceeds \p stream_size bytes, and returns what got written.
+ */
+static char *cons_print_lines(const char *grep, int stream_size, size_t *max_buffer) {
+	RzCons *cons = rz_cons_new();
+	FILE *f = tmpfile();
+	int fdout = cons->fdout;
+	cons->fdout = fileno(f);
+	cons->stream_size = stream_size;
+	if (grep) {
+		rz_cons_grep_process(strdup(grep));
+	}
+	*max_buffer = 0;
+	for (int i = 0; i < 2000; i++) {
+		rz_cons_printf("0x%08x line %d", i * 4, i);
+		rz_cons_strcat(i % 7 ? "\n" : " foo\n");
+		*max_buffer = RZ_MAX(*max_buffer, (size_t)rz_cons_get_buffer_len());
+	}
+	rz_cons_strcat("no newline");
+	rz_cons_flush();
+	cons->fdout = fdout;
+	cons->stream_size = 0;
+	rz_cons_free();
+
+	long size = ftell(f);
+	char *out = calloc(1, size + 1);
+	rewind(f);
+	if (out && fread(out, 1, size, f) != size) {
+		RZ_FREE(out);
+	}
+	fclose(f);
+	return out;
+}
+
+bool test_cons_stream(void) {
+	const char *greps[] = { NULL, "foo", "!foo", "foo[2]", "line:3", "foo:5..9", "foo&line:12.." };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(greps); i++) {
+		size_t max_buffered, max_streamed;
+		char *buffered = cons_print_lines(greps[i], 0, &max_buffered);
+		char *streamed = cons_print_lines(greps[i], 0x400, &max_streamed);
+		mu_assert_notnull(buffered, "buffered output");
+		mu_assert_streq(streamed, buffered, "same output when streamed");
+		mu_assert_true(max_buffered > 0x8000, "whole output buffered");
+		mu_assert_true(max_streamed < 0x400 + 0x40, "output streamed");
+		free(buffered);
+		free(streamed);
+	}
+
+	// selecting lines from the end needs the whole output
+	size_t max_buffered;
+	char *out = cons_print_lines(":-2", 0x400, &max_buffered);
+	mu_assert_streq(out, "0x00001f38 line 1998\n", "line from the end");
+	mu_assert_true(max_buffered > 0x8000, "whole output buffered");
+	free(out);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_cons);
 	mu_run_test(test_cons_to_html);
+	mu_run_test(test_cons_stream);
 	mu_run_test(test_line_nocompletion);
 	mu_run_test(test_line_onecompletion);
 	mu_run_test(test_line_multicompletion);
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Rizin Organization
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include "minunit.h"
+
+#define PRELUDE_RANGE_SIZE 0x90000
+
+// around the boundaries of the chunks scanned in parallel, with some unaligned ones
+static const ut64 prelude_addrs[] = { 0x100, 0x203, 0x3fff0, 0x3fffe, 0x40010, 0x40021, 0x7fffd, 0x80100, PRELUDE_RANGE_SIZE - 6 };
+
+static RzCore *prelude_core_new(int align) {
+	RzCore *core = rz_core_new();
+	rz_io_open_at(core->io, "malloc://0x90000", RZ_PERM_RWX, 0644, 0, NULL);
+	rz_core_set_asm_configs(core, "x86", 64, 0);
+	rz_config_set_i(core->config, "search.align", align);
+	// push rbp; mov rbp, rsp; pop rbp; ret
+	const ut8 fcn[] = { 0x55, 0x48, 0x89, 0xe5, 0x5d, 0xc3 };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(prelude_addrs); i++) {
+		rz_io_write_at(core->io, prelude_addrs[i], fcn, sizeof(fcn));
+	}
+	return core;
+}
+
+static int addr_cmp(const void *a, const void *b) {
+	ut64 x = *(const ut64 *)a, y = *(const ut64 *)b;
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static RzVector /*<ut64>*/ *function_addrs(RzCore *core) {
+	RzVector *addrs = rz_vector_new(sizeof(ut64), NULL, NULL);
+	RzListIter *iter;
+	RzAnalysisFunction *fcn;
+	rz_list_foreach (core->analysis->fcns, iter, fcn) {
+		rz_vector_push(addrs, &fcn->addr);
+	}
+	rz_vector_sort(addrs, addr_cmp, false);
+	return addrs;
+}
+
+static bool preludes_match_serial(int align, size_t expected) {
+	// serial reference: one sequential scan of the range per prelude
+	RzCore *core = prelude_core_new(align);
+	RzList *preludes = rz_analysis_preludes(core->analysis);
+	mu_assert_notnull(preludes, "x86 preludes");
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	rz_list_foreach (preludes, iter, kw) {
+		rz_core_search_prelude(core, 0, PRELUDE_RANGE_SIZE, kw->bin_keyword, kw->keyword_length, kw->bin_binmask, kw->binmask_length);
+	}
+	rz_list_free(preludes);
+	RzVector *serial = function_addrs(core);
+	rz_core_free(core);
+
+	core = prelude_core_new(align);
+	int found = rz_core_search_preludes(core, false);
+	RzVector *parallel = function_addrs(core);
+	rz_core_free(core);
+
+	mu_assert_eq(rz_vector_len(serial), expected, "serial functions");
+	mu_assert_eq(found, expected, "analyzed preludes");
+	mu_assert_eq(rz_vector_len(parallel), rz_vector_len(serial), "same number of functions");
+	for (size_t i = 0; i < rz_vector_len(serial); i++) {
+		mu_assert_eq(*(ut64 *)rz_vector_index_ptr(parallel, i), *(ut64 *)rz_vector_index_ptr(serial, i), "same functions");
+	}
+	rz_vector_free(serial);
+	rz_vector_free(parallel);
+	return true;
+}
+
+static bool test_core_search_preludes(void) {
+	mu_assert_true(preludes_match_serial(0, RZ_ARRAY_SIZE(prelude_addrs)), "all preludes");
+	mu_end;
+}
+
+static bool test_core_search_preludes_align(void) {
+	size_t aligned = 0;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(prelude_addrs); i++) {
+		aligned += !(prelude_addrs[i] % 4);
+	}
+	mu_assert_true(preludes_match_serial(4, aligned), "aligned preludes");
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_core_search_preludes);
+	mu_run_test(test_core_search_preludes_align);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
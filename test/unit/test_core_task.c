@@ -83,10 +83,96 @@ static bool test_core_task_finished_cb(void) {
 	mu_end;
 }
 
+static bool test_core_task_read_only(void) {
+	RzCore *core = rz_core_new();
+	rz_config_set_i(core->config, "scr.interactive", 0);
+	rz_core_task_sync_begin(&core->tasks);
+
+	mu_assert_true(rz_core_cmd_is_read_only(core, "aflc"), "read-only");
+	mu_assert_true(rz_core_cmd_is_read_only(core, " aflq"), "read-only mode");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "aflj"), "mode not read-only");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "afll"), "mode not read-only");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "afi"), "not read-only");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "af"), "not read-only");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "aflc~0"), "grep");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "aflc @ 0x100"), "tmp seek");
+	mu_assert_false(rz_core_cmd_is_read_only(core, "aflc; af"), "multiple commands");
+	mu_assert_false(rz_core_cmd_is_read_only(core, ""), "empty");
+
+	RzCoreTask *a = rz_core_cmd_task_new(core, "aflc", NULL, NULL);
+	RzCoreTask *b = rz_core_cmd_task_new(core, "afl", NULL, NULL);
+	RzCoreTask *c = rz_core_cmd_task_new(core, "echo write", NULL, NULL);
+	mu_assert_true(a->read_only, "read-only task");
+	mu_assert_true(b->read_only, "read-only task");
+	mu_assert_false(c->read_only, "cooperative task");
+	rz_core_task_enqueue(&core->tasks, a);
+	rz_core_task_enqueue(&core->tasks, b);
+	rz_core_task_enqueue(&core->tasks, c);
+
+	rz_cons_printf("main\n");
+	rz_core_task_join(&core->tasks, rz_core_task_self(&core->tasks), -1);
+
+	mu_assert_streq(rz_core_cmd_task_get_result(a), "0\n", "read-only result");
+	mu_assert_streq(rz_core_cmd_task_get_result(b), "", "read-only result");
+	mu_assert_streq(rz_core_cmd_task_get_result(c), "write\n", "cooperative result");
+	mu_assert_streq(rz_cons_get_buffer(), "main\n", "main buffer");
+
+	rz_core_task_del(&core->tasks, a->id);
+	rz_core_task_del(&core->tasks, b->id);
+	rz_core_task_del(&core->tasks, c->id);
+
+	rz_core_task_sync_end(&core->tasks);
+	rz_core_free(core);
+	mu_end;
+}
+
+static bool test_core_task_concurrent_readers(void) {
+	RzCore *core = rz_core_new();
+	rz_config_set_i(core->config, "scr.interactive", 0);
+	rz_core_task_sync_begin(&core->tasks);
+
+	for (ut64 addr = 0x1000; addr < 0x1000 + 0x100 * 64; addr += 0x100) {
+		char name[32];
+		snprintf(name, sizeof(name), "fcn.%" PFMT64x, addr);
+		RzAnalysisFunction *fcn = rz_analysis_create_function(core->analysis, name, addr, RZ_ANALYSIS_FCN_TYPE_FCN);
+		mu_assert_notnull(fcn, "function");
+		for (ut64 bb = addr; bb < addr + 0x40; bb += 0x10) {
+			RzAnalysisBlock *block = rz_analysis_create_block(core->analysis, bb, 0x8);
+			rz_analysis_function_add_block(fcn, block);
+			rz_analysis_block_unref(block);
+		}
+	}
+	char *afl = rz_core_cmd_str(core, "afl");
+	char *aflq = rz_core_cmd_str(core, "aflq");
+	RzAnalysisFunction *fcn = rz_analysis_get_function_at(core->analysis, 0x1000);
+	mu_assert_eq(fcn->meta._min, UT64_MAX, "afl does not fill the cached range");
+
+	RzCoreTask *tasks[8];
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(tasks); i++) {
+		tasks[i] = rz_core_cmd_task_new(core, i % 2 ? "aflq" : "afl", NULL, NULL);
+		mu_assert_true(tasks[i]->read_only, "read-only task");
+		rz_core_task_enqueue(&core->tasks, tasks[i]);
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(tasks); i++) {
+		rz_core_task_join(&core->tasks, rz_core_task_self(&core->tasks), tasks[i]->id);
+		mu_assert_streq(rz_core_cmd_task_get_result(tasks[i]), i % 2 ? aflq : afl, "same output as a serial run");
+		rz_core_task_del(&core->tasks, tasks[i]->id);
+	}
+	mu_assert_eq(fcn->meta._min, UT64_MAX, "readers do not fill the cached range");
+	free(afl);
+	free(aflq);
+
+	rz_core_task_sync_end(&core->tasks);
+	rz_core_free(core);
+	mu_end;
+}
+
 // This test is best served with helgrind
 static int all_tests(void) {
 	mu_run_test(test_core_task);
 	mu_run_test(test_core_task_finished_cb);
+	mu_run_test(test_core_task_read_only);
+	mu_run_test(test_core_task_concurrent_readers);
 	return tests_passed != tests_run;
 }
 
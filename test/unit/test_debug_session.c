@@ -4,6 +4,7 @@
 #include <rz_debug.h>
 #include <rz_util.h>
 #include <rz_reg.h>
+#include <rz_core.h>
 #include "minunit.h"
 
 Sdb *ref_db() {
@@ -15,8 +16,7 @@ Sdb *ref_db() {
 	sdb_set(registers_db, "0x100", "[{\"cnum\":0,\"data\":1094861636},{\"cnum\":1,\"data\":3735928559}]", 0);
 
 	Sdb *memory_sdb = sdb_ns(db, "memory", true);
-	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"data\":170},{\"cnum\":1,\"data\":187}]", 0);
-	sdb_set(memory_sdb, "0x7ffffffff001", "[{\"cnum\":0,\"data\":0},{\"cnum\":1,\"data\":1}]", 0);
+	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"offset\":0,\"data\":\"qgA=\"},{\"cnum\":1,\"offset\":0,\"data\":\"uwE=\"}]", 0);
 
 	Sdb *checkpoints_sdb = sdb_ns(db, "checkpoints", true);
 	sdb_set(checkpoints_sdb, "0x0", "{"
@@ -126,17 +126,21 @@ static bool compare_registers_cb(void *user, const ut64 key, const void *value)
 static bool compare_memory_cb(void *user, const ut64 key, const void *value) {
 	RzDebugChangeMem *actual_mem, *expected_mem;
 	HtUP *ref = user;
-	RzVector *actual_vmem = (RzVector *)value;
+	RzDebugMemPage *actual_page = (RzDebugMemPage *)value;
 
-	RzVector *expected_vmem = ht_up_find(ref, key, NULL);
-	mu_assert("vmem not found", expected_vmem);
-	mu_assert_eq(actual_vmem->len, expected_vmem->len, "vmem length");
+	RzDebugMemPage *expected_page = ht_up_find(ref, key, NULL);
+	mu_assert("page not found", expected_page);
+	mu_assert_eq(actual_page->addr, expected_page->addr, "page addr");
+	mu_assert_eq(actual_page->changes.len, expected_page->changes.len, "page changes");
 
 	size_t i;
-	rz_vector_enumerate(actual_vmem, actual_mem, i) {
-		expected_mem = rz_vector_index_ptr(expected_vmem, i);
+	rz_vector_enumerate(&actual_page->changes, actual_mem, i) {
+		expected_mem = rz_vector_index_ptr(&expected_page->changes, i);
 		mu_assert_eq(actual_mem->cnum, expected_mem->cnum, "cnum");
-		mu_assert_eq(actual_mem->data, expected_mem->data, "data");
+		mu_assert_eq(actual_mem->offset, expected_mem->offset, "offset");
+		mu_assert_eq(actual_mem->size, expected_mem->size, "size");
+		mu_assert_memeq(rz_vector_index_ptr(&actual_page->data, actual_mem->data),
+			rz_vector_index_ptr(&expected_page->data, expected_mem->data), expected_mem->size, "data");
 	}
 	return true;
 }
@@ -198,9 +202,152 @@ static bool test_session_load(void) {
 	mu_end;
 }
 
+static bool test_session_load_legacy_memory(void) {
+	RzDebugSession *s = rz_debug_session_new();
+	Sdb *db = ref_db();
+	// one byte per address, as saved before the page store
+	Sdb *memory_sdb = sdb_ns(db, "memory", false);
+	sdb_reset(memory_sdb);
+	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"data\":170},{\"cnum\":1,\"data\":187}]", 0);
+	sdb_set(memory_sdb, "0x7ffffffff001", "[{\"cnum\":0,\"data\":0},{\"cnum\":1,\"data\":1}]", 0);
+	rz_debug_session_deserialize(s, db);
+
+	mu_assert_eq(s->memory->count, 1, "pages");
+	RzDebugMemPage *page = ht_up_find(s->memory, 0x7ffffffff000, NULL);
+	mu_assert_notnull(page, "page");
+	// the bytes are loaded one by one, in any order
+	ut8 bytes[2][2] = { 0 };
+	int cnum = 0;
+	RzDebugChangeMem *mem;
+	rz_vector_foreach(&page->changes, mem) {
+		mu_assert_true(mem->cnum >= cnum && mem->cnum < 2, "sorted by cnum");
+		mu_assert_true(mem->offset + mem->size <= 2, "offset");
+		cnum = mem->cnum;
+		memcpy(bytes[cnum] + mem->offset, rz_vector_index_ptr(&page->data, mem->data), mem->size);
+	}
+	mu_assert_memeq(bytes[0], (const ut8 *)"\xaa\x00", 2, "cnum 0");
+	mu_assert_memeq(bytes[1], (const ut8 *)"\xbb\x01", 2, "cnum 1");
+
+	sdb_free(db);
+	rz_debug_session_free(s);
+	mu_end;
+}
+
+static bool test_session_mem_pages(void) {
+	RzDebugSession *s = rz_debug_session_new();
+	ut8 buf[0x10];
+	memset(buf, 0x41, sizeof(buf));
+
+	// crosses a page boundary
+	rz_debug_session_add_mem_changes(s, 0x1ff8, buf, sizeof(buf));
+	// consecutive writes of the same step are merged
+	rz_debug_session_add_mem_change(s, 0x2008, 0x42);
+	s->cnum++;
+	rz_debug_session_add_mem_change(s, 0x2009, 0x43);
+
+	mu_assert_eq(s->memory->count, 2, "pages");
+	RzDebugMemPage *page = ht_up_find(s->memory, 0x1000, NULL);
+	mu_assert_notnull(page, "first page");
+	mu_assert_eq(page->changes.len, 1, "first page changes");
+	RzDebugChangeMem *mem = rz_vector_index_ptr(&page->changes, 0);
+	mu_assert_eq(mem->offset, 0xff8, "first page offset");
+	mu_assert_eq(mem->size, 8, "first page size");
+
+	page = ht_up_find(s->memory, 0x2000, NULL);
+	mu_assert_notnull(page, "second page");
+	mu_assert_eq(page->changes.len, 2, "second page changes");
+	mem = rz_vector_index_ptr(&page->changes, 0);
+	mu_assert_eq(mem->cnum, 0, "cnum");
+	mu_assert_eq(mem->offset, 0, "offset");
+	mu_assert_eq(mem->size, 9, "merged size");
+	mu_assert_memeq(rz_vector_index_ptr(&page->data, mem->data), (const ut8 *)"AAAAAAAAB", 9, "merged data");
+	mem = rz_vector_index_ptr(&page->changes, 1);
+	mu_assert_eq(mem->cnum, 1, "next cnum");
+	mu_assert_eq(mem->offset, 9, "next offset");
+	mu_assert_eq(mem->size, 1, "next size");
+
+	rz_debug_session_free(s);
+	mu_end;
+}
+
+static void add_checkpoint(RzDebugSession *s, ut8 first, ut8 second) {
+	RzDebugCheckpoint checkpoint = { 0 };
+	checkpoint.cnum = s->cnum;
+	RzRegArena *a = rz_reg_arena_new(0x10);
+	memset(a->bytes, s->cnum, a->size);
+	checkpoint.arena[RZ_REG_TYPE_GPR] = a;
+	checkpoint.snaps = rz_list_newf((RzListFree)rz_debug_snap_free);
+	RzDebugSnap *snap = RZ_NEW0(RzDebugSnap);
+	snap->name = strdup("[stack]");
+	snap->addr = 0x7fffffde000;
+	snap->size = 2 * RZ_DEBUG_SESSION_PAGE_SIZE;
+	snap->addr_end = snap->addr + snap->size;
+	snap->perm = 6;
+	snap->data = malloc(snap->size);
+	memset(snap->data, first, RZ_DEBUG_SESSION_PAGE_SIZE);
+	memset(snap->data + RZ_DEBUG_SESSION_PAGE_SIZE, second, RZ_DEBUG_SESSION_PAGE_SIZE);
+	rz_list_append(checkpoint.snaps, snap);
+	rz_vector_push(s->checkpoints, &checkpoint);
+}
+
+static bool test_session_save_load_file(void) {
+	RzDebugSession *ref = rz_debug_session_new();
+	add_checkpoint(ref, 0xf0, 0xf1);
+	rz_debug_session_add_reg_change(ref, 0, 0x100, 0x41424344);
+	rz_debug_session_add_mem_changes(ref, 0x7ffffffff000, (const ut8 *)"\xaa\x00", 2);
+	ref->maxcnum++;
+	ref->cnum++;
+	// the first page of the stack did not change
+	add_checkpoint(ref, 0xf0, 0xf2);
+	rz_debug_session_add_reg_change(ref, 0, 0x100, 0xdeadbeef);
+	rz_debug_session_add_mem_changes(ref, 0x7ffffffff000, (const ut8 *)"\xbb\x01", 2);
+
+	char *tmpdir = rz_file_tmpdir();
+	char *dir = rz_str_newf("%s" RZ_SYS_DIR "rz-test-session-%d", tmpdir, rz_sys_getpid());
+	char *file = rz_str_newf("%s" RZ_SYS_DIR "session.rzds", dir);
+	mu_assert_true(rz_sys_mkdirp(dir), "mkdir");
+	mu_assert_true(rz_debug_session_save(ref, dir), "save");
+	ut64 size = rz_file_size(file);
+	mu_assert_true(size > 3 * RZ_DEBUG_SESSION_PAGE_SIZE && size < 4 * RZ_DEBUG_SESSION_PAGE_SIZE, "unchanged page not stored");
+
+	RzCore *core = rz_core_new();
+	rz_debug_session_free(core->dbg->session);
+	core->dbg->session = rz_debug_session_new();
+	mu_assert_true(rz_debug_session_load(core->dbg, dir), "load");
+	RzDebugSession *s = core->dbg->session;
+
+	mu_assert_eq(s->maxcnum, ref->maxcnum, "maxcnum");
+	mu_assert_eq(s->registers->count, ref->registers->count, "registers");
+	ht_up_foreach(s->registers, compare_registers_cb, ref->registers);
+	mu_assert_eq(s->memory->count, ref->memory->count, "memory");
+	ht_up_foreach(s->memory, compare_memory_cb, ref->memory);
+	mu_assert_eq(s->checkpoints->len, 2, "checkpoints length");
+	size_t chkpt_idx;
+	RzDebugCheckpoint *chkpt;
+	rz_vector_enumerate(s->checkpoints, chkpt, chkpt_idx) {
+		RzDebugCheckpoint *ref_chkpt = rz_vector_index_ptr(ref->checkpoints, chkpt_idx);
+		mu_assert_eq(chkpt->cnum, ref_chkpt->cnum, "checkpoint cnum");
+		mu_assert_true(arena_eq(chkpt->arena[RZ_REG_TYPE_GPR], ref_chkpt->arena[RZ_REG_TYPE_GPR]), "arena");
+		mu_assert_eq(rz_list_length(chkpt->snaps), 1, "snaps");
+		mu_assert_true(snap_eq(rz_list_first(chkpt->snaps), rz_list_first(ref_chkpt->snaps)), "snap");
+	}
+
+	rz_core_free(core);
+	rz_debug_session_free(ref);
+	rz_file_rm(file);
+	rz_file_rm(dir);
+	free(file);
+	free(dir);
+	free(tmpdir);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_session_save);
 	mu_run_test(test_session_load);
+	mu_run_test(test_session_load_legacy_memory);
+	mu_run_test(test_session_mem_pages);
+	mu_run_test(test_session_save_load_file);
 	return tests_passed != tests_run;
 }
 
@@ -4,6 +4,8 @@
 
 #include <math.h>
 #include <rz_flirt.h>
+#include <rz_flag.h>
+#include <rz_io.h>
 #include <rz_util.h>
 #include "minunit.h"
 
@@ -48,6 +50,63 @@ test_flirt_pat_def(parse_multiline, 5,
 	"31C04885D2741F488D4417FF4839C77610EB1D0F1F4400004883E8014839C777 13 9867 0033 :0000 Curl_memrchr \n"
 	"---\n");
 
+static RzFlirtNode *parse_pat(const char *string) {
+	RzBuffer *buffer = rz_buf_new_with_string(string);
+	RzFlirtNode *node = rz_sign_flirt_parse_string_pattern_from_buffer(buffer, RZ_FLIRT_NODE_OPTIMIZE_NONE, NULL);
+	rz_buf_free(buffer);
+	return node;
+}
+
+static void add_function(RzAnalysis *analysis, ut64 addr) {
+	char name[32];
+	rz_strf(name, "fcn.%08" PFMT64x, addr);
+	RzAnalysisFunction *fcn = rz_analysis_create_function(analysis, name, addr, RZ_ANALYSIS_FCN_TYPE_FCN);
+	RzAnalysisBlock *block = rz_analysis_create_block(analysis, addr, 0x20);
+	rz_analysis_function_add_block(fcn, block);
+	rz_analysis_block_unref(block);
+}
+
+bool test_flirt_apply_nodes(void) {
+	RzIO *io = rz_io_new();
+	rz_io_open_at(io, "malloc://0x300", RZ_PERM_RW, 0644, 0, NULL);
+	RzFlag *flag = rz_flag_new();
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_io_bind(io, &analysis->iob);
+	rz_flag_bind(flag, &analysis->flb);
+
+	ut8 code[0x20];
+	rz_hex_str2bin("5548909090909090909090909090909090909090909090909090909090909090", code);
+	rz_io_write_at(io, 0x000, code, sizeof(code));
+	rz_hex_str2bin("5548CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC", code);
+	rz_io_write_at(io, 0x100, code, sizeof(code));
+	rz_hex_str2bin("C3ABABABABABABABABABABABABABABABABABABABABABABABABABABABABABABAB", code);
+	rz_io_write_at(io, 0x200, code, sizeof(code));
+	add_function(analysis, 0x000);
+	add_function(analysis, 0x100);
+	add_function(analysis, 0x200);
+
+	RzPVector *trees = rz_pvector_new((RzPVectorFree)rz_sign_flirt_node_free);
+	rz_pvector_push(trees, parse_pat("5548909090909090909090909090909090909090909090909090909090909090 00 0000 0020 :0000 first\n---\n"));
+	// matches 0x000 too, but the first tree renamed it already
+	rz_pvector_push(trees, parse_pat("5548............................................................ 00 0000 0020 :0000 second\n"
+					 "..ABABABABABABABABABABABABABABABABABABABABABABABABABABABABABABAB 00 0000 0020 :0000 third\n"
+					 "---\n"));
+	mu_assert_notnull(rz_pvector_at(trees, 0), "first tree");
+	mu_assert_notnull(rz_pvector_at(trees, 1), "second tree");
+
+	mu_assert_true(rz_sign_flirt_apply_nodes(analysis, trees, 2), "apply");
+	mu_assert_streq(rz_analysis_get_function_at(analysis, 0x000)->name, "flirt.first", "first tree match");
+	mu_assert_streq(rz_analysis_get_function_at(analysis, 0x100)->name, "flirt.second", "second tree match");
+	mu_assert_streq(rz_analysis_get_function_at(analysis, 0x200)->name, "flirt.third", "variant first byte match");
+	mu_assert_notnull(rz_flag_get(flag, "flirt.second"), "flag");
+
+	rz_pvector_free(trees);
+	rz_analysis_free(analysis);
+	rz_flag_free(flag);
+	rz_io_free(io);
+	mu_end;
+}
+
 int all_tests() {
 	test_flirt_pat_run(parse_signature);
 	test_flirt_pat_run(parse_comment);
@@ -55,6 +114,7 @@ int all_tests() {
 	test_flirt_pat_run(parse_large_function);
 	test_flirt_pat_run(parse_large_offset);
 	test_flirt_pat_run(parse_multiline);
+	mu_run_test(test_flirt_apply_nodes);
 	return tests_passed != tests_run;
 }
 
@@ -141,8 +141,49 @@ static bool test_legacy_graph(void) {
 	mu_end;
 }
 
+static bool test_graph_del_nodes(void) {
+	RzGraph *g = rz_graph_new();
+	RzGraphNode *gn1 = rz_graph_add_node(g, (void *)1);
+	RzGraphNode *gn2 = rz_graph_add_node(g, (void *)2);
+	RzGraphNode *gn3 = rz_graph_add_node(g, (void *)3);
+	RzGraphNode *gn4 = rz_graph_add_node(g, (void *)4);
+	rz_graph_add_edge(g, gn1, gn2);
+	rz_graph_add_edge(g, gn2, gn3);
+	rz_graph_add_edge(g, gn3, gn4);
+	rz_graph_add_edge(g, gn1, gn4);
+	mu_assert_eq(g->n_edges, 4, "n_edges");
+
+	RzList *del = rz_list_new();
+	rz_list_append(del, gn2);
+	rz_list_append(del, gn3);
+	rz_list_append(del, gn2);
+	rz_graph_del_nodes(g, del);
+	rz_list_free(del);
+	mu_assert_eq(g->n_nodes, 2, "n_nodes.del_nodes");
+	mu_assert_eq(g->n_edges, 1, "n_edges.del_nodes");
+
+	RzList *exp_nodes = rz_list_new();
+	rz_list_append(exp_nodes, gn1);
+	rz_list_append(exp_nodes, gn4);
+	check_list(rz_graph_get_nodes(g), exp_nodes, "get_all_nodes.del_nodes");
+	rz_list_free(exp_nodes);
+
+	RzList *exp_neigh = rz_list_new();
+	rz_list_append(exp_neigh, gn4);
+	check_list(rz_graph_get_neighbours(g, gn1), exp_neigh, "get_neighbours.del_nodes");
+	rz_list_free(exp_neigh);
+	RzList *exp_innodes = rz_list_new();
+	rz_list_append(exp_innodes, gn1);
+	check_list(rz_graph_innodes(g, gn4), exp_innodes, "in_nodes.del_nodes");
+	rz_list_free(exp_innodes);
+
+	rz_graph_free(g);
+	mu_end;
+}
+
 static int all_tests() {
 	mu_run_test(test_legacy_graph);
+	mu_run_test(test_graph_del_nodes);
 	return tests_passed != tests_run;
 }
 
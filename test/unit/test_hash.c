@@ -238,11 +238,73 @@ bool test_message_digest_small_block_stringified() {
 	mu_end;
 }
 
+static RzHashCfg *hash_cfg_large_buffer(RzHash *rh, const char **algos, size_t n_algos, size_t threads, const ut8 *data, ut64 size) {
+	RzHashCfg *md = rz_hash_cfg_new(rh);
+	if (!md) {
+		return NULL;
+	}
+	md->threads = threads;
+	for (size_t i = 0; i < n_algos; i++) {
+		if (!rz_hash_cfg_configure(md, algos[i])) {
+			rz_hash_cfg_free(md);
+			return NULL;
+		}
+	}
+	// twice, so that the contexts carry state from one parallel update to the next
+	if (!rz_hash_cfg_init(md) ||
+		!rz_hash_cfg_update(md, data, size) ||
+		!rz_hash_cfg_update(md, data, size) ||
+		!rz_hash_cfg_final(md)) {
+		rz_hash_cfg_free(md);
+		return NULL;
+	}
+	return md;
+}
+
+bool test_message_digest_threads() {
+	const char *algos[] = { "md5", "sha1", "sha256", "sha512", "adler32", "xor8" };
+	const ut64 size = 3 * 1024 * 1024 + 17;
+	char message[256];
+	RzHashSize digest_size;
+	RzHash *rh = rz_hash_new();
+	ut8 *data = malloc(size);
+	mu_assert_notnull(data, "data");
+	for (ut64 i = 0; i < size; i++) {
+		data[i] = (ut8)(i * 31 + (i >> 11));
+	}
+
+	RzHashCfg *md = rz_hash_cfg_new(rh);
+	mu_assert_eq(md->threads, 1, "single threaded by default");
+	rz_hash_cfg_free(md);
+
+	RzHashCfg *serial = hash_cfg_large_buffer(rh, algos, RZ_ARRAY_SIZE(algos), 1, data, size);
+	mu_assert_notnull(serial, "single threaded digest");
+	const size_t threads[] = { 0, 2, 4 };
+	for (size_t t = 0; t < RZ_ARRAY_SIZE(threads); t++) {
+		RzHashCfg *parallel = hash_cfg_large_buffer(rh, algos, RZ_ARRAY_SIZE(algos), threads[t], data, size);
+		mu_assert_notnull(parallel, "multi threaded digest");
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(algos); i++) {
+			char *expected = rz_hash_cfg_get_result_string(serial, algos[i], &digest_size, false);
+			char *result = rz_hash_cfg_get_result_string(parallel, algos[i], &digest_size, false);
+			snprintf(message, sizeof(message), "%s digest with %" PFMTSZu " threads", algos[i], threads[t]);
+			mu_assert_streq(result, expected, message);
+			free(expected);
+			free(result);
+		}
+		rz_hash_cfg_free(parallel);
+	}
+	rz_hash_cfg_free(serial);
+	free(data);
+	rz_hash_free(rh);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_message_digest_configure);
 	mu_run_test(test_message_digest_api_stringified);
 	mu_run_test(test_message_digest_hmac_stringified);
 	mu_run_test(test_message_digest_small_block_stringified);
+	mu_run_test(test_message_digest_threads);
 	return tests_passed != tests_run;
 }
 
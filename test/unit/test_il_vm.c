@@ -312,6 +312,52 @@ static bool test_rzil_vm_op_signed() {
 	mu_end;
 }
 
+static bool test_rzil_vm_op_arith() {
+	RzILVM *vm = rz_il_vm_new(0, 8, false);
+	const ut32 lens[] = { 8, 33, 64, 65 };
+	const ut64 vals[][2] = { { 0, 0 }, { 0xff, 0x02 }, { 0x01, 0x02 }, { 0x80, 0x80 }, { UT64_MAX, 0x1234 } };
+	for (size_t l = 0; l < RZ_ARRAY_SIZE(lens); l++) {
+		for (size_t v = 0; v < RZ_ARRAY_SIZE(vals); v++) {
+			RzBitVector *x = rz_bv_new_from_ut64(lens[l], vals[v][0]);
+			RzBitVector *y = rz_bv_new_from_ut64(lens[l], vals[v][1]);
+			RzBitVector *expect[] = {
+				rz_bv_add(x, y, NULL), rz_bv_sub(x, y, NULL), rz_bv_mul(x, y),
+				rz_bv_and(x, y), rz_bv_or(x, y), rz_bv_xor(x, y), rz_bv_neg(x), rz_bv_not(x)
+			};
+			RzILOpPure *ops[] = {
+				rz_il_op_new_add(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_sub(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_mul(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_log_and(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_log_or(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_log_xor(rz_il_op_new_bitv(rz_bv_dup(x)), rz_il_op_new_bitv(rz_bv_dup(y))),
+				rz_il_op_new_neg(rz_il_op_new_bitv(rz_bv_dup(x))),
+				rz_il_op_new_log_not(rz_il_op_new_bitv(rz_bv_dup(x)))
+			};
+			for (size_t i = 0; i < RZ_ARRAY_SIZE(ops); i++) {
+				RzBitVector *r = rz_il_evaluate_bitv(vm, ops[i]);
+				mu_assert_notnull(r, "eval");
+				mu_assert_eq(rz_bv_len(r), lens[l], "eval length");
+				mu_assert_true(rz_bv_eq(r, expect[i]), "same result as the bitvector operation");
+				rz_bv_free(r);
+				rz_bv_free(expect[i]);
+				rz_il_op_pure_free(ops[i]);
+			}
+			rz_bv_free(x);
+			rz_bv_free(y);
+		}
+	}
+
+	// operands of different lengths are an error
+	RzILOpPure *op = rz_il_op_new_add(rz_il_op_new_bitv_from_ut64(8, 1), rz_il_op_new_bitv_from_ut64(16, 1));
+	RzBitVector *r = rz_il_evaluate_bitv(vm, op);
+	rz_il_op_pure_free(op);
+	mu_assert_null(r, "length mismatch");
+
+	rz_il_vm_free(vm);
+	mu_end;
+}
+
 static bool test_rzil_vm_op_set() {
 	RzILVM *vm = rz_il_vm_new(0, 8, false);
 
@@ -1029,6 +1075,7 @@ bool all_tests() {
 	mu_run_test(test_rzil_vm_op_cast);
 	mu_run_test(test_rzil_vm_op_unsigned);
 	mu_run_test(test_rzil_vm_op_signed);
+	mu_run_test(test_rzil_vm_op_arith);
 	mu_run_test(test_rzil_vm_op_set);
 	mu_run_test(test_rzil_vm_op_jmp);
 	mu_run_test(test_rzil_vm_op_goto_addr);
@@ -165,6 +165,81 @@ bool test_rz_io_pcache(void) {
 	mu_end;
 }
 
+bool test_rz_io_page_cache(void) {
+	RzIO *io = rz_io_new();
+	ut8 buf[0x20];
+	ut64 hits, misses;
+	int fd = rz_io_fd_open(io, "malloc://0x3000", RZ_PERM_RW, 0);
+	rz_io_map_add(io, fd, RZ_PERM_RW, 0LL, 0x10000, 0x3000);
+	io->va = true;
+	rz_io_fd_write_at(io, fd, 0xff0, (const ut8 *)"0123456789abcdefghijklmnopqrstuv", 0x20);
+	mu_assert_true(rz_io_page_cache_resize(io, 2), "page cache enable");
+
+	// read across a page boundary, both pages are loaded
+	rz_io_read_at(io, 0x10ff0, buf, 0x20);
+	mu_assert_memeq(buf, (const ut8 *)"0123456789abcdefghijklmnopqrstuv", 0x20, "read across pages");
+	rz_io_page_cache_stats(io, &hits, &misses);
+	mu_assert_eq(hits, 0, "hits");
+	mu_assert_eq(misses, 2, "misses");
+	rz_io_read_at(io, 0x10ff8, buf, 0x10);
+	mu_assert_memeq(buf, (const ut8 *)"89abcdefghijklmn", 0x10, "cached read");
+	rz_io_page_cache_stats(io, &hits, &misses);
+	mu_assert_eq(hits, 2, "hits");
+	mu_assert_eq(misses, 2, "misses");
+
+	// writes must not be hidden by stale pages
+	rz_io_write_at(io, 0x11000, (const ut8 *)"XYZ", 3);
+	rz_io_read_at(io, 0x10ffe, buf, 6);
+	mu_assert_memeq(buf, (const ut8 *)"efXYZj", 6, "read after write");
+
+	// a third page evicts one of the two slots
+	rz_io_read_at(io, 0x12000, buf, 4);
+	rz_io_read_at(io, 0x10ff0, buf, 0x20);
+	mu_assert_memeq(buf, (const ut8 *)"0123456789abcdefXYZjklmnopqrstuv", 0x20, "read after eviction");
+
+	// short read at the end of the file
+	mu_assert_eq(rz_io_fd_read_at(io, fd, 0x2ff0, buf, 0x20), 0x10, "short read");
+
+	rz_io_page_cache_invalidate_all(io);
+	mu_assert_true(rz_io_page_cache_resize(io, 0), "page cache disable");
+	rz_io_read_at(io, 0x10ff0, buf, 4);
+	mu_assert_memeq(buf, (const ut8 *)"0123", 4, "uncached read");
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_rz_io_borrow(void) {
+	RzIO *io = rz_io_new();
+	int fd = rz_io_fd_open(io, "malloc://0x100", RZ_PERM_RW, 0);
+	rz_io_fd_write_at(io, fd, 0x10, (const ut8 *)"borrowed", 8);
+	rz_io_map_add(io, fd, RZ_PERM_R, 0LL, 0x1000, 0x80);
+	rz_io_map_add(io, fd, RZ_PERM_R, 0x80, 0x1080, 0x80);
+	io->va = true;
+
+	const ut8 *data = rz_io_borrow_at(io, 0x1010, 8);
+	mu_assert_notnull(data, "borrow inside a map");
+	mu_assert_memeq(data, (const ut8 *)"borrowed", 8, "borrowed bytes");
+	mu_assert_null(rz_io_borrow_at(io, 0x1070, 0x20), "borrow across maps");
+	mu_assert_null(rz_io_borrow_at(io, 0x1100, 4), "borrow unmapped");
+	mu_assert_null(rz_io_borrow_at(io, 0x1010, 0), "borrow nothing");
+
+	// patches in the io cache hide the backing memory
+	io->cached = RZ_PERM_RW;
+	rz_io_write_at(io, 0x1012, (const ut8 *)"X", 1);
+	mu_assert_null(rz_io_borrow_at(io, 0x1010, 8), "borrow over a patch");
+	mu_assert_notnull(rz_io_borrow_at(io, 0x1020, 8), "borrow next to a patch");
+	io->cached = 0;
+
+	io->va = false;
+	rz_io_use_fd(io, fd);
+	data = rz_io_borrow_at(io, 0x10, 8);
+	mu_assert_notnull(data, "physical borrow");
+	mu_assert_memeq(data, (const ut8 *)"borrowed", 8, "physical borrowed bytes");
+	mu_assert_null(rz_io_borrow_at(io, 0xf0, 0x20), "physical borrow past the end");
+	rz_io_free(io);
+	mu_end;
+}
+
 bool test_rz_io_desc_exchange(void) {
 	RzIO *io = rz_io_new();
 	int fd = rz_io_fd_open(io, "malloc://3", RZ_PERM_R, 0),
@@ -637,6 +712,8 @@ bool all_tests(void) {
 	mu_run_test(test_rz_io_mapsplit3);
 	mu_run_test(test_rz_io_maps_vector);
 	mu_run_test(test_rz_io_pcache);
+	mu_run_test(test_rz_io_page_cache);
+	mu_run_test(test_rz_io_borrow);
 	mu_run_test(test_rz_io_desc_exchange);
 	mu_run_test(test_rz_io_priority);
 	mu_run_test(test_rz_io_priority2);
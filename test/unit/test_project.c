@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2026 Rizin Organization
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_project.h>
+#include "minunit.h"
+#include "test_sdb.h"
+
+static Sdb *binary_project_db(void) {
+	Sdb *db = sdb_new0();
+	sdb_set(db, "type", "rizin rz-db project", 0);
+	sdb_set(db, "version", "13", 0);
+	Sdb *core = sdb_ns(db, "core", true);
+	sdb_set(core, "offset", "0x1337", 0);
+	Sdb *analysis = sdb_ns(core, "analysis", true);
+	Sdb *xrefs = sdb_ns(analysis, "xrefs", true);
+	for (int i = 0; i < 1000; i++) {
+		char key[32];
+		snprintf(key, sizeof(key), "0x%x", 0x1000 + i * 4);
+		sdb_set(xrefs, key, "[{\"to\":4096,\"type\":\"c\"}]", 0);
+	}
+	Sdb *meta = sdb_ns(analysis, "meta", true);
+	sdb_set(meta, "0x1000", "[{\"size\":4,\"type\":\"s\",\"str\":\"line\\nbreak\"}]", 0);
+	sdb_set(meta, PERTURBATOR, "a=b\nc\\d", 0);
+	sdb_ns(sdb_ns(meta, "spaces", true), "spacestack", true);
+	sdb_set(sdb_ns(core, "flags", true), "/leading/slash", "1", 0);
+	return db;
+}
+
+static bool test_project_binary_roundtrip(void) {
+	char *file = NULL;
+	int fd = rz_file_mkstemp("prjbin", &file);
+	mu_assert_neq(fd, -1, "mkstemp");
+	close(fd);
+	mu_assert_false(rz_project_is_binary_file(file), "empty file is not binary");
+
+	Sdb *db = binary_project_db();
+	mu_assert_true(rz_project_binary_save(db, file), "save");
+	mu_assert_true(rz_project_is_binary_file(file), "binary file");
+
+	Sdb *loaded = sdb_new0();
+	mu_assert_true(rz_project_binary_load(loaded, file), "load");
+	assert_sdb_eq(loaded, db, "loaded contents");
+	mu_assert_notnull(sdb_ns_path(loaded, "core/analysis/meta/spaces/spacestack", false), "empty namespace");
+	sdb_free(loaded);
+
+	// a corrupted section must be rejected
+	ut64 size = rz_file_size(file);
+	RzBuffer *b = rz_buf_new_file(file, O_RDWR, 0);
+	ut8 c = 0;
+	rz_buf_read_at(b, 64, &c, 1);
+	c ^= 0xff;
+	rz_buf_write_at(b, 64, &c, 1);
+	rz_buf_free(b);
+	mu_assert_eq(rz_file_size(file), size, "same size");
+	loaded = sdb_new0();
+	mu_assert_false(rz_project_binary_load(loaded, file), "corrupted load");
+	sdb_free(loaded);
+
+	sdb_free(db);
+	rz_file_rm(file);
+	free(file);
+	mu_end;
+}
+
+static bool test_project_binary_incremental(void) {
+	char *file = NULL;
+	int fd = rz_file_mkstemp("prjbin", &file);
+	mu_assert_neq(fd, -1, "mkstemp");
+	close(fd);
+
+	Sdb *db = binary_project_db();
+	mu_assert_true(rz_project_binary_save(db, file), "save");
+	ut64 size = rz_file_size(file);
+
+	// nothing changed, only the index is appended
+	mu_assert_true(rz_project_binary_save(db, file), "save unchanged");
+	ut64 index_size = rz_file_size(file) - size;
+	mu_assert_true(index_size < 1024, "unchanged sections are not rewritten");
+	size += index_size;
+
+	// only the meta section is rewritten, not the big xrefs one
+	Sdb *meta = sdb_ns_path(db, "core/analysis/meta", false);
+	sdb_set(meta, "0x2000", "[{\"size\":1,\"type\":\"d\"}]", 0);
+	mu_assert_true(rz_project_binary_save(db, file), "save changed");
+	mu_assert_true(rz_file_size(file) - size < 2048, "only the changed section is rewritten");
+
+	Sdb *loaded = sdb_new0();
+	mu_assert_true(rz_project_binary_load(loaded, file), "load");
+	assert_sdb_eq(loaded, db, "loaded contents");
+	sdb_free(loaded);
+
+	// once most of the file is stale, it is compacted
+	Sdb *xrefs = sdb_ns_path(db, "core/analysis/xrefs", false);
+	sdb_set(xrefs, "0x1000", "[]", 0);
+	mu_assert_true(rz_project_binary_save(db, file), "save xrefs");
+	size = rz_file_size(file);
+	sdb_set(xrefs, "0x1000", "[{}]", 0);
+	mu_assert_true(rz_project_binary_save(db, file), "save xrefs again");
+	mu_assert_true(rz_file_size(file) < size, "compacted");
+	char *tmp_file = rz_str_newf("%s.tmp", file);
+	mu_assert_false(rz_file_exists(tmp_file), "compacted through a replaced temporary file");
+	free(tmp_file);
+
+	loaded = sdb_new0();
+	mu_assert_true(rz_project_binary_load(loaded, file), "load compacted");
+	assert_sdb_eq(loaded, db, "compacted contents");
+	sdb_free(loaded);
+
+	sdb_free(db);
+	rz_file_rm(file);
+	free(file);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_project_binary_roundtrip);
+	mu_run_test(test_project_binary_incremental);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
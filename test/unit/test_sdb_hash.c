@@ -536,6 +536,66 @@ bool test_ht_pu_ops(void) {
 	mu_end;
 }
 
+static bool count_uu_cb(void *user, const ut64 key, const ut64 value) {
+	ut32 *count = user;
+	(*count)++;
+	return key + 1 == value;
+}
+
+bool test_ht_uu_high_keys(void) {
+	HtUU *ht = ht_uu_new0();
+	bool found;
+	ut32 i, count = 0;
+
+	// kernel-like addresses, which only differ in the lower bits
+	for (i = 0; i < 10000; i++) {
+		ut64 key = 0xffffffff81000000ULL + (ut64)i * 0x10;
+		mu_assert("key should be inserted", ht_uu_insert(ht, key, key + 1));
+	}
+	mu_assert_eq(ht->count, 10000, "all keys should be stored");
+
+	for (i = 0; i < 10000; i++) {
+		ut64 key = 0xffffffff81000000ULL + (ut64)i * 0x10;
+		mu_assert_eq(ht_uu_find(ht, key, &found), key + 1, "value should be retrieved");
+		mu_assert("found should be true", found);
+	}
+	ht_uu_find(ht, 0x81000000ULL, &found);
+	mu_assert("truncated key should not be found", !found);
+
+	ht_uu_foreach(ht, count_uu_cb, &count);
+	mu_assert_eq(count, 10000, "foreach should visit all keys");
+
+	ht_uu_free(ht);
+	mu_end;
+}
+
+bool test_ht_uu_churn(void) {
+	HtUU *ht = ht_uu_new0();
+	bool found;
+	ut64 i;
+
+	// repeatedly fill and empty the table, to stress the reuse of the deleted slots
+	for (ut32 round = 0; round < 8; round++) {
+		for (i = 0; i < 2000; i++) {
+			ht_uu_insert(ht, (i << 32) | round, i);
+		}
+		for (i = 0; i < 2000; i += 2) {
+			mu_assert("key should be deleted", ht_uu_delete(ht, (i << 32) | round));
+		}
+		for (i = 1; i < 2000; i += 2) {
+			mu_assert_eq(ht_uu_find(ht, (i << 32) | round, &found), i, "odd keys should be retrieved");
+			mu_assert("found should be true", found);
+			mu_assert("key should be deleted", ht_uu_delete(ht, (i << 32) | round));
+		}
+		mu_assert_eq(ht->count, 0, "the table should be empty");
+	}
+	ht_uu_find(ht, 1ULL << 32, &found);
+	mu_assert("found should be false", !found);
+
+	ht_uu_free(ht);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_ht_insert_lookup);
 	mu_run_test(test_ht_update_lookup);
@@ -556,6 +616,8 @@ int all_tests() {
 	mu_run_test(test_foreach_delete);
 	mu_run_test(test_update_key);
 	mu_run_test(test_ht_pu_ops);
+	mu_run_test(test_ht_uu_high_keys);
+	mu_run_test(test_ht_uu_churn);
 	return tests_passed != tests_run;
 }
 
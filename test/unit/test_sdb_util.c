@@ -3,6 +3,7 @@
 
 #include "minunit.h"
 #include <sdb.h>
+#include <set.h>
 #include <fcntl.h>
 #include <stdio.h>
 
@@ -25,9 +26,25 @@ bool test_sdb_itoa() {
 	mu_end;
 }
 
+bool test_set_p() {
+	char a[] = "same", b[] = "same";
+	SetP *set = set_p_new();
+	mu_assert_notnull(set, "set_p_new");
+	set_p_add(set, a);
+	mu_assert_true(set_p_contains(set, a), "contains a");
+	mu_assert_false(set_p_contains(set, b), "pointers are compared, not strings");
+	set_p_add(set, b);
+	set_p_delete(set, a);
+	mu_assert_false(set_p_contains(set, a), "a deleted");
+	mu_assert_true(set_p_contains(set, b), "contains b");
+	set_p_free(set);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_sdb_itoa_null_arg);
 	mu_run_test(test_sdb_itoa);
+	mu_run_test(test_set_p);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include "minunit.h"
+
+// less than RZ_SEARCH_MULTIKEY_MIN, so that RZ_SEARCH_KEYWORD matches byte by byte
+static const char *hex_kws[] = {
+	"4889e5",
+	"c3",
+	"9090",
+	"e8..ff..",
+	"5.4.", // no fully masked byte, not anchored
+	"b8........c3",
+};
+
+typedef struct {
+	ut64 kw;
+	ut64 addr;
+} Hit;
+
+static int hit_cb(RzSearchKeyword *kw, void *user, ut64 where) {
+	Hit hit = { kw->kwidx, where };
+	return rz_vector_push(user, &hit) ? 1 : 0;
+}
+
+static void search_all(RzVector /*<Hit>*/ *hits, int mode, const ut8 *buf, int len, int chunk, bool overlap, bool icase) {
+	RzSearch *s = rz_search_new(mode);
+	s->overlap = overlap;
+	s->contiguous = true;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(hex_kws); i++) {
+		rz_search_kw_add(s, rz_search_keyword_new_hexmask(hex_kws[i], NULL));
+	}
+	rz_search_kw_add(s, rz_search_keyword_new_str("Hello", NULL, NULL, icase));
+	rz_search_set_callback(s, hit_cb, hits);
+	rz_search_begin(s);
+	for (int off = 0; off < len; off += chunk) {
+		rz_search_update(s, 0x1000 + off, buf + off, RZ_MIN(chunk, len - off));
+	}
+	rz_search_free(s);
+}
+
+static ut8 *sample_buffer(int len) {
+	static const char *snippets[] = {
+		"\x55\x48\x89\xe5", "\xc3", "\x90\x90\x90", "\xde\xad\xbe\xef",
+		"\xe8\x01\xff\x02", "\xb8\x10\x11\x22\x33\xc3", "HELLO", "Hello", "hElLo"
+	};
+	ut8 *buf = malloc(len);
+	ut32 seed = 0x1337;
+	for (int i = 0; i < len;) {
+		seed = seed * 1103515245 + 12345;
+		if ((seed >> 16) % 4) {
+			buf[i++] = seed >> 8;
+			continue;
+		}
+		const char *snip = snippets[(seed >> 20) % RZ_ARRAY_SIZE(snippets)];
+		for (size_t j = 0; snip[j] && i < len; j++) {
+			buf[i++] = snip[j];
+		}
+	}
+	return buf;
+}
+
+bool test_search_multikey_same_hits(void) {
+	const int len = 0x4000;
+	ut8 *buf = sample_buffer(len);
+	const int chunks[] = { len, 0x100, 7 };
+	RzVector brute, multi;
+	rz_vector_init(&brute, sizeof(Hit), NULL, NULL);
+	rz_vector_init(&multi, sizeof(Hit), NULL, NULL);
+	for (size_t c = 0; c < RZ_ARRAY_SIZE(chunks); c++) {
+		for (int overlap = 0; overlap < 2; overlap++) {
+			for (int icase = 0; icase < 2; icase++) {
+				rz_vector_clear(&brute);
+				rz_vector_clear(&multi);
+				search_all(&brute, RZ_SEARCH_KEYWORD, buf, len, chunks[c], overlap, icase);
+				search_all(&multi, RZ_SEARCH_MULTIKEY, buf, len, chunks[c], overlap, icase);
+				mu_assert_true(rz_vector_len(&brute) > 100, "enough hits");
+				mu_assert_eq(rz_vector_len(&multi), rz_vector_len(&brute), "hits count");
+				mu_assert_memeq(multi.a, brute.a, rz_vector_len(&brute) * sizeof(Hit), "same hits in the same order");
+			}
+		}
+	}
+	rz_vector_fini(&brute);
+	rz_vector_fini(&multi);
+	free(buf);
+	mu_end;
+}
+
+bool test_search_multikey_basic(void) {
+	const ut8 buf[] = "\x90\x90\x90\x55\x48\x89\xe5\xc3 Hello hello";
+	RzSearch *s = rz_search_new(RZ_SEARCH_MULTIKEY);
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("9090", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("4889e5", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("55..89", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_str("hello", NULL, NULL, true));
+	s->overlap = true;
+	RzList *hits = rz_search_find(s, 0x100, buf, sizeof(buf) - 1);
+	const ut64 expect[][2] = {
+		{ 0, 0x100 }, { 0, 0x101 }, { 1, 0x104 }, { 2, 0x103 }, { 3, 0x109 }, { 3, 0x10f }
+	};
+	mu_assert_eq(rz_list_length(hits), RZ_ARRAY_SIZE(expect), "hits count");
+	RzListIter *it;
+	RzSearchHit *hit;
+	size_t i = 0;
+	rz_list_foreach (hits, it, hit) {
+		mu_assert_eq(hit->kw->kwidx, expect[i][0], "hit keyword");
+		mu_assert_eq(hit->addr, expect[i][1], "hit address");
+		i++;
+	}
+	hits->free = free;
+	rz_list_free(hits);
+	rz_search_free(s);
+	mu_end;
+}
+
+bool all_tests(void) {
+	mu_run_test(test_search_multikey_basic);
+	mu_run_test(test_search_multikey_same_hits);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
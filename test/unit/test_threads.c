@@ -222,12 +222,171 @@ bool test_thread_iterator_pvec(void) {
 	mu_end;
 }
 
+typedef struct {
+	RzThreadScheduler *scheduler;
+	ut64 n;
+	ut64 result;
+} FibTask;
+
+static void *thread_task_fib(FibTask *fib) {
+	if (fib->n < 2) {
+		fib->result = fib->n;
+		return fib;
+	}
+	FibTask a = { fib->scheduler, fib->n - 1, 0 };
+	FibTask b = { fib->scheduler, fib->n - 2, 0 };
+	// tasks submitted and joined from a task must not deadlock the workers
+	RzThreadTask *task = rz_th_scheduler_submit(fib->scheduler, (RzThreadFunction)thread_task_fib, &a);
+	thread_task_fib(&b);
+	rz_th_task_join(task);
+	rz_th_task_free(task);
+	fib->result = a.result + b.result;
+	return fib;
+}
+
+bool test_thread_scheduler(void) {
+	RzThreadScheduler *scheduler = rz_th_scheduler_new(RZ_THREAD_POOL_ALL_CORES);
+	mu_assert_notnull(scheduler, "rz_th_scheduler_new(RZ_THREAD_POOL_ALL_CORES) null check");
+	mu_assert_eq(rz_th_scheduler_size(scheduler), rz_th_physical_core_number(), "scheduler size");
+
+	FibTask fib = { scheduler, 20, 0 };
+	RzThreadTask *task = rz_th_scheduler_submit(scheduler, (RzThreadFunction)thread_task_fib, &fib);
+	mu_assert_notnull(task, "rz_th_scheduler_submit null check");
+	mu_assert_ptreq(rz_th_task_join(task), &fib, "join returns the task result");
+	mu_assert_true(rz_th_task_is_done(task), "task is done");
+	mu_assert_eq(fib.result, 6765, "fib(20)");
+	rz_th_task_free(task);
+	rz_th_scheduler_free(scheduler);
+
+	// a single worker must run the nested tasks while joining
+	scheduler = rz_th_scheduler_new(1);
+	mu_assert_notnull(scheduler, "rz_th_scheduler_new(1) null check");
+	mu_assert_eq(rz_th_scheduler_size(scheduler), 1, "scheduler size");
+	fib.scheduler = scheduler;
+	fib.n = 15;
+	task = rz_th_scheduler_submit(scheduler, (RzThreadFunction)thread_task_fib, &fib);
+	rz_th_task_free(task);
+	mu_assert_eq(fib.result, 610, "fib(15)");
+	rz_th_scheduler_free(scheduler);
+	mu_end;
+}
+
+typedef struct {
+	RzThreadLock *lock;
+	RzThreadTaskGroup *group;
+	RzAtomicBool *breaked;
+	size_t count;
+	size_t break_at;
+} GroupCounter;
+
+static void *thread_task_count(GroupCounter *counter) {
+	if (rz_th_task_group_is_cancelled(counter->group)) {
+		return NULL;
+	}
+	rz_th_lock_enter(counter->lock);
+	if (++counter->count == counter->break_at) {
+		rz_atomic_bool_set(counter->breaked, true);
+	}
+	rz_th_lock_leave(counter->lock);
+	return NULL;
+}
+
+static bool thread_group_breaked(GroupCounter *counter) {
+	return rz_atomic_bool_get(counter->breaked);
+}
+
+bool test_thread_task_group(void) {
+	RzThreadScheduler *scheduler = rz_th_scheduler_new(RZ_THREAD_POOL_ALL_CORES);
+	mu_assert_notnull(scheduler, "rz_th_scheduler_new null check");
+	GroupCounter counter = { 0 };
+	counter.lock = rz_th_lock_new(false);
+	counter.breaked = rz_atomic_bool_new(false);
+	mu_assert_false(rz_atomic_bool_get(counter.breaked), "rz_atomic_bool_new(false) is false");
+
+	counter.group = rz_th_task_group_new(scheduler);
+	mu_assert_notnull(counter.group, "rz_th_task_group_new null check");
+	for (size_t i = 0; i < 1000; i++) {
+		mu_assert_true(rz_th_task_group_submit(counter.group, (RzThreadFunction)thread_task_count, &counter), "task submitted");
+	}
+	mu_assert_true(rz_th_task_group_wait(counter.group), "group was not cancelled");
+	mu_assert_eq(counter.count, 1000, "all the tasks did run");
+	rz_th_task_group_free(counter.group);
+
+	// cancel the group when the break check returns true
+	counter.count = 0;
+	counter.break_at = 10;
+	counter.group = rz_th_task_group_new(scheduler);
+	rz_th_task_group_set_break_check(counter.group, (RzThreadBreakCheck)thread_group_breaked, &counter);
+	size_t submitted = 0;
+	while (submitted < 100000 && rz_th_task_group_submit(counter.group, (RzThreadFunction)thread_task_count, &counter)) {
+		submitted++;
+	}
+	mu_assert_false(rz_th_task_group_wait(counter.group), "group was cancelled");
+	mu_assert_true(rz_th_task_group_is_cancelled(counter.group), "group is cancelled");
+	mu_assert_false(rz_th_task_group_submit(counter.group, (RzThreadFunction)thread_task_count, &counter), "cannot submit to a cancelled group");
+	mu_assert_true(counter.count >= 10 && counter.count < 100000, "the tasks after the break were skipped");
+	rz_th_task_group_free(counter.group);
+
+	rz_atomic_bool_free(counter.breaked);
+	rz_th_lock_free(counter.lock);
+	rz_th_scheduler_free(scheduler);
+	mu_end;
+}
+
+typedef struct {
+	RzAtomicBool *breaked;
+	RzAtomicBool *seen; ///< set when the break check runs after the break
+	bool seen_by_task;
+} BreakPoll;
+
+static bool thread_poll_breaked(BreakPoll *poll) {
+	if (!rz_atomic_bool_get(poll->breaked)) {
+		return false;
+	}
+	rz_atomic_bool_set(poll->seen, true);
+	return true;
+}
+
+static void *thread_task_break_and_wait(BreakPoll *poll) {
+	rz_atomic_bool_set(poll->breaked, true);
+	// nothing is submitted or completed meanwhile, only polling can see the break
+	for (size_t i = 0; i < 500 && !rz_atomic_bool_get(poll->seen); i++) {
+		rz_sys_usleep(10000);
+	}
+	poll->seen_by_task = rz_atomic_bool_get(poll->seen);
+	return NULL;
+}
+
+bool test_thread_task_group_break_poll(void) {
+	RzThreadScheduler *scheduler = rz_th_scheduler_new(1);
+	mu_assert_notnull(scheduler, "rz_th_scheduler_new(1) null check");
+	BreakPoll poll = { 0 };
+	poll.breaked = rz_atomic_bool_new(false);
+	poll.seen = rz_atomic_bool_new(false);
+
+	RzThreadTaskGroup *group = rz_th_task_group_new(scheduler);
+	mu_assert_notnull(group, "rz_th_task_group_new null check");
+	rz_th_task_group_set_break_check(group, (RzThreadBreakCheck)thread_poll_breaked, &poll);
+	mu_assert_true(rz_th_task_group_submit(group, (RzThreadFunction)thread_task_break_and_wait, &poll), "task submitted");
+	mu_assert_false(rz_th_task_group_wait(group), "group was cancelled");
+	mu_assert_true(poll.seen_by_task, "the break was polled while the task was running");
+	rz_th_task_group_free(group);
+
+	rz_atomic_bool_free(poll.seen);
+	rz_atomic_bool_free(poll.breaked);
+	rz_th_scheduler_free(scheduler);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_thread_pool_cores);
 	mu_run_test(test_thread_queue);
 	mu_run_test(test_thread_ht);
 	mu_run_test(test_thread_iterator_list);
 	mu_run_test(test_thread_iterator_pvec);
+	mu_run_test(test_thread_scheduler);
+	mu_run_test(test_thread_task_group);
+	mu_run_test(test_thread_task_group_break_poll);
 	return tests_passed != tests_run;
 }
 
@@ -1705,6 +1705,59 @@ bool test_path_by_offset_typedef(void) {
 	mu_end;
 }
 
+static bool test_lazy_callables(void) {
+	const char *types_dir = TEST_BUILD_TYPES_DIR;
+	RzTypeDB *eager = rz_type_db_new();
+	eager->pin_all = true;
+	rz_type_db_init(eager, types_dir, "x86", 64, "linux");
+	mu_assert_null(eager->lazy_callables, "callables are loaded eagerly");
+	RzTypeDB *typedb = rz_type_db_new();
+	rz_type_db_init(typedb, types_dir, "x86", 64, "linux");
+	mu_assert_notnull(typedb->lazy_callables, "callables are loaded on lookup");
+	ut32 opened = rz_list_length(typedb->lazy_callables);
+	rz_type_db_init(typedb, types_dir, "x86", 64, "linux");
+	mu_assert_eq(rz_list_length(typedb->lazy_callables), opened, "databases are opened once");
+	ut32 loaded = typedb->callables->count;
+	mu_assert_false(rz_type_func_exist(typedb, "not_a_function"), "unknown function");
+	mu_assert_eq(typedb->callables->count, loaded, "nothing is loaded by a miss");
+
+	RzCallable *callable = rz_type_func_get(typedb, "puts");
+	mu_assert_notnull(callable, "puts is loaded on lookup");
+	mu_assert_eq(rz_pvector_len(callable->args), 1, "puts arguments");
+	char *ret = rz_type_as_string(typedb, callable->ret);
+	mu_assert_streq(ret, "int", "puts return type");
+	free(ret);
+	mu_assert_eq(typedb->callables->count, loaded + 1, "only puts is loaded");
+	mu_assert_true(rz_type_func_exist(typedb, "strlen"), "strlen exists");
+
+	RzList *noret_eager = rz_type_noreturn_function_names(eager);
+	RzList *noret = rz_type_noreturn_function_names(typedb);
+	mu_assert_notnull(typedb->lazy_callables, "noreturn functions are listed without loading them");
+	mu_assert_eq(rz_list_length(noret), rz_list_length(noret_eager), "noreturn functions");
+	RzListIter *it;
+	const char *name;
+	rz_list_foreach (noret_eager, it, name) {
+		mu_assert_notnull(rz_list_find(noret, name, (RzListComparator)strcmp), "noreturn function");
+	}
+	rz_list_free(noret_eager);
+	rz_list_free(noret);
+
+	rz_type_func_delete(typedb, "puts");
+	rz_type_func_delete(typedb, "strlen");
+	mu_assert_false(rz_type_func_exist(typedb, "puts"), "puts is deleted");
+	mu_assert_false(rz_type_func_exist(typedb, "strlen"), "strlen is deleted");
+
+	RzList *names = rz_type_function_names(typedb);
+	mu_assert_null(typedb->lazy_callables, "listing pins all the callables");
+	mu_assert_eq(rz_list_length(names) + 2, eager->callables->count, "all the callables but the deleted ones");
+	rz_list_free(names);
+	mu_assert_false(rz_type_func_exist(typedb, "puts"), "puts is still deleted");
+
+	rz_type_db_free(typedb);
+	rz_type_db_free(eager);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_types_get_base_type_struct);
 	mu_run_test(test_types_get_base_type_union);
@@ -1733,6 +1786,7 @@ int all_tests() {
 	mu_run_test(test_path_by_offset_union);
 	mu_run_test(test_path_by_offset_array);
 	mu_run_test(test_path_by_offset_typedef);
+	mu_run_test(test_lazy_callables);
 	return tests_passed != tests_run;
 }
 